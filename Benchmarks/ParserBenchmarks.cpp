@@ -0,0 +1,895 @@
+// Parser and evaluator microbenchmarks over synthetic probe outputs.
+// Runs without Windows: every check is driven through its static evaluate()
+// with generated text, so only parsing and scoring cost is measured.
+//
+// Usage: ParserBenchmarks [--scale N] [--min-time SECONDS] [--filter TEXT]
+
+#include "SyntheticProbeData.h"
+#include "AccountDirectory.h"
+#include "BitLockerCheck.h"
+#include "CsvReader.h"
+#include "EvtxParser.h"
+#include "FactTable.h"
+#include "FileIntegrity.h"
+#include "FileIntegrityCheck.h"
+#include "FirewallCheck.h"
+#include "FirewallRules.h"
+#include "FirewallRulesCheck.h"
+#include "GroupPolicy.h"
+#include "InstalledSoftwareCheck.h"
+#include "LogonAnomalies.h"
+#include "LogonAnomalyCheck.h"
+#include "NetworkSharesCheck.h"
+#include "OfflineRegistry.h"
+#include "PasswordPolicyCheck.h"
+#include "Persistence.h"
+#include "PersistenceCheck.h"
+#include "RegistryHive.h"
+#include "RulePack.h"
+#include "RulePackCheck.h"
+#include "ScheduledTaskCheck.h"
+#include "ScheduledTasks.h"
+#include "SecurityDescriptor.h"
+#include "SecurityBaseline.h"
+#include "SecurityBaselineCheck.h"
+#include "FrameworkMap.h"
+#include "WhatIfSimulator.h"
+#include "ScanPlanner.h"
+#include "ScanArena.h"
+#include "PolicyTables.h"
+#include "SecurityPolicy.h"
+#include "SoftwareInventory.h"
+#include "SystemLoggingCheck.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+#include "UpdateCatalog.h"
+#include "UserAccountCheck.h"
+#include "VulnerabilityDatabase.h"
+#include "WindowsUpdateCheck.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Allocation accounting for the whole process
+namespace {
+std::atomic<unsigned long long> allocationCount{ 0 };
+std::atomic<unsigned long long> allocationBytes{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// std::pmr::new_delete_resource allocates through the aligned forms
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    size_t rounded = (size + align - 1) / align * align;
+#ifdef _WIN32
+    void* p = _aligned_malloc(rounded ? rounded : align, align);
+#else
+    void* p = std::aligned_alloc(align, rounded ? rounded : align);
+#endif
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+#ifdef _WIN32
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+#else
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+namespace {
+
+struct BenchmarkCase {
+    std::string name;
+    size_t inputBytes;
+    size_t items;
+    std::function<int()> run;   // result is folded into a sink so work is not elided
+};
+
+volatile int benchmarkSink = 0;
+
+void runBenchmark(const BenchmarkCase& bench, double minSeconds) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up
+    benchmarkSink += bench.run();
+
+    unsigned long long allocsBefore = allocationCount.load();
+    unsigned long long bytesBefore = allocationBytes.load();
+
+    size_t iterations = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        benchmarkSink += bench.run();
+        iterations++;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+
+    double perOpUs = elapsed * 1e6 / iterations;
+    double allocsPerOp = static_cast<double>(allocationCount.load() - allocsBefore) / iterations;
+    double kbPerOp = static_cast<double>(allocationBytes.load() - bytesBefore) / iterations / 1024.0;
+    double mbPerSec = bench.inputBytes > 0 ? (bench.inputBytes / 1e6) / (perOpUs / 1e6) : 0.0;
+    double itemsPerSec = bench.items > 0 ? bench.items / (perOpUs / 1e6) : 0.0;
+
+    std::printf("%-28s %9zu %11.1f %10.2f %14.0f %11.1f %12.1f\n",
+                bench.name.c_str(), bench.items, perOpUs, mbPerSec, itemsPerSec, allocsPerOp, kbPerOp);
+}
+
+// The what-if simulator's incremental scores against scanning the changed
+// facts from scratch, over random queries that set or remove a few
+// settings; every hundredth query is applied for good. Returns the number
+// of queries whose scores or count of changed controls and rules differ.
+size_t verifyWhatIf(const SecurityBaseline& baseline, const RulePack& rules, const FactTable& facts, size_t queries) {
+    struct NameLess {
+        bool operator()(const std::string& a, const std::string& b) const { return TextUtil::lessIgnoreCase(a, b); }
+    };
+    using FactMap = std::map<std::string, std::string, NameLess>;
+    auto build = [](const FactMap& values) {
+        FactTable table;
+        for (const auto& fact : values) table.set(fact.first, fact.second);
+        return table;
+    };
+    auto evaluate = [&](const FactTable& table) {
+        return std::vector<ComplianceResult>{ SecurityBaselineCheck::evaluate(baseline, table),
+                                              RulePackCheck::evaluate(rules, table) };
+    };
+
+    // The host's facts as a map, since a FactTable cannot drop one
+    FactMap current;
+    for (uint32_t id = 0; id < facts.size(); ++id) current[std::string(facts.name(id))] = facts.value(id);
+    FactTable currentTable = build(current);
+    std::vector<BaselineOutcome> baselineOutcomes;
+    std::vector<RuleOutcome> ruleOutcomes;
+    baseline.evaluate(facts, baselineOutcomes);
+    rules.evaluate(facts, ruleOutcomes);
+    WhatIfSimulator simulator(evaluate(currentTable));
+    simulator.setBaseline(0, baseline, facts, baselineOutcomes);
+    simulator.setRules(1, rules, facts, ruleOutcomes);
+
+    std::vector<std::string> settings = { "HKEY_LOCAL_MACHINE\\SOFTWARE\\WhatIfCheck\\Unread" };
+    for (const auto& control : baseline.controls()) settings.push_back(control.factName);
+    settings.insert(settings.end(), rules.factNames().begin(), rules.factNames().end());
+    const char* values[] = { "0", "1", "2", "4", "14", "365", "", "Enabled" };
+
+    std::mt19937 rng(20240501);
+    size_t mismatches = 0;
+    for (size_t query = 0; query < queries; ++query) {
+        std::vector<WhatIfChange> changes(1 + rng() % 3);
+        bool removes = false;
+        for (auto& change : changes) {
+            change.setting = settings[rng() % settings.size()];
+            change.remove = rng() % 5 == 0;
+            if (!change.remove) change.value = values[rng() % (sizeof(values) / sizeof(values[0]))];
+            removes = removes || change.remove;
+        }
+
+        // Values are written over a copy; a removal rebuilds the table
+        bool keep = query % 100 == 99;
+        FactMap trial;
+        FactTable trialTable;
+        if (keep || removes) {
+            trial = current;
+            for (const auto& change : changes) {
+                if (change.remove) trial.erase(change.setting);
+                else trial[change.setting] = change.value;
+            }
+            trialTable = build(trial);
+        } else {
+            trialTable = currentTable;
+            for (const auto& change : changes) trialTable.set(change.setting, change.value);
+        }
+
+        WhatIfOutcome outcome = keep ? simulator.apply(changes) : simulator.simulate(changes);
+        std::vector<ComplianceResult> expected = evaluate(trialTable);
+        std::vector<BaselineOutcome> trialControls;
+        std::vector<RuleOutcome> trialRules;
+        baseline.evaluate(trialTable, trialControls);
+        rules.evaluate(trialTable, trialRules);
+        uint32_t changed = 0;
+        for (size_t i = 0; i < trialControls.size(); ++i) {
+            if (trialControls[i].passed != baselineOutcomes[i].passed) changed++;
+        }
+        for (size_t i = 0; i < trialRules.size(); ++i) {
+            const RuleOutcome& next = trialRules[i];
+            const RuleOutcome& scanned = ruleOutcomes[i];
+            if (next.score != scanned.score || next.status != scanned.status || next.severity != scanned.severity) changed++;
+        }
+
+        bool matches = outcome.overallScore == WhatIfSimulator(expected).overallScore() &&
+                       outcome.controlsChanged == changed && outcome.modules.size() == expected.size();
+        for (size_t i = 0; matches && i < outcome.modules.size(); ++i) {
+            const SimulatedModule& module = outcome.modules[i];
+            const ComplianceResult& result = expected[module.result];
+            matches = module.score == result.score && module.status == result.status && module.severity == result.severity;
+        }
+        if (!matches) mismatches++;
+        if (keep) {
+            current = std::move(trial);
+            currentTable = std::move(trialTable);
+            baselineOutcomes = std::move(trialControls);
+            ruleOutcomes = std::move(trialRules);
+        }
+    }
+    return mismatches;
+}
+
+// The overall score over random scans against the weighted average of the
+// modules that apply, from calculateOverallScore's formula and from the
+// what-if simulator; a Not Applicable module added to a scan must leave
+// its score as it was. Returns the number of scans that differ.
+size_t verifyOverallScore(size_t scans) {
+    const CheckStatus statuses[] = { CheckStatus::Pass, CheckStatus::Warning, CheckStatus::Fail, CheckStatus::NotApplicable };
+    const Severity severities[] = { Severity::Low, Severity::Medium, Severity::High, Severity::Critical };
+
+    std::mt19937 rng(20240601);
+    size_t mismatches = 0;
+    for (size_t scan = 0; scan < scans; ++scan) {
+        std::vector<ComplianceResult> results;
+        int64_t weighted = 0;
+        int64_t weight = 0;
+        for (size_t i = 0, count = rng() % 17; i < count; ++i) {
+            CheckStatus status = statuses[rng() % 4];
+            Severity severity = severities[rng() % 4];
+            int score = static_cast<int>(rng() % 101);
+            results.emplace_back("Module", "", status, severity, score);
+            if (status != CheckStatus::NotApplicable) {
+                weighted += static_cast<int64_t>(score) * PolicyTables::weight<ModuleWeights>(severity);
+                weight += PolicyTables::weight<ModuleWeights>(severity);
+            }
+        }
+        int expected = weight > 0 ? static_cast<int>(weighted / weight) : 0;
+
+        bool matches = PolicyTables::overallScore<ModuleWeights>(results) == expected &&
+                       WhatIfSimulator(results).overallScore() == expected;
+        results.emplace_back("Skipped", "", CheckStatus::NotApplicable, severities[rng() % 4], 0);
+        matches = matches && PolicyTables::overallScore<ModuleWeights>(results) == expected &&
+                  WhatIfSimulator(results).overallScore() == expected;
+        if (!matches) mismatches++;
+    }
+    return mismatches;
+}
+
+// Cumulative updates installed as RollupFix servicing packages carry no
+// KB; a host counts as having the newest one of its build once its
+// revision reaches that update's, and only then. Returns the number of
+// hosts evaluated wrongly.
+size_t verifyRollupRevisions(const UpdateCatalog& catalog) {
+    const std::string package = "Package_for_RollupFix~31bf3856ad364e35~amd64~~";
+
+    size_t mismatches = 0;
+    for (uint32_t build : { 19045u, 22621u, 22631u, 26100u }) {
+        InstalledUpdates bare;
+        bare.setBuild(build);
+        const UpdateEntry* cumulative = nullptr;
+        for (const UpdateEntry* entry : catalog.evaluate(bare).missing) {
+            if (entry->revision != 0) cumulative = entry;
+        }
+        if (cumulative == nullptr) {
+            mismatches++;
+            continue;
+        }
+
+        for (int offset : { -1, 0, 1 }) {
+            InstalledUpdates host;
+            host.setBuild(build);
+            host.add(package + std::to_string(build) + ".1.1.1");   // an older rollup still staged
+            host.add(package + std::to_string(build) + "." + std::to_string(cumulative->revision + offset) + ".1.7");
+            PatchGap gap = catalog.evaluate(host);
+            bool missing = std::find(gap.missing.begin(), gap.missing.end(), cumulative) != gap.missing.end();
+            if (missing != (offset < 0)) mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t scale = 1;
+    double minSeconds = 0.25;
+    std::string filter;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = static_cast<size_t>(std::atoi(argv[++i]));
+            if (scale == 0) scale = 1;
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            std::printf("Usage: %s [--scale N] [--min-time SECONDS] [--filter TEXT]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SyntheticProbeData generator;
+
+    // Probe outputs as the checks receive them (Export-Csv files are UTF-16LE)
+    const std::string uninstall = SyntheticProbeData::toUtf16LE(generator.uninstallCsv(10000 * scale));
+    const std::string shares = SyntheticProbeData::toUtf16LE(generator.smbShareCsv(5000 * scale));
+    const std::vector<std::string> binaryDescriptors = generator.binarySecurityDescriptors(5000 * scale);
+    const std::string users = SyntheticProbeData::toUtf16LE(generator.localUserCsv(2000 * scale));
+    const std::string members = SyntheticProbeData::toUtf16LE(generator.groupMemberCsv(20000 * scale, 2000 * scale));
+    const std::string volumes = generator.bitLockerVolumes(64 * scale);
+    const std::string firewall = generator.firewallProfiles();
+    const std::string auditpol = generator.auditPolicy();
+    const std::string inf = SyntheticProbeData::toUtf16LE(generator.seceditInf(200 * scale));
+    const std::string netAccounts = generator.netAccounts();
+    const std::string systemHive = generator.systemHive(2000 * scale);
+    const std::string samHive = generator.samHive(2000 * scale);
+    const std::string softwareHive = generator.softwareHive(2000 * scale);
+    const std::string registryPol = generator.registryPol(5000 * scale);
+    const std::string securityLog = generator.securityEvtx(200000 * scale);
+    const std::string vulnerabilityCsv = generator.vulnerabilityCsv(100000 * scale);
+    const std::string catalogCsv = generator.updateCatalogCsv(20000 * scale);
+    const std::string hotfixes = SyntheticProbeData::toUtf16LE(generator.hotfixCsv(20000 * scale));
+    const std::string firewallRules = SyntheticProbeData::toUtf16LE(generator.firewallRulesCsv(30000 * scale));
+    const auto taskFiles = generator.scheduledTasks(500 * scale);
+    const auto programFiles = generator.programFiles(1000 * scale);
+    const std::string baselineCsv = generator.securityBaselineCsv(500 * scale);
+    const std::string ruleSource = generator.policyRules(2000 * scale);
+
+    // Pre-parsed tables for the evaluate-only cases
+    CsvReader uninstallTable, shareTable, userTable, memberTable;
+    uninstallTable.parseOwned(TextEncoding::toUtf8(uninstall));
+    shareTable.parseOwned(TextEncoding::toUtf8(shares));
+    userTable.parseOwned(TextEncoding::toUtf8(users));
+    memberTable.parseOwned(TextEncoding::toUtf8(members));
+
+    AccountDirectory accounts;
+    accounts.loadFromCsv(userTable, memberTable);
+    RegistryHive sam;
+    sam.openMemory(samHive.data(), samHive.size());
+
+    RegistryHive systemRegf, softwareRegf;
+    systemRegf.openMemory(systemHive.data(), systemHive.size());
+    softwareRegf.openMemory(softwareHive.data(), softwareHive.size());
+    PersistenceInventory persistence;
+    persistence.loadFromHives(&systemRegf, &softwareRegf);
+
+    AccountPolicy accountPolicy;
+    SecurityPolicy parsedInf;
+    parsedInf.parse(TextEncoding::toUtf8(inf));
+    parsedInf.getAccountPolicy(accountPolicy);
+
+    OfflineRegistry offlineRegistry;
+    offlineRegistry.loadHiveMemory("SYSTEM", systemHive.data(), systemHive.size());
+
+    std::vector<std::string> serviceKeys;
+    offlineRegistry.enumerateSubkeys("HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services", serviceKeys);
+    for (auto& name : serviceKeys) {
+        name = "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\" + name;
+    }
+
+    EvtxParser evtxParser;
+    EventRecordSet securityEvents;
+    evtxParser.parseMemory(securityLog.data(), securityLog.size(), securityEvents);
+
+    EvtxParser evidenceParser;
+    evidenceParser.setEventFilter(SystemLoggingCheck::evidenceEventIds());
+    evidenceParser.setDecodeFields(false);
+    EventRecordSet evidenceEvents;
+    evidenceParser.parseMemory(securityLog.data(), securityLog.size(), evidenceEvents);
+
+    // Logon events decoded once, to time the detector on its own
+    LogonAnomalyDetector logonDetector;
+    std::vector<LogonEvent> logonEvents;
+    for (const auto& record : securityEvents.records()) {
+        LogonEvent event;
+        if (logonDetector.decode(securityEvents, record, event)) logonEvents.push_back(event);
+    }
+    logonDetector.process(logonEvents.data(), logonEvents.size());
+
+    GroupPolicy groupPolicy;
+    groupPolicy.loadMemory(registryPol, PolicyScope::Machine);
+
+    // Benchmark definition and the host facts it reads
+    CsvReader baselineTable;
+    baselineTable.parse(baselineCsv);
+    SecurityBaseline securityBaseline;
+    securityBaseline.loadFromCsv(baselineTable);
+    const std::vector<std::string> baselineKeys = securityBaseline.registryKeys();
+    FactTable hostFacts;
+    hostFacts.addGroupPolicy(groupPolicy);
+    hostFacts.addSecurityPolicy(parsedInf);
+    std::vector<BaselineOutcome> baselineOutcomes;
+
+    // Rule pack over the same host facts
+    RulePack rulePack;
+    if (!rulePack.compile(ruleSource)) std::fprintf(stderr, "rule pack: %s\n", rulePack.error().c_str());
+    std::vector<RuleFact> ruleFactIds;
+    rulePack.resolve(hostFacts, ruleFactIds);
+    std::vector<RuleOutcome> ruleOutcomes;
+    securityBaseline.evaluate(hostFacts, baselineOutcomes);
+    rulePack.evaluate(hostFacts, ruleOutcomes);
+
+    // Eight frameworks, each mapping every control and rule to one of its
+    // requirements (four controls per requirement)
+    FrameworkMap frameworkMap;
+    for (int framework = 0; framework < 8; ++framework) {
+        std::string name = "Framework " + std::to_string(framework);
+        for (size_t i = 0; i < securityBaseline.size(); ++i) {
+            frameworkMap.add(name, "B-" + std::to_string(i / 4), "", ControlSource::Baseline, securityBaseline.controls()[i].id);
+        }
+        for (size_t i = 0; i < rulePack.size(); ++i) {
+            frameworkMap.add(name, "R-" + std::to_string(i / 4), "", ControlSource::Rule, rulePack.rules()[i].id);
+        }
+    }
+    frameworkMap.bind(&securityBaseline, &rulePack);
+    FrameworkInputs frameworkInputs;
+    frameworkInputs.baseline = &baselineOutcomes;
+    frameworkInputs.rules = &ruleOutcomes;
+    std::vector<FrameworkScore> frameworkScores;
+    std::vector<RequirementOutcome> requirementOutcomes;
+
+    // What-if queries against the baseline and rule results: one benchmark
+    // setting and two rule facts changed per query
+    std::vector<ComplianceResult> simulatedResults = {
+        SecurityBaselineCheck::evaluate(securityBaseline, hostFacts),
+        RulePackCheck::evaluate(rulePack, hostFacts)
+    };
+    WhatIfSimulator simulator(simulatedResults);
+    simulator.setBaseline(0, securityBaseline, hostFacts, baselineOutcomes);
+    simulator.setRules(1, rulePack, hostFacts, ruleOutcomes);
+    // Quick-scan choice over the built-in modules with a 2 s budget
+    ScanPlanner scanPlanner;
+    std::vector<std::string> plannedModules;
+    for (const auto& prior : QuickScanPriors) plannedModules.push_back(prior.module);
+
+    std::vector<WhatIfChange> whatIfChanges = {
+        { securityBaseline.controls()[securityBaseline.size() / 2].factName, "1", false },
+        { rulePack.factNames()[rulePack.factNames().size() / 3], "0", false },
+        { rulePack.factNames()[rulePack.factNames().size() / 2], "", true }
+    };
+
+    // Task definitions written out as a Tasks directory fixture
+    const std::filesystem::path tasksDirectory = std::filesystem::temp_directory_path() / "wct_bench_tasks";
+    size_t taskBytes = 0;
+    for (const auto& file : taskFiles) {
+        std::string relative = file.first;
+        std::replace(relative.begin(), relative.end(), '\\', '/');
+        std::filesystem::path path = tasksDirectory / relative;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary).write(file.second.data(), static_cast<std::streamsize>(file.second.size()));
+        taskBytes += file.second.size();
+    }
+    ScheduledTaskSet scheduledTasks;
+    scheduledTasks.loadDirectory(tasksDirectory.string());
+
+    // Program directory fixture for the integrity scan, its baseline and a
+    // later scan with a few binaries replaced
+    const std::filesystem::path programDirectory = std::filesystem::temp_directory_path() / "wct_bench_programs";
+    size_t programBytes = 0;
+    for (const auto& file : programFiles) {
+        std::string relative = file.first;
+        std::replace(relative.begin(), relative.end(), '\\', '/');
+        std::filesystem::path path = programDirectory / relative;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary).write(file.second.data(), static_cast<std::streamsize>(file.second.size()));
+        programBytes += file.second.size();
+    }
+    FileIntegrityScanner integrityScanner;
+    integrityScanner.addRoot(programDirectory.string());
+    FileDigestSet integrityBaseline, integrityCurrent;
+    integrityScanner.scan(integrityBaseline);
+    integrityScanner.scan(integrityCurrent);
+    const std::string hashInput(4 * 1024 * 1024, '\x5A');
+
+    SoftwareInventory softwareInventory;
+    softwareInventory.loadFromCsv(uninstallTable);
+
+    CsvReader vulnerabilityTable;
+    vulnerabilityTable.parseOwned(std::string(vulnerabilityCsv));
+    VulnerabilityDatabase vulnerabilities;
+    vulnerabilities.loadFromCsv(vulnerabilityTable);
+
+    CsvReader catalogTable, hotfixTable;
+    catalogTable.parseOwned(std::string(catalogCsv));
+    hotfixTable.parseOwned(TextEncoding::toUtf8(hotfixes));
+    UpdateCatalog updateCatalog;
+    updateCatalog.loadFromCsv(catalogTable);
+    InstalledUpdates installedUpdates;
+    installedUpdates.loadFromCsv(hotfixTable);
+    installedUpdates.setBuild(22631);
+    PatchGap patchGap = updateCatalog.evaluate(installedUpdates);
+
+    CsvReader firewallTable;
+    firewallTable.parseOwned(TextEncoding::toUtf8(firewallRules));
+    FirewallRuleSet firewallRuleSet;
+    firewallRuleSet.loadFromCsv(firewallTable);
+
+    // One host snapshot end to end: probe tables loaded from their raw
+    // bytes and the offline modules evaluated, as a scan would run them
+    auto scanSnapshot = [&] {
+        CsvReader shareList, userList;
+        shareList.loadFromMemory(shares);
+        userList.loadFromMemory(users);
+        std::vector<ComplianceResult> results;
+        results.reserve(10);
+        results.push_back(NetworkSharesCheck::evaluate(shareList));
+        results.push_back(UserAccountCheck::evaluate(accounts, 0));
+        results.push_back(InstalledSoftwareCheck::evaluate(softwareInventory, &vulnerabilities));
+        results.push_back(PersistenceCheck::evaluate(persistence));
+        results.push_back(ScheduledTaskCheck::evaluate(scheduledTasks));
+        results.push_back(FirewallCheck::evaluate(firewall));
+        results.push_back(BitLockerCheck::evaluate(volumes));
+        results.push_back(PasswordPolicyCheck::evaluate(accountPolicy, "secedit"));
+        results.push_back(SystemLoggingCheck::evaluate("Running", auditpol, "20480"));
+        results.push_back(WindowsUpdateCheck::evaluate("4", "Running", "3"));
+        int total = static_cast<int>(userList.rowCount());
+        for (const auto& result : results) total += result.score;
+        return total;
+    };
+    ScanArena scanArena;
+
+    std::vector<BenchmarkCase> cases = {
+        { "software.parse", uninstall.size(), uninstallTable.rowCount(), [&] {
+            CsvReader table;
+            table.parseOwned(TextEncoding::toUtf8(uninstall));
+            return static_cast<int>(table.rowCount());
+        } },
+        { "software.inventory", 0, uninstallTable.rowCount(), [&] {
+            SoftwareInventory inventory;
+            inventory.loadFromCsv(uninstallTable);
+            return static_cast<int>(inventory.size());
+        } },
+        { "software.evaluate", 0, softwareInventory.size(), [&] {
+            return InstalledSoftwareCheck::evaluate(softwareInventory, &vulnerabilities).score;
+        } },
+        { "vulndb.build", vulnerabilityCsv.size(), vulnerabilityTable.rowCount(), [&] {
+            VulnerabilityDatabase database;
+            database.loadFromCsv(vulnerabilityTable);
+            return static_cast<int>(database.size());
+        } },
+        { "vulndb.lookup", 0, softwareInventory.size(), [&] {
+            int matches = 0;
+            for (const auto& software : softwareInventory.records()) {
+                vulnerabilities.forEachMatch(software.productKey, software.version, [&](const VulnerabilityEntry&) { matches++; });
+            }
+            return matches;
+        } },
+        { "shares.parse", shares.size(), shareTable.rowCount(), [&] {
+            CsvReader shareList;
+            shareList.parseOwned(TextEncoding::toUtf8(shares));
+            return static_cast<int>(shareList.rowCount());
+        } },
+        { "shares.evaluate", 0, shareTable.rowCount(), [&] {
+            return NetworkSharesCheck::evaluate(shareTable).score;
+        } },
+        { "acl.parse-sddl", 0, shareTable.rowCount() * 2, [&] {
+            SecurityDescriptorCache descriptors;
+            int shareColumn = shareTable.columnIndex("SecurityDescriptor");
+            int pathColumn = shareTable.columnIndex("PathSddl");
+            int invalid = 0;
+            for (size_t i = 0; i < shareTable.rowCount(); ++i) {
+                CsvReader::Row row = shareTable.row(i);
+                invalid += descriptors.addSddl(row[shareColumn]) == SecurityDescriptorCache::InvalidDescriptor;
+                invalid += descriptors.addSddl(row[pathColumn]) == SecurityDescriptorCache::InvalidDescriptor;
+            }
+            return invalid + static_cast<int>(descriptors.size());
+        } },
+        { "acl.parse-binary", 0, binaryDescriptors.size(), [&] {
+            SecurityDescriptorCache descriptors;
+            for (const auto& descriptor : binaryDescriptors) {
+                descriptors.addBinary(descriptor.data(), descriptor.size());
+            }
+            return static_cast<int>(descriptors.size());
+        } },
+        { "users.parse", users.size(), userTable.rowCount(), [&] {
+            CsvReader table;
+            table.parseOwned(TextEncoding::toUtf8(users));
+            return static_cast<int>(table.rowCount());
+        } },
+        { "users.build-closure", members.size(), accounts.size(), [&] {
+            AccountDirectory directory;
+            directory.loadFromCsv(userTable, memberTable);
+            return static_cast<int>(directory.membershipCount());
+        } },
+        { "users.load-sam", samHive.size(), userTable.rowCount(), [&] {
+            AccountDirectory directory;
+            directory.loadFromSam(sam);
+            return static_cast<int>(directory.size());
+        } },
+        { "users.evaluate", 0, accounts.size(), [&] {
+            return UserAccountCheck::evaluate(accounts, 0).score;
+        } },
+        { "persistence.load-hives", systemHive.size() + softwareHive.size(),
+          persistence.services().size() + persistence.autoruns().size(), [&] {
+            PersistenceInventory inventory;
+            inventory.loadFromHives(&systemRegf, &softwareRegf);
+            return static_cast<int>(inventory.services().size());
+        } },
+        { "persistence.analyze", 0, persistence.services().size() + persistence.autoruns().size(), [&] {
+            return static_cast<int>(persistence.analyze().size());
+        } },
+        { "persistence.evaluate", 0, persistence.services().size() + persistence.autoruns().size(), [&] {
+            return PersistenceCheck::evaluate(persistence).score;
+        } },
+        { "tasks.parse", taskBytes, taskFiles.size(), [&] {
+            ScheduledTaskSet tasks;
+            for (const auto& file : taskFiles) tasks.add(file.first, file.second);
+            return static_cast<int>(tasks.size());
+        } },
+        { "tasks.load-directory", taskBytes, taskFiles.size(), [&] {
+            ScheduledTaskSet tasks;
+            tasks.loadDirectory(tasksDirectory.string());
+            return static_cast<int>(tasks.size());
+        } },
+        { "tasks.evaluate", 0, scheduledTasks.size(), [&] {
+            return ScheduledTaskCheck::evaluate(scheduledTasks).score;
+        } },
+        { "integrity.sha256", hashInput.size(), 1, [&] {
+            return static_cast<int>(Sha256::hash(hashInput.data(), hashInput.size())[0]);
+        } },
+        { "integrity.scan-cold", programBytes, integrityBaseline.size(), [&] {
+            FileDigestSet digests;
+            integrityScanner.scan(digests);
+            return static_cast<int>(digests.size());
+        } },
+        { "integrity.scan-cached", 0, integrityBaseline.size(), [&] {
+            FileDigestSet digests;
+            integrityScanner.scan(digests, &integrityBaseline);
+            return static_cast<int>(digests.size());
+        } },
+        { "integrity.compare", 0, integrityBaseline.size(), [&] {
+            return static_cast<int>(integrityBaseline.compare(integrityCurrent).size());
+        } },
+        { "integrity.evaluate", 0, integrityBaseline.size(), [&] {
+            return FileIntegrityCheck::evaluate(integrityBaseline, integrityCurrent).score;
+        } },
+        { "bitlocker.evaluate", volumes.size(), 64 * scale, [&] {
+            return BitLockerCheck::evaluate(volumes).score;
+        } },
+        { "firewall.evaluate", firewall.size(), 3, [&] {
+            return FirewallCheck::evaluate(firewall).score;
+        } },
+        { "firewall.parse-rules", firewallRules.size(), firewallRuleSet.size(), [&] {
+            CsvReader table;
+            table.parseOwned(TextEncoding::toUtf8(firewallRules));
+            FirewallRuleSet rules;
+            rules.loadFromCsv(table);
+            return static_cast<int>(rules.size());
+        } },
+        { "firewall.analyze-rules", 0, firewallRuleSet.size(), [&] {
+            return static_cast<int>(firewallRuleSet.analyze().size());
+        } },
+        { "firewall.evaluate-rules", 0, firewallRuleSet.size(), [&] {
+            return FirewallRulesCheck::evaluate(firewallRuleSet).score;
+        } },
+        { "logging.evaluate", auditpol.size(), 1, [&] {
+            return SystemLoggingCheck::evaluate("Running", auditpol, "20480").score;
+        } },
+        { "update.evaluate", 0, 1, [&] {
+            return WindowsUpdateCheck::evaluate("4", "Running", "3").score;
+        } },
+        { "update.catalog-build", catalogCsv.size(), catalogTable.rowCount(), [&] {
+            UpdateCatalog catalog;
+            catalog.loadFromCsv(catalogTable);
+            return static_cast<int>(catalog.size());
+        } },
+        { "update.hotfix-load", hotfixes.size(), hotfixTable.rowCount(), [&] {
+            CsvReader table;
+            table.parseOwned(TextEncoding::toUtf8(hotfixes));
+            InstalledUpdates installed;
+            installed.loadFromCsv(table);
+            return static_cast<int>(installed.size());
+        } },
+        { "update.patch-gap", 0, patchGap.applicable, [&] {
+            return static_cast<int>(updateCatalog.evaluate(installedUpdates).missing.size());
+        } },
+        { "update.evaluate-catalog", 0, patchGap.applicable, [&] {
+            PatchGap gap = updateCatalog.evaluate(installedUpdates);
+            return WindowsUpdateCheck::evaluate("4", "Running", std::string(), &gap).score;
+        } },
+        { "password.parse-inf", inf.size(), parsedInf.size(), [&] {
+            SecurityPolicy policy;
+            policy.parse(TextEncoding::toUtf8(inf));
+            return static_cast<int>(policy.size());
+        } },
+        { "password.parse-net", netAccounts.size(), 1, [&] {
+            AccountPolicy policy;
+            NetAccountsParser::parse(netAccounts, policy);
+            return policy.minPasswordLength;
+        } },
+        { "password.evaluate", 0, 1, [&] {
+            return PasswordPolicyCheck::evaluate(accountPolicy, "secedit").score;
+        } },
+        { "registry.open-hive", systemHive.size(), 1, [&] {
+            OfflineRegistry registry;
+            return static_cast<int>(registry.loadHiveMemory("SYSTEM", systemHive.data(), systemHive.size()));
+        } },
+        { "registry.enumerate", 0, serviceKeys.size(), [&] {
+            std::vector<std::string> names;
+            offlineRegistry.enumerateSubkeys("HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services", names);
+            return static_cast<int>(names.size());
+        } },
+        { "registry.read-values", 0, serviceKeys.size(), [&] {
+            int found = 0;
+            for (const auto& key : serviceKeys) {
+                found += !offlineRegistry.readValue(key, "ImagePath").empty();
+            }
+            return found;
+        } },
+        { "evtx.parse", securityLog.size(), securityEvents.size(), [&] {
+            EventRecordSet events;
+            evtxParser.parseMemory(securityLog.data(), securityLog.size(), events);
+            return static_cast<int>(events.size());
+        } },
+        { "evtx.parse-1thread", securityLog.size(), securityEvents.size(), [&] {
+            EvtxParser parser;
+            parser.setThreadCount(1);
+            EventRecordSet events;
+            parser.parseMemory(securityLog.data(), securityLog.size(), events);
+            return static_cast<int>(events.size());
+        } },
+        { "evtx.parse-evidence", securityLog.size(), evidenceEvents.size(), [&] {
+            EventRecordSet events;
+            evidenceParser.parseMemory(securityLog.data(), securityLog.size(), events);
+            return static_cast<int>(events.size());
+        } },
+        { "logging.evaluate-events", 0, evidenceEvents.size(), [&] {
+            return SystemLoggingCheck::evaluate("Running", auditpol, "20480", &evidenceEvents).score;
+        } },
+        { "logons.replay", 0, securityEvents.size(), [&] {
+            LogonAnomalyDetector detector;
+            detector.replay(securityEvents);
+            return static_cast<int>(detector.processedCount());
+        } },
+        { "logons.process", 0, logonEvents.size(), [&] {
+            LogonAnomalyDetector detector;
+            detector.process(logonEvents.data(), logonEvents.size());
+            return static_cast<int>(detector.anomalies().size());
+        } },
+        { "logons.evaluate", 0, 1, [&] {
+            return LogonAnomalyCheck::evaluate(&logonDetector).score;
+        } },
+        { "policy.parse-pol", registryPol.size(), groupPolicy.size(), [&] {
+            std::vector<PolicyRecord> records;
+            RegistryPolFile::parse(registryPol, records);
+            return static_cast<int>(records.size());
+        } },
+        { "policy.merge", registryPol.size(), groupPolicy.size(), [&] {
+            GroupPolicy policy;
+            policy.loadMemory(registryPol, PolicyScope::Machine);
+            return static_cast<int>(policy.size());
+        } },
+        { "policy.compare", 0, groupPolicy.size(), [&] {
+            return static_cast<int>(groupPolicy.compare(offlineRegistry).size());
+        } },
+        { "baseline.load", baselineCsv.size(), securityBaseline.size(), [&] {
+            CsvReader table;
+            table.parse(baselineCsv);
+            SecurityBaseline definition;
+            definition.loadFromCsv(table);
+            return static_cast<int>(definition.size());
+        } },
+        { "baseline.collect", 0, hostFacts.size(), [&] {
+            FactTable facts;
+            std::vector<std::pair<std::string, std::string>> values;
+            for (const auto& key : baselineKeys) {
+                values.clear();
+                if (offlineRegistry.readValues(key, values)) facts.addRegistryValues(key, values);
+            }
+            facts.addGroupPolicy(groupPolicy);
+            facts.addSecurityPolicy(parsedInf);
+            return static_cast<int>(facts.size());
+        } },
+        { "baseline.evaluate", 0, securityBaseline.size(), [&] {
+            securityBaseline.evaluate(hostFacts, baselineOutcomes);
+            return static_cast<int>(baselineOutcomes.size());
+        } },
+        { "baseline.check", 0, securityBaseline.size(), [&] {
+            return SecurityBaselineCheck::evaluate(securityBaseline, hostFacts).score;
+        } },
+        { "rules.compile", ruleSource.size(), rulePack.size(), [&] {
+            RulePack pack;
+            pack.compile(ruleSource);
+            return static_cast<int>(pack.size());
+        } },
+        { "rules.evaluate", 0, rulePack.size(), [&] {
+            rulePack.evaluate(hostFacts, ruleOutcomes);
+            return static_cast<int>(ruleOutcomes.size());
+        } },
+        { "rules.run", 0, rulePack.size(), [&] {
+            // Facts already resolved: interpreter only
+            int total = 0;
+            for (uint32_t i = 0; i < rulePack.size(); ++i) total += rulePack.evaluate(i, hostFacts, ruleFactIds).score;
+            return total;
+        } },
+        { "rules.check", 0, rulePack.size(), [&] {
+            return RulePackCheck::evaluate(rulePack, hostFacts).score;
+        } },
+        { "quickscan.plan", 0, plannedModules.size(), [&] {
+            return static_cast<int>(scanPlanner.plan(plannedModules, 2000).selected.size());
+        } },
+        { "whatif.simulate", 0, whatIfChanges.size(), [&] {
+            return simulator.simulate(whatIfChanges).overallScore;
+        } },
+        { "scan.heap", shares.size() + users.size(), 10, [&] {
+            return scanSnapshot();
+        } },
+        { "scan.arena", shares.size() + users.size(), 10, [&] {
+            // Same snapshot with its tables and results in a per-scan arena
+            int total = 0;
+            {
+                ScanArena::Scope scope(scanArena);
+                total = scanSnapshot();
+            }
+            scanArena.release();
+            return total;
+        } },
+        { "frameworks.evaluate", 0, frameworkMap.mappingCount(), [&] {
+            // Outcomes already computed: one pass scores all eight frameworks
+            frameworkMap.evaluate(frameworkInputs, frameworkScores, requirementOutcomes);
+            return frameworkScores.front().score;
+        } },
+    };
+
+    // Incremental what-if scores must match a full re-evaluation
+    size_t whatIfMismatches = 0;
+    if (filter.empty() || std::string("whatif.verify").find(filter) != std::string::npos) {
+        const size_t queries = 3000;
+        whatIfMismatches = verifyWhatIf(securityBaseline, rulePack, hostFacts, queries);
+        std::printf("whatif.verify: %zu of %zu random queries differ from a full re-evaluation\n\n", whatIfMismatches, queries);
+    }
+
+    // Modules that do not apply must not count toward the overall score
+    size_t scoreMismatches = 0;
+    if (filter.empty() || std::string("score.verify").find(filter) != std::string::npos) {
+        const size_t scans = 10000;
+        scoreMismatches = verifyOverallScore(scans);
+        std::printf("score.verify: %zu of %zu random scans differ from the applicable modules' average\n\n", scoreMismatches, scans);
+    }
+
+    // Cumulative updates found by build revision rather than KB
+    size_t rollupMismatches = 0;
+    if (filter.empty() || std::string("update.verify").find(filter) != std::string::npos) {
+        rollupMismatches = verifyRollupRevisions(updateCatalog);
+        std::printf("update.verify: %zu of 12 RollupFix hosts evaluated wrongly\n\n", rollupMismatches);
+    }
+
+    std::printf("%-28s %9s %11s %10s %14s %11s %12s\n",
+                "benchmark", "items", "us/op", "MB/s", "items/s", "allocs/op", "KB alloc/op");
+
+    for (const auto& bench : cases) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        runBenchmark(bench, minSeconds);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(tasksDirectory, ec);
+    std::filesystem::remove_all(programDirectory, ec);
+    return whatIfMismatches > 0 || scoreMismatches > 0 || rollupMismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,1377 @@
+#include "SyntheticProbeData.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+namespace {
+
+const char* const Vendors[] = {
+    "Microsoft Corporation", "Adobe Inc.", "Google LLC", "Mozilla", "Oracle Corporation",
+    "Igor Pavlov", "Notepad++ Team", "VideoLAN", "Python Software Foundation", "Contoso, Ltd."
+};
+
+const char* const Products[] = {
+    "Visual C++ 2015-2022 Redistributable (x64)", "Acrobat Reader DC", "Chrome", "Firefox (x64 en-US)",
+    "Java 8 Update 381", "7-Zip 23.01 (x64)", "Notepad++ (64-bit x64)", "VLC media player",
+    "Python 3.11.4 (64-bit)", "Line of Business Client", "uTorrent", "TightVNC"
+};
+
+// OS builds of the synthetic update catalog; 0 = build-independent updates
+const unsigned UpdateBuilds[] = { 19045, 22621, 22631, 26100, 0 };
+const unsigned CumulativeMonths = 60;
+
+// Account SIDs and logon times of the synthetic users
+const char* const MachineSid = "S-1-5-21-1111-2222-3333";
+const char* const DomainSid = "S-1-5-21-100-200-300";
+const uint64_t TicksPerDay = 864000000000ull;
+const uint64_t RecentFileTime = 133700000000000000ull;     // FILETIME in late 2024
+
+// Little-endian integer of the given width
+void appendLE(std::string& out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+// Minimal regf writer: one hbin, ASCII (compressed) names, lh subkey lists
+class HiveWriter {
+public:
+    struct Value {
+        std::string name;
+        uint32_t type;
+        std::string data;
+    };
+
+    struct Node {
+        std::string name;
+        std::vector<Value> values;
+        std::vector<Node> children;
+
+        Node& child(const std::string& childName) {
+            children.push_back(Node{ childName, {}, {} });
+            return children.back();
+        }
+        void dword(const std::string& valueName, uint32_t value) {
+            std::string data(4, '\0');
+            std::memcpy(&data[0], &value, 4);
+            values.push_back(Value{ valueName, 4, data });
+        }
+        void binary(const std::string& valueName, const std::string& data) {
+            values.push_back(Value{ valueName, 3, data });
+        }
+        void text(const std::string& valueName, const std::string& value, uint32_t type = 1) {
+            std::string data;
+            for (char c : value + '\0') {
+                data += c;
+                data += '\0';
+            }
+            values.push_back(Value{ valueName, type, data });
+        }
+    };
+
+    std::string build(Node& root) {
+        bins.assign(32, '\0');
+        uint32_t rootCell = writeKey(root, 0, true);
+
+        // Pad the single hbin to a 4 KB multiple
+        bins.resize((bins.size() + 4095) / 4096 * 4096, '\0');
+        std::memcpy(&bins[0], "hbin", 4);
+        put32(bins, 8, static_cast<uint32_t>(bins.size()));
+
+        std::string image(4096, '\0');
+        std::memcpy(&image[0], "regf", 4);
+        put32(image, 0x04, 1);
+        put32(image, 0x08, 1);
+        put32(image, 0x14, 1);
+        put32(image, 0x18, 5);
+        put32(image, 0x20, 1);
+        put32(image, 0x24, rootCell);
+        put32(image, 0x28, static_cast<uint32_t>(bins.size()));
+        put32(image, 0x2C, 1);
+
+        uint32_t checksum = 0;
+        for (size_t i = 0; i < 0x1FC; i += 4) {
+            uint32_t word;
+            std::memcpy(&word, &image[i], 4);
+            checksum ^= word;
+        }
+        put32(image, 0x1FC, checksum);
+
+        return image + bins;
+    }
+
+private:
+    std::string bins;
+
+    static void put16(std::string& buffer, size_t offset, uint16_t value) { std::memcpy(&buffer[offset], &value, 2); }
+    static void put32(std::string& buffer, size_t offset, uint32_t value) { std::memcpy(&buffer[offset], &value, 4); }
+
+    // Allocate a cell and return its hbin-relative offset; data starts 4 bytes in
+    uint32_t allocate(size_t dataSize) {
+        size_t cellSize = (dataSize + 4 + 7) & ~static_cast<size_t>(7);
+        uint32_t offset = static_cast<uint32_t>(bins.size());
+        bins.resize(bins.size() + cellSize, '\0');
+        put32(bins, offset, static_cast<uint32_t>(-static_cast<int32_t>(cellSize)));
+        return offset;
+    }
+
+    static std::string upper(const std::string& text) {
+        std::string out = text;
+        for (char& c : out) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return out;
+    }
+
+    uint32_t writeValue(const Value& value) {
+        uint32_t vk = allocate(0x14 + value.name.size());
+        size_t p = vk + 4;
+        std::memcpy(&bins[p], "vk", 2);
+        put16(bins, p + 2, static_cast<uint16_t>(value.name.size()));
+        put32(bins, p + 0x0C, value.type);
+        put16(bins, p + 0x10, value.name.empty() ? 0 : 1);
+        std::memcpy(&bins[p + 0x14], value.name.data(), value.name.size());
+
+        if (value.data.size() <= 4) {
+            put32(bins, p + 4, static_cast<uint32_t>(value.data.size()) | 0x80000000u);
+            std::memcpy(&bins[p + 8], value.data.data(), value.data.size());
+        } else {
+            uint32_t data = allocate(value.data.size());
+            put32(bins, vk + 4 + 4, static_cast<uint32_t>(value.data.size()));
+            put32(bins, vk + 4 + 8, data);
+            std::memcpy(&bins[data + 4], value.data.data(), value.data.size());
+        }
+        return vk;
+    }
+
+    uint32_t writeKey(Node& node, uint32_t parent, bool isRoot) {
+        uint32_t nk = allocate(0x4C + node.name.size());
+        size_t p = nk + 4;
+        std::memcpy(&bins[p], "nk", 2);
+        put16(bins, p + 2, static_cast<uint16_t>(0x20 | (isRoot ? 0x0C : 0)));
+        put32(bins, p + 0x10, parent);
+        put32(bins, p + 0x2C, 0xFFFFFFFFu);
+        put32(bins, p + 0x30, 0xFFFFFFFFu);
+        put16(bins, p + 0x48, static_cast<uint16_t>(node.name.size()));
+        std::memcpy(&bins[p + 0x4C], node.name.data(), node.name.size());
+
+        if (!node.values.empty()) {
+            uint32_t list = allocate(node.values.size() * 4);
+            for (size_t i = 0; i < node.values.size(); ++i) {
+                put32(bins, list + 4 + i * 4, writeValue(node.values[i]));
+            }
+            put32(bins, nk + 4 + 0x24, static_cast<uint32_t>(node.values.size()));
+            put32(bins, nk + 4 + 0x28, list);
+        } else {
+            put32(bins, nk + 4 + 0x28, 0xFFFFFFFFu);
+        }
+
+        if (!node.children.empty()) {
+            std::sort(node.children.begin(), node.children.end(), [](const Node& a, const Node& b) {
+                return upper(a.name) < upper(b.name);
+            });
+
+            std::vector<uint32_t> offsets;
+            for (Node& child : node.children) {
+                offsets.push_back(writeKey(child, nk, false));
+            }
+
+            uint32_t list = allocate(4 + offsets.size() * 8);
+            std::memcpy(&bins[list + 4], "lh", 2);
+            put16(bins, list + 4 + 2, static_cast<uint16_t>(offsets.size()));
+            for (size_t i = 0; i < offsets.size(); ++i) {
+                uint32_t hash = 0;
+                for (char c : upper(node.children[i].name)) hash = hash * 37 + static_cast<unsigned char>(c);
+                put32(bins, list + 4 + 4 + i * 8, offsets[i]);
+                put32(bins, list + 4 + 8 + i * 8, hash);
+            }
+            put32(bins, nk + 4 + 0x14, static_cast<uint32_t>(offsets.size()));
+            put32(bins, nk + 4 + 0x1C, list);
+        } else {
+            put32(bins, nk + 4 + 0x1C, 0xFFFFFFFFu);
+        }
+        put32(bins, nk + 4 + 0x20, 0xFFFFFFFFu);
+
+        return nk;
+    }
+};
+
+
+// Minimal .evtx writer: each chunk defines a template per event shape the
+// first time it is used (inline names, as Windows writes them) and every
+// record instantiates it with a substitution array
+class EvtxWriter {
+public:
+    struct Field {
+        std::string name;
+        uint8_t type;           // BinXML value type
+        std::string bytes;
+    };
+
+    struct Shape {
+        uint16_t eventId;
+        std::string provider;
+        std::vector<std::pair<std::string, uint8_t>> fields;
+    };
+
+    EvtxWriter() { startChunk(); }
+
+    void add(const Shape& shape, uint64_t recordId, uint64_t fileTime, const std::vector<Field>& values) {
+        std::string record = buildRecord(shape, recordId, fileTime, values);
+        if (chunkPos + record.size() > ChunkSize) {
+            finishChunk();
+            startChunk();
+            record = buildRecord(shape, recordId, fileTime, values);
+        }
+        chunk.replace(chunkPos, record.size(), record);
+        if (firstRecord == 0) firstRecord = recordId;
+        lastRecord = recordId;
+        lastRecordOffset = static_cast<uint32_t>(chunkPos);
+        chunkPos += record.size();
+        nextRecordId = recordId + 1;
+    }
+
+    std::string finish() {
+        finishChunk();
+
+        std::string header(4096, '\0');
+        std::memcpy(&header[0], "ElfFile\0", 8);
+        uint64_t lastChunk = chunks.empty() ? 0 : chunks.size() / ChunkSize - 1;
+        std::memcpy(&header[16], &lastChunk, 8);
+        std::memcpy(&header[24], &nextRecordId, 8);
+        put32(header, 32, 128);
+        put16(header, 36, 1);
+        put16(header, 38, 3);
+        put16(header, 40, 4096);
+        put16(header, 42, static_cast<uint16_t>(chunks.size() / ChunkSize));
+        return header + chunks;
+    }
+
+private:
+    static const size_t ChunkSize = 65536;
+
+    std::string chunks;
+    std::string chunk;
+    size_t chunkPos = 0;
+    uint64_t firstRecord = 0;
+    uint64_t lastRecord = 0;
+    uint32_t lastRecordOffset = 0;
+    uint64_t nextRecordId = 1;
+    std::vector<std::pair<std::string, uint32_t>> names;        // chunk string table
+    std::vector<std::pair<uint16_t, uint32_t>> templates;       // event ID -> definition offset
+
+    static void put16(std::string& buffer, size_t offset, uint16_t value) { std::memcpy(&buffer[offset], &value, 2); }
+    static void put32(std::string& buffer, size_t offset, uint32_t value) { std::memcpy(&buffer[offset], &value, 4); }
+    static void append16(std::string& out, uint16_t value) { out.append(reinterpret_cast<const char*>(&value), 2); }
+    static void append32(std::string& out, uint32_t value) { out.append(reinterpret_cast<const char*>(&value), 4); }
+    static void append64(std::string& out, uint64_t value) { out.append(reinterpret_cast<const char*>(&value), 8); }
+
+    static void appendUtf16(std::string& out, const std::string& text) {
+        for (char c : text) {
+            out += c;
+            out += '\0';
+        }
+    }
+
+    void startChunk() {
+        chunk.assign(ChunkSize, '\0');
+        chunkPos = 512;
+        firstRecord = 0;
+        names.clear();
+        templates.clear();
+    }
+
+    void finishChunk() {
+        if (firstRecord == 0) return;
+        std::memcpy(&chunk[0], "ElfChnk\0", 8);
+        std::memcpy(&chunk[8], &firstRecord, 8);
+        std::memcpy(&chunk[16], &lastRecord, 8);
+        std::memcpy(&chunk[24], &firstRecord, 8);
+        std::memcpy(&chunk[32], &lastRecord, 8);
+        put32(chunk, 40, 128);
+        put32(chunk, 44, lastRecordOffset);
+        put32(chunk, 48, static_cast<uint32_t>(chunkPos));
+        chunks += chunk;
+        firstRecord = 0;
+    }
+
+    // Name reference; written inline (at base + out.size()) on first use in the chunk
+    void appendName(std::string& out, size_t base, const std::string& name, std::vector<std::pair<std::string, uint32_t>>& table) {
+        for (const auto& entry : table) {
+            if (entry.first == name) {
+                append32(out, entry.second);
+                return;
+            }
+        }
+        uint32_t offset = static_cast<uint32_t>(base + out.size() + 4);
+        append32(out, offset);
+        table.emplace_back(name, offset);
+        append32(out, 0);
+        append16(out, 0);
+        append16(out, static_cast<uint16_t>(name.size()));
+        appendUtf16(out, name);
+        append16(out, 0);
+    }
+
+    void openElement(std::string& out, size_t base, const std::string& name, bool attributes,
+                     std::vector<std::pair<std::string, uint32_t>>& table) {
+        out += static_cast<char>(attributes ? 0x41 : 0x01);
+        append16(out, 0xFFFF);
+        append32(out, 0);
+        if (attributes) {
+            // Name offset, then the attribute list size, then the inline name
+            size_t nameField = out.size();
+            append32(out, 0);
+            append32(out, 0);
+            std::string inlineName;
+            appendName(inlineName, base + out.size() - 4, name, table);
+            std::memcpy(&out[nameField], inlineName.data(), 4);
+            out += inlineName.substr(4);
+        } else {
+            appendName(out, base, name, table);
+        }
+    }
+
+    void attribute(std::string& out, size_t base, const std::string& name, std::vector<std::pair<std::string, uint32_t>>& table) {
+        out += '\x06';
+        appendName(out, base, name, table);
+    }
+
+    void literal(std::string& out, const std::string& text) {
+        out += '\x05';
+        out += '\x01';
+        append16(out, static_cast<uint16_t>(text.size()));
+        appendUtf16(out, text);
+    }
+
+    void substitution(std::string& out, uint16_t id, uint8_t type) {
+        out += '\x0E';
+        append16(out, id);
+        out += static_cast<char>(type);
+    }
+
+    std::string buildTemplate(const Shape& shape, size_t base, std::vector<std::pair<std::string, uint32_t>>& table) {
+        std::string t;
+        t += std::string("\x0F\x01\x01\x00", 4);
+        openElement(t, base, "Event", false, table);
+        t += '\x02';
+        openElement(t, base, "System", false, table);
+        t += '\x02';
+        openElement(t, base, "Provider", true, table);
+        attribute(t, base, "Name", table);
+        literal(t, shape.provider);
+        t += '\x03';
+        openElement(t, base, "EventID", false, table);
+        t += '\x02';
+        substitution(t, 0, 0x06);
+        t += '\x04';
+        openElement(t, base, "Level", false, table);
+        t += '\x02';
+        substitution(t, 1, 0x04);
+        t += '\x04';
+        openElement(t, base, "TimeCreated", true, table);
+        attribute(t, base, "SystemTime", table);
+        substitution(t, 2, 0x11);
+        t += '\x03';
+        openElement(t, base, "EventRecordID", false, table);
+        t += '\x02';
+        substitution(t, 3, 0x0A);
+        t += '\x04';
+        openElement(t, base, "Computer", false, table);
+        t += '\x02';
+        literal(t, "WS01.contoso.com");
+        t += '\x04';
+        t += '\x04';
+        openElement(t, base, "EventData", false, table);
+        t += '\x02';
+        for (size_t i = 0; i < shape.fields.size(); ++i) {
+            openElement(t, base, "Data", true, table);
+            attribute(t, base, "Name", table);
+            literal(t, shape.fields[i].first);
+            t += '\x02';
+            substitution(t, static_cast<uint16_t>(4 + i), shape.fields[i].second);
+            t += '\x04';
+        }
+        t += '\x04';
+        t += '\x04';
+        t += '\x00';
+        return t;
+    }
+
+    std::string buildRecord(const Shape& shape, uint64_t recordId, uint64_t fileTime, const std::vector<Field>& values) {
+        std::string r("**\0\0", 4);
+        append32(r, 0);
+        append64(r, recordId);
+        append64(r, fileTime);
+        r += std::string("\x0F\x01\x01\x00", 4);
+        r += '\x0C';
+        r += '\x01';
+        append32(r, shape.eventId);
+
+        uint32_t definition = 0;
+        for (const auto& entry : templates) {
+            if (entry.first == shape.eventId) definition = entry.second;
+        }
+
+        if (definition != 0) {
+            append32(r, definition);
+        } else {
+            // Inline definition: next offset, GUID, data size, BinXML
+            definition = static_cast<uint32_t>(chunkPos + r.size() + 4);
+            append32(r, definition);
+            auto table = names;
+            std::string body = buildTemplate(shape, chunkPos + r.size() + 24, table);
+            append32(r, 0);
+            append32(r, shape.eventId);
+            r.append(12, '\x5A');
+            append32(r, static_cast<uint32_t>(body.size()));
+            r += body;
+            if (chunkPos + r.size() <= ChunkSize) {
+                names = table;
+                templates.emplace_back(shape.eventId, definition);
+            }
+        }
+
+        // Substitution array
+        std::vector<Field> all;
+        Field eventId{ "", 0x06, std::string(2, '\0') };
+        std::memcpy(&eventId.bytes[0], &shape.eventId, 2);
+        all.push_back(eventId);
+        all.push_back(Field{ "", 0x04, std::string(1, '\0') });
+        all.push_back(Field{ "", 0x11, std::string(reinterpret_cast<const char*>(&fileTime), 8) });
+        all.push_back(Field{ "", 0x0A, std::string(reinterpret_cast<const char*>(&recordId), 8) });
+        all.insert(all.end(), values.begin(), values.end());
+
+        append32(r, static_cast<uint32_t>(all.size()));
+        for (const auto& value : all) {
+            append16(r, static_cast<uint16_t>(value.bytes.size()));
+            r += static_cast<char>(value.type);
+            r += '\0';
+        }
+        for (const auto& value : all) {
+            r += value.bytes;
+        }
+
+        append32(r, static_cast<uint32_t>(r.size() + 4));
+        put32(r, 4, static_cast<uint32_t>(r.size()));
+        return r;
+    }
+};
+
+} // namespace
+
+std::string SyntheticProbeData::uninstallCsv(size_t count) {
+    std::string csv = "\"DisplayName\",\"DisplayVersion\",\"Publisher\",\"InstallDate\"\r\n";
+    csv.reserve(count * 96);
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t product = pick(sizeof(Products) / sizeof(Products[0]));
+        size_t vendor = pick(sizeof(Vendors) / sizeof(Vendors[0]));
+
+        csv += "\"";
+        csv += Products[product];
+        csv += " ";
+        csv += std::to_string(i);
+        csv += "\",\"";
+        csv += std::to_string(range(1, 30)) + "." + std::to_string(range(0, 9)) + "." + std::to_string(range(0, 9999));
+        csv += "\",\"";
+        csv += Vendors[vendor];
+        csv += "\",\"";
+        csv += std::to_string(range(2015, 2024)) + (range(0, 1) ? "0" : "1") + std::to_string(range(1, 2)) +
+               std::to_string(range(10, 28));
+        csv += "\"\r\n";
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::smbShareCsv(size_t count) {
+    std::string csv = "\"Name\",\"Path\",\"Description\",\"ShareType\",\"SecurityDescriptor\",\"PathSddl\"\r\n";
+    csv.reserve(count * 320);
+
+    const std::string adminShare = "O:SYG:SYD:(A;;FA;;;BA)(A;;FA;;;BO)(A;;FA;;;SY)";
+    const std::string systemFolder = "O:SYG:SYD:PAI(A;OICI;FA;;;SY)(A;OICI;FA;;;BA)(A;OICI;0x1200a9;;;BU)";
+    csv += "\"ADMIN$\",\"C:\\Windows\",\"Remote Admin\",\"FileSystemDirectory\",\"" + adminShare + "\",\"" + systemFolder + "\"\r\n";
+    csv += "\"C$\",\"C:\\\",\"Default share\",\"FileSystemDirectory\",\"" + adminShare + "\",\"" + systemFolder + "\"\r\n";
+    csv += "\"IPC$\",\"\",\"Remote IPC\",\"FileSystemDirectory\",\"" + adminShare + "\",\"\"\r\n";
+
+    for (size_t i = 3; i < count; ++i) {
+        std::string name = "Dept" + std::to_string(i);
+        std::string group = "S-1-5-21-1004336348-1177238915-682003330-" + std::to_string(2000 + pick(300));
+
+        // Share permissions: mostly Everyone Read (the default) or group Change, sometimes Everyone Full
+        std::string shareSddl = "O:SYG:SYD:";
+        int shareKind = range(0, 99);
+        if (shareKind < 50) shareSddl += "(A;;0x1200a9;;;WD)";
+        else if (shareKind < 95) shareSddl += "(A;;FA;;;BA)(A;;0x1301bf;;;" + group + ")";
+        else shareSddl += "(A;;FA;;;WD)";
+
+        // Folder permissions: group Modify, with occasional Users read or Everyone full control
+        std::string folderSddl = "O:BAG:DUD:AI(A;OICIID;FA;;;SY)(A;OICIID;FA;;;BA)(A;OICI;0x1301bf;;;" + group + ")";
+        int folderKind = range(0, 99);
+        if (folderKind < 10) folderSddl += "(A;OICI;0x1200a9;;;BU)";
+        else if (folderKind < 12) folderSddl += "(A;OICI;FA;;;WD)";
+        else if (folderKind < 15) folderSddl += "(D;OICI;0x10000;;;AU)(A;OICI;0x1301bf;;;AU)";
+
+        csv += "\"" + name + "\",\"D:\\Shares\\" + name + "\",\"Department share, \"\"" + name +
+               "\"\"\",\"FileSystemDirectory\",\"" + shareSddl + "\",\"" + folderSddl + "\"\r\n";
+    }
+
+    return csv;
+}
+
+std::vector<std::string> SyntheticProbeData::binarySecurityDescriptors(size_t count) {
+    std::vector<std::string> descriptors;
+    descriptors.reserve(count);
+
+    // SID: revision, sub-authority count, 6-byte authority, sub-authorities
+    auto appendSid = [](std::string& out, uint8_t authority, std::initializer_list<uint32_t> subAuthorities) {
+        out += static_cast<char>(1);
+        out += static_cast<char>(subAuthorities.size());
+        out.append(5, '\0');
+        out += static_cast<char>(authority);
+        for (uint32_t sub : subAuthorities) appendLE(out, sub, 4);
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        std::string acl;
+        uint16_t aceCount = 0;
+        auto appendAce = [&](uint8_t type, uint32_t mask, uint8_t authority, std::initializer_list<uint32_t> subs) {
+            std::string ace;
+            ace += static_cast<char>(type);
+            ace += static_cast<char>(0);
+            appendLE(ace, 8 + 8 + static_cast<uint32_t>(subs.size()) * 4, 2);
+            appendLE(ace, mask, 4);
+            appendSid(ace, authority, subs);
+            acl += ace;
+            aceCount++;
+        };
+
+        appendAce(0, 0x1F01FF, 5, { 32, 544 });
+        appendAce(0, 0x1301BF, 5, { 21, 1004336348, 1177238915, 682003330, 2000 + static_cast<uint32_t>(pick(300)) });
+        if (pick(4) == 0) appendAce(0, 0x1200A9, 1, { 0 });
+        if (pick(10) == 0) appendAce(1, 0x10000, 5, { 11 });
+
+        std::string descriptor;
+        descriptor += static_cast<char>(1);     // revision
+        descriptor += static_cast<char>(0);
+        appendLE(descriptor, 0x8004, 2);        // SE_SELF_RELATIVE | SE_DACL_PRESENT
+        appendLE(descriptor, 0, 4);             // owner
+        appendLE(descriptor, 0, 4);             // group
+        appendLE(descriptor, 0, 4);             // SACL
+        appendLE(descriptor, 20, 4);            // DACL
+        descriptor += static_cast<char>(2);     // ACL revision
+        descriptor += static_cast<char>(0);
+        appendLE(descriptor, 8 + static_cast<uint32_t>(acl.size()), 2);
+        appendLE(descriptor, aceCount, 2);
+        appendLE(descriptor, 0, 2);
+        descriptor += acl;
+        descriptors.push_back(std::move(descriptor));
+    }
+
+    return descriptors;
+}
+
+std::string SyntheticProbeData::localUserCsv(size_t count) {
+    std::string csv = "\"Name\",\"SID\",\"Enabled\",\"PasswordNeverExpires\",\"PasswordRequired\",\"LastLogon\"\r\n";
+    csv.reserve(count * 96);
+
+    csv += "\"Administrator\",\"" + std::string(MachineSid) + "-500\",\"False\",\"True\",\"True\",\"\"\r\n";
+    csv += "\"Guest\",\"" + std::string(MachineSid) + "-501\",\"False\",\"True\",\"False\",\"\"\r\n";
+
+    for (size_t i = 2; i < count; ++i) {
+        csv += "\"user" + std::to_string(i) + "\",\"" + MachineSid + "-" + std::to_string(1000 + i) + "\",\"";
+        csv += range(0, 9) == 0 ? "False" : "True";
+        csv += "\",\"";
+        csv += range(0, 19) == 0 ? "True" : "False";
+        csv += "\",\"True\",\"";
+        if (range(0, 9) != 0) csv += std::to_string(RecentFileTime - static_cast<uint64_t>(range(0, 200)) * TicksPerDay);
+        csv += "\"\r\n";
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::groupMemberCsv(size_t userCount, size_t groupCount) {
+    std::string csv = "\"Group\",\"GroupSID\",\"Name\",\"SID\",\"ObjectClass\"\r\n";
+    csv.reserve((userCount * 2 + groupCount) * 110);
+
+    auto row = [&](const std::string& group, const std::string& groupSid, const std::string& name,
+                   const std::string& sid, const char* objectClass) {
+        csv += "\"" + group + "\",\"" + groupSid + "\",\"" + name + "\",\"" + sid + "\",\"" + objectClass + "\"\r\n";
+    };
+    auto groupName = [](size_t k) { return "CONTOSO\\Dept" + std::to_string(k); };
+    auto groupSid = [](size_t k) { return std::string(DomainSid) + "-" + std::to_string(5000 + k); };
+    const std::string admins = "Administrators", adminsSid = "S-1-5-32-544";
+    const std::string rdp = "Remote Desktop Users", rdpSid = "S-1-5-32-555";
+    const std::string domainAdmins = "CONTOSO\\Domain Admins", domainAdminsSid = std::string(DomainSid) + "-512";
+
+    // Local administrators: the built-in account, a few local users and Domain Admins
+    row(admins, adminsSid, "HOST\\Administrator", std::string(MachineSid) + "-500", "User");
+    for (size_t i = 2; i < 5; ++i) {
+        row(admins, adminsSid, "HOST\\user" + std::to_string(i), std::string(MachineSid) + "-" + std::to_string(1000 + i), "User");
+    }
+    row(admins, adminsSid, domainAdmins, domainAdminsSid, "Group");
+
+    // Tier-0 groups nested in each other and in Domain Admins
+    const std::string tierA = "CONTOSO\\Tier0 Operators", tierASid = std::string(DomainSid) + "-4001";
+    const std::string tierB = "CONTOSO\\Tier0 Servers", tierBSid = std::string(DomainSid) + "-4002";
+    row(domainAdmins, domainAdminsSid, tierA, tierASid, "Group");
+    row(tierA, tierASid, tierB, tierBSid, "Group");
+    row(tierB, tierBSid, tierA, tierASid, "Group");
+
+    // Department tree under Remote Desktop Users
+    if (groupCount > 0) row(rdp, rdpSid, groupName(0), groupSid(0), "Group");
+    for (size_t k = 1; k < groupCount; ++k) {
+        size_t parent = pick(k);
+        row(groupName(parent), groupSid(parent), groupName(k), groupSid(k), "Group");
+    }
+
+    for (size_t i = 0; i < userCount; ++i) {
+        std::string name = "CONTOSO\\duser" + std::to_string(i);
+        std::string sid = std::string(DomainSid) + "-" + std::to_string(10000 + i);
+        if (i < 3) {
+            row(i % 2 == 0 ? tierA : tierB, i % 2 == 0 ? tierASid : tierBSid, name, sid, "User");
+            continue;
+        }
+        size_t memberships = groupCount == 0 ? 0 : static_cast<size_t>(range(1, 2));
+        for (size_t m = 0; m < memberships; ++m) {
+            size_t k = pick(groupCount);
+            row(groupName(k), groupSid(k), name, sid, "User");
+        }
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::bitLockerVolumes(size_t count) {
+    std::string out;
+    out.reserve(count * 200);
+
+    for (size_t i = 0; i < count; ++i) {
+        std::string mount = i == 0 ? "C:" : (i < 24 ? std::string(1, static_cast<char>('D' + i - 1)) + ":"
+                                                    : "\\\\?\\Volume{" + std::to_string(i) + "}\\");
+        int percent = range(0, 9) < 7 ? 100 : range(0, 99);
+
+        out += "\r\nMountPoint           : " + mount + "\r\n";
+        out += "VolumeType           : ";
+        out += i == 0 ? "OperatingSystem" : "Data";
+        out += "\r\nEncryptionPercentage : " + std::to_string(percent) + "\r\n";
+        out += "VolumeStatus         : ";
+        out += percent == 100 ? "FullyEncrypted" : "EncryptionInProgress";
+        out += "\r\nProtectionStatus     : ";
+        out += percent == 100 ? "On" : "Off";
+        out += "\r\n";
+    }
+
+    return out;
+}
+
+std::string SyntheticProbeData::firewallProfiles() {
+    return "\r\nName    : Domain\r\nEnabled : True\r\n"
+           "\r\nName    : Private\r\nEnabled : True\r\n"
+           "\r\nName    : Public\r\nEnabled : False\r\n";
+}
+
+std::string SyntheticProbeData::auditPolicy() {
+    return "System audit policy\r\n"
+           "Category/Subcategory                      Setting\r\n"
+           "System\r\n"
+           "  Security System Extension               No Auditing\r\n"
+           "  System Integrity                        Success and Failure\r\n"
+           "Logon/Logoff\r\n"
+           "  Logon                                   Success and Failure\r\n"
+           "  Logoff                                  Success\r\n"
+           "  Account Lockout                         Success\r\n"
+           "Object Access\r\n"
+           "  File System                             No Auditing\r\n"
+           "  Registry                                No Auditing\r\n"
+           "Policy Change\r\n"
+           "  Audit Policy Change                     Success\r\n"
+           "Account Management\r\n"
+           "  User Account Management                 Success and Failure\r\n";
+}
+
+std::string SyntheticProbeData::seceditInf(size_t privilegeCount) {
+    std::string inf =
+        "[Unicode]\r\nUnicode=yes\r\n"
+        "[System Access]\r\n"
+        "MinimumPasswordAge = 1\r\n"
+        "MaximumPasswordAge = 60\r\n"
+        "MinimumPasswordLength = 14\r\n"
+        "PasswordComplexity = 1\r\n"
+        "PasswordHistorySize = 24\r\n"
+        "LockoutBadCount = 5\r\n"
+        "ResetLockoutCount = 15\r\n"
+        "LockoutDuration = 15\r\n"
+        "NewAdministratorName = \"Administrator\"\r\n"
+        "[Event Audit]\r\n"
+        "AuditSystemEvents = 3\r\nAuditLogonEvents = 3\r\nAuditObjectAccess = 0\r\n"
+        "AuditPrivilegeUse = 2\r\nAuditPolicyChange = 1\r\nAuditAccountManage = 3\r\n"
+        "[Privilege Rights]\r\n";
+
+    for (size_t i = 0; i < privilegeCount; ++i) {
+        inf += "SeCustomRight" + std::to_string(i) + " = *S-1-5-32-544,*S-1-5-21-1004336348-1177238915-682003330-" +
+               std::to_string(1000 + i) + ",CONTOSO\\svc" + std::to_string(i) + "\r\n";
+    }
+
+    inf += "[Version]\r\nsignature=\"$CHICAGO$\"\r\nRevision=1\r\n";
+    return inf;
+}
+
+std::string SyntheticProbeData::netAccounts() {
+    return "Force user logoff how long after time expires?:       Never\r\n"
+           "Minimum password age (days):                          1\r\n"
+           "Maximum password age (days):                          60\r\n"
+           "Minimum password length:                              14\r\n"
+           "Length of password history maintained:                24\r\n"
+           "Lockout threshold:                                    5\r\n"
+           "Lockout duration (minutes):                           15\r\n"
+           "Lockout observation window (minutes):                 15\r\n"
+           "Computer role:                                        SERVER\r\n"
+           "The command completed successfully.\r\n";
+}
+
+std::string SyntheticProbeData::systemHive(size_t serviceCount) {
+    HiveWriter::Node root{ "ROOT", {}, {} };
+
+    HiveWriter::Node& select = root.child("Select");
+    select.dword("Current", 1);
+    select.dword("Default", 1);
+    select.dword("LastKnownGood", 2);
+
+    for (const char* setName : { "ControlSet001", "ControlSet002" }) {
+        HiveWriter::Node& controlSet = root.child(setName);
+
+        HiveWriter::Node& lsa = controlSet.child("Control").child("Lsa");
+        lsa.dword("LmCompatibilityLevel", static_cast<uint32_t>(range(3, 5)));
+        lsa.dword("RestrictAnonymous", 1);
+        lsa.dword("NoLMHash", 1);
+
+        HiveWriter::Node& services = controlSet.child("Services");
+        for (size_t i = 0; i < serviceCount; ++i) {
+            HiveWriter::Node& service = services.child("Svc" + std::to_string(100000 + i));
+            service.text("ImagePath", "C:\\Program Files\\" + std::string(Products[pick(sizeof(Products) / sizeof(Products[0]))]) +
+                                          "\\svc" + std::to_string(i) + ".exe", 2);
+            service.text("DisplayName", "Synthetic Service " + std::to_string(i));
+            service.text("ObjectName", i % 3 == 0 ? "LocalSystem" : "NT AUTHORITY\\LocalService");
+            service.dword("Start", static_cast<uint32_t>(range(2, 4)));
+            service.dword("Type", 16);
+        }
+
+        HiveWriter::Node& eventLog = services.child("EventLog");
+        eventLog.text("ImagePath", "%SystemRoot%\\System32\\svchost.exe -k LocalServiceNetworkRestricted -p", 2);
+        eventLog.dword("Start", 2);
+        eventLog.child("Security").dword("MaxSize", 20971520);
+    }
+
+    HiveWriter writer;
+    return writer.build(root);
+}
+
+std::string SyntheticProbeData::samHive(size_t userCount) {
+    HiveWriter::Node root{ "ROOT", {}, {} };
+    HiveWriter::Node& domains = root.child("SAM").child("Domains");
+
+    // Account domain V value ends with the machine SID sub-authorities 1111-2222-3333
+    HiveWriter::Node& account = domains.child("Account");
+    std::string domainRecord(0x30, '\0');
+    appendLE(domainRecord, 1111, 4);
+    appendLE(domainRecord, 2222, 4);
+    appendLE(domainRecord, 3333, 4);
+    account.binary("V", domainRecord);
+
+    auto utf16 = [](const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            out += c;
+            out += '\0';
+        }
+        return out;
+    };
+    auto sid = [](std::initializer_list<uint32_t> subAuthorities, uint8_t authority) {
+        std::string out;
+        out += static_cast<char>(1);
+        out += static_cast<char>(subAuthorities.size());
+        out.append(5, '\0');
+        out += static_cast<char>(authority);
+        for (uint32_t sub : subAuthorities) appendLE(out, sub, 4);
+        return out;
+    };
+    auto hexRid = [](uint32_t rid) {
+        char name[9];
+        std::snprintf(name, sizeof(name), "%08X", rid);
+        return std::string(name);
+    };
+
+    HiveWriter::Node& users = account.child("Users");
+    users.child("Names");
+    std::vector<uint32_t> rids;
+    for (size_t i = 0; i < userCount; ++i) {
+        uint32_t rid = i == 0 ? 500 : (i == 1 ? 501 : static_cast<uint32_t>(1000 + i));
+        rids.push_back(rid);
+        std::string name = i == 0 ? "Administrator" : (i == 1 ? "Guest" : "user" + std::to_string(i));
+
+        // F: last logon, RID and account control bits
+        std::string fixed(0x50, '\0');
+        uint64_t lastLogon = i < 2 || range(0, 9) == 0 ? 0 : RecentFileTime - static_cast<uint64_t>(range(0, 200)) * TicksPerDay;
+        std::memcpy(&fixed[0x08], &lastLogon, 8);
+        std::memcpy(&fixed[0x30], &rid, 4);
+        uint16_t control = 0x0010;
+        if (i < 2 || range(0, 9) == 0) control |= 0x0001;
+        if (range(0, 19) == 0) control |= 0x0200;
+        std::memcpy(&fixed[0x38], &control, 2);
+
+        // V: string table header, then the user name
+        std::string record(0xCC, '\0');
+        std::string nameBytes = utf16(name);
+        uint32_t nameLength = static_cast<uint32_t>(nameBytes.size());
+        std::memcpy(&record[0x10], &nameLength, 4);
+        record += nameBytes;
+
+        HiveWriter::Node& user = users.child(hexRid(rid));
+        user.binary("F", fixed);
+        user.binary("V", record);
+    }
+
+    // Alias C value: header with name and member offsets, then the name and member SIDs
+    auto alias = [&](HiveWriter::Node& aliases, uint32_t rid, const std::string& name, const std::vector<std::string>& members) {
+        std::string record(0x34, '\0');
+        std::string nameBytes = utf16(name);
+        uint32_t nameLength = static_cast<uint32_t>(nameBytes.size());
+        uint32_t memberOffset = (nameLength + 3) & ~3u;
+        uint32_t memberCount = static_cast<uint32_t>(members.size());
+        std::memcpy(&record[0x14], &nameLength, 4);
+        std::memcpy(&record[0x28], &memberOffset, 4);
+        std::memcpy(&record[0x30], &memberCount, 4);
+        record += nameBytes;
+        record.resize(0x34 + memberOffset, '\0');
+        for (const auto& member : members) record += member;
+        aliases.child(hexRid(rid)).binary("C", record);
+    };
+
+    HiveWriter::Node& builtin = domains.child("Builtin").child("Aliases");
+    std::vector<std::string> administrators = { sid({ 21, 1111, 2222, 3333, 500 }, 5), sid({ 21, 100, 200, 300, 512 }, 5) };
+    for (size_t i = 2; i < 5 && i < rids.size(); ++i) administrators.push_back(sid({ 21, 1111, 2222, 3333, rids[i] }, 5));
+    alias(builtin, 544, "Administrators", administrators);
+
+    // Remote Desktop Users: every fifth user, kept under the 16 KB big-data limit
+    std::vector<std::string> remoteDesktop;
+    for (size_t i = 2; i < rids.size() && remoteDesktop.size() < 500; i += 5) {
+        remoteDesktop.push_back(sid({ 21, 1111, 2222, 3333, rids[i] }, 5));
+    }
+    alias(builtin, 555, "Remote Desktop Users", remoteDesktop);
+
+    HiveWriter writer;
+    return writer.build(root);
+}
+
+std::string SyntheticProbeData::softwareHive(size_t autorunCount) {
+    HiveWriter::Node root{ "ROOT", {}, {} };
+
+    HiveWriter::Node& software = root.child("Microsoft");
+    HiveWriter::Node& currentVersion = software.child("Windows").child("CurrentVersion");
+    HiveWriter::Node& run = currentVersion.child("Run");
+    for (size_t i = 0; i < autorunCount; ++i) {
+        std::string product = Products[pick(sizeof(Products) / sizeof(Products[0]))];
+        if (i % 25 == 0) {
+            run.text("Updater" + std::to_string(i), "C:\\Users\\user" + std::to_string(i % 40) +
+                                                        "\\AppData\\Roaming\\" + product + "\\update.exe /silent");
+        } else if (i % 10 == 0) {
+            run.text("Agent" + std::to_string(i), "C:\\Tools\\" + product + "\\agent.exe");
+        } else {
+            run.text(product + std::to_string(i), "\"C:\\Program Files\\" + product + "\\tray" + std::to_string(i) + ".exe\" -minimized");
+        }
+    }
+    HiveWriter::Node& runOnce = currentVersion.child("RunOnce");
+    runOnce.text("Setup", "%ProgramData%\\Setup\\finish.cmd", 2);
+
+    HiveWriter::Node& windowsNt = software.child("Windows NT").child("CurrentVersion");
+    HiveWriter::Node& winlogon = windowsNt.child("Winlogon");
+    winlogon.text("Shell", "explorer.exe");
+    winlogon.text("Userinit", "C:\\Windows\\system32\\userinit.exe,");
+
+    HiveWriter::Node& ifeo = windowsNt.child("Image File Execution Options");
+    for (size_t i = 0; i < autorunCount / 4; ++i) {
+        HiveWriter::Node& image = ifeo.child("app" + std::to_string(i) + ".exe");
+        image.dword("MitigationOptions", 0x100);
+        if (i % 50 == 0) image.text("Debugger", "C:\\ProgramData\\dbg\\dbg.exe");
+    }
+
+    HiveWriter writer;
+    return writer.build(root);
+}
+
+std::vector<std::pair<std::string, std::string>> SyntheticProbeData::scheduledTasks(size_t count) {
+    const char* const Folders[] = { "Microsoft\\Windows\\Defrag", "Microsoft\\Windows\\UpdateOrchestrator",
+                                    "Microsoft\\Windows\\WindowsBackup", "Microsoft\\Office", "" };
+
+    std::vector<std::pair<std::string, std::string>> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string product = Products[pick(sizeof(Products) / sizeof(Products[0]))];
+        std::string folder = Folders[i % (sizeof(Folders) / sizeof(Folders[0]))];
+        bool vendor = folder.empty();
+        bool system = i % 3 != 1;
+
+        std::string command, arguments;
+        if (!vendor) {
+            command = "%windir%\\system32\\taskhostw.exe";
+            arguments = "/Task" + std::to_string(i);
+        } else if (i % 20 == 4) {
+            command = "C:\\Users\\Public\\" + product + "\\update.exe";
+        } else if (i % 20 == 9) {
+            command = "powershell.exe";
+            arguments = "-NoProfile -ExecutionPolicy Bypass -File &quot;C:\\ProgramData\\" + product + "\\sync.ps1&quot;";
+        } else {
+            command = "&quot;C:\\Program Files\\" + product + "\\updater.exe&quot;";
+            arguments = "/check /silent";
+        }
+
+        std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-16\"?>\r\n"
+                          "<Task version=\"1.4\" xmlns=\"http://schemas.microsoft.com/windows/2004/02/mit/task\">\r\n"
+                          "  <RegistrationInfo>\r\n"
+                          "    <Date>2024-03-0" + std::to_string(1 + i % 9) + "T10:00:00</Date>\r\n"
+                          "    <Author>" + (vendor ? product : std::string("Microsoft Corporation")) + "</Author>\r\n"
+                          "    <URI>\\" + (vendor ? "" : folder + "\\") + "Task" + std::to_string(i) + "</URI>\r\n"
+                          "  </RegistrationInfo>\r\n"
+                          "  <Triggers>\r\n";
+        if (i % 4 == 0) {
+            xml += "    <BootTrigger>\r\n      <Enabled>true</Enabled>\r\n    </BootTrigger>\r\n";
+        }
+        xml += "    <CalendarTrigger>\r\n"
+               "      <StartBoundary>2024-01-01T03:00:00</StartBoundary>\r\n"
+               "      <ScheduleByWeek>\r\n        <DaysOfWeek>\r\n          <Sunday />\r\n        </DaysOfWeek>\r\n"
+               "        <WeeksInterval>1</WeeksInterval>\r\n      </ScheduleByWeek>\r\n"
+               "    </CalendarTrigger>\r\n"
+               "  </Triggers>\r\n"
+               "  <Principals>\r\n"
+               "    <Principal id=\"Author\">\r\n";
+        if (system) {
+            xml += "      <UserId>S-1-5-18</UserId>\r\n      <RunLevel>HighestAvailable</RunLevel>\r\n";
+        } else {
+            xml += "      <GroupId>S-1-5-32-545</GroupId>\r\n      <RunLevel>LeastPrivilege</RunLevel>\r\n";
+        }
+        xml += "    </Principal>\r\n"
+               "  </Principals>\r\n"
+               "  <Settings>\r\n"
+               "    <MultipleInstancesPolicy>IgnoreNew</MultipleInstancesPolicy>\r\n"
+               "    <DisallowStartIfOnBatteries>true</DisallowStartIfOnBatteries>\r\n"
+               "    <StopIfGoingOnBatteries>true</StopIfGoingOnBatteries>\r\n"
+               "    <Enabled>" + std::string(i % 11 == 10 ? "false" : "true") + "</Enabled>\r\n"
+               "    <Hidden>" + std::string(vendor ? "false" : "true") + "</Hidden>\r\n"
+               "    <ExecutionTimeLimit>PT72H</ExecutionTimeLimit>\r\n"
+               "  </Settings>\r\n"
+               "  <Actions Context=\"Author\">\r\n"
+               "    <Exec>\r\n"
+               "      <Command>" + command + "</Command>\r\n";
+        if (!arguments.empty()) xml += "      <Arguments>" + arguments + "</Arguments>\r\n";
+        xml += "    </Exec>\r\n"
+               "  </Actions>\r\n"
+               "</Task>\r\n";
+
+        std::string path = (vendor ? product : folder) + "\\Task" + std::to_string(i);
+        tasks.emplace_back(path, toUtf16LE(xml));
+    }
+    return tasks;
+}
+
+std::vector<std::pair<std::string, std::string>> SyntheticProbeData::programFiles(size_t count) {
+    std::vector<std::pair<std::string, std::string>> files;
+    files.reserve(count + count / 4);
+    for (size_t i = 0; i < count; ++i) {
+        std::string directory = std::string(Products[i % (sizeof(Products) / sizeof(Products[0]))]) + "\\" +
+                                (i % 3 == 0 ? "bin\\" : "");
+        int bucket = range(0, 99);
+        size_t size = bucket < 80 ? static_cast<size_t>(range(4, 64)) * 1024
+                    : bucket < 98 ? static_cast<size_t>(range(64, 256)) * 1024
+                                  : static_cast<size_t>(range(1024, 2048)) * 1024;
+
+        std::string contents(size, '\0');
+        contents[0] = 'M';
+        contents[1] = 'Z';
+        for (size_t pos = 64; pos + 4 <= size; pos += 4) {
+            uint32_t word = rng();
+            std::memcpy(&contents[pos], &word, 4);
+        }
+        files.emplace_back(directory + "module" + std::to_string(i) + (i % 4 == 0 ? ".exe" : ".dll"), std::move(contents));
+
+        if (i % 4 == 0) {
+            files.emplace_back(directory + "readme" + std::to_string(i) + ".txt", "Synthetic component " + std::to_string(i) + "\n");
+        }
+    }
+    return files;
+}
+
+std::string SyntheticProbeData::registryPol(size_t settingCount) {
+    std::string pol("PReg\x01\0\0\0", 8);
+
+    auto unit = [&](char c) { pol += c; pol += '\0'; };
+    auto name = [&](const std::string& text) { for (char c : text) unit(c); unit('\0'); };
+    auto record = [&](const std::string& key, const std::string& valueName, uint32_t type, const std::string& data) {
+        unit('[');
+        name(key);
+        unit(';');
+        name(valueName);
+        unit(';');
+        pol.append(reinterpret_cast<const char*>(&type), 4);
+        unit(';');
+        uint32_t size = static_cast<uint32_t>(data.size());
+        pol.append(reinterpret_cast<const char*>(&size), 4);
+        unit(';');
+        pol += data;
+        unit(']');
+    };
+    auto dword = [&](const std::string& key, const std::string& valueName, uint32_t value) {
+        record(key, valueName, 4, std::string(reinterpret_cast<const char*>(&value), 4));
+    };
+    auto text = [&](const std::string& key, const std::string& valueName, const std::string& value) {
+        std::string data = toUtf16LE(value).substr(2);
+        data.append(2, '\0');
+        record(key, valueName, 1, data);
+    };
+
+    dword("Software\\Policies\\Microsoft\\Windows\\WindowsUpdate\\AU", "NoAutoUpdate", 0);
+    dword("Software\\Policies\\Microsoft\\Windows\\WindowsUpdate\\AU", "AUOptions", 4);
+    text("Software\\Policies\\Microsoft\\Windows\\WindowsUpdate", "WUServer", "https://wsus.contoso.com:8531");
+    for (const char* profile : { "DomainProfile", "PrivateProfile", "PublicProfile" }) {
+        dword(std::string("Software\\Policies\\Microsoft\\WindowsFirewall\\") + profile, "EnableFirewall", 1);
+    }
+    dword("System\\CurrentControlSet\\Control\\Lsa", "LmCompatibilityLevel", 5);
+    record("Software\\Policies\\Microsoft\\Windows\\EventLog\\Security", "**del.Retention", 1, std::string(2, '\0'));
+
+    for (size_t i = 0; i < settingCount; ++i) {
+        std::string key = "Software\\Policies\\Contoso\\App" + std::to_string(i % 97);
+        if (i % 5 == 0) {
+            text(key, "Setting" + std::to_string(i), std::string(Products[pick(sizeof(Products) / sizeof(Products[0]))]));
+        } else if (i % 23 == 0) {
+            record(key, "**del.Setting" + std::to_string(i - 1), 1, std::string(2, '\0'));
+        } else {
+            dword(key, "Setting" + std::to_string(i), static_cast<uint32_t>(range(0, 3)));
+        }
+    }
+
+    return pol;
+}
+
+std::string SyntheticProbeData::securityEvtx(size_t eventCount) {
+    const std::string auditing = "Microsoft-Windows-Security-Auditing";
+    const uint8_t String = 0x01, UInt32 = 0x08, HexInt32 = 0x14;
+
+    const EvtxWriter::Shape shapes[] = {
+        { 4624, auditing, { { "TargetUserName", String }, { "TargetDomainName", String }, { "LogonType", UInt32 },
+                            { "IpAddress", String }, { "WorkstationName", String } } },
+        { 4625, auditing, { { "TargetUserName", String }, { "TargetDomainName", String }, { "Status", HexInt32 },
+                            { "SubStatus", HexInt32 }, { "LogonType", UInt32 }, { "IpAddress", String } } },
+        { 4688, auditing, { { "SubjectUserName", String }, { "NewProcessName", String }, { "CommandLine", String } } },
+        { 4672, auditing, { { "SubjectUserName", String }, { "SubjectDomainName", String }, { "PrivilegeList", String } } },
+        { 4740, auditing, { { "TargetUserName", String }, { "TargetDomainName", String } } },
+    };
+    const char* const users[] = { "alice", "bob", "carol", "svc_backup", "Administrator", "dave", "erin" };
+    const char* const processes[] = { "C:\\Windows\\System32\\cmd.exe", "C:\\Windows\\System32\\svchost.exe",
+                                      "C:\\Program Files\\Contoso\\client.exe", "C:\\Users\\Public\\tool.exe" };
+
+    auto text = [](const std::string& value) {
+        std::string bytes = toUtf16LE(value).substr(2);
+        bytes.append(2, '\0');
+        return EvtxWriter::Field{ "", String, bytes };
+    };
+    auto number = [](uint8_t type, uint32_t value) {
+        return EvtxWriter::Field{ "", type, std::string(reinterpret_cast<const char*>(&value), 4) };
+    };
+
+    EvtxWriter writer;
+    uint64_t fileTime = 134048736000000000ULL;   // 2025-10-12T00:00:00Z
+
+    for (size_t i = 0; i < eventCount; ++i) {
+        int roll = range(0, 99);
+        size_t shape = roll < 50 ? 0 : roll < 65 ? 1 : roll < 85 ? 2 : roll < 98 ? 3 : 4;
+        std::string user = users[pick(sizeof(users) / sizeof(users[0]))];
+        std::string ip = "10.0." + std::to_string(range(0, 20)) + "." + std::to_string(range(1, 254));
+
+        std::vector<EvtxWriter::Field> values;
+        switch (shape) {
+        case 0:
+            values = { text(user), text("CONTOSO"), number(UInt32, range(2, 10)), text(ip), text("WS" + std::to_string(range(1, 400))) };
+            break;
+        case 1:
+            values = { text(user), text("CONTOSO"), number(HexInt32, 0xC000006D), number(HexInt32, 0xC000006A),
+                       number(UInt32, 3), text(ip) };
+            break;
+        case 2:
+            values = { text(user), text(processes[pick(4)]), text("/c echo " + std::to_string(i)) };
+            break;
+        case 3:
+            values = { text(user), text("CONTOSO"), text("SeSecurityPrivilege\r\n\t\t\tSeBackupPrivilege\r\n\t\t\tSeDebugPrivilege") };
+            break;
+        default:
+            values = { text(user), text("CONTOSO") };
+            break;
+        }
+
+        fileTime += static_cast<uint64_t>(range(1, 30)) * 10000000ULL;
+        writer.add(shapes[shape], i + 1, fileTime, values);
+    }
+
+    return writer.finish();
+}
+
+std::string SyntheticProbeData::vulnerabilityCsv(size_t count) {
+    std::string csv = "Product,Introduced,Fixed,Id,Severity\r\n";
+    csv.reserve((count + 64) * 48);
+
+    static const char* const SeverityNames[] = { "Low", "Medium", "High", "Critical" };
+
+    // A few ranges per inventory product, so some installed versions match
+    for (const char* product : Products) {
+        for (int k = 0; k < 4; ++k) {
+            int major = range(1, 30);
+            csv += product;
+            csv += ",";
+            csv += std::to_string(major) + ".0,";
+            csv += std::to_string(major + range(0, 3)) + "." + std::to_string(range(1, 9)) + ",";
+            csv += "CVE-2024-" + std::to_string(range(10000, 99999)) + ",";
+            csv += SeverityNames[pick(4)];
+            csv += "\r\n";
+        }
+    }
+
+    // Products are named with letters; numeric tokens are dropped when names are normalized
+    for (size_t i = 0; i < count; ++i) {
+        size_t product = i / 4;
+        std::string name = "Product ";
+        do {
+            name += static_cast<char>('a' + product % 26);
+            product /= 26;
+        } while (product > 0);
+
+        int major = range(1, 30);
+        csv += name + ",";
+        if (range(0, 3) > 0) csv += std::to_string(major) + "." + std::to_string(range(0, 9));
+        csv += ",";
+        csv += std::to_string(major + range(0, 2)) + "." + std::to_string(range(0, 9)) + "." + std::to_string(range(0, 999)) + ",";
+        csv += "CVE-2023-" + std::to_string(range(10000, 99999)) + ",";
+        csv += SeverityNames[pick(4)];
+        csv += "\r\n";
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::updateCatalogCsv(size_t count) {
+    std::string csv = "\"KB\",\"Build\",\"Revision\",\"Title\",\"Severity\",\"Released\",\"Supersedes\"\r\n";
+    csv.reserve((count + 300) * 96);
+
+    static const char* const SeverityNames[] = { "Low", "Medium", "High", "Critical" };
+
+    // Monthly cumulative updates, each superseding the previous month and
+    // raising the build revision
+    for (unsigned b = 0; b < 4; ++b) {
+        for (unsigned month = 0; month < CumulativeMonths; ++month) {
+            unsigned kb = 5000000 + b * 100 + month;
+            csv += "\"" + std::to_string(kb) + "\",\"" + std::to_string(UpdateBuilds[b]) + "\",";
+            csv += "\"" + std::to_string(100 + month * 64) + "\",";
+            csv += "\"Cumulative Update for build " + std::to_string(UpdateBuilds[b]) + "\",\"Critical\",";
+            csv += "\"" + std::to_string(2020 + month / 12) + "-" + (month % 12 < 9 ? "0" : "") + std::to_string(month % 12 + 1) + "-10\",\"";
+            if (month > 0) csv += "KB" + std::to_string(kb - 1);
+            csv += "\"\r\n";
+        }
+    }
+
+    // Standalone updates; every third one replaces an earlier update of the same build
+    for (size_t i = 0; i < count; ++i) {
+        csv += "\"" + std::to_string(5100000 + i) + "\",\"";
+        if (UpdateBuilds[i % 5] != 0) csv += std::to_string(UpdateBuilds[i % 5]);
+        csv += "\",\"\",\"Security Update " + std::to_string(i) + "\",\"" + SeverityNames[pick(4)] + "\",";
+        csv += "\"" + std::to_string(range(2020, 2024)) + "-0" + std::to_string(range(1, 9)) + "-1" + std::to_string(range(0, 9)) + "\",\"";
+        if (i % 3 == 0 && i >= 5) csv += std::to_string(5100000 + i - 5);
+        csv += "\"\r\n";
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::hotfixCsv(size_t standaloneCount) {
+    std::string csv = "\"HotFixID\"\r\n";
+    csv.reserve((standaloneCount + 1) * 14);
+
+    // Build 22631, three cumulative updates behind
+    csv += "\"KB" + std::to_string(5000000 + 2 * 100 + CumulativeMonths - 4) + "\"\r\n";
+    for (size_t i = 0; i < standaloneCount; ++i) {
+        if (pick(10) == 0) continue;
+        csv += "\"KB" + std::to_string(5100000 + i) + "\"\r\n";
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::firewallRulesCsv(size_t count) {
+    std::string csv = "\"Name\",\"Rule\"\r\n";
+    csv.reserve(count * 200);
+
+    static const char* const Profiles[] = { "Domain", "Private", "Public" };
+    static const char* const Services[] = { "RpcSs", "Dnscache", "LanmanServer", "WinRM", "TermService", "W32Time" };
+    size_t applications = count / 3 + 1;
+    std::string previous;
+
+    for (size_t i = 0; i < count; ++i) {
+        std::string rule;
+        if (i % 50 == 49 && !previous.empty()) {
+            rule = previous;    // duplicate of the previous rule
+        } else if (i % 500 == 7) {
+            rule = "v2.30|Action=Allow|Active=TRUE|Dir=In|Protocol=6|LPort=3389|Name=Remote Desktop " + std::to_string(i) + "|";
+        } else {
+            size_t kind = pick(10);
+            rule = "v2.30|Action=";
+            rule += kind == 0 ? "Block" : "Allow";
+            rule += "|Active=";
+            rule += pick(20) == 0 ? "FALSE" : "TRUE";
+            rule += pick(4) == 0 ? "|Dir=Out" : "|Dir=In";
+            rule += pick(5) == 0 ? "|Protocol=17" : "|Protocol=6";
+            if (pick(3) != 0) {
+                rule += "|Profile=";
+                rule += Profiles[pick(3)];
+            }
+
+            int port = range(1024, 60000);
+            if (kind == 0) {
+                rule += "|LPort=" + std::to_string(port) + "-" + std::to_string(port + range(10, 200));
+            } else if (pick(8) == 0) {
+                rule += "|LPort=" + std::to_string(port) + "-" + std::to_string(port + range(1, 50));
+            } else {
+                rule += "|LPort=" + std::to_string(port);
+                if (pick(4) == 0) rule += "|LPort=" + std::to_string(port + 1);
+            }
+
+            if (kind >= 1 && kind <= 7) {
+                rule += "|App=C:\\Program Files\\Vendor\\App" + std::to_string(pick(applications)) + "\\app.exe";
+            } else if (kind == 8) {
+                rule += "|App=%SystemRoot%\\system32\\svchost.exe|Svc=";
+                rule += Services[pick(sizeof(Services) / sizeof(Services[0]))];
+            }
+            if (pick(3) != 0) {
+                rule += "|RA4=10." + std::to_string(range(0, 255)) + ".0.0/16";
+            } else if (pick(4) == 0) {
+                rule += "|RA4=LocalSubnet";
+            }
+            rule += "|Name=Rule " + std::to_string(i) + "|";
+        }
+
+        csv += "\"{" + std::to_string(i) + "}\",\"" + rule + "\"\r\n";
+        previous = rule;
+    }
+
+    return csv;
+}
+
+std::string SyntheticProbeData::toUtf16LE(const std::string& text) {
+    std::string out;
+    out.reserve(2 + text.size() * 2);
+    out += '\xFF';
+    out += '\xFE';
+    for (char c : text) {
+        out += c;
+        out += '\0';
+    }
+    return out;
+}
+
+std::string SyntheticProbeData::securityBaselineCsv(size_t controlCount) {
+    std::string csv =
+        "Id,Title,Severity,Path,Value,Comparator,Expected,Default\r\n"
+        "ACCT-01,Enforce password history,Medium,SecurityPolicy\\System Access,PasswordHistorySize,>=,24,\r\n"
+        "ACCT-02,Maximum password age,Medium,SecurityPolicy\\System Access,MaximumPasswordAge,between,1..365,\r\n"
+        "ACCT-04,Minimum password length,High,SecurityPolicy\\System Access,MinimumPasswordLength,>=,14,\r\n"
+        "ACCT-05,Password complexity,High,SecurityPolicy\\System Access,PasswordComplexity,=,1,\r\n"
+        "ACCT-08,Account lockout threshold,High,SecurityPolicy\\System Access,LockoutBadCount,between,1..5,\r\n"
+        "ACCT-12,Rename administrator account,Low,SecurityPolicy\\System Access,NewAdministratorName,!=,Administrator,\r\n"
+        "RIGHTS-02,Act as part of the operating system,Critical,SecurityPolicy\\Privilege Rights,SeTcbPrivilege,missing,,\r\n"
+        "FW-05,Public profile: firewall state,High,HKLM\\Software\\Policies\\Microsoft\\WindowsFirewall\\PublicProfile,EnableFirewall,=,1,\r\n"
+        "LSA-03,LAN Manager authentication level,High,HKLM\\System\\CurrentControlSet\\Control\\Lsa,LmCompatibilityLevel,>=,5,3\r\n";
+
+    const char* const severities[] = { "Low", "Medium", "High", "Critical" };
+    for (size_t i = 0; i < controlCount; ++i) {
+        std::string id = "APP-" + std::to_string(i);
+        std::string severity = severities[pick(4)];
+        if (i % 10 == 0) {
+            // Custom user rights hold Administrators, one user SID and a service account
+            csv += id + ",Custom right " + std::to_string(i) + "," + severity + ",SecurityPolicy\\Privilege Rights,SeCustomRight" +
+                   std::to_string(i % 200) + ",subset," + (i % 20 == 0 ? "*S-1-5-32-544" : "*S-1-5-32-544|*S-1-5-21-1004336348-1177238915-682003330-" +
+                   std::to_string(1000 + i % 200) + "|CONTOSO\\svc" + std::to_string(i % 200)) + ",\r\n";
+            continue;
+        }
+
+        std::string path = "HKLM\\Software\\Policies\\Contoso\\App" + std::to_string(i % 97);
+        std::string value = "Setting" + std::to_string(i);
+        std::string rule;
+        switch (i % 7) {
+            case 0: rule = "=,1,"; break;
+            case 1: rule = "<=,2,0"; break;
+            case 2: rule = ">=,1,"; break;
+            case 3: rule = "between,1..2,"; break;
+            case 4: rule = "oneof,0|1,"; break;
+            case 5: rule = i % 5 == 0 ? "contains,Contoso," : "exists,,"; break;
+            default: rule = "!=,3,"; break;
+        }
+        csv += id + ",Application setting " + std::to_string(i) + "," + severity + "," + path + "," + value + "," + rule + "\r\n";
+    }
+    return csv;
+}
+
+std::string SyntheticProbeData::policyRules(size_t ruleCount) {
+    std::string rules =
+        "rule PWD-01 \"Password policy\"\n"
+        "    let length = [SecurityPolicy\\System Access\\MinimumPasswordLength] ?? 0\n"
+        "    let history = [SecurityPolicy\\System Access\\PasswordHistorySize] ?? 0\n"
+        "    score = if(length >= 8, 50, if(length >= 6, 30, 0)) + if(history >= 12, 50, if(history > 0, 30, 0))\n"
+        "    raise High when length < 6 and history <= 0\n"
+        "end\n"
+        "rule FW-01 \"Firewall profiles\"\n"
+        "    let enabled = count([HKLM\\Software\\Policies\\Microsoft\\WindowsFirewall\\DomainProfile\\EnableFirewall] == 1, "
+        "[HKLM\\Software\\Policies\\Microsoft\\WindowsFirewall\\PrivateProfile\\EnableFirewall] == 1, "
+        "[HKLM\\Software\\Policies\\Microsoft\\WindowsFirewall\\PublicProfile\\EnableFirewall] == 1)\n"
+        "    score = if(enabled == 3, 100, if(enabled == 2, 67, if(enabled == 1, 33, 0)))\n"
+        "    band 100 Pass Low\n"
+        "    band 67 Warning Medium\n"
+        "    band 0 Fail Critical \"Enable the firewall.\"\n"
+        "end\n";
+
+    for (size_t i = 0; i < ruleCount; ++i) {
+        // Facts of the application policy values, some of them never set
+        auto fact = [&](size_t offset) {
+            size_t setting = (i * 7 + offset * 13) % (ruleCount + ruleCount / 4 + 1);
+            return "[HKLM\\Software\\Policies\\Contoso\\App" + std::to_string(setting % 97) + "\\Setting" + std::to_string(setting) + "]";
+        };
+        rules += "rule APP-" + std::to_string(i) + " \"Application rule " + std::to_string(i) + "\"\n";
+        switch (i % 5) {
+            case 0:
+                rules += "    score -= 10 * count(" + fact(0) + " == 0, " + fact(1) + " >= 2, " + fact(2) + " != 1, " + fact(3) + " > 2)\n";
+                break;
+            case 1:
+                rules += "    let level = " + fact(0) + " ?? 1\n"
+                         "    score = if(level == 1, 100, if(level == 2, 75, 40))\n"
+                         "    raise Critical when level >= 3 and exists " + fact(1) + "\n";
+                break;
+            case 2:
+                rules += "    score = 0 when " + fact(0) + " contains \"Contoso\" or " + fact(1) + " == \"PuTTY\"\n"
+                         "    score -= min(((" + fact(2) + " ?? 0) + (" + fact(3) + " ?? 0)) * 15, 45)\n";
+                break;
+            case 3:
+                rules += "    let a = " + fact(0) + " ?? 0\n"
+                         "    let b = " + fact(1) + " ?? 0\n"
+                         "    score = 100 - max(a, b) * 20 - (a + b) * 5\n"
+                         "    score = 50 when not exists " + fact(2) + "\n";
+                break;
+            default:
+                rules += "    score -= 30 when " + fact(0) + " >= 1 and " + fact(1) + " <= 2\n"
+                         "    score -= 25 when not (" + fact(2) + " == 1 or " + fact(3) + " == 2)\n"
+                         "    band 90 Pass Low\n"
+                         "    band 60 Warning Medium \"Review the application settings.\"\n"
+                         "    band 0 Fail High \"Reset the application policy.\"\n";
+                break;
+        }
+        rules += "end\n";
+    }
+    return rules;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Generates realistic probe outputs at fleet scale for the parser benchmarks.
+// Output is deterministic for a given seed so runs are comparable.
+class SyntheticProbeData {
+public:
+    explicit SyntheticProbeData(uint32_t seed = 20240501) : rng(seed) {}
+
+    // Uninstall keys piped through Export-Csv (DisplayName, DisplayVersion, Publisher, InstallDate)
+    std::string uninstallCsv(size_t count);
+
+    // Get-SmbShare (Name, Path, Description, ShareType, SecurityDescriptor)
+    // with the shared folder's Get-Acl SDDL (PathSddl); ACLs come from a
+    // pool of a few hundred department groups
+    std::string smbShareCsv(size_t count);
+
+    // Self-relative binary security descriptors (LanmanServer\Shares\Security)
+    std::vector<std::string> binarySecurityDescriptors(size_t count);
+
+    // Get-LocalUser (Name, SID, Enabled, PasswordNeverExpires, PasswordRequired, LastLogon)
+    std::string localUserCsv(size_t count);
+
+    // Members of every group (Group, GroupSID, Name, SID, ObjectClass) for a
+    // terminal server with nested domain groups: a tree of department groups
+    // under Remote Desktop Users and a cyclic tier-0 pair inside Domain Admins
+    std::string groupMemberCsv(size_t userCount, size_t groupCount);
+
+    // Get-BitLockerVolume | Format-List
+    std::string bitLockerVolumes(size_t count);
+
+    // Get-NetFirewallProfile | Format-List
+    std::string firewallProfiles();
+
+    // auditpol /get /category:*
+    std::string auditPolicy();
+
+    // secedit /export INF with the given number of [Privilege Rights] entries
+    std::string seceditInf(size_t privilegeCount);
+
+    // net accounts
+    std::string netAccounts();
+
+    // SYSTEM hive image (regf) with Select\Current, ControlSet001\Control\Lsa
+    // and the given number of service keys under ControlSet001\Services
+    std::string systemHive(size_t serviceCount);
+
+    // SAM hive image (regf) with the given number of local users (F/V
+    // values) and the builtin Administrators / Remote Desktop Users aliases
+    std::string samHive(size_t userCount);
+
+    // SOFTWARE hive image (regf) with Run / RunOnce autoruns (some in user
+    // profiles), Winlogon Shell / Userinit and Image File Execution Options
+    // subkeys, a few of them with a Debugger
+    std::string softwareHive(size_t autorunCount);
+
+    // Task Scheduler definitions as stored under System32\Tasks (UTF-16LE
+    // XML): (relative path, file bytes) for built-in maintenance tasks and
+    // vendor tasks, some running as SYSTEM from user-writable directories
+    std::vector<std::pair<std::string, std::string>> scheduledTasks(size_t count);
+
+    // Program directory tree: (relative path, contents) of the given number
+    // of executables and DLLs, mostly small with a few multi-megabyte files,
+    // plus non-binary files the integrity scan skips
+    std::vector<std::pair<std::string, std::string>> programFiles(size_t count);
+
+    // Registry.pol (PReg) machine policy with Windows Update, firewall and
+    // Lsa settings plus the given number of application policy values
+    std::string registryPol(size_t settingCount);
+
+    // Exported Security log (.evtx) with logon, failed logon, process
+    // creation, special privilege and lockout events
+    std::string securityEvtx(size_t eventCount);
+
+    // Vulnerable-version database CSV: ranges for the products in
+    // uninstallCsv() plus the given number of other ranges
+    std::string vulnerabilityCsv(size_t count);
+
+    // Update catalog CSV for a few OS builds: monthly cumulative updates
+    // superseding the previous month plus standalone updates
+    std::string updateCatalogCsv(size_t count);
+
+    // Get-HotFix export of a host a few cumulative updates behind
+    std::string hotfixCsv(size_t standaloneCount);
+
+    // Exported firewall rules (Name, Rule) of a server: application,
+    // service, port and block rules with some duplicates and open ports
+    std::string firewallRulesCsv(size_t count);
+
+    // Benchmark definition CSV: account policy and user-rights controls
+    // over seceditInf() plus registry controls over the application
+    // policy values of registryPol(), with every comparator
+    std::string securityBaselineCsv(size_t controlCount);
+
+    // Policy rule pack over the same settings as securityBaselineCsv():
+    // ladders, penalties, text tests, locals and raised severities
+    std::string policyRules(size_t ruleCount);
+
+    // Encode ASCII text as Export-Csv -Encoding Unicode would (BOM + UTF-16LE)
+    static std::string toUtf16LE(const std::string& text);
+
+private:
+    std::mt19937 rng;
+
+    size_t pick(size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(rng); }
+    int range(int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); }
+};
@@ -0,0 +1,429 @@
+#include "AccountDirectory.h"
+#include "BinaryRead.h"
+#include "CsvReader.h"
+#include "RegistryHive.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+using BinaryRead::formatSid;
+using BinaryRead::readU16;
+using BinaryRead::readU32;
+using BinaryRead::readU64;
+using TextUtil::equalsIgnoreCase;
+using TextUtil::toLower;
+
+// "CONTOSO\jdoe" -> "jdoe"
+std::string_view shortName(std::string_view name) {
+    size_t slash = name.rfind('\\');
+    return slash == std::string_view::npos ? name : name.substr(slash + 1);
+}
+
+struct PrivilegedSid {
+    const char* suffix;         // builtin SID, or "-RID" of a domain SID
+    const char* name;
+};
+
+// Indexed by PrivilegedGroup
+const PrivilegedSid PrivilegedSids[] = {
+    { "S-1-5-32-544", "Administrators" },
+    { "S-1-5-32-548", "Account Operators" },
+    { "S-1-5-32-549", "Server Operators" },
+    { "S-1-5-32-550", "Print Operators" },
+    { "S-1-5-32-551", "Backup Operators" },
+    { "S-1-5-32-555", "Remote Desktop Users" },
+    { "S-1-5-32-578", "Hyper-V Administrators" },
+    { "S-1-5-32-580", "Remote Management Users" },
+    { "-512", "Domain Admins" },
+    { "-518", "Schema Admins" },
+    { "-519", "Enterprise Admins" }
+};
+
+// UTF-16LE string at (offset, length) after a SAM record header
+bool readSamString(std::string_view data, size_t base, uint32_t offset, uint32_t length, std::string& text) {
+    size_t start = base + offset;
+    if (start > data.size() || length > data.size() - start) return false;
+    text = TextEncoding::utf16LEToUtf8(data.data() + start, length);
+    return true;
+}
+
+// Account key names are the RID in hex ("000001F4")
+bool parseRidKey(std::string_view name, uint32_t& rid) {
+    if (name.empty() || name.size() > 8) return false;
+    rid = 0;
+    for (char c : name) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        uint32_t digit;
+        if (c >= '0' && c <= '9') digit = static_cast<uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') digit = static_cast<uint32_t>(c - 'a' + 10);
+        else return false;
+        rid = (rid << 4) | digit;
+    }
+    return true;
+}
+
+bool parseUInt64(std::string_view text, uint64_t& value) {
+    if (text.empty()) return false;
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
+
+PrincipalKind parseKind(std::string_view objectClass, PrincipalKind fallback) {
+    if (equalsIgnoreCase(objectClass, "User")) return PrincipalKind::User;
+    if (equalsIgnoreCase(objectClass, "Group")) return PrincipalKind::Group;
+    return fallback;
+}
+
+// SAM user F value fields
+const size_t SamLastLogon = 0x08;
+const size_t SamAccountControl = 0x38;
+const uint16_t AcbDisabled = 0x0001;
+const uint16_t AcbPasswordNotRequired = 0x0004;
+const uint16_t AcbDontExpirePassword = 0x0200;
+const uint16_t AcbAutoLocked = 0x0400;
+
+// SAM user V and alias C values: string table entries are relative to the end of the header
+const size_t SamUserHeader = 0xCC;
+const size_t SamAliasHeader = 0x34;
+
+} // namespace
+
+uint32_t Principal::rid() const {
+    size_t dash = sid.rfind('-');
+    uint64_t value;
+    if (dash == std::string::npos || !parseUInt64(std::string_view(sid).substr(dash + 1), value) || value > 0xFFFFFFFFu) {
+        return 0;
+    }
+    return static_cast<uint32_t>(value);
+}
+
+const char* AccountDirectory::privilegedGroupName(PrivilegedGroup group) {
+    return PrivilegedSids[static_cast<size_t>(group)].name;
+}
+
+void AccountDirectory::clear() {
+    principals.clear();
+    sidIndex.clear();
+    nameIndex.clear();
+    edges.clear();
+    memberOfStart.clear();
+    memberOf.clear();
+    closure.clear();
+}
+
+uint32_t AccountDirectory::findSid(std::string_view sid) const {
+    auto it = sidIndex.find(std::string(sid));
+    return it == sidIndex.end() ? NoPrincipal : it->second;
+}
+
+uint32_t AccountDirectory::findName(std::string_view name) const {
+    auto it = nameIndex.find(toLower(name));
+    if (it == nameIndex.end()) it = nameIndex.find(toLower(shortName(name)));
+    return it == nameIndex.end() ? NoPrincipal : it->second;
+}
+
+uint32_t AccountDirectory::add(std::string_view name, std::string_view sid, PrincipalKind kind) {
+    uint32_t id = sid.empty() ? findName(name) : findSid(sid);
+    if (id == NoPrincipal) {
+        id = static_cast<uint32_t>(principals.size());
+        Principal principal;
+        principal.name = std::string(name);
+        principal.sid = std::string(sid);
+        principal.kind = kind;
+
+        // Unresolved SIDs of well-known groups (Domain Admins, ...) are still groups
+        if (kind == PrincipalKind::Unknown && name == sid) {
+            uint32_t privilege = directPrivilege(principal);
+            for (size_t i = 0; privilege != 0 && i < static_cast<size_t>(PrivilegedGroup::Count); ++i) {
+                if (privilege == (1u << i)) {
+                    principal.kind = PrincipalKind::Group;
+                    principal.name = PrivilegedSids[i].name;
+                }
+            }
+        }
+        principals.push_back(std::move(principal));
+        if (!sid.empty()) sidIndex.emplace(std::string(sid), id);
+
+        // Index both "HOST\name" and "name"; the first principal keeps a name
+        std::string_view indexed = principals[id].name;
+        nameIndex.emplace(toLower(indexed), id);
+        if (shortName(indexed).size() != indexed.size()) nameIndex.emplace(toLower(shortName(indexed)), id);
+        return id;
+    }
+
+    // A later source may know more about a member seen only as a SID
+    Principal& existing = principals[id];
+    if (existing.kind == PrincipalKind::Unknown) existing.kind = kind;
+    if ((existing.name.empty() || existing.name == existing.sid) && !name.empty() && name != sid) {
+        existing.name = std::string(name);
+        nameIndex.emplace(toLower(name), id);
+    }
+    return id;
+}
+
+void AccountDirectory::addMembership(uint32_t member, uint32_t group) {
+    if (member == group) return;
+    edges.emplace_back(member, group);
+}
+
+bool AccountDirectory::loadFromSam(const RegistryHive& sam) {
+    RegistryHive::Key account = sam.findKey("SAM\\Domains\\Account");
+    if (!account) return false;
+
+    std::string scratch;
+    std::string text;
+
+    // The machine SID is the last 12 bytes of the Account V value
+    std::string machineSid;
+    if (RegistryHive::Value domain = sam.findValue(account, "V")) {
+        std::string_view data = sam.valueData(domain, scratch);
+        if (data.size() >= 12) {
+            const unsigned char* tail = reinterpret_cast<const unsigned char*>(data.data() + data.size() - 12);
+            machineSid = "S-1-5-21-" + std::to_string(readU32(tail)) + "-" + std::to_string(readU32(tail + 4)) +
+                         "-" + std::to_string(readU32(tail + 8));
+        }
+    }
+
+    if (RegistryHive::Key users = sam.findSubkey(account, "Users")) {
+        sam.forEachSubkey(users, [&](RegistryHive::Key key) {
+            uint32_t rid;
+            if (!parseRidKey(sam.keyName(key), rid)) return true;     // "Names"
+
+            std::string name;
+            RegistryHive::Value v = sam.findValue(key, "V");
+            std::string_view record = v ? sam.valueData(v, scratch) : std::string_view();
+            if (record.size() >= SamUserHeader) {
+                const unsigned char* header = reinterpret_cast<const unsigned char*>(record.data());
+                readSamString(record, SamUserHeader, readU32(header + 0x0C), readU32(header + 0x10), name);
+            }
+            if (name.empty()) name = std::to_string(rid);
+
+            uint32_t id = add(name, machineSid.empty() ? std::string() : machineSid + "-" + std::to_string(rid),
+                              PrincipalKind::User);
+            principals[id].flags |= AccountLocal;
+
+            RegistryHive::Value f = sam.findValue(key, "F");
+            std::string_view fixed = f ? sam.valueData(f, scratch) : std::string_view();
+            if (fixed.size() >= SamAccountControl + 2) {
+                const unsigned char* data = reinterpret_cast<const unsigned char*>(fixed.data());
+                uint16_t control = readU16(data + SamAccountControl);
+                Principal& principal = principals[id];
+                principal.lastLogon = readU64(data + SamLastLogon);
+                if (control & AcbDisabled) principal.flags |= AccountDisabled;
+                if (control & AcbPasswordNotRequired) principal.flags |= AccountPasswordNotRequired;
+                if (control & AcbDontExpirePassword) principal.flags |= AccountPasswordNeverExpires;
+                if (control & AcbAutoLocked) principal.flags |= AccountLocked;
+            }
+            return true;
+        });
+    }
+
+    // Builtin aliases (Administrators, ...) and machine-local groups
+    const std::pair<const char*, std::string> domains[] = {
+        { "SAM\\Domains\\Builtin\\Aliases", "S-1-5-32" },
+        { "SAM\\Domains\\Account\\Aliases", machineSid }
+    };
+    for (const auto& domain : domains) {
+        RegistryHive::Key aliases = sam.findKey(domain.first);
+        if (!aliases) continue;
+
+        sam.forEachSubkey(aliases, [&](RegistryHive::Key key) {
+            uint32_t rid;
+            if (!parseRidKey(sam.keyName(key), rid)) return true;
+            RegistryHive::Value c = sam.findValue(key, "C");
+            std::string_view record = c ? sam.valueData(c, scratch) : std::string_view();
+            if (record.size() < SamAliasHeader) return true;
+            const unsigned char* header = reinterpret_cast<const unsigned char*>(record.data());
+
+            std::string name;
+            readSamString(record, SamAliasHeader, readU32(header + 0x10), readU32(header + 0x14), name);
+            if (name.empty()) name = std::to_string(rid);
+            std::string sid = domain.second.empty() ? std::string() : domain.second + "-" + std::to_string(rid);
+            uint32_t group = add(name, sid, PrincipalKind::Group);
+
+            // Member SIDs are packed back to back
+            size_t offset = SamAliasHeader + readU32(header + 0x28);
+            uint32_t memberCount = readU32(header + 0x30);
+            for (uint32_t i = 0; i < memberCount && offset < record.size(); ++i) {
+                size_t length = formatSid(reinterpret_cast<const unsigned char*>(record.data() + offset),
+                                          record.size() - offset, text);
+                if (length == 0) break;
+                offset += length;
+                addMembership(add(text, text, PrincipalKind::Unknown), group);
+            }
+            return true;
+        });
+    }
+
+    build();
+    return !principals.empty();
+}
+
+bool AccountDirectory::loadFromCsv(const CsvReader& table, const CsvReader& memberships) {
+    int nameColumn = table.columnIndex("Name");
+    int sidColumn = table.columnIndex("SID");
+    int classColumn = table.columnIndex("ObjectClass");
+    int enabledColumn = table.columnIndex("Enabled");
+    int neverExpiresColumn = table.columnIndex("PasswordNeverExpires");
+    int requiredColumn = table.columnIndex("PasswordRequired");
+    int lastLogonColumn = table.columnIndex("LastLogon");
+
+    // Every row can introduce a principal
+    size_t expected = principals.size() + table.rowCount() + memberships.rowCount();
+    principals.reserve(expected);
+    sidIndex.reserve(expected);
+    nameIndex.reserve(expected);
+    edges.reserve(edges.size() + memberships.rowCount());
+
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        std::string_view name = row[nameColumn];
+        std::string_view sid = row[sidColumn];
+        if (name.empty() && sid.empty()) continue;
+
+        uint32_t id = add(name.empty() ? sid : name, sid, parseKind(row[classColumn], PrincipalKind::User));
+        Principal& principal = principals[id];
+        principal.flags |= AccountLocal;
+        if (equalsIgnoreCase(row[enabledColumn], "False")) principal.flags |= AccountDisabled;
+        if (equalsIgnoreCase(row[neverExpiresColumn], "True")) principal.flags |= AccountPasswordNeverExpires;
+        if (equalsIgnoreCase(row[requiredColumn], "False")) principal.flags |= AccountPasswordNotRequired;
+        uint64_t lastLogon;
+        if (parseUInt64(row[lastLogonColumn], lastLogon)) principal.lastLogon = lastLogon;
+    }
+
+    int groupColumn = memberships.columnIndex("Group");
+    int groupSidColumn = memberships.columnIndex("GroupSID");
+    int memberColumn = memberships.columnIndex("Name");
+    int memberSidColumn = memberships.columnIndex("SID");
+    int memberClassColumn = memberships.columnIndex("ObjectClass");
+
+    for (size_t i = 0; i < memberships.rowCount(); ++i) {
+        CsvReader::Row row = memberships.row(i);
+        std::string_view groupName = row[groupColumn];
+        std::string_view groupSid = row[groupSidColumn];
+        std::string_view memberName = row[memberColumn];
+        std::string_view memberSid = row[memberSidColumn];
+        if ((groupName.empty() && groupSid.empty()) || (memberName.empty() && memberSid.empty())) continue;
+
+        uint32_t group = add(groupName.empty() ? groupSid : groupName, groupSid, PrincipalKind::Group);
+        uint32_t member = add(memberName.empty() ? memberSid : memberName, memberSid,
+                              parseKind(row[memberClassColumn], PrincipalKind::Unknown));
+        addMembership(member, group);
+    }
+
+    build();
+    return !principals.empty();
+}
+
+uint32_t AccountDirectory::directPrivilege(const Principal& principal) const {
+    if (principal.kind == PrincipalKind::User) return 0;
+
+    for (size_t i = 0; i < static_cast<size_t>(PrivilegedGroup::Count); ++i) {
+        const PrivilegedSid& entry = PrivilegedSids[i];
+        if (principal.sid.empty()) {
+            if (equalsIgnoreCase(shortName(principal.name), entry.name)) return 1u << i;
+            continue;
+        }
+        if (entry.suffix[0] == '-') {
+            // Domain RIDs only count under a domain (S-1-5-21-...) SID
+            std::string_view sid = principal.sid;
+            size_t length = std::strlen(entry.suffix);
+            if (sid.size() > length && sid.compare(0, 9, "S-1-5-21-") == 0 &&
+                sid.compare(sid.size() - length, length, entry.suffix) == 0) {
+                return 1u << i;
+            }
+        } else if (principal.sid == entry.suffix) {
+            return 1u << i;
+        }
+    }
+    return 0;
+}
+
+void AccountDirectory::build() {
+    // Deduplicate memberships and lay them out by member
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    memberOfStart.assign(principals.size() + 1, 0);
+    for (const auto& edge : edges) memberOfStart[edge.first + 1]++;
+    for (size_t i = 1; i < memberOfStart.size(); ++i) memberOfStart[i] += memberOfStart[i - 1];
+    memberOf.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) memberOf[i] = edges[i].second;
+
+    computeClosure();
+}
+
+void AccountDirectory::computeClosure() {
+    // Iterative Tarjan over member -> group edges. A component is finished
+    // only after every component it reaches, so its closure is its members'
+    // own privileges plus the closures of groups outside the component.
+    const uint32_t Unvisited = 0xFFFFFFFFu;
+    size_t count = principals.size();
+    closure.assign(count, 0);
+    std::vector<uint32_t> index(count, Unvisited);
+    std::vector<uint32_t> low(count, 0);
+    std::vector<uint8_t> onStack(count, 0);
+    std::vector<uint32_t> stack;
+    std::vector<std::pair<uint32_t, uint32_t>> frames;     // (node, next edge)
+    uint32_t nextIndex = 0;
+
+    for (uint32_t root = 0; root < count; ++root) {
+        if (index[root] != Unvisited) continue;
+        frames.emplace_back(root, memberOfStart[root]);
+        index[root] = low[root] = nextIndex++;
+        stack.push_back(root);
+        onStack[root] = 1;
+
+        while (!frames.empty()) {
+            uint32_t node = frames.back().first;
+            uint32_t& edge = frames.back().second;
+            if (edge < memberOfStart[node + 1]) {
+                uint32_t group = memberOf[edge++];
+                if (index[group] == Unvisited) {
+                    index[group] = low[group] = nextIndex++;
+                    stack.push_back(group);
+                    onStack[group] = 1;
+                    frames.emplace_back(group, memberOfStart[group]);
+                } else if (onStack[group]) {
+                    low[node] = std::min(low[node], index[group]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            if (!frames.empty()) {
+                uint32_t parent = frames.back().first;
+                low[parent] = std::min(low[parent], low[node]);
+            }
+            if (low[node] != index[node]) continue;
+
+            // Pop the component rooted at node
+            size_t begin = stack.size();
+            do {
+                --begin;
+            } while (stack[begin] != node);
+
+            uint32_t mask = 0;
+            for (size_t i = begin; i < stack.size(); ++i) {
+                uint32_t member = stack[i];
+                mask |= directPrivilege(principals[member]);
+                for (uint32_t e = memberOfStart[member]; e < memberOfStart[member + 1]; ++e) {
+                    if (!onStack[memberOf[e]]) mask |= closure[memberOf[e]];
+                }
+            }
+            for (size_t i = begin; i < stack.size(); ++i) {
+                closure[stack[i]] = mask;
+                onStack[stack[i]] = 0;
+            }
+            stack.resize(begin);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CsvReader;
+class RegistryHive;
+
+enum class PrincipalKind : uint8_t {
+    User,
+    Group,
+    Unknown     // member SID that is not defined locally (domain account, orphaned SID)
+};
+
+// Account flag bits of Principal::flags
+const uint32_t AccountDisabled = 0x01;
+const uint32_t AccountPasswordNeverExpires = 0x02;
+const uint32_t AccountPasswordNotRequired = 0x04;
+const uint32_t AccountLocked = 0x08;
+const uint32_t AccountLocal = 0x10;          // defined on this machine, not only seen as a group member
+
+// Privileged groups tracked by the membership closure, one bit each
+enum class PrivilegedGroup : uint8_t {
+    Administrators,         // S-1-5-32-544
+    AccountOperators,       // S-1-5-32-548
+    ServerOperators,        // S-1-5-32-549
+    PrintOperators,         // S-1-5-32-550
+    BackupOperators,        // S-1-5-32-551
+    RemoteDesktopUsers,     // S-1-5-32-555
+    HyperVAdministrators,   // S-1-5-32-578
+    RemoteManagementUsers,  // S-1-5-32-580
+    DomainAdmins,           // <domain>-512
+    SchemaAdmins,           // <domain>-518
+    EnterpriseAdmins,       // <domain>-519
+    Count
+};
+
+inline uint32_t privilegedBit(PrivilegedGroup group) { return 1u << static_cast<uint32_t>(group); }
+
+// Groups that grant administrative control of the machine or domain
+const uint32_t AdministrativeGroups =
+    (1u << static_cast<uint32_t>(PrivilegedGroup::Administrators)) |
+    (1u << static_cast<uint32_t>(PrivilegedGroup::DomainAdmins)) |
+    (1u << static_cast<uint32_t>(PrivilegedGroup::SchemaAdmins)) |
+    (1u << static_cast<uint32_t>(PrivilegedGroup::EnterpriseAdmins));
+
+// One user, group or unresolved member SID
+struct Principal {
+    std::string name;
+    std::string sid;            // "S-1-5-21-...-1001", empty if the source has no SIDs
+    PrincipalKind kind = PrincipalKind::Unknown;
+    uint32_t flags = 0;         // Account* bits
+    uint64_t lastLogon = 0;     // FILETIME, 0 = never / unknown
+
+    uint32_t rid() const;       // last SID component, 0 if there is no SID
+};
+
+// Accounts, groups and group memberships indexed by id. Memberships are
+// stored as a compact adjacency array (CSR) from each principal to the
+// groups it belongs to, and the privileged groups a principal reaches
+// through nested membership are computed once per strongly connected
+// component, so membership cycles and deep nesting cost one pass over
+// the edges even for domain exports with tens of thousands of principals.
+class AccountDirectory {
+public:
+    // SAM hive: users (F/V values) and the local and builtin aliases (C values)
+    bool loadFromSam(const RegistryHive& sam);
+
+    // Structured exports. principals: Name, SID, ObjectClass, Enabled,
+    // PasswordNeverExpires, PasswordRequired, LastLogon (FILETIME);
+    // memberships: Group, GroupSID, Name, SID, ObjectClass. Missing SID
+    // columns fall back to matching by name.
+    bool loadFromCsv(const CsvReader& principals, const CsvReader& memberships);
+
+    // Principal id for a SID (or name when sid is empty), created on first use
+    uint32_t add(std::string_view name, std::string_view sid, PrincipalKind kind);
+    void addMembership(uint32_t member, uint32_t group);
+
+    // Build the membership index and privileged closure; call after the last add
+    void build();
+
+    void clear();
+    size_t size() const { return principals.size(); }
+    size_t membershipCount() const { return edges.size(); }
+    const Principal& principal(uint32_t id) const { return principals[id]; }
+    Principal& principal(uint32_t id) { return principals[id]; }
+
+    // Id by SID or case-insensitive name, NoPrincipal if unknown
+    uint32_t findSid(std::string_view sid) const;
+    uint32_t findName(std::string_view name) const;
+
+    // PrivilegedGroup bits the principal holds directly or through nesting
+    uint32_t privilegedGroups(uint32_t id) const { return closure[id]; }
+
+    // PrivilegedGroup bit of the group itself, 0 for other principals
+    uint32_t ownPrivilege(uint32_t id) const { return directPrivilege(principals[id]); }
+
+    // Groups the principal is a direct member of: fn(groupId)
+    template <typename Fn>
+    void forEachGroup(uint32_t id, Fn&& fn) const {
+        for (uint32_t i = memberOfStart[id]; i < memberOfStart[id + 1]; ++i) fn(memberOf[i]);
+    }
+
+    static const char* privilegedGroupName(PrivilegedGroup group);
+
+    static const uint32_t NoPrincipal = 0xFFFFFFFFu;
+
+private:
+    std::vector<Principal> principals;
+    std::unordered_map<std::string, uint32_t> sidIndex;
+    std::unordered_map<std::string, uint32_t> nameIndex;    // lower-case name
+    std::vector<std::pair<uint32_t, uint32_t>> edges;       // (member, group)
+
+    std::vector<uint32_t> memberOfStart;    // CSR offsets, size() + 1 entries
+    std::vector<uint32_t> memberOf;
+    std::vector<uint32_t> closure;
+
+    uint32_t directPrivilege(const Principal& principal) const;
+    void computeClosure();
+};
@@ -1,5 +1,5 @@
 #include "AntivirusCheck.h"
-#include <sstream>
+#include "PolicyTables.h"
 #include <windows.h>
 #include <wbemidl.h>
 #include <comdef.h>
@@ -11,8 +11,6 @@ ComplianceResult AntivirusCheck::performCheck() {
                            "Detects if an antivirus or endpoint protection software is active and updated.",
                            CheckStatus::Pass, Severity::Low, 100);
     
-    result.details.push_back("Checking antivirus status...");
-    
     bool antivirusFound = false;
     bool antivirusEnabled = false;
     bool antivirusUpdated = false;
@@ -91,39 +89,21 @@ ComplianceResult AntivirusCheck::performCheck() {
     if (pLoc) pLoc->Release();
     CoUninitialize();
     
-    std::stringstream details;
     if (antivirusFound) {
-        details << "Antivirus Product: " << antivirusName << "\n";
-        details << "Status: " << (antivirusEnabled ? "Enabled" : "Disabled") << "\n";
-        details << "Up-to-date: " << (antivirusUpdated ? "Yes" : "No");
+        result.findings.text(FindingKey::AntivirusProduct, antivirusName);
+        result.findings.flag(FindingKey::AntivirusEnabled, antivirusEnabled);
+        result.findings.flag(FindingKey::AntivirusUpToDate, antivirusUpdated);
     } else {
-        details << "No antivirus product detected in Security Center.";
+        result.findings.message(FindingKey::AntivirusMissing);
     }
     
-    result.details.push_back(details.str());
-    
-    // Calculate score
-    if (antivirusFound && antivirusEnabled && antivirusUpdated) {
-        result.status = CheckStatus::Pass;
-        result.score = 100;
-        result.severity = Severity::Low;
-        result.recommendation = "Antivirus is installed, enabled, and up-to-date. System is compliant.";
-    } else if (antivirusFound && antivirusEnabled) {
-        result.status = CheckStatus::Warning;
-        result.score = 70;
-        result.severity = Severity::Medium;
-        result.recommendation = "Antivirus is installed and enabled but may not be up-to-date. Update your antivirus definitions.";
-    } else if (antivirusFound) {
-        result.status = CheckStatus::Fail;
-        result.score = 40;
-        result.severity = Severity::High;
-        result.recommendation = "Antivirus is installed but disabled. Enable your antivirus software immediately.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.score = 0;
-        result.severity = Severity::Critical;
-        result.recommendation = "No antivirus software detected. Install and enable antivirus protection immediately.";
-    }
+    // Calculate score: each stage counts only once the one before it holds
+    size_t stages = !antivirusFound ? 0 : !antivirusEnabled ? 1 : !antivirusUpdated ? 2 : 3;
+    int score = PolicyTables::ladderScore<AntivirusStageScores>(stages);
+    if (stages == 2) result.attribution.add("Antivirus definitions", 100 - score);
+    else if (stages == 1) result.attribution.add("Antivirus enabled", 100 - score);
+    else if (stages == 0) result.attribution.add("Antivirus product", 100 - score);
+    PolicyTables::applyScore<AntivirusStatusPolicy>(result, score);
     
     return result;
 }
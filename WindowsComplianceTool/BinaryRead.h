@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Little-endian fields of the binary formats the offline readers parse
+// (hive cells, event log chunks, SAM records, security descriptors).
+// memcpy keeps unaligned offsets defined; callers check bounds first.
+namespace BinaryRead {
+
+inline uint16_t readU16(const unsigned char* p) {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t readU32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t readU64(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Binary SID to "S-1-5-21-..." text; returns its length in bytes, 0 if it
+// does not fit in size or is not a revision 1 SID
+inline size_t formatSid(const unsigned char* data, size_t size, std::string& text) {
+    if (size < 8) return 0;
+    uint8_t subCount = data[1];
+    size_t length = 8 + static_cast<size_t>(subCount) * 4;
+    if (data[0] != 1 || size < length) return 0;
+
+    uint64_t authority = 0;
+    for (int i = 2; i < 8; ++i) authority = (authority << 8) | data[i];
+
+    text = "S-" + std::to_string(data[0]) + "-" + std::to_string(authority);
+    for (uint8_t i = 0; i < subCount; ++i) {
+        text += '-';
+        text += std::to_string(readU32(data + 8 + i * 4));
+    }
+    return length;
+}
+
+} // namespace BinaryRead
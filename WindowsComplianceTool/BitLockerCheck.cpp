@@ -1,17 +1,17 @@
 #include "BitLockerCheck.h"
-#include <sstream>
+#include "PolicyTables.h"
 
 ComplianceResult BitLockerCheck::performCheck() {
+    // Check BitLocker status using PowerShell
+    std::string psCommand = "Get-BitLockerVolume | Select-Object MountPoint, VolumeType, EncryptionPercentage, VolumeStatus, ProtectionStatus | Format-List";
+    return evaluate(executePowerShell(psCommand));
+}
+
+ComplianceResult BitLockerCheck::evaluate(const std::string& output) {
     ComplianceResult result("Disk Encryption (BitLocker)",
                            "Verifies encryption status for system drives.",
                            CheckStatus::Pass, Severity::Low, 100);
     
-    result.details.push_back("Checking BitLocker encryption status...");
-    
-    // Check BitLocker status using PowerShell
-    std::string psCommand = "Get-BitLockerVolume | Select-Object MountPoint, VolumeType, EncryptionPercentage, VolumeStatus, ProtectionStatus | Format-List";
-    std::string output = executePowerShell(psCommand);
-    
     bool bitLockerAvailable = false;
     bool systemDriveEncrypted = false;
     bool allDrivesEncrypted = true;
@@ -71,44 +71,34 @@ ComplianceResult BitLockerCheck::performCheck() {
         }
     }
     
-    std::stringstream details;
     if (!bitLockerAvailable) {
-        details << "BitLocker is not available on this system.\n";
-        details << "BitLocker requires Windows Pro, Enterprise, or Education edition.";
+        result.findings.message(FindingKey::BitLockerUnavailable);
     } else {
-        details << "Total Drives Checked: " << totalDrives << "\n";
-        details << "Fully Encrypted Drives: " << encryptedDrives << "\n";
-        details << "System Drive (C:) Encrypted: " << (systemDriveEncrypted ? "Yes" : "No");
+        result.findings.number(FindingKey::DrivesChecked, totalDrives);
+        result.findings.number(FindingKey::EncryptedDrives, encryptedDrives);
+        result.findings.flag(FindingKey::SystemDriveEncrypted, systemDriveEncrypted);
     }
     
-    result.details.push_back(details.str());
-    
-    // Calculate score
-    int score = 0;
-    
     if (!bitLockerAvailable) {
-        score = 0;
+        result.score = 0;
         result.status = CheckStatus::NotApplicable;
         result.severity = Severity::Medium;
         result.recommendation = "BitLocker is not available on this Windows edition. Consider upgrading to Windows Pro/Enterprise/Education or using third-party encryption software.";
-    } else if (systemDriveEncrypted && allDrivesEncrypted) {
-        score = 100;
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "All drives are encrypted with BitLocker. System is compliant.";
-    } else if (systemDriveEncrypted) {
-        score = 70;
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "System drive is encrypted but other drives are not. Enable BitLocker on all drives for complete protection.";
-    } else {
-        score = 20;
-        result.status = CheckStatus::Fail;
-        result.severity = Severity::High;
-        result.recommendation = "System drive is not encrypted. Enable BitLocker encryption immediately to protect sensitive data.";
+        return result;
     }
     
-    result.score = score;
+    // Calculate score
+    size_t encrypted = !systemDriveEncrypted ? 0 : !allDrivesEncrypted ? 1 : 2;
+    int score = PolicyTables::ladderScore<BitLockerScores>(encrypted);
+    if (encrypted == 1) result.attribution.add("Data drive encryption", 100 - score);
+    else if (encrypted == 0) result.attribution.add("System drive encryption", 100 - score);
+    
+    const char* advice[] = {
+        "All drives are encrypted with BitLocker. System is compliant.",
+        "System drive is encrypted but other drives are not. Enable BitLocker on all drives for complete protection.",
+        "System drive is not encrypted. Enable BitLocker encryption immediately to protect sensitive data."
+    };
+    result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score)];
     
     return result;
 }
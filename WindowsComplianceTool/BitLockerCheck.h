@@ -5,5 +5,7 @@ class BitLockerCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "Disk Encryption (BitLocker)"; }
+    
+    // Score Get-BitLockerVolume Format-List output (no system access)
+    static ComplianceResult evaluate(const std::string& volumeOutput);
 };
-
@@ -1,10 +1,19 @@
 #include "ComplianceCheck.h"
-#include <windows.h>
-#include <comdef.h>
-#include <Wbemidl.h>
+#include "CsvReader.h"
+#include "FactTable.h"
+#include "RegistryProvider.h"
+#include "SecurityLogExport.h"
+#include "SecurityPolicy.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <filesystem>
+#include <atomic>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <comdef.h>
+#include <Wbemidl.h>
 
 #pragma comment(lib, "wbemuuid.lib")
 
@@ -62,7 +71,85 @@ std::string ComplianceCheck::executePowerShell(const std::string& command) {
     return result;
 }
 
+std::string ComplianceCheck::dataFilePath(const char* fileName) {
+    std::wstring module(MAX_PATH, L'\0');
+    DWORD length;
+    while ((length = GetModuleFileNameW(nullptr, &module[0], static_cast<DWORD>(module.size()))) == module.size()) {
+        module.resize(module.size() * 2);
+    }
+    if (length == 0) return fileName;
+    module.resize(length);
+
+    // Paths are passed on as ANSI strings; a directory the code page cannot
+    // spell falls back to the working directory
+    std::wstring path = (std::filesystem::path(module).parent_path() / fileName).native();
+    BOOL lossy = FALSE;
+    int size = WideCharToMultiByte(CP_ACP, WC_NO_BEST_FIT_CHARS, path.c_str(), -1, nullptr, 0, nullptr, &lossy);
+    if (size <= 1 || lossy) return fileName;
+    std::string result(size - 1, '\0');
+    WideCharToMultiByte(CP_ACP, WC_NO_BEST_FIT_CHARS, path.c_str(), -1, &result[0], size, nullptr, nullptr);
+    return result;
+}
+#else
+// Live probes need Windows; offline builds (benchmarks, snapshot tools) see no output
+std::string ComplianceCheck::executePowerShell(const std::string& command) {
+    (void)command;
+    return "";
+}
+
+std::string ComplianceCheck::dataFilePath(const char* fileName) {
+    std::error_code ec;
+    std::filesystem::path executable = std::filesystem::read_symlink("/proc/self/exe", ec);
+    if (ec || executable.empty()) return fileName;
+    return (executable.parent_path() / fileName).string();
+}
+#endif
+
+std::string ComplianceCheck::tempProbePath(const char* stem, const char* extension) {
+    static std::atomic<unsigned int> probeCounter{ 0 };
+
+#ifdef _WIN32
+    unsigned long processId = GetCurrentProcessId();
+#else
+    unsigned long processId = 0;
+#endif
+
+    std::string fileName = std::string("wct_") + stem + "_" + std::to_string(processId) + "_" +
+        std::to_string(probeCounter++) + extension;
+    return (std::filesystem::temp_directory_path() / fileName).string();
+}
+
+std::shared_ptr<SecurityLogExport> ComplianceCheck::exportSecurityLog() {
+    std::shared_ptr<SecurityLogExport> log = securityLog ? securityLog : std::make_shared<SecurityLogExport>();
+    if (log->path().empty()) {
+        std::string evtxPath = tempProbePath("security", ".evtx");
+        executePowerShell("wevtutil epl Security '" + evtxPath + "' '/q:*[System[TimeCreated[timediff(@SystemTime) <= 604800000]]]' /ow:true");
+        log->setPath(evtxPath);
+    }
+    return log;
+}
+
+// Large inventories are written to a UTF-16 CSV file instead of being
+// formatted as console text, then parsed without per-field copies
+bool ComplianceCheck::executePowerShellCsv(const std::string& command, CsvReader& reader) {
+    std::string csvPath = tempProbePath("probe", ".csv");
+
+    executePowerShell(command + " | Export-Csv -Path '" + csvPath + "' -NoTypeInformation -Encoding Unicode");
+
+    bool loaded = reader.loadFromFile(csvPath);
+
+    std::error_code ec;
+    std::filesystem::remove(csvPath, ec);
+
+    return loaded;
+}
+
+#ifdef _WIN32
 std::string ComplianceCheck::readRegistryValue(const std::string& keyPath, const std::string& valueName) {
+    if (registryProvider) {
+        return registryProvider->readValue(keyPath, valueName);
+    }
+
     HKEY hKey;
     std::string result;
 
@@ -104,7 +191,62 @@ std::string ComplianceCheck::readRegistryValue(const std::string& keyPath, const
     return result;
 }
 
+bool ComplianceCheck::readRegistryValues(const std::string& keyPath, std::vector<std::pair<std::string, std::string>>& values) {
+    if (registryProvider) {
+        return registryProvider->readValues(keyPath, values);
+    }
+
+    size_t backslashPos = keyPath.find('\\');
+    if (backslashPos == std::string::npos) return false;
+
+    std::string rootKey = keyPath.substr(0, backslashPos);
+    std::string subKey = keyPath.substr(backslashPos + 1);
+
+    HKEY hRootKey = HKEY_LOCAL_MACHINE;
+    if (rootKey == "HKEY_CURRENT_USER") hRootKey = HKEY_CURRENT_USER;
+    else if (rootKey == "HKEY_CLASSES_ROOT") hRootKey = HKEY_CLASSES_ROOT;
+    else if (rootKey == "HKEY_USERS") hRootKey = HKEY_USERS;
+
+    HKEY hKey;
+    if (RegOpenKeyExA(hRootKey, subKey.c_str(), 0, KEY_READ, &hKey) != ERROR_SUCCESS) {
+        return false;
+    }
+
+    DWORD valueCount = 0, maxNameLength = 0, maxDataLength = 0;
+    RegQueryInfoKeyA(hKey, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                     &valueCount, &maxNameLength, &maxDataLength, nullptr, nullptr);
+
+    std::vector<char> name(maxNameLength + 1);
+    std::vector<BYTE> data(maxDataLength + 1);
+    values.reserve(values.size() + valueCount);
+    for (DWORD i = 0; i < valueCount; ++i) {
+        DWORD nameLength = static_cast<DWORD>(name.size());
+        DWORD dataLength = static_cast<DWORD>(data.size() - 1);
+        DWORD dwType = 0;
+        if (RegEnumValueA(hKey, i, name.data(), &nameLength, nullptr, &dwType, data.data(), &dataLength) != ERROR_SUCCESS) {
+            continue;
+        }
+
+        std::string value;
+        if (dwType == REG_SZ || dwType == REG_EXPAND_SZ) {
+            data[dataLength] = 0;
+            value = std::string(reinterpret_cast<const char*>(data.data()));
+        }
+        else if (dwType == REG_DWORD && dataLength >= sizeof(DWORD)) {
+            value = std::to_string(*reinterpret_cast<const DWORD*>(data.data()));
+        }
+        values.emplace_back(std::string(name.data(), nameLength), std::move(value));
+    }
+
+    RegCloseKey(hKey);
+    return true;
+}
+
 bool ComplianceCheck::registryValueExists(const std::string& keyPath, const std::string& valueName) {
+    if (registryProvider) {
+        return registryProvider->valueExists(keyPath, valueName);
+    }
+
     HKEY hKey;
 
     size_t backslashPos = keyPath.find('\\');
@@ -128,4 +270,49 @@ bool ComplianceCheck::registryValueExists(const std::string& keyPath, const std:
     }
 
     return false;
-}
\ No newline at end of file
+}
+#else
+std::string ComplianceCheck::readRegistryValue(const std::string& keyPath, const std::string& valueName) {
+    if (registryProvider) {
+        return registryProvider->readValue(keyPath, valueName);
+    }
+    return "";
+}
+
+bool ComplianceCheck::readRegistryValues(const std::string& keyPath, std::vector<std::pair<std::string, std::string>>& values) {
+    if (registryProvider) {
+        return registryProvider->readValues(keyPath, values);
+    }
+    return false;
+}
+
+bool ComplianceCheck::registryValueExists(const std::string& keyPath, const std::string& valueName) {
+    if (registryProvider) {
+        return registryProvider->valueExists(keyPath, valueName);
+    }
+    return false;
+}
+#endif
+
+void ComplianceCheck::collectSettings(const std::vector<std::string>& registryKeys, bool securityPolicy, FactTable& facts) {
+    std::vector<std::pair<std::string, std::string>> values;
+    for (const auto& key : registryKeys) {
+        values.clear();
+        if (readRegistryValues(key, values)) {
+            facts.addRegistryValues(key, values);
+        }
+    }
+    
+    // secedit reads the live policy only; offline hives have no export
+    if (securityPolicy && !registryProvider) {
+        std::string infPath = tempProbePath("settings", ".inf");
+        executePowerShell("secedit /export /cfg '" + infPath + "' /areas SECURITYPOLICY USER_RIGHTS /quiet");
+        
+        SecurityPolicy policy;
+        if (policy.loadFromFile(infPath)) {
+            facts.addSecurityPolicy(policy);
+        }
+        std::error_code ec;
+        std::filesystem::remove(infPath, ec);
+    }
+}
@@ -1,6 +1,14 @@
 #pragma once
 #include "ComplianceResult.h"
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+
+class CsvReader;
+class FactTable;
+class RegistryProvider;
+class SecurityLogExport;
 
 // Base class for all compliance checks
 class ComplianceCheck {
@@ -17,16 +25,51 @@ public:
     bool isEnabled() const { return enabled; }
     void setEnabled(bool value) { enabled = value; }
 
+    // Route registry reads to another source (e.g. offline hive files);
+    // nullptr restores the live registry
+    void setRegistryProvider(std::shared_ptr<RegistryProvider> provider) { registryProvider = std::move(provider); }
+
+    // Share one Security log export between the checks of a scan;
+    // nullptr makes each check export its own
+    void setSecurityLog(std::shared_ptr<SecurityLogExport> log) { securityLog = std::move(log); }
+    
+    // Path of a data file shipped next to the executable (vulnerability
+    // database, update catalog, ...); the bare name if that directory is
+    // unknown. The working directory is wherever the tool was started from.
+    static std::string dataFilePath(const char* fileName);
+
 protected:
     bool enabled = true;
+    std::shared_ptr<RegistryProvider> registryProvider;
+    std::shared_ptr<SecurityLogExport> securityLog;
     
-    // Helper method to execute PowerShell commands
+    // Helper method to execute PowerShell commands. The output is parsed
+    // once and dropped, so it stays on the heap rather than in the scan arena.
     std::string executePowerShell(const std::string& command);
     
+    // Helper method to name a probe's temporary file; process id and a
+    // counter keep concurrent scans and instances apart
+    static std::string tempProbePath(const char* stem, const char* extension);
+    
+    // Helper method to export the last 7 days of the Security log, once per
+    // shared export; keep the result alive while the file is read
+    std::shared_ptr<SecurityLogExport> exportSecurityLog();
+    
+    // Helper method to run a PowerShell pipeline through Export-Csv and load the table
+    bool executePowerShellCsv(const std::string& command, CsvReader& reader);
+    
     // Helper method to read registry values
     std::string readRegistryValue(const std::string& keyPath, const std::string& valueName);
     
+    // Helper method to read every value of a registry key in one open;
+    // values formatted like readRegistryValue, false if the key is missing
+    bool readRegistryValues(const std::string& keyPath, std::vector<std::pair<std::string, std::string>>& values);
+    
     // Helper method to check if a registry value exists
     bool registryValueExists(const std::string& keyPath, const std::string& valueName);
+    
+    // Helper method to collect settings into one fact table: each registry
+    // key is read once, secedit is exported once if securityPolicy is set
+    void collectSettings(const std::vector<std::string>& registryKeys, bool securityPolicy, FactTable& facts);
 };
 
@@ -1,7 +1,39 @@
 #include "ComplianceEngine.h"
+#include "PolicyTables.h"
+#include "SecurityLogExport.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
 #include <numeric>
 
+namespace {
+
+// Range of calculateOverallScore's result once the pending modules report.
+// The worst outcome for every pending module is a score of 0 at the
+// heaviest weight. The best is each pending module at its severity's
+// ceiling; the modules are interchangeable, so the best case gives all of
+// them the same severity and each severity is tried once. A pending module
+// may also turn out not to apply and drop out, which leaves the current
+// average as it is.
+void overallBounds(int64_t weighted, int64_t weight, size_t pending, int& lower, int& upper) {
+    int current = weight > 0 ? static_cast<int>(weighted / weight) : 0;
+    if (pending == 0) {
+        lower = upper = current;
+        return;
+    }
+    int64_t count = static_cast<int64_t>(pending);
+    lower = static_cast<int>(weighted / (weight + count * PolicyTables::weight<ModuleWeights>(Severity::Critical)));
+    upper = current;
+    for (Severity severity : { Severity::Low, Severity::Medium, Severity::High, Severity::Critical }) {
+        int score = PolicyTables::ceiling<ModuleScoreCeilings>(severity);
+        int64_t moduleWeight = PolicyTables::weight<ModuleWeights>(severity);
+        upper = std::max(upper, static_cast<int>((weighted + count * score * moduleWeight) / (weight + count * moduleWeight)));
+    }
+}
+
+} // namespace
+
 ComplianceEngine::ComplianceEngine() : overallScore(0) {
     initializeChecks();
 }
@@ -13,6 +45,7 @@ void ComplianceEngine::initializeChecks() {
     checks.clear();
 
     checks.push_back(std::make_unique<FirewallCheck>());
+    checks.push_back(std::make_unique<FirewallRulesCheck>());
     checks.push_back(std::make_unique<AntivirusCheck>());
     checks.push_back(std::make_unique<PasswordPolicyCheck>());
     checks.push_back(std::make_unique<WindowsUpdateCheck>());
@@ -21,24 +54,37 @@ void ComplianceEngine::initializeChecks() {
     checks.push_back(std::make_unique<SystemLoggingCheck>());
     checks.push_back(std::make_unique<InstalledSoftwareCheck>());
     checks.push_back(std::make_unique<NetworkSharesCheck>());
+    checks.push_back(std::make_unique<PersistenceCheck>());
+    auto tasks = std::make_unique<ScheduledTaskCheck>();
+    scheduledTaskCheck = tasks.get();
+    checks.push_back(std::move(tasks));
+    auto integrity = std::make_unique<FileIntegrityCheck>();
+    fileIntegrityCheck = integrity.get();
+    checks.push_back(std::move(integrity));
+    checks.push_back(std::make_unique<LogonAnomalyCheck>());
+    auto baseline = std::make_unique<SecurityBaselineCheck>();
+    baselineCheck = baseline.get();
+    checks.push_back(std::move(baseline));
+    auto rules = std::make_unique<RulePackCheck>();
+    rulePackCheck = rules.get();
+    checks.push_back(std::move(rules));
 }
 
 void ComplianceEngine::performFullScan() {
-    results.clear();
-
+    std::vector<ComplianceCheck*> planned;
     for (const auto& check : checks) {
         if (check->isEnabled()) {
-            ComplianceResult result = check->performCheck();
-            results.push_back(result);
+            planned.push_back(check.get());
         }
     }
 
-    calculateOverallScore();
+    beginScan();
+    runChecks(planned);
+    finishScan();
 }
 
 void ComplianceEngine::performCustomScan(const std::vector<std::string>& selectedModules) {
-    results.clear();
-
+    std::vector<ComplianceCheck*> planned;
     for (const auto& check : checks) {
         std::string moduleName = check->getModuleName();
 
@@ -46,48 +92,212 @@ void ComplianceEngine::performCustomScan(const std::vector<std::string>& selecte
         bool selected = std::find(selectedModules.begin(), selectedModules.end(), moduleName) != selectedModules.end();
 
         if (selected && check->isEnabled()) {
-            ComplianceResult result = check->performCheck();
-            results.push_back(result);
+            planned.push_back(check.get());
         }
     }
 
-    calculateOverallScore();
+    beginScan();
+    runChecks(planned);
+    finishScan();
 }
 
-void ComplianceEngine::calculateOverallScore() {
-    if (results.empty()) {
-        overallScore = 0;
-        return;
+void ComplianceEngine::performQuickScan(int budgetMs) {
+    beginScan();
+    quickScan.performed = true;
+    quickScan.budgetMs = budgetMs;
+    
+    std::vector<ComplianceCheck*> candidates;
+    std::vector<std::string> names;
+    for (const auto& check : checks) {
+        if (check->isEnabled()) {
+            candidates.push_back(check.get());
+            names.push_back(check->getModuleName());
+        }
     }
+    
+    QuickScanPlan plan = history.plan(names, budgetMs);
+    quickScan.estimatedMs = plan.estimatedMs;
+    quickScan.coverage = plan.coverage;
+    for (size_t index : plan.skipped) {
+        quickScan.skipped.push_back(names[index]);
+    }
+    
+    std::vector<ComplianceCheck*> planned;
+    for (size_t index : plan.selected) {
+        planned.push_back(candidates[index]);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    runChecks(planned);
+    quickScan.elapsedMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    
+    finishScan();
+}
 
-    // Weighted average based on severity
-    int totalWeightedScore = 0;
-    int totalWeight = 0;
+void ComplianceEngine::loadHistory() {
+    // Earlier scans' timings and failure rates, once per engine
+    if (!historyLoaded) {
+        historyLoaded = true;
+        if (!dataDirectory.empty()) {
+            history.loadFile((std::filesystem::path(dataDirectory) / "ScanHistory.csv").string());
+        }
+    }
+}
 
-    for (const auto& result : results) {
-        int weight = 1;
+void ComplianceEngine::beginScan() {
+    // The previous scan's results go first, then their memory in one step
+    results.clear();
+    arena.release();
+    quickScan = QuickScanSummary();
+    provisional = ProvisionalScore();
+    completedWeighted = 0;
+    completedWeight = 0;
+    stoppedEarly = false;
+    loadHistory();
+}
 
-        // Higher severity gets more weight
-        switch (result.severity) {
-        case Severity::Critical:
-            weight = 4;
-            break;
-        case Severity::High:
-            weight = 3;
-            break;
-        case Severity::Medium:
-            weight = 2;
-            break;
-        case Severity::Low:
-            weight = 1;
+void ComplianceEngine::runChecks(const std::vector<ComplianceCheck*>& planned) {
+    // Results and probe tables of this scan are built in the arena
+    ScanArena::Scope scope(arena);
+    results.reserve(planned.size());
+    
+    // Checks that replay the Security log read one export, deleted after the scan
+    auto securityLog = std::make_shared<SecurityLogExport>();
+    for (ComplianceCheck* check : planned) check->setSecurityLog(securityLog);
+    
+    provisional.pending = planned.size();
+    for (size_t i = 0; i < planned.size(); ++i) {
+        runCheck(*planned[i]);
+        
+        // Publish the score so far and where the final score can still land
+        const ComplianceResult& result = results.back();
+        int weight = PolicyTables::weight<ModuleWeights>(result);
+        completedWeighted += static_cast<int64_t>(result.score) * weight;
+        completedWeight += weight;
+        provisional.completed = i + 1;
+        provisional.pending = planned.size() - i - 1;
+        provisional.score = completedWeight > 0 ? static_cast<int>(completedWeighted / completedWeight) : 0;
+        overallBounds(completedWeighted, completedWeight, provisional.pending, provisional.lower, provisional.upper);
+        if (progressHandler) progressHandler(provisional);
+        
+        // The outcome is settled once the threshold is outside the bounds
+        if (earlyStopScore >= 0 && provisional.pending > 0 &&
+            (provisional.lower >= earlyStopScore || provisional.upper < earlyStopScore)) {
+            stoppedEarly = true;
             break;
         }
+    }
+    
+    for (ComplianceCheck* check : planned) check->setSecurityLog(nullptr);
+}
+
+void ComplianceEngine::runCheck(ComplianceCheck& check) {
+    auto start = std::chrono::steady_clock::now();
+    results.push_back(check.performCheck());
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    history.record(check.getModuleName(), elapsedMs, results.back());
+}
 
-        totalWeightedScore += result.score * weight;
-        totalWeight += weight;
+void ComplianceEngine::finishScan() {
+    calculateOverallScore();
+    calculateFrameworkScores();
+    if (!dataDirectory.empty()) {
+        history.saveFile((std::filesystem::path(dataDirectory) / "ScanHistory.csv").string());
     }
+}
 
-    overallScore = totalWeight > 0 ? totalWeightedScore / totalWeight : 0;
+void ComplianceEngine::calculateOverallScore() {
+    // Weighted average based on severity; modules that do not apply are
+    // left out, as the framework scores leave them out
+    overallScore = PolicyTables::overallScore<ModuleWeights>(results);
+}
+
+std::vector<ScoreLoss> ComplianceEngine::getTopContributors(size_t count) const {
+    std::vector<ScoreLoss> losses;
+    int64_t totalWeight = 0;
+    for (const auto& result : results) totalWeight += PolicyTables::weight<ModuleWeights>(result);
+    if (totalWeight == 0) return losses;
+    
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ComplianceResult& result = results[i];
+        double lost = 100 - result.score;
+        int weight = PolicyTables::weight<ModuleWeights>(result);
+        if (lost <= 0 || weight == 0) continue;
+        double scale = static_cast<double>(weight) / totalWeight;
+        
+        // Penalties past a score of 0 are scaled down; points no input in
+        // the buffer claims stay with the module
+        double attributed = result.attribution.total();
+        double fit = attributed > lost ? lost / attributed : 1.0;
+        double remaining = lost;
+        for (const auto& contribution : result.attribution) {
+            losses.push_back({ i, contribution.setting, contribution.points * fit * scale });
+            remaining -= contribution.points * fit;
+        }
+        if (remaining > 0.01) losses.push_back({ i, std::string(), remaining * scale });
+    }
+    
+    auto larger = [](const ScoreLoss& a, const ScoreLoss& b) { return a.points > b.points; };
+    if (losses.size() > count) {
+        std::partial_sort(losses.begin(), losses.begin() + count, losses.end(), larger);
+        losses.resize(count);
+    } else {
+        std::sort(losses.begin(), losses.end(), larger);
+    }
+    return losses;
+}
+
+size_t ComplianceEngine::findResult(const std::string& moduleName) const {
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (std::string_view(results[i].moduleName) == moduleName) return i;
+    }
+    return results.size();
+}
+
+void ComplianceEngine::calculateFrameworkScores() {
+    frameworkScores.clear();
+    requirementOutcomes.clear();
+    
+    // Load the local mappings once and keep them for later scans
+    if (!frameworks && !frameworksSearched) {
+        frameworksSearched = true;
+        std::string path = ComplianceCheck::dataFilePath("FrameworkMappings.csv");
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            auto map = std::make_shared<FrameworkMap>();
+            if (map->loadFile(path)) {
+                frameworks = map;
+            }
+        }
+    }
+    if (!frameworks || results.empty()) return;
+    
+    // Bound to the loaded definitions whether or not they ran, so a custom
+    // scan does not force a rebind; outcomes only count if their module ran
+    frameworks->bind(baselineCheck ? baselineCheck->getBaseline().get() : nullptr,
+                     rulePackCheck ? rulePackCheck->getRulePack().get() : nullptr);
+    
+    FrameworkInputs inputs;
+    inputs.modules = &results;
+    if (baselineCheck && findResult(baselineCheck->getModuleName()) < results.size()) inputs.baseline = &baselineCheck->getOutcomes();
+    if (rulePackCheck && findResult(rulePackCheck->getModuleName()) < results.size()) inputs.rules = &rulePackCheck->getOutcomes();
+    frameworks->evaluate(inputs, frameworkScores, requirementOutcomes);
+}
+
+WhatIfSimulator ComplianceEngine::createSimulator() const {
+    WhatIfSimulator simulator(results);
+    
+    // Only modules that ran and scored settings in this scan
+    size_t index = baselineCheck ? findResult(baselineCheck->getModuleName()) : results.size();
+    if (index < results.size() && results[index].status != CheckStatus::NotApplicable && baselineCheck->getBaseline()) {
+        simulator.setBaseline(index, *baselineCheck->getBaseline(), baselineCheck->getFacts(), baselineCheck->getOutcomes());
+    }
+    index = rulePackCheck ? findResult(rulePackCheck->getModuleName()) : results.size();
+    if (index < results.size() && results[index].status != CheckStatus::NotApplicable && rulePackCheck->getRulePack()) {
+        simulator.setRules(index, *rulePackCheck->getRulePack(), rulePackCheck->getFacts(), rulePackCheck->getOutcomes());
+    }
+    return simulator;
 }
 
 int ComplianceEngine::getOverallComplianceScore() const {
@@ -146,4 +356,42 @@ std::vector<std::string> ComplianceEngine::getAvailableModules() const {
     }
 
     return moduleNames;
+}
+
+void ComplianceEngine::setFrameworkMap(std::shared_ptr<FrameworkMap> map) {
+    frameworks = std::move(map);
+    frameworksSearched = true;
+}
+
+void ComplianceEngine::setRegistryProvider(std::shared_ptr<RegistryProvider> provider) {
+    for (auto& check : checks) {
+        check->setRegistryProvider(provider);
+    }
+}
+
+void ComplianceEngine::setTasksDirectory(const std::string& directory) {
+    scheduledTaskCheck->setTasksDirectory(directory);
+}
+
+void ComplianceEngine::setDataDirectory(const std::string& directory) {
+    dataDirectory = directory;
+    historyLoaded = false;
+    if (!directory.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+    }
+    
+    std::filesystem::path root(directory);
+    fileIntegrityCheck->setBaselinePath(directory.empty() ? std::string() : (root / "IntegrityBaseline.csv").string());
+    fileIntegrityCheck->setCachePath(directory.empty() ? std::string() : (root / "IntegrityCache.csv").string());
+}
+
+std::string ComplianceEngine::defaultDataDirectory() {
+    const char* localAppData = std::getenv("LOCALAPPDATA");
+    if (localAppData == nullptr || *localAppData == '\0') return std::string();
+    return (std::filesystem::path(localAppData) / "WindowsComplianceTool").string();
+}
+
+bool ComplianceEngine::recordIntegrityBaseline(std::function<void(size_t, size_t)> progress) {
+    return fileIntegrityCheck->recordBaseline(std::move(progress));
 }
\ No newline at end of file
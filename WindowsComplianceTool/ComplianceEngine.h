@@ -2,6 +2,7 @@
 #include "ComplianceResult.h"
 #include "ComplianceCheck.h"
 #include "FirewallCheck.h"
+#include "FirewallRulesCheck.h"
 #include "AntivirusCheck.h"
 #include "PasswordPolicyCheck.h"
 #include "WindowsUpdateCheck.h"
@@ -10,12 +11,24 @@
 #include "SystemLoggingCheck.h"
 #include "InstalledSoftwareCheck.h"
 #include "NetworkSharesCheck.h"
+#include "PersistenceCheck.h"
+#include "ScheduledTaskCheck.h"
+#include "FileIntegrityCheck.h"
+#include "LogonAnomalyCheck.h"
+#include "SecurityBaselineCheck.h"
+#include "RulePackCheck.h"
+#include "FrameworkMap.h"
+#include "WhatIfSimulator.h"
+#include "ScanPlanner.h"
+#include "ScanArena.h"
 #include <vector>
 #include <list>
 #include <map>
 #include <queue>
 #include <string>
 #include <memory>
+#include <functional>
+#include <cstdint>
 
 // Priority queue comparator for severity-based sorting
 struct SeverityComparator {
@@ -25,6 +38,32 @@ struct SeverityComparator {
     }
 };
 
+// Outcome of the last quick scan
+struct QuickScanSummary {
+    bool performed = false;
+    int budgetMs = 0;
+    int estimatedMs = 0;
+    int elapsedMs = 0;
+    double coverage = 0;            // share of the enabled modules' risk value that ran, 0..1
+    std::vector<std::string> skipped;
+};
+
+// Overall score while a scan runs, published after each module
+struct ProvisionalScore {
+    int score = 0;                  // calculateOverallScore over the modules completed so far
+    int lower = 0;                  // lowest and highest final score still possible
+    int upper = 100;
+    size_t completed = 0;
+    size_t pending = 0;
+};
+
+// One input's cost to the overall score
+struct ScoreLoss {
+    size_t result;                  // index into the results
+    std::string setting;            // empty: points the module did not attribute
+    double points;                  // points off the overall score
+};
+
 class ComplianceEngine {
 public:
     ComplianceEngine();
@@ -39,10 +78,36 @@ public:
     // Perform selected compliance checks
     void performCustomScan(const std::vector<std::string>& selectedModules);
     
+    // Run the enabled modules that cover the most risk (severity weight x
+    // failure rate) within budgetMs, using the timings and failure rates
+    // of earlier scans
+    void performQuickScan(int budgetMs);
+    const QuickScanSummary& getQuickScanSummary() const { return quickScan; }
+    
+    // Called after every module with the provisional overall score
+    void setProgressHandler(std::function<void(const ProvisionalScore&)> handler) { progressHandler = std::move(handler); }
+    const ProvisionalScore& getProvisionalScore() const { return provisional; }
+    
+    // Stop a scan once the final overall score is certain to be at least
+    // passScore or certain to be below it (-1 runs every module). The
+    // pending modules are not run and getResults() holds those that were.
+    void setEarlyStopScore(int passScore) { earlyStopScore = passScore; }
+    bool wasStoppedEarly() const { return stoppedEarly; }
+    
+    // Inputs that cost the overall score the most, largest first. Each
+    // module's attributed points are scaled to the points it lost and
+    // weighted as calculateOverallScore weights the module.
+    std::vector<ScoreLoss> getTopContributors(size_t count) const;
+    
+    // Per-module timings and failure rates, kept in ScanHistory.csv in the
+    // data directory when one is set
+    const ScanPlanner& getScanHistory() const { return history; }
+    
     // Get overall compliance score (0-100)
     int getOverallComplianceScore() const;
     
-    // Get all results
+    // Get all results. Their text lives in the scan's arena until the next
+    // scan starts; copy a result to keep it longer.
     const std::vector<ComplianceResult>& getResults() const { return results; }
     
     // Get results organized by severity (using map)
@@ -59,12 +124,77 @@ public:
     
     // Get all available module names
     std::vector<std::string> getAvailableModules() const;
+    
+    // Read registry settings from another source (e.g. OfflineRegistry) in every check
+    void setRegistryProvider(std::shared_ptr<RegistryProvider> provider);
+    
+    // Scheduled task definitions of the same image (its Windows\System32\Tasks)
+    void setTasksDirectory(const std::string& directory);
+    
+    // Folder for files kept between scans (scan history, the integrity
+    // baseline and hash cache); nothing is stored while it is unset
+    void setDataDirectory(const std::string& directory);
+    const std::string& getDataDirectory() const { return dataDirectory; }
+    
+    // Per-user folder, %LOCALAPPDATA%\WindowsComplianceTool; empty if unknown
+    static std::string defaultDataDirectory();
+    
+    // Hash the binaries on disk now and trust them as the integrity baseline;
+    // progress gets the files done and the total as hashing advances
+    bool recordIntegrityBaseline(std::function<void(size_t, size_t)> progress = nullptr);
+    
+    // Framework mappings (CIS, NIST, ISO, ...) scored after every scan from
+    // the same outcomes; when unset, FrameworkMappings.csv in the working
+    // directory is loaded if present
+    void setFrameworkMap(std::shared_ptr<FrameworkMap> map);
+    const FrameworkMap* getFrameworkMap() const { return frameworks.get(); }
+    
+    // Per-framework scores and per-requirement outcomes of the last scan,
+    // indexed like the map's frameworks() and requirements()
+    const std::vector<FrameworkScore>& getFrameworkScores() const { return frameworkScores; }
+    const std::vector<RequirementOutcome>& getRequirementOutcomes() const { return requirementOutcomes; }
+
+    // What-if simulator over the last scan: setting changes re-evaluate only
+    // the benchmark controls and policy rules that read them
+    WhatIfSimulator createSimulator() const;
 
 private:
     std::vector<std::unique_ptr<ComplianceCheck>> checks;
+    ScanArena arena;                // declared before the results built in it
     std::vector<ComplianceResult> results;
     
+    ScheduledTaskCheck* scheduledTaskCheck = nullptr;
+    FileIntegrityCheck* fileIntegrityCheck = nullptr;
+    std::string dataDirectory;
+    
+    // Checks whose per-control outcomes feed the framework scores
+    SecurityBaselineCheck* baselineCheck = nullptr;
+    RulePackCheck* rulePackCheck = nullptr;
+    
+    std::shared_ptr<FrameworkMap> frameworks;
+    bool frameworksSearched = false;
+    std::vector<FrameworkScore> frameworkScores;
+    std::vector<RequirementOutcome> requirementOutcomes;
+    
+    ScanPlanner history;
+    bool historyLoaded = false;
+    QuickScanSummary quickScan;
+    
+    ProvisionalScore provisional;
+    int64_t completedWeighted = 0;
+    int64_t completedWeight = 0;
+    std::function<void(const ProvisionalScore&)> progressHandler;
+    int earlyStopScore = -1;
+    bool stoppedEarly = false;
+    
+    void loadHistory();
+    void beginScan();
+    void runChecks(const std::vector<ComplianceCheck*>& planned);
+    void runCheck(ComplianceCheck& check);
+    void finishScan();
     void calculateOverallScore();
+    void calculateFrameworkScores();
+    size_t findResult(const std::string& moduleName) const;
     int overallScore;
 };
 
@@ -1,6 +1,11 @@
 #pragma once
+#include "Findings.h"
+#include "ScanArena.h"
+#include "ScoreAttribution.h"
+#include "TextUtil.h"
+#include <memory_resource>
 #include <string>
-#include <vector>
+#include <string_view>
 
 // Severity levels for compliance issues
 enum class Severity {
@@ -10,6 +15,15 @@ enum class Severity {
     Critical = 80
 };
 
+// Severity named in a data file, case-insensitive; names other than
+// Critical, High and Low are Medium
+inline Severity parseSeverity(std::string_view text) {
+    if (TextUtil::equalsIgnoreCase(text, "Critical")) return Severity::Critical;
+    if (TextUtil::equalsIgnoreCase(text, "High")) return Severity::High;
+    if (TextUtil::equalsIgnoreCase(text, "Low")) return Severity::Low;
+    return Severity::Medium;
+}
+
 // Status of a compliance check
 enum class CheckStatus {
     Pass,
@@ -18,20 +32,27 @@ enum class CheckStatus {
     NotApplicable
 };
 
-// Structure to hold individual compliance check results
+// Structure to hold individual compliance check results. Text is kept in
+// the memory it was built in (the scan's arena during a scan); copies
+// use the default resource and outlive the scan.
 struct ComplianceResult {
-    std::string moduleName;
-    std::string description;
+    std::pmr::string moduleName;
+    std::pmr::string description;
     CheckStatus status;
     Severity severity;
-    std::string recommendation;
-    std::vector<std::string> details;
+    std::pmr::string recommendation;
+    Findings findings;              // typed; reports render the text
     int score; // 0-100 for this module
+    ScoreAttribution attribution;   // inputs that cost the score its lost points
 
-    ComplianceResult() : status(CheckStatus::NotApplicable), severity(Severity::Low), score(0) {}
+    explicit ComplianceResult(std::pmr::memory_resource* memory = ScanArena::current())
+        : moduleName(memory), description(memory), status(CheckStatus::NotApplicable), severity(Severity::Low),
+          recommendation(memory), findings(memory), score(0) {}
     
-    ComplianceResult(const std::string& name, const std::string& desc, 
-                    CheckStatus stat, Severity sev, int sc = 0)
-        : moduleName(name), description(desc), status(stat), severity(sev), score(sc) {}
+    ComplianceResult(std::string_view name, std::string_view desc, 
+                    CheckStatus stat, Severity sev, int sc = 0,
+                    std::pmr::memory_resource* memory = ScanArena::current())
+        : moduleName(name, memory), description(desc, memory), status(stat), severity(sev),
+          recommendation(memory), findings(memory), score(sc) {}
 };
 
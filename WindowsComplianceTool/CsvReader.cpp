@@ -0,0 +1,253 @@
+#include "CsvReader.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSV_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+
+inline int lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Portable popcount (no POPCNT instruction requirement)
+inline uint32_t countBits(uint32_t v) {
+    v = v - ((v >> 1) & 0x55555555u);
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    return (((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+// Bit i of the result is the XOR of bits 0..i, i.e. "inside quotes"
+inline uint32_t prefixXor(uint32_t v) {
+    v ^= v << 1;
+    v ^= v << 2;
+    v ^= v << 4;
+    v ^= v << 8;
+    return v & 0xFFFFu;
+}
+
+} // namespace
+
+bool CsvReader::loadFromFile(const std::string& path) {
+    // Raw bytes on the heap, freed once converted; only the text the
+    // fields point into is kept in the reader's memory
+    std::string bytes;
+    if (!TextEncoding::readFile(path, bytes)) {
+        return false;
+    }
+    return loadFromMemory(bytes);
+}
+
+bool CsvReader::loadFromMemory(std::string_view bytes) {
+    owned.clear();
+    buffer.clear();
+    TextEncoding::appendUtf8(buffer, bytes);
+    return parse(buffer);
+}
+
+bool CsvReader::parse(std::string_view source) {
+    fields.clear();
+    columns = 0;
+    rows = 0;
+    text = source;
+
+    // Offsets are stored as 31-bit values
+    if (text.size() >= EscapedFlag) {
+        text = std::string_view();
+        return false;
+    }
+
+    scan();
+    return columns > 0;
+}
+
+bool CsvReader::parseOwned(std::string&& source) {
+    buffer.clear();
+    owned = std::move(source);
+    return parse(owned);
+}
+
+void CsvReader::clear() {
+    buffer.clear();
+    owned.clear();
+    text = std::string_view();
+    fields.clear();
+    columns = 0;
+    rows = 0;
+}
+
+void CsvReader::finishRecord(size_t recordStart) {
+    size_t count = fields.size() - recordStart;
+
+    // Blank line
+    if (count == 1 && fields[recordStart].length == 0) {
+        fields.resize(recordStart);
+        return;
+    }
+
+    if (columns == 0) {
+        // Export-Csv without -NoTypeInformation starts with a #TYPE line
+        if (count > 0 && view(fields[recordStart]).compare(0, 5, "#TYPE") == 0) {
+            fields.resize(recordStart);
+            return;
+        }
+        columns = count;
+    } else {
+        rows++;
+    }
+
+    // Keep the table rectangular
+    fields.resize(recordStart + columns, Field{ 0, 0 });
+}
+
+void CsvReader::scan() {
+    const char* data = text.data();
+    const size_t n = text.size();
+
+    // Rough pre-size: one field per 16 bytes
+    fields.reserve(n / 16 + 8);
+
+    size_t recordStart = 0;
+    size_t fieldStart = 0;
+    uint32_t quoteCount = 0;
+    bool inQuotes = false;
+
+    auto emit = [&](size_t end, bool endOfLine) {
+        size_t start = fieldStart;
+        if (endOfLine && end > start && data[end - 1] == '\r') {
+            end--;
+        }
+
+        uint32_t flags = 0;
+        if (quoteCount >= 2 && end - start >= 2 && data[start] == '"' && data[end - 1] == '"') {
+            start++;
+            end--;
+            if (quoteCount > 2) flags = EscapedFlag;
+        }
+
+        fields.push_back(Field{ static_cast<uint32_t>(start), static_cast<uint32_t>(end - start) | flags });
+        if (endOfLine) {
+            finishRecord(recordStart);
+            recordStart = fields.size();
+        }
+    };
+
+    size_t i = 0;
+
+#ifdef CSV_USE_SSE2
+    const __m128i quoteChar = _mm_set1_epi8('"');
+    const __m128i delimChar = _mm_set1_epi8(delimiter);
+    const __m128i newlineChar = _mm_set1_epi8('\n');
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t quotes = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quoteChar)));
+        uint32_t structural = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, delimChar), _mm_cmpeq_epi8(chunk, newlineChar))));
+
+        if ((quotes | structural) == 0) {
+            continue;
+        }
+
+        uint32_t inside = prefixXor(quotes);
+        if (inQuotes) inside = ~inside & 0xFFFFu;
+        structural &= ~inside;
+
+        uint32_t pendingQuotes = quotes;
+        while (structural) {
+            int bit = lowestBit(structural);
+            uint32_t below = (1u << bit) - 1;
+
+            quoteCount += countBits(pendingQuotes & below);
+            pendingQuotes &= ~below;
+
+            size_t pos = i + static_cast<size_t>(bit);
+            emit(pos, data[pos] == '\n');
+            fieldStart = pos + 1;
+            quoteCount = 0;
+
+            structural &= structural - 1;
+        }
+
+        quoteCount += countBits(pendingQuotes);
+        inQuotes = (inside >> 15) & 1u;
+    }
+#endif
+
+    // Scalar tail (or whole input without SSE2)
+    for (; i < n; ++i) {
+        char c = data[i];
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            quoteCount++;
+        } else if (!inQuotes && (c == delimiter || c == '\n')) {
+            emit(i, c == '\n');
+            fieldStart = i + 1;
+            quoteCount = 0;
+        }
+    }
+
+    // Last record without a trailing newline
+    if (fieldStart < n || fields.size() > recordStart) {
+        emit(n, true);
+    }
+}
+
+int CsvReader::columnIndex(std::string_view name) const {
+    for (size_t c = 0; c < columns; ++c) {
+        if (equalsIgnoreCase(view(fields[c]), name)) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+std::string_view CsvReader::columnName(size_t column) const {
+    return column < columns ? view(fields[column]) : std::string_view();
+}
+
+std::string_view CsvReader::field(size_t row, size_t column) const {
+    if (row >= rows || column >= columns) {
+        return std::string_view();
+    }
+    return view(fields[(row + 1) * columns + column]);
+}
+
+bool CsvReader::isEscaped(size_t row, size_t column) const {
+    if (row >= rows || column >= columns) {
+        return false;
+    }
+    return (fields[(row + 1) * columns + column].length & EscapedFlag) != 0;
+}
+
+std::string CsvReader::value(size_t row, size_t column) const {
+    std::string_view raw = field(row, column);
+    return isEscaped(row, column) ? unescape(raw) : std::string(raw);
+}
+
+std::string CsvReader::unescape(std::string_view field) {
+    std::string out;
+    out.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        out += field[i];
+        if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return out;
+}
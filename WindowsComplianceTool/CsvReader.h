@@ -0,0 +1,93 @@
+#pragma once
+#include "ScanArena.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Zero-copy reader for Export-Csv / ConvertTo-Csv probe output.
+// Quotes, delimiters and line breaks are located 16 bytes at a time with
+// SSE2; fields are stored as (offset, length) pairs into the source text
+// and handed out as string_views, so no per-field strings are allocated.
+class CsvReader {
+public:
+    // Lightweight view of one data row
+    class Row {
+    public:
+        Row(const CsvReader& reader, size_t index) : reader(reader), index(index) {}
+        std::string_view operator[](size_t column) const { return reader.field(index, column); }
+        std::string_view operator[](int column) const {
+            return column < 0 ? std::string_view() : reader.field(index, static_cast<size_t>(column));
+        }
+        std::string value(int column) const {
+            return column < 0 ? std::string() : reader.value(index, static_cast<size_t>(column));
+        }
+    private:
+        const CsvReader& reader;
+        size_t index;
+    };
+
+    // Loaded text and field offsets are kept in memory (the scan's arena
+    // when a scan is running)
+    explicit CsvReader(char delimiter = ',', std::pmr::memory_resource* memory = ScanArena::current())
+        : delimiter(delimiter), buffer(memory), fields(memory) {}
+
+    // Load a CSV file; UTF-16LE input (Export-Csv -Encoding Unicode) is
+    // converted to UTF-8 once and owned by the reader
+    bool loadFromFile(const std::string& path);
+
+    // Load probe output already in memory, converted the same way
+    bool loadFromMemory(std::string_view bytes);
+
+    // Parse UTF-8 text in place. The text must outlive the reader.
+    bool parse(std::string_view text);
+
+    // Parse text owned by the reader (moved in)
+    bool parseOwned(std::string&& text);
+
+    void clear();
+
+    // Data rows (the header is not counted)
+    size_t rowCount() const { return rows; }
+    size_t columnCount() const { return columns; }
+    Row row(size_t index) const { return Row(*this, index); }
+
+    // Header lookup (case-insensitive), -1 if the column is missing
+    int columnIndex(std::string_view name) const;
+    std::string_view columnName(size_t column) const;
+
+    // Field view with surrounding quotes removed. Doubled quotes ("") inside
+    // a quoted field are left as-is; use value() when they matter.
+    std::string_view field(size_t row, size_t column) const;
+
+    // True if the field contains escaped quotes and needs value()
+    bool isEscaped(size_t row, size_t column) const;
+
+    // Field value with escaped quotes collapsed
+    std::string value(size_t row, size_t column) const;
+
+    static std::string unescape(std::string_view field);
+
+private:
+    struct Field {
+        uint32_t offset;
+        uint32_t length;   // high bit set = contains escaped quotes
+    };
+
+    static const uint32_t EscapedFlag = 0x80000000u;
+
+    char delimiter;
+    std::pmr::string buffer;     // text loaded by the reader
+    std::string owned;           // text moved in by parseOwned
+    std::string_view text;
+    std::pmr::vector<Field> fields;   // header row first, then data rows, row-major
+    size_t columns = 0;
+    size_t rows = 0;
+
+    void scan();
+    void finishRecord(size_t recordStart);
+    std::string_view view(const Field& f) const {
+        return text.substr(f.offset, f.length & ~EscapedFlag);
+    }
+};
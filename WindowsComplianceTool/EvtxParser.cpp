@@ -0,0 +1,791 @@
+#include "EvtxParser.h"
+#include "BinaryRead.h"
+#include "MappedFile.h"
+#include "TextEncoding.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+const size_t FileHeaderSize = 4096;
+const uint32_t ChunkSize = static_cast<uint32_t>(EvtxParser::ChunkSize);
+const uint32_t ChunkHeaderSize = 512;   // header, string table and template table
+const uint32_t RecordSignature = 0x00002A2A;
+const uint32_t RecordHeaderSize = 24;
+
+// BinXML tokens; 0x40 marks "more data follows" (attributes / more values)
+const uint8_t TokenEof = 0x00;
+const uint8_t TokenOpenStartElement = 0x01;
+const uint8_t TokenCloseStartElement = 0x02;
+const uint8_t TokenCloseEmptyElement = 0x03;
+const uint8_t TokenEndElement = 0x04;
+const uint8_t TokenValue = 0x05;
+const uint8_t TokenAttribute = 0x06;
+const uint8_t TokenCData = 0x07;
+const uint8_t TokenCharRef = 0x08;
+const uint8_t TokenEntityRef = 0x09;
+const uint8_t TokenPITarget = 0x0A;
+const uint8_t TokenPIData = 0x0B;
+const uint8_t TokenTemplateInstance = 0x0C;
+const uint8_t TokenNormalSubstitution = 0x0D;
+const uint8_t TokenOptionalSubstitution = 0x0E;
+const uint8_t TokenFragmentHeader = 0x0F;
+const uint8_t TokenMoreBit = 0x40;
+
+// Substitution value types
+const uint8_t TypeNull = 0x00;
+const uint8_t TypeString = 0x01;
+const uint8_t TypeAnsiString = 0x02;
+const uint8_t TypeInt8 = 0x03;
+const uint8_t TypeUInt8 = 0x04;
+const uint8_t TypeInt16 = 0x05;
+const uint8_t TypeUInt16 = 0x06;
+const uint8_t TypeInt32 = 0x07;
+const uint8_t TypeUInt32 = 0x08;
+const uint8_t TypeInt64 = 0x09;
+const uint8_t TypeUInt64 = 0x0A;
+const uint8_t TypeReal32 = 0x0B;
+const uint8_t TypeReal64 = 0x0C;
+const uint8_t TypeBool = 0x0D;
+const uint8_t TypeBinary = 0x0E;
+const uint8_t TypeGuid = 0x0F;
+const uint8_t TypeSizeT = 0x10;
+const uint8_t TypeFileTime = 0x11;
+const uint8_t TypeSystemTime = 0x12;
+const uint8_t TypeSid = 0x13;
+const uint8_t TypeHexInt32 = 0x14;
+const uint8_t TypeHexInt64 = 0x15;
+const uint8_t TypeStringArray = 0x81;
+
+enum class Element { Other, System, Provider, EventID, Level, TimeCreated, EventData, Data };
+enum class AttributeKind { None, ProviderName, SystemTime, DataName, Other };
+
+using BinaryRead::readU16;
+using BinaryRead::readU32;
+using BinaryRead::readU64;
+
+void appendFormat(std::string& out, const char* format, unsigned long long value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), format, value);
+    if (length > 0) out.append(buffer, static_cast<size_t>(length));
+}
+
+void appendSigned(std::string& out, long long value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+    if (length > 0) out.append(buffer, static_cast<size_t>(length));
+}
+
+// FILETIME as ISO 8601 UTC, the form Event Viewer shows in XML view
+void appendFileTime(std::string& out, uint64_t fileTime) {
+    uint64_t seconds = fileTime / 10000000ULL;
+    unsigned fraction = static_cast<unsigned>(fileTime % 10000000ULL);
+    int64_t days = static_cast<int64_t>(seconds / 86400) - 134774;   // 1601-01-01 to 1970-01-01
+    unsigned secondOfDay = static_cast<unsigned>(seconds % 86400);
+
+    // Civil date from days since 1970-01-01
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned mp = (5 * dayOfYear + 2) / 153;
+    unsigned day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    long long year = static_cast<long long>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+
+    char buffer[40];
+    int length = std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02uT%02u:%02u:%02u.%07uZ", year, month, day,
+                               secondOfDay / 3600, (secondOfDay / 60) % 60, secondOfDay % 60, fraction);
+    if (length > 0) out.append(buffer, static_cast<size_t>(length));
+}
+
+void appendSid(std::string& out, const unsigned char* p, uint32_t size) {
+    if (size < 8 || size < 8u + p[1] * 4u) return;
+
+    uint64_t authority = 0;
+    for (int i = 2; i < 8; ++i) authority = (authority << 8) | p[i];
+
+    appendFormat(out, "S-%llu", p[0]);
+    appendFormat(out, "-%llu", authority);
+    for (uint32_t i = 0; i < p[1]; ++i) {
+        appendFormat(out, "-%llu", readU32(p + 8 + i * 4));
+    }
+}
+
+// Render a substitution value as text (numbers decimal, hex types 0x-prefixed)
+void appendValue(std::string& out, uint8_t type, const unsigned char* p, uint32_t size) {
+    switch (type) {
+    case TypeString:
+        while (size >= 2 && p[size - 2] == 0 && p[size - 1] == 0) size -= 2;
+        TextEncoding::appendUtf16LE(out, reinterpret_cast<const char*>(p), size);
+        break;
+    case TypeAnsiString:
+        while (size > 0 && p[size - 1] == 0) size--;
+        out.append(reinterpret_cast<const char*>(p), size);
+        break;
+    case TypeInt8:
+        if (size >= 1) appendSigned(out, static_cast<int8_t>(p[0]));
+        break;
+    case TypeUInt8:
+        if (size >= 1) appendFormat(out, "%llu", p[0]);
+        break;
+    case TypeInt16:
+        if (size >= 2) appendSigned(out, static_cast<int16_t>(readU16(p)));
+        break;
+    case TypeUInt16:
+        if (size >= 2) appendFormat(out, "%llu", readU16(p));
+        break;
+    case TypeInt32:
+        if (size >= 4) appendSigned(out, static_cast<int32_t>(readU32(p)));
+        break;
+    case TypeUInt32:
+        if (size >= 4) appendFormat(out, "%llu", readU32(p));
+        break;
+    case TypeInt64:
+        if (size >= 8) appendSigned(out, static_cast<long long>(readU64(p)));
+        break;
+    case TypeUInt64:
+        if (size >= 8) appendFormat(out, "%llu", readU64(p));
+        break;
+    case TypeReal32:
+        if (size >= 4) {
+            float value;
+            std::memcpy(&value, p, sizeof(value));
+            char buffer[32];
+            int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+            if (length > 0) out.append(buffer, static_cast<size_t>(length));
+        }
+        break;
+    case TypeReal64:
+        if (size >= 8) {
+            double value;
+            std::memcpy(&value, p, sizeof(value));
+            char buffer[32];
+            int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+            if (length > 0) out.append(buffer, static_cast<size_t>(length));
+        }
+        break;
+    case TypeBool:
+        if (size >= 4) out += readU32(p) != 0 ? "true" : "false";
+        break;
+    case TypeBinary:
+        for (uint32_t i = 0; i < size; ++i) appendFormat(out, "%02llX", p[i]);
+        break;
+    case TypeGuid:
+        if (size >= 16) {
+            char buffer[40];
+            int length = std::snprintf(buffer, sizeof(buffer), "{%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
+                                       readU32(p), readU16(p + 4), readU16(p + 6), p[8], p[9],
+                                       p[10], p[11], p[12], p[13], p[14], p[15]);
+            if (length > 0) out.append(buffer, static_cast<size_t>(length));
+        }
+        break;
+    case TypeSizeT:
+    case TypeHexInt32:
+    case TypeHexInt64:
+        if (size >= 8) appendFormat(out, "0x%llx", readU64(p));
+        else if (size >= 4) appendFormat(out, "0x%llx", readU32(p));
+        break;
+    case TypeFileTime:
+        if (size >= 8) appendFileTime(out, readU64(p));
+        break;
+    case TypeSystemTime:
+        if (size >= 16) {
+            char buffer[40];
+            int length = std::snprintf(buffer, sizeof(buffer), "%04u-%02u-%02uT%02u:%02u:%02u.%03uZ",
+                                       readU16(p), readU16(p + 2), readU16(p + 6), readU16(p + 8),
+                                       readU16(p + 10), readU16(p + 12), readU16(p + 14));
+            if (length > 0) out.append(buffer, static_cast<size_t>(length));
+        }
+        break;
+    case TypeSid:
+        appendSid(out, p, size);
+        break;
+    case TypeStringArray: {
+        // NUL-separated UTF-16 strings, joined with ", "
+        uint32_t start = 0;
+        bool first = true;
+        for (uint32_t i = 0; i + 1 < size; i += 2) {
+            if (p[i] == 0 && p[i + 1] == 0) {
+                if (i > start) {
+                    if (!first) out += ", ";
+                    TextEncoding::appendUtf16LE(out, reinterpret_cast<const char*>(p + start), i - start);
+                    first = false;
+                }
+                start = i + 2;
+            }
+        }
+        if (start + 1 < size) {
+            if (!first) out += ", ";
+            TextEncoding::appendUtf16LE(out, reinterpret_cast<const char*>(p + start), (size - start) & ~1u);
+        }
+        break;
+    }
+    default:
+        break;   // null, nested BinXML and other arrays are not rendered
+    }
+}
+
+// Integer form of a numeric substitution (EventID, Level)
+bool valueInteger(uint8_t type, const unsigned char* p, uint32_t size, uint64_t& value) {
+    switch (type) {
+    case TypeInt8: case TypeUInt8:
+        if (size < 1) return false;
+        value = p[0];
+        return true;
+    case TypeInt16: case TypeUInt16:
+        if (size < 2) return false;
+        value = readU16(p);
+        return true;
+    case TypeInt32: case TypeUInt32: case TypeHexInt32: case TypeBool:
+        if (size < 4) return false;
+        value = readU32(p);
+        return true;
+    case TypeInt64: case TypeUInt64: case TypeHexInt64: case TypeFileTime:
+        if (size < 8) return false;
+        value = readU64(p);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool parseInteger(std::string_view text, uint64_t& value) {
+    if (text.empty()) return false;
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
+
+// Where a template gets one of its values from: a substitution or literal text
+struct Slot {
+    int substitution = -1;
+    std::string literal;
+    bool present = false;
+};
+
+struct DataSlot {
+    uint16_t name;
+    Slot value;
+};
+
+// What a template definition means for the compact record
+struct TemplateLayout {
+    bool valid = false;
+    Slot eventId;
+    Slot level;
+    Slot provider;
+    Slot timeCreated;
+    std::vector<DataSlot> data;
+};
+
+struct ChunkResult {
+    bool valid = false;
+    std::vector<EventRecord> events;
+    std::vector<EventField> fields;
+    std::string text;
+    std::vector<std::string> providers;
+    std::vector<std::string> fieldNames;
+    size_t corrupt = 0;
+};
+
+struct SubstitutionValue {
+    uint32_t offset;
+    uint16_t size;
+    uint8_t type;
+};
+
+// Decodes the records of one chunk. Offsets are chunk-relative, as in BinXML.
+class ChunkDecoder {
+public:
+    ChunkDecoder(const unsigned char* chunkData, const std::bitset<65536>* events,
+                 const std::vector<std::string>& fields, bool decodeFields, ChunkResult& result)
+        : chunk(chunkData), eventFilter(events), fieldFilter(fields), anyFields(decodeFields), out(result) {}
+
+    void decode() {
+        if (std::memcmp(chunk, "ElfChnk\0", 8) != 0) {
+            return;
+        }
+        out.valid = true;
+
+        // Typical chunks hold a few hundred records
+        out.events.reserve(256);
+        out.fields.reserve(1024);
+        out.text.reserve(ChunkSize / 2);
+
+        uint32_t freeSpace = readU32(chunk + 48);
+        if (freeSpace < ChunkHeaderSize || freeSpace > ChunkSize) {
+            freeSpace = ChunkSize;
+        }
+
+        uint32_t pos = ChunkHeaderSize;
+        while (fits(pos, RecordHeaderSize + 4, freeSpace) && readU32(chunk + pos) == RecordSignature) {
+            uint32_t size = readU32(chunk + pos + 4);
+            if (size < RecordHeaderSize + 4 || size > freeSpace - pos) {
+                out.corrupt++;
+                break;
+            }
+            if (!decodeRecord(pos, size)) {
+                out.corrupt++;
+            }
+            pos += size;
+        }
+    }
+
+private:
+    const unsigned char* chunk;
+    const std::bitset<65536>* eventFilter;
+    const std::vector<std::string>& fieldFilter;
+    bool anyFields;
+    ChunkResult& out;
+
+    std::unordered_map<uint32_t, TemplateLayout> layouts;
+    std::unordered_map<std::string, uint16_t> providerIndex;
+    std::unordered_map<std::string, uint16_t> fieldIndex;
+    std::vector<SubstitutionValue> values;
+    std::string scratch;
+
+    // length bytes from pos lie before end; compares by subtraction so a
+    // length read from the file cannot wrap the offset
+    static bool fits(uint32_t pos, uint32_t length, uint32_t end) {
+        return pos <= end && length <= end - pos;
+    }
+
+    static bool has(uint32_t pos, uint32_t length) { return fits(pos, length, ChunkSize); }
+
+    // Name strings: next offset (4), hash (2), character count (2), UTF-16, NUL
+    bool nameEquals(uint32_t offset, const char* name) const {
+        if (!has(offset, 8)) return false;
+        uint16_t length = readU16(chunk + offset + 6);
+        if (length != std::strlen(name) || !has(offset + 8, length * 2u)) return false;
+        for (uint16_t i = 0; i < length; ++i) {
+            if (readU16(chunk + offset + 8 + i * 2) != static_cast<unsigned char>(name[i])) return false;
+        }
+        return true;
+    }
+
+    // A name defined at the point of first use is stored inline; skip it
+    bool skipInlineName(uint32_t& pos, uint32_t nameOffset) const {
+        if (nameOffset != pos) return true;
+        if (!has(pos, 8)) return false;
+        uint32_t length = 8 + readU16(chunk + pos + 6) * 2u + 2;
+        if (!has(pos, length)) return false;
+        pos += length;
+        return true;
+    }
+
+    Element classifyElement(uint32_t nameOffset, Element parent) const {
+        if (nameEquals(nameOffset, "System")) return Element::System;
+        if (nameEquals(nameOffset, "EventData")) return Element::EventData;
+        if (parent == Element::System) {
+            if (nameEquals(nameOffset, "Provider")) return Element::Provider;
+            if (nameEquals(nameOffset, "EventID")) return Element::EventID;
+            if (nameEquals(nameOffset, "Level")) return Element::Level;
+            if (nameEquals(nameOffset, "TimeCreated")) return Element::TimeCreated;
+        }
+        if (parent == Element::EventData && nameEquals(nameOffset, "Data")) return Element::Data;
+        return Element::Other;
+    }
+
+    AttributeKind classifyAttribute(uint32_t nameOffset, Element element) const {
+        if (nameEquals(nameOffset, "Name")) {
+            if (element == Element::Provider) return AttributeKind::ProviderName;
+            if (element == Element::Data) return AttributeKind::DataName;
+        }
+        if (element == Element::TimeCreated && nameEquals(nameOffset, "SystemTime")) return AttributeKind::SystemTime;
+        return AttributeKind::Other;
+    }
+
+    uint16_t internField(const std::string& name) {
+        auto it = fieldIndex.find(name);
+        if (it != fieldIndex.end()) return it->second;
+        uint16_t id = static_cast<uint16_t>(out.fieldNames.size());
+        out.fieldNames.push_back(name);
+        fieldIndex.emplace(name, id);
+        return id;
+    }
+
+    bool fieldWanted(const std::string& name) const {
+        if (fieldFilter.empty()) return true;
+        for (const auto& wanted : fieldFilter) {
+            if (wanted == name) return true;
+        }
+        return false;
+    }
+
+    // Walk a template definition once and record where each value comes from
+    void buildLayout(uint32_t definition, TemplateLayout& layout) {
+        if (!has(definition, 24)) return;
+        uint32_t pos = definition + 24;
+        uint32_t dataSize = readU32(chunk + definition + 20);
+        if (!has(pos, dataSize)) return;
+        uint32_t end = pos + dataSize;
+
+        std::vector<Element> stack;
+        AttributeKind attribute = AttributeKind::None;
+        std::string dataName;
+        int unnamedData = 0;
+
+        auto assign = [&](const Slot& slot) {
+            Element element = stack.empty() ? Element::Other : stack.back();
+            switch (attribute) {
+            case AttributeKind::ProviderName: layout.provider = slot; return;
+            case AttributeKind::SystemTime: layout.timeCreated = slot; return;
+            case AttributeKind::DataName: dataName = slot.literal; return;
+            case AttributeKind::Other: return;
+            case AttributeKind::None: break;
+            }
+            if (element == Element::EventID) layout.eventId = slot;
+            else if (element == Element::Level) layout.level = slot;
+            else if (element == Element::Data && anyFields) {
+                std::string name = dataName.empty() ? "Data" + std::to_string(unnamedData) : dataName;
+                if (fieldWanted(name)) {
+                    layout.data.push_back(DataSlot{ internField(name), slot });
+                }
+            }
+        };
+
+        while (pos < end) {
+            uint8_t token = chunk[pos];
+            switch (token & ~TokenMoreBit) {
+            case TokenFragmentHeader:
+                pos += 4;
+                break;
+            case TokenOpenStartElement: {
+                if (!has(pos, 11)) return;
+                uint32_t nameOffset = readU32(chunk + pos + 7);
+                pos += (token & TokenMoreBit) ? 15 : 11;
+                if (!skipInlineName(pos, nameOffset)) return;
+                Element element = classifyElement(nameOffset, stack.empty() ? Element::Other : stack.back());
+                if (element == Element::Data) {
+                    dataName.clear();
+                    unnamedData++;
+                }
+                stack.push_back(element);
+                attribute = AttributeKind::None;
+                break;
+            }
+            case TokenCloseStartElement:
+                pos += 1;
+                attribute = AttributeKind::None;
+                break;
+            case TokenCloseEmptyElement:
+            case TokenEndElement:
+                pos += 1;
+                if (!stack.empty()) stack.pop_back();
+                attribute = AttributeKind::None;
+                break;
+            case TokenAttribute: {
+                if (!has(pos, 5)) return;
+                uint32_t nameOffset = readU32(chunk + pos + 1);
+                pos += 5;
+                if (!skipInlineName(pos, nameOffset)) return;
+                attribute = classifyAttribute(nameOffset, stack.empty() ? Element::Other : stack.back());
+                break;
+            }
+            case TokenValue: {
+                if (!has(pos, 4)) return;
+                uint32_t length = readU16(chunk + pos + 2) * 2u;
+                if (!has(pos + 4, length)) return;
+                Slot slot;
+                slot.present = true;
+                slot.literal = TextEncoding::utf16LEToUtf8(reinterpret_cast<const char*>(chunk + pos + 4), length);
+                pos += 4 + length;
+                assign(slot);
+                break;
+            }
+            case TokenNormalSubstitution:
+            case TokenOptionalSubstitution: {
+                if (!has(pos, 4)) return;
+                Slot slot;
+                slot.present = true;
+                slot.substitution = readU16(chunk + pos + 1);
+                pos += 4;
+                assign(slot);
+                break;
+            }
+            case TokenCData:
+            case TokenPIData:
+            {
+                if (!has(pos, 3)) return;
+                uint32_t length = 3 + readU16(chunk + pos + 1) * 2u;
+                if (!has(pos, length)) return;
+                pos += length;
+                break;
+            }
+            case TokenCharRef:
+                pos += 3;
+                break;
+            case TokenEntityRef:
+            case TokenPITarget: {
+                if (!has(pos, 5)) return;
+                uint32_t nameOffset = readU32(chunk + pos + 1);
+                pos += 5;
+                if (!skipInlineName(pos, nameOffset)) return;
+                break;
+            }
+            case TokenEof:
+                pos = end;
+                break;
+            default:
+                return;   // unknown token: leave the layout invalid
+            }
+        }
+
+        layout.valid = true;
+    }
+
+    const TemplateLayout& layoutFor(uint32_t definition) {
+        auto it = layouts.find(definition);
+        if (it != layouts.end()) return it->second;
+        TemplateLayout& layout = layouts[definition];
+        buildLayout(definition, layout);
+        return layout;
+    }
+
+    const SubstitutionValue* substitution(const Slot& slot) const {
+        if (slot.substitution < 0 || static_cast<size_t>(slot.substitution) >= values.size()) return nullptr;
+        return &values[slot.substitution];
+    }
+
+    bool slotInteger(const Slot& slot, uint64_t& value) const {
+        if (!slot.present) return false;
+        if (const SubstitutionValue* v = substitution(slot)) {
+            return valueInteger(v->type, chunk + v->offset, v->size, value);
+        }
+        return slot.substitution < 0 && parseInteger(slot.literal, value);
+    }
+
+    bool decodeRecord(uint32_t record, uint32_t size) {
+        uint32_t pos = record + RecordHeaderSize;
+        uint32_t end = record + size - 4;
+
+        if (fits(pos, 4, end) && chunk[pos] == TokenFragmentHeader) pos += 4;
+        if (!fits(pos, 10, end) || chunk[pos] != TokenTemplateInstance) return false;
+
+        uint32_t definition = readU32(chunk + pos + 6);
+        pos += 10;
+
+        // The template definition follows inline the first time it is used
+        if (definition == pos) {
+            if (!fits(pos, 24, end)) return false;
+            uint32_t templateSize = readU32(chunk + pos + 20);
+            if (!fits(pos + 24, templateSize, end)) return false;
+            pos += 24 + templateSize;
+        }
+        if (!fits(pos, 4, end)) return false;
+
+        // Substitution array: count, (size, type) descriptors, then the values
+        uint32_t count = readU32(chunk + pos);
+        pos += 4;
+        if (count > (end - pos) / 4) return false;
+
+        values.clear();
+        uint32_t valuePos = pos + count * 4;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint16_t valueSize = readU16(chunk + pos + i * 4);
+            uint8_t valueType = chunk[pos + i * 4 + 2];
+            if (valueSize > end - valuePos) return false;
+            values.push_back(SubstitutionValue{ valuePos, valueSize, valueType });
+            valuePos += valueSize;
+        }
+
+        const TemplateLayout& layout = layoutFor(definition);
+        if (!layout.valid) return false;
+
+        EventRecord event;
+        event.recordId = readU64(chunk + record + 8);
+        event.timestamp = readU64(chunk + record + 16);
+
+        uint64_t number = 0;
+        if (slotInteger(layout.eventId, number)) event.eventId = static_cast<uint16_t>(number);
+        if (eventFilter != nullptr && !eventFilter->test(event.eventId)) {
+            return true;
+        }
+        if (slotInteger(layout.level, number)) event.level = static_cast<uint8_t>(number);
+
+        const SubstitutionValue* time = substitution(layout.timeCreated);
+        if (time != nullptr && time->type == TypeFileTime && time->size >= 8) {
+            event.timestamp = readU64(chunk + time->offset);
+        }
+
+        // Provider name, interned per chunk
+        scratch.clear();
+        if (const SubstitutionValue* v = substitution(layout.provider)) {
+            appendValue(scratch, v->type, chunk + v->offset, v->size);
+        } else {
+            scratch = layout.provider.literal;
+        }
+        auto provider = providerIndex.find(scratch);
+        if (provider == providerIndex.end()) {
+            provider = providerIndex.emplace(scratch, static_cast<uint16_t>(out.providers.size())).first;
+            out.providers.push_back(scratch);
+        }
+        event.provider = provider->second;
+
+        event.firstField = static_cast<uint32_t>(out.fields.size());
+        for (const auto& data : layout.data) {
+            size_t start = out.text.size();
+            if (const SubstitutionValue* v = substitution(data.value)) {
+                appendValue(out.text, v->type, chunk + v->offset, v->size);
+            } else if (data.value.substitution < 0) {
+                out.text += data.value.literal;
+            }
+            out.fields.push_back(EventField{ data.name, static_cast<uint32_t>(out.text.size() - start), start });
+        }
+        event.fieldCount = static_cast<uint16_t>(layout.data.size());
+
+        out.events.push_back(event);
+        return true;
+    }
+};
+
+} // namespace
+
+void EventRecordSet::clear() {
+    events.clear();
+    fields.clear();
+    text.clear();
+    providers.clear();
+    fieldNames.clear();
+    chunks = 0;
+    corrupt = 0;
+}
+
+int EventRecordSet::fieldId(std::string_view name) const {
+    for (size_t i = 0; i < fieldNames.size(); ++i) {
+        if (fieldNames[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+std::string_view EventRecordSet::field(const EventRecord& record, int id) const {
+    if (id < 0) return std::string_view();
+    for (uint32_t i = 0; i < record.fieldCount; ++i) {
+        const EventField& f = fields[record.firstField + i];
+        if (f.name == id) return std::string_view(text.data() + f.offset, f.length);
+    }
+    return std::string_view();
+}
+
+size_t EventRecordSet::count(uint16_t eventId) const {
+    size_t total = 0;
+    for (const auto& event : events) {
+        if (event.eventId == eventId) total++;
+    }
+    return total;
+}
+
+void EvtxParser::setEventFilter(const std::vector<uint16_t>& eventIds) {
+    eventFilter.reset();
+    for (uint16_t id : eventIds) eventFilter.set(id);
+    filterEvents = !eventIds.empty();
+}
+
+void EvtxParser::setFieldFilter(const std::vector<std::string>& names) {
+    fieldFilter = names;
+}
+
+bool EvtxParser::parseFile(const std::string& path, EventRecordSet& events) const {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    return parseMemory(file.bytes(), file.size(), events);
+}
+
+bool EvtxParser::parseMemory(const void* data, size_t size, EventRecordSet& events) const {
+    events.clear();
+
+    const unsigned char* base = static_cast<const unsigned char*>(data);
+    if (base == nullptr || size < FileHeaderSize || std::memcmp(base, "ElfFile\0", 8) != 0) {
+        return false;
+    }
+
+    // Chunks are independent; the header's chunk count can be stale, so use the file size
+    size_t chunkCount = (size - FileHeaderSize) / ChunkSize;
+    std::vector<ChunkResult> results(chunkCount);
+    const std::bitset<65536>* filter = filterEvents ? &eventFilter : nullptr;
+
+    std::atomic<size_t> nextChunk{ 0 };
+    auto worker = [&]() {
+        for (size_t i = nextChunk++; i < chunkCount; i = nextChunk++) {
+            ChunkDecoder decoder(base + FileHeaderSize + i * ChunkSize, filter, fieldFilter, decodeFields, results[i]);
+            decoder.decode();
+        }
+    };
+
+    unsigned workers = threadCount != 0 ? threadCount : std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+    if (workers > chunkCount) workers = static_cast<unsigned>(chunkCount > 0 ? chunkCount : 1);
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Merge in file order, remapping per-chunk provider and field name indexes
+    size_t totalEvents = 0, totalFields = 0, totalText = 0;
+    for (const auto& chunk : results) {
+        totalEvents += chunk.events.size();
+        totalFields += chunk.fields.size();
+        totalText += chunk.text.size();
+    }
+    events.events.reserve(totalEvents);
+    events.fields.reserve(totalFields);
+    events.text.reserve(totalText);
+
+    std::unordered_map<std::string, uint16_t> providerIndex, fieldIndex;
+    std::vector<uint16_t> providerMap, fieldMap;
+
+    auto intern = [](std::unordered_map<std::string, uint16_t>& index, std::vector<std::string>& names, const std::string& name) {
+        auto it = index.find(name);
+        if (it != index.end()) return it->second;
+        uint16_t id = static_cast<uint16_t>(names.size());
+        names.push_back(name);
+        index.emplace(name, id);
+        return id;
+    };
+
+    for (auto& chunk : results) {
+        if (!chunk.valid) continue;
+        events.chunks++;
+        events.corrupt += chunk.corrupt;
+
+        providerMap.clear();
+        for (const auto& name : chunk.providers) providerMap.push_back(intern(providerIndex, events.providers, name));
+        fieldMap.clear();
+        for (const auto& name : chunk.fieldNames) fieldMap.push_back(intern(fieldIndex, events.fieldNames, name));
+
+        uint32_t fieldBase = static_cast<uint32_t>(events.fields.size());
+        uint64_t textBase = events.text.size();
+
+        for (EventRecord event : chunk.events) {
+            event.provider = providerMap[event.provider];
+            event.firstField += fieldBase;
+            events.events.push_back(event);
+        }
+        for (EventField field : chunk.fields) {
+            field.name = fieldMap[field.name];
+            field.offset += textBase;
+            events.fields.push_back(field);
+        }
+        events.text += chunk.text;
+
+        // Release the chunk as soon as it is merged
+        chunk = ChunkResult();
+    }
+
+    return true;
+}
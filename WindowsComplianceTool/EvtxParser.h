@@ -0,0 +1,105 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One decoded event. Provider and field names are indexes into the owning
+// EventRecordSet, field values live in its shared text buffer.
+struct EventRecord {
+    uint64_t recordId = 0;
+    uint64_t timestamp = 0;     // FILETIME (TimeCreated, or the record header time)
+    uint16_t eventId = 0;
+    uint8_t level = 0;
+    uint16_t provider = 0;
+    uint16_t fieldCount = 0;
+    uint32_t firstField = 0;
+};
+
+// EventData field of a record
+struct EventField {
+    uint16_t name;
+    uint32_t length;
+    uint64_t offset;
+};
+
+// Events decoded from an .evtx file, in file order
+class EventRecordSet {
+public:
+    const std::vector<EventRecord>& records() const { return events; }
+    size_t size() const { return events.size(); }
+    bool empty() const { return events.empty(); }
+    void clear();
+
+    std::string_view providerName(const EventRecord& record) const { return providers[record.provider]; }
+
+    // Field name index for lookups, -1 if no event carried the field
+    int fieldId(std::string_view name) const;
+
+    std::string_view field(const EventRecord& record, int fieldId) const;
+    std::string_view field(const EventRecord& record, std::string_view name) const { return field(record, fieldId(name)); }
+
+    // Every EventData field of a record: fn(name, value)
+    template <typename Fn>
+    void forEachField(const EventRecord& record, Fn&& fn) const {
+        for (uint32_t i = 0; i < record.fieldCount; ++i) {
+            const EventField& f = fields[record.firstField + i];
+            fn(std::string_view(fieldNames[f.name]), std::string_view(text.data() + f.offset, f.length));
+        }
+    }
+
+    size_t count(uint16_t eventId) const;
+
+    // Parse statistics
+    size_t chunkCount() const { return chunks; }
+    size_t corruptRecords() const { return corrupt; }
+
+private:
+    friend class EvtxParser;
+
+    std::vector<EventRecord> events;
+    std::vector<EventField> fields;
+    std::string text;
+    std::vector<std::string> providers;
+    std::vector<std::string> fieldNames;
+    size_t chunks = 0;
+    size_t corrupt = 0;
+};
+
+// Parser for exported Windows event logs (.evtx). The file is memory-mapped
+// and its 64 KB chunks, which are self-contained (own string and template
+// tables), are decoded in parallel and merged in file order.
+//
+// BinXML is not rendered to XML: each template is walked once per chunk to
+// find which substitution holds EventID, Level, Provider, TimeCreated and
+// every EventData <Data Name=...> value, then records are decoded straight
+// from their substitution arrays. UserData payloads are not decoded.
+class EvtxParser {
+public:
+    // Keep only these event IDs (empty = all events)
+    void setEventFilter(const std::vector<uint16_t>& eventIds);
+
+    // Keep only these EventData fields (empty = all fields)
+    void setFieldFilter(const std::vector<std::string>& names);
+
+    // Skip EventData entirely when only ids, levels, providers and times are read
+    void setDecodeFields(bool value) { decodeFields = value; }
+
+    // Worker threads; 0 uses every core
+    void setThreadCount(unsigned count) { threadCount = count; }
+
+    bool parseFile(const std::string& path, EventRecordSet& events) const;
+
+    // Parse an .evtx image already in memory
+    bool parseMemory(const void* data, size_t size, EventRecordSet& events) const;
+
+    static const size_t ChunkSize = 65536;
+
+private:
+    std::bitset<65536> eventFilter;
+    bool filterEvents = false;
+    std::vector<std::string> fieldFilter;
+    bool decodeFields = true;
+    unsigned threadCount = 0;
+};
@@ -0,0 +1,149 @@
+#include "FactTable.h"
+#include "GroupPolicy.h"
+#include "SecurityPolicy.h"
+#include "TextUtil.h"
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+using TextUtil::parseNumber;
+
+const struct { const char* abbreviation; const char* root; } RootKeys[] = {
+    { "HKLM", "HKEY_LOCAL_MACHINE" },
+    { "HKCU", "HKEY_CURRENT_USER" },
+    { "HKU", "HKEY_USERS" },
+    { "HKCR", "HKEY_CLASSES_ROOT" }
+};
+
+} // namespace
+
+uint32_t FactTable::hashName(std::string_view name) {
+    return TextUtil::hashIgnoreCase(name);
+}
+
+std::string FactTable::canonicalKeyPath(std::string_view keyPath) {
+    size_t separator = keyPath.find('\\');
+    std::string_view root = keyPath.substr(0, separator);
+    for (const auto& entry : RootKeys) {
+        if (equalsIgnoreCase(root, entry.abbreviation)) {
+            std::string path = entry.root;
+            if (separator != std::string_view::npos) path.append(keyPath.substr(separator));
+            return path;
+        }
+    }
+    return std::string(keyPath);
+}
+
+std::string FactTable::registryName(std::string_view keyPath, std::string_view valueName) {
+    std::string name = canonicalKeyPath(keyPath);
+    name += '\\';
+    name.append(valueName);
+    return name;
+}
+
+std::string FactTable::securityPolicyName(std::string_view section, std::string_view key) {
+    std::string name = "SecurityPolicy\\";
+    name.append(section);
+    name += '\\';
+    name.append(key);
+    return name;
+}
+
+uint32_t FactTable::find(std::string_view name, uint32_t hash) const {
+    if (slots.empty()) return NotFound;
+    size_t mask = slots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t id = slots[slot];
+        if (id == NotFound) return NotFound;
+        const Entry& entry = entries[id];
+        if (entry.hash == hash && equalsIgnoreCase(std::string_view(names).substr(entry.nameOffset, entry.nameLength), name)) {
+            return id;
+        }
+    }
+}
+
+std::string_view FactTable::name(uint32_t id) const {
+    const Entry& entry = entries[id];
+    return std::string_view(names).substr(entry.nameOffset, entry.nameLength);
+}
+
+void FactTable::set(std::string_view name, std::string_view value) {
+    uint32_t hash = hashName(name);
+    uint32_t id = find(name, hash);
+    if (id == NotFound) {
+        if ((entries.size() + 1) * 2 > slots.size()) grow();
+        id = static_cast<uint32_t>(entries.size());
+        entries.push_back({ static_cast<uint32_t>(names.size()), static_cast<uint32_t>(name.size()), hash, false, 0, std::string() });
+        names.append(name);
+
+        size_t mask = slots.size() - 1;
+        size_t slot = hash & mask;
+        while (slots[slot] != NotFound) slot = (slot + 1) & mask;
+        slots[slot] = id;
+    }
+
+    Entry& entry = entries[id];
+    entry.value.assign(value.data(), value.size());
+    entry.numeric = parseNumber(value, entry.number);
+}
+
+void FactTable::grow() {
+    slots.assign(slots.empty() ? 256 : slots.size() * 2, NotFound);
+    size_t mask = slots.size() - 1;
+    for (uint32_t id = 0; id < entries.size(); ++id) {
+        size_t slot = entries[id].hash & mask;
+        while (slots[slot] != NotFound) slot = (slot + 1) & mask;
+        slots[slot] = id;
+    }
+}
+
+void FactTable::clear() {
+    entries.clear();
+    names.clear();
+    slots.clear();
+}
+
+void FactTable::truncate(size_t count) {
+    if (count >= entries.size()) return;
+    // Newer facts were placed after every older probe sequence was complete,
+    // so emptying their slots never cuts one short
+    size_t mask = slots.size() - 1;
+    for (uint32_t id = static_cast<uint32_t>(entries.size()); id-- > count;) {
+        size_t slot = entries[id].hash & mask;
+        while (slots[slot] != id) slot = (slot + 1) & mask;
+        slots[slot] = NotFound;
+    }
+    names.resize(entries[count].nameOffset);
+    entries.resize(count);
+}
+
+void FactTable::addRegistryValues(std::string_view keyPath, const std::vector<std::pair<std::string, std::string>>& values) {
+    std::string name = canonicalKeyPath(keyPath);
+    name += '\\';
+    size_t prefix = name.size();
+    for (const auto& value : values) {
+        name.resize(prefix);
+        name += value.first;
+        set(name, value.second);
+    }
+}
+
+void FactTable::addGroupPolicy(const GroupPolicy& policy) {
+    std::string name;
+    policy.forEachSetting([&](const PolicySetting& setting) {
+        if (setting.deleted) return;
+        name = GroupPolicy::fullKeyPath(setting);
+        name += '\\';
+        name += setting.valueName;
+        set(name, setting.text());
+    });
+}
+
+void FactTable::addSecurityPolicy(const SecurityPolicy& policy) {
+    std::string name;
+    policy.forEachSetting([&](std::string_view key, std::string_view value) {
+        name = "SecurityPolicy\\";
+        name.append(key);
+        set(name, value);
+    });
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class GroupPolicy;
+class SecurityPolicy;
+
+// Settings collected from one host, indexed by name in a single
+// open-addressing hash table (case-insensitive). Registry values are named
+// by their full path, "HKEY_LOCAL_MACHINE\<key>\<value name>"; secedit
+// values by "SecurityPolicy\<section>\<key>". Numeric values are parsed
+// once when stored so comparisons never re-parse text.
+class FactTable {
+public:
+    static constexpr uint32_t NotFound = 0xFFFFFFFFu;
+
+    // Store or replace a fact
+    void set(std::string_view name, std::string_view value);
+
+    // Fact id, NotFound if the host did not report it. Callers that look
+    // the same name up on many hosts can precompute the hash.
+    uint32_t find(std::string_view name) const { return find(name, hashName(name)); }
+    uint32_t find(std::string_view name, uint32_t hash) const;
+
+    std::string_view name(uint32_t id) const;
+    const std::string& value(uint32_t id) const { return entries[id].value; }
+
+    // Decimal value, false if the fact is not a number
+    bool number(uint32_t id, int64_t& result) const {
+        const Entry& entry = entries[id];
+        result = entry.number;
+        return entry.numeric;
+    }
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    void clear();
+
+    // Drop the facts added since the table held count facts, newest first;
+    // ids below count are unchanged (undoing a trial change)
+    void truncate(size_t count);
+
+    // Every value of one registry key, as read by readValues
+    void addRegistryValues(std::string_view keyPath, const std::vector<std::pair<std::string, std::string>>& values);
+
+    // Values configured by policy (deleted values are skipped)
+    void addGroupPolicy(const GroupPolicy& policy);
+
+    // Every secedit value
+    void addSecurityPolicy(const SecurityPolicy& policy);
+
+    static uint32_t hashName(std::string_view name);
+
+    // Registry fact name for a key and value; HKLM / HKCU / HKU / HKCR
+    // abbreviations are expanded
+    static std::string registryName(std::string_view keyPath, std::string_view valueName);
+
+    // Expand a leading root key abbreviation ("HKLM\..." -> "HKEY_LOCAL_MACHINE\...")
+    static std::string canonicalKeyPath(std::string_view keyPath);
+
+    static std::string securityPolicyName(std::string_view section, std::string_view key);
+
+private:
+    struct Entry {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t hash;
+        bool numeric;
+        int64_t number;
+        std::string value;
+    };
+
+    std::vector<Entry> entries;
+    std::string names;
+    std::vector<uint32_t> slots;      // entry ids, NotFound = empty
+
+    void grow();
+};
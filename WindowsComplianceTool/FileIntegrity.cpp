@@ -0,0 +1,254 @@
+#include "FileIntegrity.h"
+#include "CsvReader.h"
+#include "MappedFile.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+
+bool parseInteger(std::string_view text, int64_t& value) {
+    bool negative = !text.empty() && text.front() == '-';
+    if (negative) text.remove_prefix(1);
+    if (text.empty()) return false;
+    uint64_t result = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        result = result * 10 + static_cast<uint64_t>(c - '0');
+    }
+    value = negative ? -static_cast<int64_t>(result) : static_cast<int64_t>(result);
+    return true;
+}
+
+// Executables, libraries, drivers and other code Windows loads
+const char* const BinaryExtensions[] = {
+    ".exe", ".dll", ".sys", ".ocx", ".cpl", ".scr", ".drv", ".efi", ".com", ".mui", ".winmd"
+};
+
+// Files at least this large are mapped instead of read
+const uint64_t MapThreshold = 1024 * 1024;
+
+bool isUnreadable(const Sha256::Digest& digest) {
+    for (uint8_t byte : digest) {
+        if (byte != 0) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool FileDigestSet::pathLess(std::string_view a, std::string_view b) {
+    return TextUtil::lessIgnoreCase(a, b);
+}
+
+void FileDigestSet::sort() {
+    std::sort(entries.begin(), entries.end(), [](const FileDigest& a, const FileDigest& b) {
+        return pathLess(a.path, b.path);
+    });
+}
+
+const FileDigest* FileDigestSet::find(std::string_view path) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), path, [](const FileDigest& entry, std::string_view key) {
+        return pathLess(entry.path, key);
+    });
+    return it != entries.end() && equalsIgnoreCase(it->path, path) ? &*it : nullptr;
+}
+
+bool FileDigestSet::loadFromCsv(const CsvReader& table) {
+    int pathColumn = table.columnIndex("Path");
+    int sizeColumn = table.columnIndex("Size");
+    int modifiedColumn = table.columnIndex("Modified");
+    int hashColumn = table.columnIndex("SHA256");
+    if (pathColumn < 0 || hashColumn < 0) return false;
+
+    entries.reserve(entries.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        FileDigest digest;
+        digest.path = row.value(pathColumn);
+        if (digest.path.empty() || !Sha256::fromHex(row[hashColumn], digest.hash)) continue;
+
+        int64_t number = 0;
+        if (parseInteger(row[sizeColumn], number) && number >= 0) digest.size = static_cast<uint64_t>(number);
+        if (parseInteger(row[modifiedColumn], number)) digest.modified = number;
+        entries.push_back(std::move(digest));
+    }
+    sort();
+    return !entries.empty();
+}
+
+bool FileDigestSet::loadFile(const std::string& path) {
+    CsvReader table;
+    return table.loadFromFile(path) && loadFromCsv(table);
+}
+
+bool FileDigestSet::saveFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    file << "Path,Size,Modified,SHA256\n";
+    for (const auto& entry : entries) {
+        line.clear();
+        line += '"';
+        for (char c : entry.path) {
+            if (c == '"') line += '"';
+            line += c;
+        }
+        line += "\",";
+        line += std::to_string(entry.size);
+        line += ',';
+        line += std::to_string(entry.modified);
+        line += ',';
+        line += Sha256::toHex(entry.hash);
+        line += '\n';
+        file << line;
+    }
+    return file.good();
+}
+
+std::vector<IntegrityChange> FileDigestSet::compare(const FileDigestSet& current) const {
+    std::vector<IntegrityChange> changes;
+    const std::vector<FileDigest>& after = current.entries;
+
+    // Both sides are sorted by path: one merge pass
+    size_t i = 0, j = 0;
+    while (i < entries.size() || j < after.size()) {
+        if (j == after.size() || (i < entries.size() && pathLess(entries[i].path, after[j].path))) {
+            changes.push_back({ IntegrityChange::Kind::Removed, entries[i].path, entries[i].size, 0 });
+            i++;
+        } else if (i == entries.size() || pathLess(after[j].path, entries[i].path)) {
+            changes.push_back({ IntegrityChange::Kind::Added, after[j].path, 0, after[j].size });
+            j++;
+        } else {
+            // A file that could not be read keeps an all-zero hash and is not compared
+            const FileDigest& before = entries[i];
+            const FileDigest& now = after[j];
+            if (!isUnreadable(before.hash) && !isUnreadable(now.hash) &&
+                (before.size != now.size || before.hash != now.hash)) {
+                changes.push_back({ IntegrityChange::Kind::Changed, now.path, before.size, now.size });
+            }
+            i++;
+            j++;
+        }
+    }
+    return changes;
+}
+
+bool FileIntegrityScanner::isBinary(std::string_view path) {
+    size_t dot = path.rfind('.');
+    if (dot == std::string_view::npos) return false;
+    std::string_view extension = path.substr(dot);
+    for (const char* binary : BinaryExtensions) {
+        if (equalsIgnoreCase(extension, binary)) return true;
+    }
+    return false;
+}
+
+bool FileIntegrityScanner::hashFile(const std::string& path, uint64_t size, Sha256::Digest& digest, std::string& buffer) {
+    std::filesystem::path native = std::filesystem::u8path(path);
+    if (size >= MapThreshold) {
+        MappedFile file;
+        if (!file.open(native)) return false;
+        digest = Sha256::hash(file.bytes(), file.size());
+        return true;
+    }
+    if (!TextEncoding::readFile(native, buffer)) return false;
+    digest = Sha256::hash(buffer.data(), buffer.size());
+    return true;
+}
+
+bool FileIntegrityScanner::scan(FileDigestSet& result, const FileDigestSet* cache) {
+    namespace fs = std::filesystem;
+    hashed = cached = unreadable = 0;
+    bytesHashed = 0;
+
+    std::vector<FileDigest>& files = result.entries;
+    files.clear();
+    for (const auto& root : roots) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+             !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            // UTF-8, as the baseline stores it; path::string() throws on
+            // Windows for names outside the ANSI code page
+            std::string path = TextEncoding::pathToUtf8(it->path());
+            if (!isBinary(path)) continue;
+
+            FileDigest digest;
+            digest.path = std::move(path);
+            digest.size = it->file_size(ec);
+            digest.modified = static_cast<int64_t>(it->last_write_time(ec).time_since_epoch().count());
+            files.push_back(std::move(digest));
+        }
+    }
+    result.sort();
+
+    // Unchanged size and modification time: reuse the cached hash
+    std::vector<uint32_t> pending;
+    pending.reserve(files.size());
+    for (uint32_t i = 0; i < files.size(); ++i) {
+        const FileDigest* previous = cache != nullptr ? cache->find(files[i].path) : nullptr;
+        if (previous != nullptr && previous->size == files[i].size && previous->modified == files[i].modified &&
+            !isUnreadable(previous->hash)) {
+            files[i].hash = previous->hash;
+            cached++;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    std::atomic<size_t> nextFile{ 0 };
+    std::atomic<size_t> failed{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+    std::atomic<size_t> done{ cached };
+    size_t reportedPercent = 0;
+    if (progressHandler) progressHandler(cached, files.size());
+    
+    // Only the calling thread reports, so the handler needs no locking
+    auto worker = [&](bool reports) {
+        std::string buffer;
+        for (size_t i = nextFile++; i < pending.size(); i = nextFile++) {
+            FileDigest& file = files[pending[i]];
+            if (hashFile(file.path, file.size, file.hash, buffer)) {
+                bytes += file.size;
+            } else {
+                file.hash = Sha256::Digest{};
+                failed++;
+            }
+            size_t count = ++done;
+            if (reports && progressHandler && count * 100 / files.size() > reportedPercent) {
+                reportedPercent = count * 100 / files.size();
+                progressHandler(count, files.size());
+            }
+        }
+    };
+
+    unsigned workers = threadCount != 0 ? threadCount : std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+    size_t maxWorkers = (pending.size() + 3) / 4;
+    if (workers > maxWorkers) workers = static_cast<unsigned>(maxWorkers > 0 ? maxWorkers : 1);
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; ++i) {
+        threads.emplace_back(worker, false);
+    }
+    worker(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (progressHandler && reportedPercent < 100) progressHandler(files.size(), files.size());
+
+    unreadable = failed;
+    hashed = pending.size() - unreadable;
+    bytesHashed = bytes;
+    return !files.empty();
+}
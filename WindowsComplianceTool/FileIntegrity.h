@@ -0,0 +1,109 @@
+#pragma once
+#include "Sha256.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class CsvReader;
+
+// Hash and metadata of one file
+struct FileDigest {
+    std::string path;
+    uint64_t size = 0;
+    int64_t modified = 0;       // last write time in file clock ticks
+    Sha256::Digest hash{};      // all zero if the file could not be read
+};
+
+struct IntegrityChange {
+    enum class Kind {
+        Added,
+        Removed,
+        Changed
+    };
+
+    Kind kind;
+    std::string path;
+    uint64_t oldSize;
+    uint64_t newSize;
+};
+
+// File digests sorted by case-insensitive path, so a baseline and a scan
+// are compared with one merge pass and a path is found by binary search.
+// Stored as CSV: Path, Size, Modified, SHA256.
+class FileDigestSet {
+public:
+    bool loadFromCsv(const CsvReader& table);
+    bool loadFile(const std::string& path);
+    bool saveFile(const std::string& path) const;
+
+    // Entries may be added in any order; call sort() before lookups
+    void add(FileDigest digest) { entries.push_back(std::move(digest)); }
+    void sort();
+
+    void clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const FileDigest& operator[](size_t index) const { return entries[index]; }
+    const std::vector<FileDigest>& digests() const { return entries; }
+
+    const FileDigest* find(std::string_view path) const;
+
+    // Files added, removed or with a different hash in current, by path
+    std::vector<IntegrityChange> compare(const FileDigestSet& current) const;
+
+    static bool pathLess(std::string_view a, std::string_view b);
+
+private:
+    friend class FileIntegrityScanner;
+
+    std::vector<FileDigest> entries;
+};
+
+// Hashes the executables under a set of root directories. The trees are
+// enumerated first (size and modification time come with the directory
+// entries), then a pool of workers hashes the files: large files are
+// memory-mapped and hashed in place, small ones are read in one call into
+// a per-worker buffer. Files whose path, size and modification time match
+// the cache reuse the cached hash, so a rescan of an unchanged tree only
+// pays for the directory walk.
+class FileIntegrityScanner {
+public:
+    void addRoot(const std::string& root) { roots.push_back(root); }
+    const std::vector<std::string>& rootDirectories() const { return roots; }
+
+    // Worker threads, 0 = hardware concurrency
+    void setThreadCount(unsigned count) { threadCount = count; }
+
+    // Called on the scanning thread with the files done (cached or hashed)
+    // and the total, each time another percent is done
+    void setProgressHandler(std::function<void(size_t, size_t)> handler) { progressHandler = std::move(handler); }
+
+    // Digests of every executable under the roots, sorted; false if no
+    // file was found
+    bool scan(FileDigestSet& result, const FileDigestSet* cache = nullptr);
+
+    // Statistics of the last scan
+    size_t hashedCount() const { return hashed; }
+    size_t cachedCount() const { return cached; }
+    size_t unreadableCount() const { return unreadable; }
+    uint64_t hashedBytes() const { return bytesHashed; }
+
+    // Executable and driver extensions covered by the baseline
+    static bool isBinary(std::string_view path);
+
+    // Hash one file by its UTF-8 path; size (from the directory entry)
+    // decides between mapping and reading into buffer
+    static bool hashFile(const std::string& path, uint64_t size, Sha256::Digest& digest, std::string& buffer);
+
+private:
+    std::vector<std::string> roots;
+    unsigned threadCount = 0;
+    std::function<void(size_t, size_t)> progressHandler;
+    size_t hashed = 0;
+    size_t cached = 0;
+    size_t unreadable = 0;
+    uint64_t bytesHashed = 0;
+};
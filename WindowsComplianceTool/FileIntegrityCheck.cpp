@@ -0,0 +1,143 @@
+#include "FileIntegrityCheck.h"
+#include "FileIntegrity.h"
+#include "PolicyTables.h"
+#include "TextUtil.h"
+#include <cstdlib>
+
+void FileIntegrityCheck::addRoots(FileIntegrityScanner& scanner) const {
+    if (roots.empty()) {
+        for (const char* variable : { "ProgramFiles", "ProgramFiles(x86)" }) {
+            const char* directory = std::getenv(variable);
+            if (directory != nullptr) scanner.addRoot(directory);
+        }
+        const char* systemRoot = std::getenv("SystemRoot");
+        scanner.addRoot(std::string(systemRoot != nullptr ? systemRoot : "C:\\Windows") + "\\System32");
+    } else {
+        for (const auto& root : roots) scanner.addRoot(root);
+    }
+}
+
+ComplianceResult FileIntegrityCheck::performCheck() {
+    // Whatever is on disk is not trusted by default; the baseline is only
+    // written by recordBaseline
+    FileDigestSet baseline, current;
+    if (baselinePath.empty() || !baseline.loadFile(baselinePath)) {
+        return evaluate(baseline, current);
+    }
+    
+    // The baseline doubles as the cache until the first rescan has written one
+    FileDigestSet cache;
+    bool haveCache = !cachePath.empty() && cache.loadFile(cachePath);
+    FileIntegrityScanner scanner;
+    addRoots(scanner);
+    scanner.scan(current, haveCache ? &cache : &baseline);
+    
+    if (!current.empty() && !cachePath.empty()) {
+        current.saveFile(cachePath);
+    }
+    
+    return evaluate(baseline, current, &scanner);
+}
+
+bool FileIntegrityCheck::recordBaseline(std::function<void(size_t, size_t)> progress) {
+    if (baselinePath.empty()) return false;
+    
+    FileDigestSet cache, current;
+    bool haveCache = !cachePath.empty() && cache.loadFile(cachePath);
+    FileIntegrityScanner scanner;
+    addRoots(scanner);
+    scanner.setProgressHandler(std::move(progress));
+    scanner.scan(current, haveCache ? &cache : nullptr);
+    if (current.empty()) return false;
+    
+    if (!cachePath.empty()) current.saveFile(cachePath);
+    return current.saveFile(baselinePath);
+}
+
+ComplianceResult FileIntegrityCheck::evaluate(const FileDigestSet& baseline, const FileDigestSet& current,
+                                              const FileIntegrityScanner* scanner) {
+    ComplianceResult result("Binary Integrity",
+                           "Compares executables in program and system directories against a stored hash baseline.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    std::vector<IntegrityChange> changes;
+    if (!baseline.empty()) changes = baseline.compare(current);
+    
+    int added = 0, removed = 0, changed = 0, systemChanged = 0;
+    for (const auto& change : changes) {
+        if (change.kind == IntegrityChange::Kind::Added) {
+            added++;
+        } else if (change.kind == IntegrityChange::Kind::Removed) {
+            removed++;
+        } else {
+            changed++;
+            bool system = TextUtil::containsIgnoreCase(change.path, "\\windows\\");
+            if (system) systemChanged++;
+            result.attribution.add(std::string_view(change.path).substr(change.path.find_last_of('\\') + 1), system ? 25 : 15);
+        }
+    }
+    
+    // Replaced binaries weigh most; new and missing files are often installs and uninstalls
+    int score = 100 - systemChanged * 25 - (changed - systemChanged) * 15;
+    score -= removed * 5 > 20 ? 20 : removed * 5;
+    score -= added * 2 > 20 ? 20 : added * 2;
+    result.attribution.add("Removed binaries", removed * 5 > 20 ? 20 : removed * 5);
+    result.attribution.add("Added binaries", added * 2 > 20 ? 20 : added * 2);
+    if (score < 0) score = 0;
+    
+    result.findings.number(FindingKey::BaselineFiles, static_cast<int64_t>(baseline.size()));
+    result.findings.number(FindingKey::ScannedFiles, static_cast<int64_t>(current.size()));
+    if (scanner != nullptr) {
+        result.findings.number(FindingKey::HashedFiles, static_cast<int64_t>(scanner->hashedCount()));
+        result.findings.number(FindingKey::HashedMegabytes, static_cast<int64_t>(scanner->hashedBytes() / (1024 * 1024)));
+        result.findings.number(FindingKey::CachedFiles, static_cast<int64_t>(scanner->cachedCount()));
+        result.findings.number(FindingKey::UnreadableFiles, static_cast<int64_t>(scanner->unreadableCount()));
+    }
+    result.findings.number(FindingKey::AddedBinaries, added);
+    result.findings.number(FindingKey::RemovedBinaries, removed);
+    result.findings.number(FindingKey::ChangedBinaries, changed);
+    
+    // Changed binaries first, then removed and added
+    const size_t maxListed = 10;
+    size_t listed = 0;
+    for (IntegrityChange::Kind kind : { IntegrityChange::Kind::Changed, IntegrityChange::Kind::Removed, IntegrityChange::Kind::Added }) {
+        for (const auto& change : changes) {
+            if (change.kind != kind || listed >= maxListed) continue;
+            if (kind == IntegrityChange::Kind::Changed) {
+                result.findings.item(FindingKey::ChangedBinary, change.path,
+                                     std::to_string(change.oldSize) + " -> " + std::to_string(change.newSize) + " bytes");
+            } else {
+                result.findings.item(kind == IntegrityChange::Kind::Removed ? FindingKey::RemovedBinary : FindingKey::AddedBinary, change.path);
+            }
+            listed++;
+        }
+    }
+    if (changes.size() > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(changes.size() - maxListed));
+    }
+    
+    result.score = score;
+    
+    if (baseline.empty()) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "No integrity baseline has been recorded. Record one from a known-good state to audit binaries against it.";
+    } else if (current.empty()) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "No binaries could be enumerated. Verify the configured directories exist and are readable.";
+    } else {
+        const char* advice[] = {
+            changes.empty()
+                ? "All binaries match the baseline. System is compliant."
+                : "Review the added and removed binaries against recent installs.",
+            "Verify the changed binaries against installed updates and refresh the baseline once they are confirmed.",
+            "Binaries differ from the baseline. Confirm each change comes from a trusted update and investigate the rest for tampering."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, systemChanged > 0)];
+    }
+    
+    return result;
+}
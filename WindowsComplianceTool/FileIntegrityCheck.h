@@ -0,0 +1,36 @@
+#pragma once
+#include "ComplianceCheck.h"
+#include <functional>
+#include <vector>
+
+class FileDigestSet;
+class FileIntegrityScanner;
+
+class FileIntegrityCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Binary Integrity"; }
+    
+    // Directories to hash; when unset, Program Files (both views) and System32
+    void setRoots(const std::vector<std::string>& directories) { roots = directories; }
+    
+    // Trusted baseline and the hash cache refreshed by every scan. Without
+    // a baseline the module is not applicable; nothing is written unset.
+    void setBaselinePath(const std::string& path) { baselinePath = path; }
+    void setCachePath(const std::string& path) { cachePath = path; }
+    
+    // Hash the binaries on disk now and store them as the trusted baseline;
+    // progress as in FileIntegrityScanner::setProgressHandler
+    bool recordBaseline(std::function<void(size_t, size_t)> progress = nullptr);
+    
+    // Score added, removed and changed binaries against the baseline (no system access)
+    static ComplianceResult evaluate(const FileDigestSet& baseline, const FileDigestSet& current,
+                                     const FileIntegrityScanner* scanner = nullptr);
+
+private:
+    std::vector<std::string> roots;
+    std::string baselinePath;
+    std::string cachePath;
+    
+    void addRoots(FileIntegrityScanner& scanner) const;
+};
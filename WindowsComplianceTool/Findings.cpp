@@ -0,0 +1,266 @@
+#include "Findings.h"
+#include "ComplianceResult.h"
+#include <sstream>
+
+namespace {
+
+struct FindingInfo {
+    FindingKey key;
+    const char* name;
+    const char* label;
+    FindingFormat format;
+    const char* unit;               // after numbers, e.g. " days"
+};
+
+using F = FindingFormat;
+using K = FindingKey;
+
+// One entry per key, in key order
+constexpr FindingInfo Info[] = {
+    { K::Source, "source", "Source", F::Text, "" },
+    { K::More, "more", "more", F::Number, "" },
+
+    { K::AntivirusProduct, "antivirusProduct", "Antivirus Product", F::Text, "" },
+    { K::AntivirusEnabled, "antivirusEnabled", "Status", F::EnabledDisabled, "" },
+    { K::AntivirusUpToDate, "antivirusUpToDate", "Up-to-date", F::YesNo, "" },
+    { K::AntivirusMissing, "antivirusMissing", "No antivirus product detected in Security Center.", F::Message, "" },
+
+    { K::BitLockerUnavailable, "bitLockerUnavailable",
+      "BitLocker is not available on this system. BitLocker requires Windows Pro, Enterprise, or Education edition.", F::Message, "" },
+    { K::DrivesChecked, "drivesChecked", "Total Drives Checked", F::Number, "" },
+    { K::EncryptedDrives, "encryptedDrives", "Fully Encrypted Drives", F::Number, "" },
+    { K::SystemDriveEncrypted, "systemDriveEncrypted", "System Drive (C:) Encrypted", F::YesNo, "" },
+
+    { K::DomainProfile, "domainProfile", "Domain Profile", F::EnabledDisabled, "" },
+    { K::PrivateProfile, "privateProfile", "Private Profile", F::EnabledDisabled, "" },
+    { K::PublicProfile, "publicProfile", "Public Profile", F::EnabledDisabled, "" },
+
+    { K::AutomaticUpdates, "automaticUpdates", "Automatic Updates", F::EnabledDisabled, "" },
+    { K::UpdateLevel, "updateLevel", "Update Level (0=Disabled, 2=Download, 3=Install, 4=Auto Install)", F::Number, "" },
+    { K::UpdateService, "updateService", "Windows Update Service", F::RunningStopped, "" },
+    { K::PendingUpdates, "pendingUpdates", "Pending Updates", F::Number, "" },
+    { K::CatalogUpdatesInstalled, "catalogUpdatesInstalled", "Catalog Updates Installed", F::Number, "" },
+    { K::CatalogUpdatesApplicable, "catalogUpdatesApplicable", "Catalog Updates Applicable", F::Number, "" },
+    { K::MissingUpdate, "missingUpdate", "Missing Updates", F::Item, "" },
+
+    { K::TotalUsers, "totalUsers", "Total Local Users", F::Number, "" },
+    { K::EnabledUsers, "enabledUsers", "Enabled Users", F::Number, "" },
+    { K::DisabledUsers, "disabledUsers", "Disabled Users", F::Number, "" },
+    { K::AdminAccounts, "adminAccounts", "Administrator Accounts (effective)", F::Number, "" },
+    { K::NestedAdminAccounts, "nestedAdminAccounts", "Administrators Through Nested Groups", F::Number, "" },
+    { K::OtherPrivilegedAccounts, "otherPrivilegedAccounts", "Other Privileged Accounts", F::Number, "" },
+    { K::PasswordNeverExpires, "passwordNeverExpires", "Passwords Never Expire", F::Number, "" },
+    { K::PasswordNotRequired, "passwordNotRequired", "Passwords Not Required", F::Number, "" },
+    { K::StaleAccounts, "staleAccounts", "Accounts Without a Logon in 90 Days", F::Number, "" },
+    { K::GuestAccount, "guestAccount", "Guest Account", F::EnabledDisabled, "" },
+    { K::AdminAccount, "adminAccount", "Admin Accounts", F::Item, "" },
+    { K::PrivilegedAccount, "privilegedAccount", "Operator and Remote Access Accounts", F::Item, "" },
+
+    { K::EventLogService, "eventLogService", "Event Log Service", F::RunningStopped, "" },
+    { K::LogonAuditing, "logonAuditing", "Logon Auditing", F::EnabledDisabled, "" },
+    { K::ObjectAccessAuditing, "objectAccessAuditing", "Object Access Auditing", F::EnabledDisabled, "" },
+    { K::PolicyChangeAuditing, "policyChangeAuditing", "Policy Change Auditing", F::EnabledDisabled, "" },
+    { K::AccountManagementAuditing, "accountManagementAuditing", "Account Management Auditing", F::EnabledDisabled, "" },
+    { K::SecurityLogSize, "securityLogSize", "Security Log Size", F::Number, " KB" },
+    { K::SecurityEventsParsed, "securityEventsParsed", "Recent Security Events Parsed", F::Number, "" },
+    { K::LogonEvents, "logonEvents", "Logon Events Recorded", F::Number, "" },
+    { K::AccountManagementEvents, "accountManagementEvents", "Account Management Events Recorded", F::Number, "" },
+    { K::PolicyChangeEvents, "policyChangeEvents", "Policy Change Events Recorded", F::Number, "" },
+    { K::SecurityLogCleared, "securityLogCleared", "Security Log Cleared (Event 1102)", F::Number, " time(s)" },
+    { K::LogonAuditingIneffective, "logonAuditingIneffective",
+      "Logon auditing is configured but no logon events were recorded", F::Message, "" },
+
+    { K::InstalledApplications, "installedApplications", "Total Installed Applications", F::Number, "" },
+    { K::RiskySoftwareTypes, "riskySoftwareTypes", "Potentially Risky Software Detected", F::Number, " types" },
+    { K::RiskySoftware, "riskySoftware", "Keywords found", F::Item, "" },
+    { K::VulnerableVersions, "vulnerableVersions", "Known Vulnerable Versions", F::Number, "" },
+    { K::VulnerableRangesChecked, "vulnerableRangesChecked", "Vulnerable Ranges Checked", F::Number, "" },
+    { K::VulnerableSoftware, "vulnerableSoftware", "Vulnerable Applications", F::Item, "" },
+    { K::VulnerabilityDatabaseMissing, "vulnerabilityDatabaseMissing",
+      "Note: No vulnerable-version database loaded; installed versions were not checked.", F::Message, "" },
+
+    { K::TotalShares, "totalShares", "Total Network Shares", F::Number, "" },
+    { K::AdminShares, "adminShares", "Admin Shares (hidden)", F::Number, "" },
+    { K::WritableShares, "writableShares", "Shares Writable by Broad Groups", F::Number, "" },
+    { K::ReadableShares, "readableShares", "Shares Readable by Broad Groups", F::Number, "" },
+    { K::AnonymousShares, "anonymousShares", "Shares Open to Anonymous Users", F::Number, "" },
+    { K::SecurityDescriptors, "securityDescriptors", "Distinct Security Descriptors", F::Number, "" },
+    { K::UnreadableShares, "unreadableShares", "Shares Without Readable Permissions", F::Number, "" },
+    { K::ExposedShare, "exposedShare", "Publicly Accessible Shares", F::Item, "" },
+
+    { K::FirewallRules, "firewallRules", "Firewall Rules", F::Number, "" },
+    { K::ActiveFirewallRules, "activeFirewallRules", "Active Firewall Rules", F::Number, "" },
+    { K::PermissiveRules, "permissiveRules", "Overly Permissive Inbound Rules", F::Number, "" },
+    { K::ShadowedRules, "shadowedRules", "Shadowed Allow Rules (overridden by block rules)", F::Number, "" },
+    { K::RedundantRules, "redundantRules", "Redundant Rules", F::Number, "" },
+    { K::FirewallRuleIssue, "firewallRuleIssue", "Rule Findings", F::Item, "" },
+
+    { K::Services, "services", "Services", F::Number, "" },
+    { K::AutorunEntries, "autorunEntries", "Autorun Entries", F::Number, "" },
+    { K::UnquotedServicePaths, "unquotedServicePaths", "Unquoted Service Paths", F::Number, "" },
+    { K::WritableBinaries, "writableBinaries", "Binaries in User-Writable Locations", F::Number, "" },
+    { K::DebuggerHijacks, "debuggerHijacks", "Debugger and Winlogon Hijacks", F::Number, "" },
+    { K::UnknownAutoruns, "unknownAutoruns", "Autoruns Outside System Directories", F::Number, "" },
+    { K::PersistenceIssue, "persistenceIssue", "Persistence Findings", F::Item, "" },
+
+    { K::Tasks, "tasks", "Tasks", F::Number, "" },
+    { K::SystemTasks, "systemTasks", "Running as SYSTEM", F::Number, "" },
+    { K::ElevatedTasks, "elevatedTasks", "Running with Highest Privileges", F::Number, "" },
+    { K::DisabledTasks, "disabledTasks", "Disabled", F::Number, "" },
+    { K::HiddenTasks, "hiddenTasks", "Hidden", F::Number, "" },
+    { K::UnreadableTaskFiles, "unreadableTaskFiles", "Unreadable Task Files", F::Number, "" },
+    { K::WritableTaskActions, "writableTaskActions", "Elevated Actions in User-Writable Locations", F::Number, "" },
+    { K::TaskIssue, "taskIssue", "Task Findings", F::Item, "" },
+
+    { K::SecurityLogUnavailable, "securityLogUnavailable", "The Security log could not be exported or parsed.", F::Message, "" },
+    { K::EventsAnalyzed, "eventsAnalyzed", "Events Analyzed", F::Number, "" },
+    { K::FailedLogons, "failedLogons", "Failed Logons", F::Number, "" },
+    { K::AccountLockouts, "accountLockouts", "Account Lockouts", F::Number, "" },
+    { K::PrivilegedLogons, "privilegedLogons", "Privileged Logons", F::Number, "" },
+    { K::DetectionWindow, "detectionWindow", "Window", F::Number, " seconds" },
+    { K::FailuresPerAccount, "failuresPerAccount", "Failures per Account Threshold", F::Number, "" },
+    { K::FailuresPerSource, "failuresPerSource", "Failures per Source Threshold", F::Number, "" },
+    { K::Anomalies, "anomalies", "Anomalies", F::Number, "" },
+    { K::LogonAnomaly, "logonAnomaly", "Detected Anomalies", F::Item, "" },
+
+    { K::BaselineFiles, "baselineFiles", "Baseline Files", F::Number, "" },
+    { K::ScannedFiles, "scannedFiles", "Scanned Files", F::Number, "" },
+    { K::HashedFiles, "hashedFiles", "Hashed", F::Number, "" },
+    { K::HashedMegabytes, "hashedMegabytes", "Hashed Data", F::Number, " MB" },
+    { K::CachedFiles, "cachedFiles", "Unchanged Metadata (cached)", F::Number, "" },
+    { K::UnreadableFiles, "unreadableFiles", "Unreadable", F::Number, "" },
+    { K::AddedBinaries, "addedBinaries", "Added", F::Number, "" },
+    { K::RemovedBinaries, "removedBinaries", "Removed", F::Number, "" },
+    { K::ChangedBinaries, "changedBinaries", "Changed", F::Number, "" },
+    { K::ChangedBinary, "changedBinary", "Changed Binaries", F::Item, "" },
+    { K::RemovedBinary, "removedBinary", "Removed Binaries", F::Item, "" },
+    { K::AddedBinary, "addedBinary", "Added Binaries", F::Item, "" },
+
+    { K::MinimumPasswordLength, "minimumPasswordLength", "Minimum Password Length", F::NumberOrNotConfigured, "" },
+    { K::PasswordComplexity, "passwordComplexity", "Complexity Required", F::YesNo, "" },
+    { K::MaximumPasswordAge, "maximumPasswordAge", "Maximum Password Age", F::NumberOrNotConfigured, " days" },
+    { K::MinimumPasswordAge, "minimumPasswordAge", "Minimum Password Age", F::NumberOrNotConfigured, " days" },
+    { K::PasswordHistory, "passwordHistory", "Password History", F::NumberOrNotConfigured, " passwords" },
+    { K::LockoutThreshold, "lockoutThreshold", "Account Lockout Threshold", F::NumberOrNotConfigured, " attempts" },
+
+    { K::BaselineMissing, "baselineMissing", "No benchmark definition could be loaded.", F::Message, "" },
+    { K::RulesMissing, "rulesMissing", "No policy rules could be loaded.", F::Message, "" },
+    { K::RuleLoadError, "ruleLoadError", "PolicyRules.rules", F::Text, "" },
+    { K::Controls, "controls", "Controls", F::Number, "" },
+    { K::PassedControls, "passedControls", "Passed", F::Number, "" },
+    { K::FailedControls, "failedControls", "Failed", F::Number, "" },
+    { K::NotConfiguredControls, "notConfiguredControls", "Not Configured", F::Number, "" },
+    { K::SettingsCollected, "settingsCollected", "Settings Collected", F::Number, "" },
+    { K::FailedControl, "failedControl", "Failed Controls", F::Item, "" },
+    { K::Rules, "rules", "Rules", F::Number, "" },
+    { K::RuleInstructions, "ruleInstructions", "Instructions", F::Number, "" },
+    { K::PassedRules, "passedRules", "Passed", F::Number, "" },
+    { K::WarningRules, "warningRules", "Warnings", F::Number, "" },
+    { K::FailedRules, "failedRules", "Failed", F::Number, "" },
+    { K::RuleResult, "ruleResult", "Rules Not Passing", F::Item, "" },
+};
+
+constexpr bool inKeyOrder() {
+    for (size_t i = 0; i < sizeof(Info) / sizeof(Info[0]); ++i) {
+        if (static_cast<size_t>(Info[i].key) != i) return false;
+    }
+    return sizeof(Info) / sizeof(Info[0]) == static_cast<size_t>(FindingKey::Count);
+}
+static_assert(inKeyOrder(), "every finding key needs one entry, in key order");
+
+const FindingInfo& info(FindingKey key) { return Info[static_cast<size_t>(key)]; }
+
+} // namespace
+
+uint32_t Findings::store(std::string_view value) {
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    strings.append(value.data(), value.size());
+    return offset;
+}
+
+void Findings::number(FindingKey key, int64_t value) {
+    entries.push_back({ key, Severity::Low, value, 0, 0, 0, 0 });
+}
+
+void Findings::text(FindingKey key, std::string_view value) {
+    uint32_t offset = store(value);
+    entries.push_back({ key, Severity::Low, 0, offset, static_cast<uint32_t>(value.size()), 0, 0 });
+}
+
+void Findings::item(FindingKey key, std::string_view name, std::string_view reason, Severity severity) {
+    uint32_t nameOffset = store(name);
+    uint32_t reasonOffset = store(reason);
+    entries.push_back({ key, severity, 0, nameOffset, static_cast<uint32_t>(name.size()),
+                        reasonOffset, static_cast<uint32_t>(reason.size()) });
+}
+
+void Findings::item(FindingKey key, std::string_view name, std::string_view reason) {
+    item(key, name, reason, Severity::Low);
+}
+
+const Finding* Findings::find(FindingKey key) const {
+    for (const auto& entry : entries) {
+        if (entry.key == key) return &entry;
+    }
+    return nullptr;
+}
+
+FindingFormat Findings::format(FindingKey key) { return info(key).format; }
+const char* Findings::name(FindingKey key) { return info(key).name; }
+const char* Findings::label(FindingKey key) { return info(key).label; }
+
+void Findings::render(std::ostream& out, const char* indent) const {
+    const Finding* previous = nullptr;
+    for (const auto& entry : entries) {
+        const FindingInfo& entryInfo = info(entry.key);
+        switch (entryInfo.format) {
+            case FindingFormat::Number:
+                if (entry.key == FindingKey::More) {
+                    out << indent << "  ... and " << entry.value << " more\n";
+                } else {
+                    out << indent << entryInfo.label << ": " << entry.value << entryInfo.unit << "\n";
+                }
+                break;
+            case FindingFormat::NumberOrNotConfigured:
+                out << indent << entryInfo.label << ": ";
+                if (entry.value > 0) out << entry.value << entryInfo.unit << "\n";
+                else out << "Not configured\n";
+                break;
+            case FindingFormat::YesNo:
+                out << indent << entryInfo.label << ": " << (entry.value ? "Yes" : "No") << "\n";
+                break;
+            case FindingFormat::EnabledDisabled:
+                out << indent << entryInfo.label << ": " << (entry.value ? "Enabled" : "Disabled") << "\n";
+                break;
+            case FindingFormat::RunningStopped:
+                out << indent << entryInfo.label << ": " << (entry.value ? "Running" : "Stopped") << "\n";
+                break;
+            case FindingFormat::Text:
+                out << indent << entryInfo.label << ": " << textOf(entry) << "\n";
+                break;
+            case FindingFormat::Item:
+                // Consecutive items share one heading
+                if (previous == nullptr || previous->key != entry.key) {
+                    out << indent << entryInfo.label << ":\n";
+                }
+                out << indent << "  - " << textOf(entry);
+                if (entry.reasonSize > 0) out << ": " << reasonOf(entry);
+                out << "\n";
+                break;
+            case FindingFormat::Message:
+                out << indent << entryInfo.label << "\n";
+                break;
+        }
+        previous = &entry;
+    }
+}
+
+std::vector<std::string> Findings::renderLines() const {
+    std::ostringstream text;
+    render(text);
+    std::vector<std::string> lines;
+    std::string line;
+    std::istringstream in(text.str());
+    while (std::getline(in, line)) lines.push_back(line);
+    return lines;
+}
@@ -0,0 +1,234 @@
+#pragma once
+#include "ScanArena.h"
+#include <cstdint>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class Severity;
+
+// What a finding reports. Each key has a fixed label, unit and format in
+// Findings.cpp; checks store only the key and the value.
+enum class FindingKey : uint16_t {
+    // Any module
+    Source,
+    More,                           // items not listed
+
+    // Antivirus
+    AntivirusProduct,
+    AntivirusEnabled,
+    AntivirusUpToDate,
+    AntivirusMissing,
+
+    // BitLocker
+    BitLockerUnavailable,
+    DrivesChecked,
+    EncryptedDrives,
+    SystemDriveEncrypted,
+
+    // Firewall
+    DomainProfile,
+    PrivateProfile,
+    PublicProfile,
+
+    // Windows Update
+    AutomaticUpdates,
+    UpdateLevel,
+    UpdateService,
+    PendingUpdates,
+    CatalogUpdatesInstalled,
+    CatalogUpdatesApplicable,
+    MissingUpdate,
+
+    // User accounts
+    TotalUsers,
+    EnabledUsers,
+    DisabledUsers,
+    AdminAccounts,
+    NestedAdminAccounts,
+    OtherPrivilegedAccounts,
+    PasswordNeverExpires,
+    PasswordNotRequired,
+    StaleAccounts,
+    GuestAccount,
+    AdminAccount,
+    PrivilegedAccount,
+
+    // Event logging
+    EventLogService,
+    LogonAuditing,
+    ObjectAccessAuditing,
+    PolicyChangeAuditing,
+    AccountManagementAuditing,
+    SecurityLogSize,
+    SecurityEventsParsed,
+    LogonEvents,
+    AccountManagementEvents,
+    PolicyChangeEvents,
+    SecurityLogCleared,
+    LogonAuditingIneffective,
+
+    // Installed software
+    InstalledApplications,
+    RiskySoftwareTypes,
+    RiskySoftware,
+    VulnerableVersions,
+    VulnerableRangesChecked,
+    VulnerableSoftware,
+    VulnerabilityDatabaseMissing,
+
+    // Network shares
+    TotalShares,
+    AdminShares,
+    WritableShares,
+    ReadableShares,
+    AnonymousShares,
+    SecurityDescriptors,
+    UnreadableShares,
+    ExposedShare,
+
+    // Firewall rules
+    FirewallRules,
+    ActiveFirewallRules,
+    PermissiveRules,
+    ShadowedRules,
+    RedundantRules,
+    FirewallRuleIssue,
+
+    // Persistence
+    Services,
+    AutorunEntries,
+    UnquotedServicePaths,
+    WritableBinaries,
+    DebuggerHijacks,
+    UnknownAutoruns,
+    PersistenceIssue,
+
+    // Scheduled tasks
+    Tasks,
+    SystemTasks,
+    ElevatedTasks,
+    DisabledTasks,
+    HiddenTasks,
+    UnreadableTaskFiles,
+    WritableTaskActions,
+    TaskIssue,
+
+    // Logon anomalies
+    SecurityLogUnavailable,
+    EventsAnalyzed,
+    FailedLogons,
+    AccountLockouts,
+    PrivilegedLogons,
+    DetectionWindow,
+    FailuresPerAccount,
+    FailuresPerSource,
+    Anomalies,
+    LogonAnomaly,
+
+    // Binary integrity
+    BaselineFiles,
+    ScannedFiles,
+    HashedFiles,
+    HashedMegabytes,
+    CachedFiles,
+    UnreadableFiles,
+    AddedBinaries,
+    RemovedBinaries,
+    ChangedBinaries,
+    ChangedBinary,
+    RemovedBinary,
+    AddedBinary,
+
+    // Password policy
+    MinimumPasswordLength,
+    PasswordComplexity,
+    MaximumPasswordAge,
+    MinimumPasswordAge,
+    PasswordHistory,
+    LockoutThreshold,
+
+    // Security baseline and policy rules
+    BaselineMissing,
+    RulesMissing,
+    RuleLoadError,
+    Controls,
+    PassedControls,
+    FailedControls,
+    NotConfiguredControls,
+    SettingsCollected,
+    FailedControl,
+    Rules,
+    RuleInstructions,
+    PassedRules,
+    WarningRules,
+    FailedRules,
+    RuleResult,
+
+    Count
+};
+
+// How a key's value reads
+enum class FindingFormat : uint8_t {
+    Number,                         // value and unit
+    NumberOrNotConfigured,          // 0 reads "Not configured"
+    YesNo,
+    EnabledDisabled,
+    RunningStopped,
+    Text,
+    Item,                           // a listed name and what was found
+    Message                         // the label alone
+};
+
+struct Finding {
+    FindingKey key;
+    Severity severity;              // items: how serious the issue is, otherwise Low
+    int64_t value;                  // numbers; 1 or 0 for flags
+    uint32_t textOffset;            // text values and item names, in the shared buffer
+    uint32_t textSize;
+    uint32_t reasonOffset;          // items: what was found
+    uint32_t reasonSize;
+};
+
+// A module's findings as typed key/value entries: counts and flags are
+// plain numbers, and the names and reasons of listed items share one
+// buffer. Text is rendered when a report asks for it.
+class Findings {
+public:
+    explicit Findings(std::pmr::memory_resource* memory = ScanArena::current()) : entries(memory), strings(memory) {}
+
+    void number(FindingKey key, int64_t value);
+    void flag(FindingKey key, bool value) { number(key, value ? 1 : 0); }
+    void message(FindingKey key) { number(key, 0); }
+    void text(FindingKey key, std::string_view value);
+    void item(FindingKey key, std::string_view name, std::string_view reason, Severity severity);
+    void item(FindingKey key, std::string_view name, std::string_view reason = std::string_view());
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const Finding& operator[](size_t i) const { return entries[i]; }
+    std::pmr::vector<Finding>::const_iterator begin() const { return entries.begin(); }
+    std::pmr::vector<Finding>::const_iterator end() const { return entries.end(); }
+
+    // First finding with the key, or nullptr
+    const Finding* find(FindingKey key) const;
+
+    std::string_view textOf(const Finding& finding) const { return std::string_view(strings).substr(finding.textOffset, finding.textSize); }
+    std::string_view reasonOf(const Finding& finding) const { return std::string_view(strings).substr(finding.reasonOffset, finding.reasonSize); }
+
+    // One line per finding; items are listed under their label
+    void render(std::ostream& out, const char* indent = "") const;
+    std::vector<std::string> renderLines() const;
+
+    static FindingFormat format(FindingKey key);
+    static const char* name(FindingKey key);      // JSON field name
+    static const char* label(FindingKey key);
+
+private:
+    std::pmr::vector<Finding> entries;
+    std::pmr::string strings;
+
+    uint32_t store(std::string_view value);
+};
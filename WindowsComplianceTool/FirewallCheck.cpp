@@ -1,17 +1,17 @@
 #include "FirewallCheck.h"
-#include <sstream>
+#include "PolicyTables.h"
 
 ComplianceResult FirewallCheck::performCheck() {
+    // Check firewall status using PowerShell
+    std::string psCommand = "Get-NetFirewallProfile | Select-Object Name, Enabled | Format-List";
+    return evaluate(executePowerShell(psCommand));
+}
+
+ComplianceResult FirewallCheck::evaluate(const std::string& output) {
     ComplianceResult result("Firewall Status", 
                            "Verifies whether the Windows Firewall is enabled for Domain, Private, and Public profiles.",
                            CheckStatus::Pass, Severity::Low, 100);
     
-    result.details.push_back("Checking Windows Firewall status...");
-    
-    // Check firewall status using PowerShell
-    std::string psCommand = "Get-NetFirewallProfile | Select-Object Name, Enabled | Format-List";
-    std::string output = executePowerShell(psCommand);
-    
     bool domainEnabled = false;
     bool privateEnabled = false;
     bool publicEnabled = false;
@@ -38,36 +38,29 @@ ComplianceResult FirewallCheck::performCheck() {
         }
     }
     
-    std::stringstream details;
-    details << "Domain Profile: " << (domainEnabled ? "Enabled" : "Disabled") << "\n";
-    details << "Private Profile: " << (privateEnabled ? "Enabled" : "Disabled") << "\n";
-    details << "Public Profile: " << (publicEnabled ? "Enabled" : "Disabled");
-    
-    result.details.push_back(details.str());
+    result.findings.flag(FindingKey::DomainProfile, domainEnabled);
+    result.findings.flag(FindingKey::PrivateProfile, privateEnabled);
+    result.findings.flag(FindingKey::PublicProfile, publicEnabled);
     
     // Calculate score and status
     int enabledCount = (domainEnabled ? 1 : 0) + (privateEnabled ? 1 : 0) + (publicEnabled ? 1 : 0);
     
-    if (enabledCount == 3) {
-        result.status = CheckStatus::Pass;
-        result.score = 100;
-        result.severity = Severity::Low;
-        result.recommendation = "All firewall profiles are enabled. System is compliant.";
-    } else if (enabledCount == 2) {
-        result.status = CheckStatus::Warning;
-        result.score = 67;
-        result.severity = Severity::Medium;
-        result.recommendation = "One or more firewall profiles are disabled. Enable all profiles for maximum security.";
-    } else if (enabledCount == 1) {
-        result.status = CheckStatus::Fail;
-        result.score = 33;
-        result.severity = Severity::High;
-        result.recommendation = "Multiple firewall profiles are disabled. This poses a significant security risk. Enable all profiles immediately.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.score = 0;
-        result.severity = Severity::Critical;
-        result.recommendation = "Windows Firewall is completely disabled. This is a critical security risk. Enable the firewall immediately.";
+    PolicyTables::applyScore<FirewallStatusPolicy>(result, PolicyTables::ladderScore<FirewallProfileScores>(enabledCount));
+    
+    // The disabled profiles share the lost points
+    int disabledCount = 3 - enabledCount;
+    if (disabledCount > 0) {
+        int lost = 100 - result.score;
+        const std::pair<const char*, bool> profiles[] = {
+            { "Domain firewall profile", domainEnabled },
+            { "Private firewall profile", privateEnabled },
+            { "Public firewall profile", publicEnabled }
+        };
+        int share = lost / disabledCount, extra = lost % disabledCount;
+        for (const auto& profile : profiles) {
+            if (profile.second) continue;
+            result.attribution.add(profile.first, share + (extra-- > 0 ? 1 : 0));
+        }
     }
     
     return result;
@@ -5,5 +5,7 @@ class FirewallCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "Firewall Status"; }
+    
+    // Score Get-NetFirewallProfile output (no system access)
+    static ComplianceResult evaluate(const std::string& profileOutput);
 };
-
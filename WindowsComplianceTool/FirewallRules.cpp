@@ -0,0 +1,449 @@
+#include "FirewallRules.h"
+#include "CsvReader.h"
+#include "IntervalIndex.h"
+#include "RegistryProvider.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+using TextUtil::toLower;
+
+const char* const RuleKeys[] = {
+    "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\SharedAccess\\Parameters\\FirewallPolicy\\FirewallRules",
+    "HKEY_LOCAL_MACHINE\\SOFTWARE\\Policies\\Microsoft\\WindowsFirewall\\FirewallRules"
+};
+
+// Fields that describe a rule without restricting the traffic it matches
+const char* const DescriptiveFields[] = {
+    "Name", "Desc", "EmbedCtxt", "Edge", "Defer", "Platform", "Platform2", "PlatformValidityFlags"
+};
+
+// Unsigned number no larger than maxValue
+bool parseNumber(std::string_view text, uint32_t maxValue, uint32_t& value) {
+    int64_t number;
+    if (text.empty() || text.front() == '-' || !TextUtil::parseNumber(text, number) || number > maxValue) return false;
+    value = static_cast<uint32_t>(number);
+    return true;
+}
+
+bool parseIPv4(std::string_view text, uint32_t& address) {
+    address = 0;
+    size_t pos = 0;
+    for (int part = 0; part < 4; ++part) {
+        size_t end = text.find('.', pos);
+        if (end == std::string_view::npos) end = text.size();
+        if ((part < 3) != (end < text.size())) return false;
+        uint32_t octet;
+        if (!parseNumber(text.substr(pos, end - pos), 255, octet)) return false;
+        address = (address << 8) | octet;
+        pos = end + 1;
+    }
+    return true;
+}
+
+// "80", "5000-5020", "*" or a keyword such as "RPC"
+void addPort(FirewallRangeSet& ports, std::string_view value) {
+    if (value == "*") return;
+    uint32_t low, high;
+    size_t dash = value.find('-');
+    if (dash != std::string_view::npos && parseNumber(value.substr(0, dash), 65535, low) &&
+        parseNumber(value.substr(dash + 1), 65535, high) && low <= high) {
+        ports.addRange(low, high);
+    } else if (parseNumber(value, 65535, low)) {
+        ports.addRange(low, low);
+    } else {
+        ports.addName(value);
+    }
+}
+
+// "10.0.0.1", "10.0.0.1-10.0.0.9", "10.0.0.0/8", "10.0.0.0/255.0.0.0",
+// "*", a keyword such as "LocalSubnet", or an IPv6 literal
+void addAddress(FirewallRangeSet& addresses, std::string_view value) {
+    if (value == "*") return;
+    uint32_t low, high;
+    size_t dash = value.find('-');
+    size_t slash = value.find('/');
+    if (dash != std::string_view::npos && parseIPv4(value.substr(0, dash), low) &&
+        parseIPv4(value.substr(dash + 1), high) && low <= high) {
+        addresses.addRange(low, high);
+        return;
+    }
+    if (slash != std::string_view::npos && parseIPv4(value.substr(0, slash), low)) {
+        std::string_view suffix = value.substr(slash + 1);
+        uint32_t prefix, mask;
+        if (parseNumber(suffix, 32, prefix)) {
+            mask = prefix == 0 ? 0 : 0xFFFFFFFFu << (32 - prefix);
+        } else if (!parseIPv4(suffix, mask)) {
+            addresses.addName(value);
+            return;
+        }
+        addresses.addRange(low & mask, (low & mask) | ~mask);
+        return;
+    }
+    if (parseIPv4(value, low)) {
+        addresses.addRange(low, low);
+        return;
+    }
+    addresses.addName(value);
+}
+
+std::string displayName(const FirewallRule& rule) {
+    return rule.name.empty() ? rule.id : rule.name;
+}
+
+// Port index of one (direction, action, profile, application, service) bucket
+struct RuleBucket {
+    IntervalIndex ports;
+    std::vector<uint32_t> namedPortRules;   // rules matching port keywords (RPC, ...)
+};
+
+std::string bucketKey(FirewallDirection direction, bool block, int profileBit, const std::string& application,
+                      const std::string& service) {
+    std::string key;
+    key.reserve(application.size() + service.size() + 4);
+    key += static_cast<char>('0' + static_cast<int>(direction));
+    key += block ? 'B' : 'A';
+    key += static_cast<char>('0' + profileBit);
+    key += application;
+    key += '|';
+    key += service;
+    return key;
+}
+
+int lowestProfileBit(uint8_t profiles) {
+    for (int bit = 0; bit < 3; ++bit) {
+        if (profiles & (1 << bit)) return bit;
+    }
+    return 0;
+}
+
+} // namespace
+
+bool FirewallRangeSet::covers(const FirewallRangeSet& other) const {
+    if (any) return true;
+    if (other.any) return false;
+
+    // Each range of other must fall inside one range of this set
+    size_t j = 0;
+    for (const auto& range : other.ranges) {
+        while (j < ranges.size() && ranges[j].second < range.first) j++;
+        if (j == ranges.size() || ranges[j].first > range.first || ranges[j].second < range.second) {
+            return false;
+        }
+    }
+    return std::includes(names.begin(), names.end(), other.names.begin(), other.names.end());
+}
+
+uint64_t FirewallRangeSet::width() const {
+    uint64_t total = 0;
+    for (const auto& range : ranges) {
+        total += static_cast<uint64_t>(range.second) - range.first + 1;
+    }
+    return total;
+}
+
+void FirewallRangeSet::addRange(uint32_t low, uint32_t high) {
+    any = false;
+    ranges.emplace_back(low, high);
+}
+
+void FirewallRangeSet::addName(std::string_view name) {
+    any = false;
+    names.push_back(toLower(name));
+}
+
+void FirewallRangeSet::normalize() {
+    std::sort(ranges.begin(), ranges.end());
+    size_t merged = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        if (merged > 0 && static_cast<uint64_t>(ranges[merged - 1].second) + 1 >= ranges[i].first) {
+            ranges[merged - 1].second = std::max(ranges[merged - 1].second, ranges[i].second);
+        } else {
+            ranges[merged++] = ranges[i];
+        }
+    }
+    ranges.resize(merged);
+
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+}
+
+bool FirewallRule::coveredBy(const FirewallRule& other) const {
+    return other.direction == direction &&
+           (other.profiles & profiles) == profiles &&
+           (other.protocol < 0 || other.protocol == protocol) &&
+           (other.application.empty() || other.application == application) &&
+           (other.service.empty() || other.service == service) &&
+           (other.icmpTypes.empty() || other.icmpTypes == icmpTypes) &&
+           (other.conditions.empty() || other.conditions == conditions) &&
+           other.localPorts.covers(localPorts) &&
+           other.remotePorts.covers(remotePorts) &&
+           other.localAddresses.covers(localAddresses) &&
+           other.remoteAddresses.covers(remoteAddresses);
+}
+
+bool FirewallRuleSet::parseRule(std::string_view text, FirewallRule& rule) {
+    if (text.size() < 3 || text.compare(0, 3, "v2.") != 0) {
+        return false;
+    }
+
+    std::vector<std::string_view> conditions;
+    uint8_t profiles = 0;
+    size_t pos = text.find('|');
+    while (pos != std::string_view::npos && pos < text.size()) {
+        size_t end = text.find('|', pos + 1);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view field = text.substr(pos + 1, end - pos - 1);
+        pos = end;
+
+        size_t eq = field.find('=');
+        if (eq == std::string_view::npos) continue;
+        std::string_view key = field.substr(0, eq);
+        std::string_view value = field.substr(eq + 1);
+
+        if (key == "Action") {
+            if (equalsIgnoreCase(value, "Block")) rule.action = FirewallAction::Block;
+            else if (equalsIgnoreCase(value, "ByPass")) rule.action = FirewallAction::Bypass;
+            else rule.action = FirewallAction::Allow;
+        } else if (key == "Active") {
+            rule.active = equalsIgnoreCase(value, "TRUE");
+        } else if (key == "Dir") {
+            rule.direction = equalsIgnoreCase(value, "Out") ? FirewallDirection::Out : FirewallDirection::In;
+        } else if (key == "Protocol") {
+            uint32_t protocol;
+            if (parseNumber(value, 255, protocol)) rule.protocol = static_cast<int>(protocol);
+        } else if (key == "Profile") {
+            if (equalsIgnoreCase(value, "Domain")) profiles |= FirewallProfileDomain;
+            else if (equalsIgnoreCase(value, "Private")) profiles |= FirewallProfilePrivate;
+            else if (equalsIgnoreCase(value, "Public")) profiles |= FirewallProfilePublic;
+        } else if (key == "App") {
+            rule.application = toLower(value);
+        } else if (key == "Svc") {
+            if (value != "*") rule.service = toLower(value);
+        } else if (key == "Name") {
+            rule.name.assign(value.data(), value.size());
+        } else if (key == "LPort" || key == "LPort2_10") {
+            addPort(rule.localPorts, value);
+        } else if (key == "RPort" || key == "RPort2_10") {
+            addPort(rule.remotePorts, value);
+        } else if (key.compare(0, 3, "LA4") == 0 || key.compare(0, 3, "LA6") == 0) {
+            addAddress(rule.localAddresses, value);
+        } else if (key.compare(0, 3, "RA4") == 0 || key.compare(0, 3, "RA6") == 0) {
+            addAddress(rule.remoteAddresses, value);
+        } else if (key == "ICMP4" || key == "ICMP6") {
+            if (!rule.icmpTypes.empty()) rule.icmpTypes += ',';
+            rule.icmpTypes.append(value.data(), value.size());
+        } else if (std::none_of(std::begin(DescriptiveFields), std::end(DescriptiveFields),
+                                [&](const char* name) { return key == name; })) {
+            conditions.push_back(field);
+        }
+    }
+
+    rule.profiles = profiles != 0 ? profiles : FirewallProfileAll;
+    std::sort(conditions.begin(), conditions.end());
+    for (auto condition : conditions) {
+        rule.conditions.append(condition.data(), condition.size());
+        rule.conditions += ';';
+    }
+    rule.localPorts.normalize();
+    rule.remotePorts.normalize();
+    rule.localAddresses.normalize();
+    rule.remoteAddresses.normalize();
+    return true;
+}
+
+bool FirewallRuleSet::add(std::string_view id, std::string_view ruleText) {
+    FirewallRule rule;
+    if (!parseRule(ruleText, rule)) {
+        return false;
+    }
+    rule.id.assign(id.data(), id.size());
+    entries.push_back(std::move(rule));
+    return true;
+}
+
+bool FirewallRuleSet::loadFromRegistry(const RegistryProvider& registry) {
+    bool found = false;
+    for (const char* key : RuleKeys) {
+        std::vector<std::string> names;
+        if (!registry.enumerateValues(key, names)) continue;
+        found = true;
+
+        entries.reserve(entries.size() + names.size());
+        for (const auto& name : names) {
+            add(name, registry.readValue(key, name));
+        }
+    }
+    return found;
+}
+
+bool FirewallRuleSet::loadFromCsv(const CsvReader& table) {
+    int nameColumn = table.columnIndex("Name");
+    int ruleColumn = table.columnIndex("Rule");
+    if (ruleColumn < 0) {
+        return false;
+    }
+
+    entries.reserve(entries.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        add(row[nameColumn], row[ruleColumn]);
+    }
+    return true;
+}
+
+size_t FirewallRuleSet::activeCount() const {
+    return static_cast<size_t>(std::count_if(entries.begin(), entries.end(), [](const FirewallRule& rule) {
+        return rule.active;
+    }));
+}
+
+const std::vector<uint16_t>& FirewallRuleSet::sensitivePorts() {
+    // FTP, Telnet, RPC endpoint mapper, NetBIOS, SMB, SQL Server, MySQL, RDP, VNC, WinRM
+    static const std::vector<uint16_t> ports = { 21, 23, 135, 139, 445, 1433, 3306, 3389, 5900, 5985, 5986 };
+    return ports;
+}
+
+std::vector<FirewallFinding> FirewallRuleSet::analyze() const {
+    std::vector<FirewallFinding> findings;
+
+    // Index active allow and block rules; bypass rules override blocks and are not compared
+    std::unordered_map<std::string, RuleBucket> buckets;
+    IntervalIndex publicOpenPorts;
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const FirewallRule& rule = entries[i];
+        if (!rule.active) continue;
+
+        if (rule.action != FirewallAction::Bypass) {
+            for (int bit = 0; bit < 3; ++bit) {
+                if ((rule.profiles & (1 << bit)) == 0) continue;
+                RuleBucket& bucket = buckets[bucketKey(rule.direction, rule.action == FirewallAction::Block, bit,
+                                                       rule.application, rule.service)];
+                if (rule.localPorts.any) {
+                    bucket.ports.add(0, 65535, i);
+                } else {
+                    for (const auto& range : rule.localPorts.ranges) bucket.ports.add(range.first, range.second, i);
+                    if (!rule.localPorts.names.empty()) bucket.namedPortRules.push_back(i);
+                }
+            }
+        }
+
+        // Inbound allows reachable from any address on public networks
+        if (rule.action != FirewallAction::Block && rule.direction == FirewallDirection::In &&
+            (rule.profiles & FirewallProfilePublic) && rule.remoteAddresses.any && rule.conditions.empty() &&
+            (rule.protocol < 0 || rule.protocol == 6 || rule.protocol == 17)) {
+            if (!rule.localPorts.any) {
+                for (const auto& range : rule.localPorts.ranges) publicOpenPorts.add(range.first, range.second, i);
+            } else if (rule.application.empty() && rule.service.empty()) {
+                publicOpenPorts.add(0, 65535, i);
+            }
+        }
+    }
+    for (auto& entry : buckets) {
+        entry.second.ports.build();
+    }
+    publicOpenPorts.build();
+
+    // First rule of the given action that covers entries[index]
+    auto findCovering = [&](uint32_t index, bool block) {
+        const FirewallRule& rule = entries[index];
+        bool sameAction = block == (rule.action == FirewallAction::Block);
+        uint32_t found = FirewallFinding::NoRule;
+
+        auto check = [&](uint32_t candidate) {
+            if (candidate == index || !rule.coveredBy(entries[candidate])) return true;
+            // Of two identical rules only the later one is redundant
+            if (sameAction && candidate > index && entries[candidate].coveredBy(rule)) return true;
+            found = candidate;
+            return false;
+        };
+
+        const std::string noFilter;
+        const std::string* applications[] = { &rule.application, &noFilter };
+        const std::string* services[] = { &rule.service, &noFilter };
+        int bit = lowestProfileBit(rule.profiles);
+        for (int a = 0; a < (rule.application.empty() ? 1 : 2) && found == FirewallFinding::NoRule; ++a) {
+            for (int s = 0; s < (rule.service.empty() ? 1 : 2) && found == FirewallFinding::NoRule; ++s) {
+                auto it = buckets.find(bucketKey(rule.direction, block, bit, *applications[a], *services[s]));
+                if (it == buckets.end()) continue;
+                const RuleBucket& bucket = it->second;
+
+                if (!rule.localPorts.any && !rule.localPorts.ranges.empty()) {
+                    bucket.ports.forEachContaining(rule.localPorts.ranges[0].first, rule.localPorts.ranges[0].second, check);
+                } else {
+                    bucket.ports.forEachContaining(0, 65535, check);
+                    if (!rule.localPorts.any) {
+                        for (uint32_t candidate : bucket.namedPortRules) {
+                            if (!check(candidate)) break;
+                        }
+                    }
+                }
+            }
+        }
+        return found;
+    };
+
+    // Permissive inbound rules: all traffic, sensitive ports or wide port ranges open to anyone
+    std::vector<uint8_t> flagged(entries.size(), 0);
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const FirewallRule& rule = entries[i];
+        if (rule.active && rule.action != FirewallAction::Block && rule.direction == FirewallDirection::In &&
+            rule.remoteAddresses.any && rule.conditions.empty() && rule.protocol < 0 && rule.localPorts.any &&
+            rule.application.empty() && rule.service.empty()) {
+            findings.push_back({ FirewallFinding::Kind::Permissive, i, FirewallFinding::NoRule, Severity::Critical,
+                                 "Allows all inbound traffic from any address" });
+            flagged[i] = 1;
+        }
+    }
+
+    for (uint16_t port : sensitivePorts()) {
+        publicOpenPorts.forEachContaining(port, port, [&](uint32_t i) {
+            if (!flagged[i]) {
+                findings.push_back({ FirewallFinding::Kind::Permissive, i, FirewallFinding::NoRule, Severity::High,
+                                     "Opens port " + std::to_string(port) + " to any address on public networks" });
+                flagged[i] = 1;
+            }
+            return true;
+        });
+    }
+
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const FirewallRule& rule = entries[i];
+        if (!flagged[i] && rule.active && rule.action != FirewallAction::Block && rule.direction == FirewallDirection::In &&
+            rule.remoteAddresses.any && rule.conditions.empty() && rule.application.empty() &&
+            !rule.localPorts.any && rule.localPorts.width() > 1000) {
+            findings.push_back({ FirewallFinding::Kind::Permissive, i, FirewallFinding::NoRule, Severity::Medium,
+                                 "Opens " + std::to_string(rule.localPorts.width()) + " ports to any address" });
+        }
+    }
+
+    // Shadowed allows and redundant rules
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const FirewallRule& rule = entries[i];
+        if (!rule.active || rule.action == FirewallAction::Bypass) continue;
+
+        if (rule.action == FirewallAction::Allow) {
+            uint32_t blocker = findCovering(i, true);
+            if (blocker != FirewallFinding::NoRule) {
+                findings.push_back({ FirewallFinding::Kind::Shadowed, i, blocker, Severity::Low,
+                                     "Overridden by block rule " + displayName(entries[blocker]) });
+                continue;
+            }
+        }
+
+        uint32_t covering = findCovering(i, rule.action == FirewallAction::Block);
+        if (covering != FirewallFinding::NoRule) {
+            findings.push_back({ FirewallFinding::Kind::Redundant, i, covering, Severity::Low,
+                                 "Covered by rule " + displayName(entries[covering]) });
+        }
+    }
+
+    std::stable_sort(findings.begin(), findings.end(), [](const FirewallFinding& a, const FirewallFinding& b) {
+        return static_cast<int>(a.severity) > static_cast<int>(b.severity);
+    });
+    return findings;
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class CsvReader;
+class RegistryProvider;
+
+enum class FirewallAction : uint8_t {
+    Allow,
+    Block,
+    Bypass      // authenticated bypass: allow that overrides block rules
+};
+
+enum class FirewallDirection : uint8_t {
+    In,
+    Out
+};
+
+// Profile bits of FirewallRule::profiles
+const uint8_t FirewallProfileDomain = 1;
+const uint8_t FirewallProfilePrivate = 2;
+const uint8_t FirewallProfilePublic = 4;
+const uint8_t FirewallProfileAll = 7;
+
+// Ports or addresses a rule matches: numeric ranges (ports, IPv4) plus
+// named entries (keywords such as LocalSubnet or RPC, IPv6 literals)
+struct FirewallRangeSet {
+    bool any = true;
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;     // sorted, disjoint
+    std::vector<std::string> names;                         // sorted, lower-case
+
+    // Every value matched by other is also matched by this set
+    bool covers(const FirewallRangeSet& other) const;
+
+    // Number of numeric values matched
+    uint64_t width() const;
+
+    void addRange(uint32_t low, uint32_t high);
+    void addName(std::string_view name);
+    void normalize();
+};
+
+// One rule of the FirewallRules key ("v2.30|Action=Allow|Dir=In|...")
+struct FirewallRule {
+    std::string id;             // registry value name
+    std::string name;
+    FirewallAction action = FirewallAction::Allow;
+    FirewallDirection direction = FirewallDirection::In;
+    bool active = true;
+    uint8_t profiles = FirewallProfileAll;
+    int protocol = -1;          // IANA protocol number, -1 = any
+    std::string application;    // lower-case, empty = any
+    std::string service;        // lower-case, empty = any
+    std::string icmpTypes;
+    std::string conditions;     // other restricting fields (authentication, interfaces, ...), sorted
+    FirewallRangeSet localPorts;
+    FirewallRangeSet remotePorts;
+    FirewallRangeSet localAddresses;
+    FirewallRangeSet remoteAddresses;
+
+    // Every packet this rule matches is also matched by other
+    bool coveredBy(const FirewallRule& other) const;
+};
+
+struct FirewallFinding {
+    enum class Kind {
+        Permissive,     // inbound allow open to any remote address
+        Shadowed,       // allow rule fully overridden by a block rule
+        Redundant       // rule fully covered by another rule with the same action
+    };
+
+    Kind kind;
+    uint32_t rule;
+    uint32_t other;             // covering rule index, NoRule for permissive findings
+    Severity severity;
+    std::string reason;
+
+    static const uint32_t NoRule = 0xFFFFFFFFu;
+};
+
+// Firewall rule set with interval-indexed analysis. Rules are bucketed by
+// direction, action, profile and application/service, and each bucket
+// keeps an interval tree over local port ranges, so finding the rules that
+// cover a rule is a containment query instead of a pairwise comparison.
+class FirewallRuleSet {
+public:
+    // Local store and Group Policy store FirewallRules keys
+    bool loadFromRegistry(const RegistryProvider& registry);
+
+    // Exported rules: Name and Rule columns
+    bool loadFromCsv(const CsvReader& table);
+
+    // Parse and add one rule string; false if it is not a v2 rule
+    bool add(std::string_view id, std::string_view ruleText);
+
+    static bool parseRule(std::string_view text, FirewallRule& rule);
+
+    void clear() { entries.clear(); }
+    const std::vector<FirewallRule>& rules() const { return entries; }
+    size_t size() const { return entries.size(); }
+    size_t activeCount() const;
+
+    // Permissive, shadowed and redundant rules, most severe first
+    std::vector<FirewallFinding> analyze() const;
+
+    // Inbound ports that must not be open to every remote address on public networks
+    static const std::vector<uint16_t>& sensitivePorts();
+
+private:
+    std::vector<FirewallRule> entries;
+};
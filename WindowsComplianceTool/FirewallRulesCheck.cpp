@@ -0,0 +1,99 @@
+#include "FirewallRulesCheck.h"
+#include "CsvReader.h"
+#include "FirewallRules.h"
+#include "PolicyTables.h"
+#include "RegistryProvider.h"
+
+ComplianceResult FirewallRulesCheck::performCheck() {
+    FirewallRuleSet rules;
+    
+    if (registryProvider) {
+        // Offline hives: read the rule values directly
+        rules.loadFromRegistry(*registryProvider);
+    } else {
+        // Export the local and Group Policy rule stores as Name/Rule rows
+        std::string psCommand = "& { foreach ($key in 'HKLM:\\SYSTEM\\CurrentControlSet\\Services\\SharedAccess\\Parameters\\FirewallPolicy\\FirewallRules', 'HKLM:\\SOFTWARE\\Policies\\Microsoft\\WindowsFirewall\\FirewallRules') { $item = Get-Item -Path $key -ErrorAction SilentlyContinue; if ($item) { foreach ($name in $item.GetValueNames()) { [pscustomobject]@{ Name = $name; Rule = $item.GetValue($name) } } } } }";
+        CsvReader table;
+        executePowerShellCsv(psCommand, table);
+        rules.loadFromCsv(table);
+    }
+    
+    return evaluate(rules);
+}
+
+ComplianceResult FirewallRulesCheck::evaluate(const FirewallRuleSet& rules) {
+    ComplianceResult result("Firewall Rule Analysis",
+                           "Analyzes firewall rules for overly permissive, shadowed and redundant entries.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    std::vector<FirewallFinding> findings = rules.analyze();
+    
+    int permissive = 0, shadowed = 0, redundant = 0;
+    int score = 100;
+    bool critical = false;
+    for (const auto& finding : findings) {
+        switch (finding.kind) {
+        case FirewallFinding::Kind::Permissive: {
+            permissive++;
+            int penalty = 5;
+            if (finding.severity == Severity::Critical) {
+                penalty = 30;
+                critical = true;
+            } else if (finding.severity == Severity::High) {
+                penalty = 15;
+            }
+            score -= penalty;
+            const FirewallRule& rule = rules.rules()[finding.rule];
+            result.attribution.add(rule.name.empty() ? rule.id : rule.name, penalty);
+            break;
+        }
+        case FirewallFinding::Kind::Shadowed:
+            shadowed++;
+            break;
+        case FirewallFinding::Kind::Redundant:
+            redundant++;
+            break;
+        }
+    }
+    
+    // Dead and duplicate rules are a hygiene issue; cap their weight
+    int hygienePenalty = shadowed + redundant;
+    score -= (hygienePenalty > 10 ? 10 : hygienePenalty);
+    result.attribution.add("Shadowed and redundant rules", hygienePenalty > 10 ? 10 : hygienePenalty);
+    if (score < 0) score = 0;
+    
+    result.findings.number(FindingKey::FirewallRules, static_cast<int64_t>(rules.size()));
+    result.findings.number(FindingKey::ActiveFirewallRules, static_cast<int64_t>(rules.activeCount()));
+    result.findings.number(FindingKey::PermissiveRules, permissive);
+    result.findings.number(FindingKey::ShadowedRules, shadowed);
+    result.findings.number(FindingKey::RedundantRules, redundant);
+    
+    const size_t maxListed = 10;
+    for (size_t i = 0; i < findings.size() && i < maxListed; ++i) {
+        const FirewallRule& rule = rules.rules()[findings[i].rule];
+        result.findings.item(FindingKey::FirewallRuleIssue, rule.name.empty() ? rule.id : rule.name,
+                             findings[i].reason, findings[i].severity);
+    }
+    if (findings.size() > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(findings.size() - maxListed));
+    }
+    result.score = score;
+    
+    if (rules.size() == 0) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "No firewall rules could be read. Verify the firewall rule store is accessible.";
+    } else {
+        const char* advice[] = {
+            (shadowed + redundant) > 0
+                ? "No overly permissive rules found. Remove shadowed and redundant rules to keep the rule set maintainable."
+                : "Firewall rules are restrictive and free of shadowed or redundant entries. System is compliant.",
+            "Some inbound rules are open to any remote address. Restrict them to required addresses and profiles.",
+            "Inbound rules expose the system to any remote address. Remove or restrict the listed rules immediately."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, critical)];
+    }
+    
+    return result;
+}
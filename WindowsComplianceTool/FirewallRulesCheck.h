@@ -0,0 +1,13 @@
+#pragma once
+#include "ComplianceCheck.h"
+
+class FirewallRuleSet;
+
+class FirewallRulesCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Firewall Rule Analysis"; }
+    
+    // Score permissive, shadowed and redundant rules of a rule set (no system access)
+    static ComplianceResult evaluate(const FirewallRuleSet& rules);
+};
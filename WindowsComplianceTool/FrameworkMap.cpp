@@ -0,0 +1,195 @@
+#include "FrameworkMap.h"
+#include "CsvReader.h"
+#include "PolicyTables.h"
+#include "RulePack.h"
+#include "SecurityBaseline.h"
+#include "TextUtil.h"
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+using TextUtil::trim;
+
+// Group edges by control index: offsets[i] .. offsets[i + 1] are control i's
+template <typename EdgeList>
+void buildEdges(EdgeList& list, size_t controlCount, const std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+    list.offsets.assign(controlCount + 1, 0);
+    for (const auto& pair : pairs) list.offsets[pair.first + 1]++;
+    for (size_t i = 0; i < controlCount; ++i) list.offsets[i + 1] += list.offsets[i];
+    list.edges.resize(pairs.size());
+    std::vector<uint32_t> next(list.offsets.begin(), list.offsets.end() - 1);
+    for (const auto& pair : pairs) list.edges[next[pair.first]++] = pair.second;
+}
+
+struct Accumulator {
+    int64_t weightedScore = 0;
+    int64_t weight = 0;
+    uint32_t controls = 0;
+    uint32_t failed = 0;
+};
+
+inline void accumulate(Accumulator& entry, int score, Severity severity, bool passed) {
+    int weight = PolicyTables::weight<ModuleWeights>(severity);
+    entry.weightedScore += static_cast<int64_t>(score) * weight;
+    entry.weight += weight;
+    entry.controls++;
+    if (!passed) entry.failed++;
+}
+
+} // namespace
+
+bool FrameworkMap::parseSource(std::string_view text, ControlSource& source) {
+    text = trim(text);
+    if (equalsIgnoreCase(text, "Module")) source = ControlSource::Module;
+    else if (equalsIgnoreCase(text, "Baseline")) source = ControlSource::Baseline;
+    else if (equalsIgnoreCase(text, "Rule")) source = ControlSource::Rule;
+    else return false;
+    return true;
+}
+
+void FrameworkMap::add(std::string_view framework, std::string_view requirement, std::string_view title,
+                       ControlSource source, std::string_view control) {
+    std::string frameworkName(trim(framework));
+    auto found = frameworkIndex.find(frameworkName);
+    if (found == frameworkIndex.end()) {
+        found = frameworkIndex.emplace(frameworkName, static_cast<uint32_t>(names.size())).first;
+        names.push_back(frameworkName);
+    }
+
+    std::string key = frameworkName + '\n' + std::string(trim(requirement));
+    auto requirementFound = requirementIndex.find(key);
+    if (requirementFound == requirementIndex.end()) {
+        requirementFound = requirementIndex.emplace(std::move(key), static_cast<uint32_t>(entries.size())).first;
+        entries.push_back({ found->second, std::string(trim(requirement)), std::string(trim(title)) });
+    } else if (entries[requirementFound->second].title.empty()) {
+        entries[requirementFound->second].title = std::string(trim(title));
+    }
+
+    mappings.push_back({ requirementFound->second, source, std::string(trim(control)) });
+    bound = false;
+}
+
+bool FrameworkMap::loadFromCsv(const CsvReader& table) {
+    int frameworkColumn = table.columnIndex("Framework");
+    int requirementColumn = table.columnIndex("Requirement");
+    int titleColumn = table.columnIndex("Title");
+    int sourceColumn = table.columnIndex("Source");
+    int controlColumn = table.columnIndex("Control");
+    if (frameworkColumn < 0 || requirementColumn < 0 || sourceColumn < 0 || controlColumn < 0) return false;
+
+    mappings.reserve(mappings.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        ControlSource source;
+        if (!parseSource(row[sourceColumn], source) || trim(row[frameworkColumn]).empty() ||
+            trim(row[requirementColumn]).empty() || trim(row[controlColumn]).empty()) {
+            invalid++;
+            continue;
+        }
+        add(row[frameworkColumn], row[requirementColumn], row.value(titleColumn), source, row.value(controlColumn));
+    }
+    return !mappings.empty();
+}
+
+bool FrameworkMap::loadFile(const std::string& path) {
+    CsvReader table;
+    return table.loadFromFile(path) && loadFromCsv(table);
+}
+
+void FrameworkMap::bind(const SecurityBaseline* baseline, const RulePack* rules) {
+    uint64_t revisions[2] = { baseline ? baseline->revision() : 0, rules ? rules->revision() : 0 };
+    if (bound && baseline == boundBaseline && rules == boundRules && mappings.size() == boundMappings &&
+        revisions[0] == boundRevisions[0] && revisions[1] == boundRevisions[1]) {
+        return;
+    }
+
+    std::unordered_map<std::string_view, uint32_t> controlIds, ruleIds;
+    if (baseline) {
+        for (uint32_t i = 0; i < baseline->size(); ++i) controlIds.emplace(baseline->controls()[i].id, i);
+    }
+    if (rules) {
+        for (uint32_t i = 0; i < rules->size(); ++i) ruleIds.emplace(rules->rules()[i].id, i);
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> baselinePairs, rulePairs;
+    moduleEdges.clear();
+    unbound = 0;
+    for (const auto& mapping : mappings) {
+        if (mapping.source == ControlSource::Module) {
+            moduleEdges[mapping.control].push_back(mapping.requirement);
+            continue;
+        }
+        const auto& ids = mapping.source == ControlSource::Baseline ? controlIds : ruleIds;
+        auto found = ids.find(mapping.control);
+        if (found == ids.end()) {
+            unbound++;
+            continue;
+        }
+        (mapping.source == ControlSource::Baseline ? baselinePairs : rulePairs).emplace_back(found->second, mapping.requirement);
+    }
+    buildEdges(baselineEdges, baseline ? baseline->size() : 0, baselinePairs);
+    buildEdges(ruleEdges, rules ? rules->size() : 0, rulePairs);
+
+    boundBaseline = baseline;
+    boundRules = rules;
+    boundMappings = mappings.size();
+    std::copy(revisions, revisions + 2, boundRevisions);
+    bound = true;
+}
+
+void FrameworkMap::evaluate(const FrameworkInputs& inputs, std::vector<FrameworkScore>& scores,
+                            std::vector<RequirementOutcome>& requirements) const {
+    std::vector<Accumulator> totals(entries.size());
+
+    // Every outcome once, fanned out to the requirements it maps to
+    if (bound && inputs.modules) {
+        for (const auto& result : *inputs.modules) {
+            if (result.status == CheckStatus::NotApplicable) continue;
+            auto found = moduleEdges.find(std::string(result.moduleName));
+            if (found == moduleEdges.end()) continue;
+            for (uint32_t requirement : found->second) {
+                accumulate(totals[requirement], result.score, result.severity, result.status == CheckStatus::Pass);
+            }
+        }
+    }
+    if (bound && boundBaseline && inputs.baseline) {
+        for (const auto& outcome : *inputs.baseline) {
+            if (outcome.control + 1 >= baselineEdges.offsets.size()) continue;
+            Severity severity = boundBaseline->controls()[outcome.control].severity;
+            for (uint32_t e = baselineEdges.offsets[outcome.control]; e < baselineEdges.offsets[outcome.control + 1]; ++e) {
+                accumulate(totals[baselineEdges.edges[e]], outcome.passed ? 100 : 0, severity, outcome.passed);
+            }
+        }
+    }
+    if (bound && boundRules && inputs.rules) {
+        for (const auto& outcome : *inputs.rules) {
+            if (outcome.rule + 1 >= ruleEdges.offsets.size()) continue;
+            for (uint32_t e = ruleEdges.offsets[outcome.rule]; e < ruleEdges.offsets[outcome.rule + 1]; ++e) {
+                accumulate(totals[ruleEdges.edges[e]], outcome.score, outcome.severity, outcome.status == CheckStatus::Pass);
+            }
+        }
+    }
+
+    // Then every requirement once, into its framework
+    scores.assign(names.size(), FrameworkScore{});
+    for (uint32_t i = 0; i < names.size(); ++i) scores[i].framework = i;
+    std::vector<int64_t> scoreSums(names.size(), 0);
+    requirements.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Accumulator& total = totals[i];
+        RequirementOutcome& outcome = requirements[i];
+        outcome.score = total.weight > 0 ? static_cast<int>(total.weightedScore / total.weight) : 0;
+        outcome.controls = total.controls;
+        outcome.failed = total.failed;
+
+        FrameworkScore& framework = scores[entries[i].framework];
+        framework.requirements++;
+        if (!outcome.assessed()) continue;
+        framework.assessed++;
+        if (outcome.passed()) framework.passed++;
+        scoreSums[entries[i].framework] += outcome.score;
+    }
+    for (auto& framework : scores) {
+        framework.score = framework.assessed > 0 ? static_cast<int>(scoreSums[framework.framework] / framework.assessed) : 0;
+    }
+}
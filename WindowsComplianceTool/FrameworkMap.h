@@ -0,0 +1,128 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CsvReader;
+class SecurityBaseline;
+class RulePack;
+struct BaselineOutcome;
+struct RuleOutcome;
+
+// Where a mapped control's outcome comes from
+enum class ControlSource : uint8_t {
+    Module,         // a module result, by module name
+    Baseline,       // a SecurityBaseline control, by id
+    Rule            // a RulePack rule, by id
+};
+
+// One requirement of a framework (a CIS recommendation, a NIST 800-53
+// control, an ISO 27001 Annex A control)
+struct FrameworkRequirement {
+    uint32_t framework;             // index into FrameworkMap::frameworks()
+    std::string id;
+    std::string title;
+};
+
+// A requirement's result on one host. Controls that did not run (module
+// disabled, not applicable, id unknown to the loaded definitions) are not
+// counted; a requirement with none left is not assessed.
+struct RequirementOutcome {
+    int score;                      // severity-weighted average of its controls
+    uint32_t controls;              // controls assessed
+    uint32_t failed;                // controls assessed that did not pass
+    bool assessed() const { return controls > 0; }
+    bool passed() const { return controls > 0 && failed == 0; }
+};
+
+struct FrameworkScore {
+    uint32_t framework;
+    int score;                      // mean of the assessed requirements' scores
+    uint32_t requirements;
+    uint32_t assessed;
+    uint32_t passed;
+};
+
+// Outcomes of one scan, each computed once and shared by every framework
+struct FrameworkInputs {
+    const std::vector<ComplianceResult>* modules = nullptr;
+    const std::vector<BaselineOutcome>* baseline = nullptr;
+    const std::vector<RuleOutcome>* rules = nullptr;
+};
+
+// Maps controls to the framework requirements they satisfy, so one scan is
+// scored against CIS, NIST, ISO and any other framework in a single pass.
+// Mappings are bound once per definition into per-control edge lists;
+// evaluation visits each outcome once and adds it to every requirement it
+// maps to, so another framework only adds its edges.
+//
+// CSV columns: Framework, Requirement, optional Title, Source (Module,
+// Baseline or Rule) and Control (module name or control / rule id). A
+// control may map to any number of requirements, and a requirement to any
+// number of controls.
+class FrameworkMap {
+public:
+    bool loadFile(const std::string& path);
+    bool loadFromCsv(const CsvReader& table);
+
+    void add(std::string_view framework, std::string_view requirement, std::string_view title,
+             ControlSource source, std::string_view control);
+
+    const std::vector<std::string>& frameworks() const { return names; }
+    const std::vector<FrameworkRequirement>& requirements() const { return entries; }
+    size_t mappingCount() const { return mappings.size(); }
+    bool empty() const { return mappings.empty(); }
+
+    // Rows skipped when loading
+    size_t invalidCount() const { return invalid; }
+
+    // Resolve module names and baseline and rule ids against the loaded
+    // definitions (either may be null). Cheap when neither definition's
+    // revision nor the mappings changed since the last call; evaluate()
+    // needs a bound map.
+    void bind(const SecurityBaseline* baseline, const RulePack* rules);
+
+    // Mappings whose control is not in the bound definitions
+    size_t unboundCount() const { return unbound; }
+
+    // Score every framework from one scan's outcomes; requirements is
+    // indexed like requirements()
+    void evaluate(const FrameworkInputs& inputs, std::vector<FrameworkScore>& scores,
+                  std::vector<RequirementOutcome>& requirements) const;
+
+    static bool parseSource(std::string_view text, ControlSource& source);
+
+private:
+    struct Mapping {
+        uint32_t requirement;
+        ControlSource source;
+        std::string control;
+    };
+
+    std::vector<std::string> names;
+    std::vector<FrameworkRequirement> entries;
+    std::vector<Mapping> mappings;
+    std::unordered_map<std::string, uint32_t> frameworkIndex;
+    std::unordered_map<std::string, uint32_t> requirementIndex;   // "framework\nrequirement"
+    size_t invalid = 0;
+
+    // Requirement edges per control, CSR style: control i maps to
+    // edges[offsets[i]] .. edges[offsets[i + 1]]
+    struct EdgeList {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> edges;
+    };
+
+    std::unordered_map<std::string, std::vector<uint32_t>> moduleEdges;   // module name -> requirements
+    EdgeList baselineEdges;
+    EdgeList ruleEdges;
+    const SecurityBaseline* boundBaseline = nullptr;
+    const RulePack* boundRules = nullptr;
+    size_t boundMappings = 0;
+    uint64_t boundRevisions[2] = { 0, 0 };  // baseline and rule pack when bound
+    bool bound = false;
+    size_t unbound = 0;
+};
@@ -0,0 +1,380 @@
+#include "GroupPolicy.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <set>
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+using TextUtil::startsWithIgnoreCase;
+
+const uint32_t PolVersion = 1;
+
+inline uint16_t readUnit(std::string_view bytes, size_t pos) {
+    return static_cast<uint16_t>(static_cast<unsigned char>(bytes[pos]) |
+                                 (static_cast<unsigned char>(bytes[pos + 1]) << 8));
+}
+
+inline uint32_t readU32(std::string_view bytes, size_t pos) {
+    return static_cast<uint32_t>(readUnit(bytes, pos)) | (static_cast<uint32_t>(readUnit(bytes, pos + 2)) << 16);
+}
+
+// Expect one UTF-16 delimiter character
+inline bool expectUnit(std::string_view bytes, size_t& pos, char c) {
+    if (pos + 2 > bytes.size() || readUnit(bytes, pos) != static_cast<uint16_t>(c)) {
+        return false;
+    }
+    pos += 2;
+    return true;
+}
+
+// Read a NUL-terminated UTF-16 name up to the ';' that follows it
+bool readName(std::string_view bytes, size_t& pos, std::string& name) {
+    size_t start = pos;
+    while (pos + 2 <= bytes.size()) {
+        uint16_t unit = readUnit(bytes, pos);
+        if (unit == 0 || unit == ';') {
+            name = TextEncoding::utf16LEToUtf8(bytes.data() + start, pos - start);
+            if (unit == 0) pos += 2;
+            return expectUnit(bytes, pos, ';');
+        }
+        pos += 2;
+    }
+    return false;
+}
+
+// "a;b;c" list stored as REG_SZ data of the **DeleteValues / **DeleteKeys records
+std::vector<std::string> splitList(const PolicyRecord& record) {
+    std::string text = RegistryHive::formatValue(RegistryValueType::String, record.data);
+    std::vector<std::string> items;
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t end = text.find(';', pos);
+        if (end == std::string::npos) end = text.size();
+        if (end > pos) items.push_back(text.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return items;
+}
+
+} // namespace
+
+bool RegistryPolFile::loadFromFile(const std::string& path, std::vector<PolicyRecord>& records) {
+    std::string bytes;
+    if (!TextEncoding::readFile(path, bytes)) {
+        return false;
+    }
+    return parse(bytes, records);
+}
+
+bool RegistryPolFile::parse(std::string_view bytes, std::vector<PolicyRecord>& records) {
+    if (bytes.size() < 8 || bytes.substr(0, 4) != "PReg" || readU32(bytes, 4) != PolVersion) {
+        return false;
+    }
+
+    size_t pos = 8;
+    while (pos + 2 <= bytes.size()) {
+        PolicyRecord record;
+
+        if (!expectUnit(bytes, pos, '[') ||
+            !readName(bytes, pos, record.key) ||
+            !readName(bytes, pos, record.valueName) ||
+            pos + 4 > bytes.size()) {
+            return false;
+        }
+
+        record.type = static_cast<RegistryValueType>(readU32(bytes, pos));
+        pos += 4;
+        if (!expectUnit(bytes, pos, ';') || pos + 4 > bytes.size()) {
+            return false;
+        }
+
+        uint32_t dataSize = readU32(bytes, pos);
+        pos += 4;
+        if (!expectUnit(bytes, pos, ';') || dataSize > bytes.size() - pos) {
+            return false;
+        }
+
+        record.data.assign(bytes.data() + pos, dataSize);
+        pos += dataSize;
+        if (!expectUnit(bytes, pos, ']')) {
+            return false;
+        }
+
+        records.push_back(std::move(record));
+    }
+
+    return true;
+}
+
+bool GroupPolicy::loadFile(const std::string& path, PolicyScope scope) {
+    std::string bytes;
+    if (!TextEncoding::readFile(path, bytes)) {
+        return false;
+    }
+    return loadMemory(bytes, scope, path);
+}
+
+bool GroupPolicy::loadMemory(std::string_view bytes, PolicyScope scope, const std::string& sourceName) {
+    std::vector<PolicyRecord> records;
+    if (!RegistryPolFile::parse(bytes, records)) {
+        return false;
+    }
+
+    size_t source = sourceNames.size();
+    sourceNames.push_back(sourceName);
+    settings.reserve(settings.size() + records.size());
+
+    for (const auto& record : records) {
+        apply(record, scope, source);
+    }
+    return true;
+}
+
+bool GroupPolicy::loadDirectory(const std::string& directory) {
+    std::filesystem::path root(directory);
+    std::error_code ec;
+    bool loaded = false;
+
+    std::filesystem::path machine = root / "Machine" / "Registry.pol";
+    if (std::filesystem::exists(machine, ec) && loadFile(machine.string(), PolicyScope::Machine)) {
+        loaded = true;
+    }
+
+    std::filesystem::path user = root / "User" / "Registry.pol";
+    if (std::filesystem::exists(user, ec) && loadFile(user.string(), PolicyScope::User)) {
+        loaded = true;
+    }
+
+    return loaded;
+}
+
+void GroupPolicy::clear() {
+    settings.clear();
+    keyIndex.clear();
+    sourceNames.clear();
+}
+
+std::string GroupPolicy::makeKeyIndex(PolicyScope scope, std::string_view key) {
+    std::string indexKey;
+    indexKey.reserve(key.size() + 2);
+    indexKey += scope == PolicyScope::Machine ? 'm' : 'u';
+    indexKey += '|';
+    for (char c : key) indexKey += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return indexKey;
+}
+
+std::string GroupPolicy::makeIndexKey(PolicyScope scope, std::string_view key, std::string_view valueName) {
+    std::string indexKey = makeKeyIndex(scope, key);
+    indexKey.reserve(indexKey.size() + valueName.size() + 1);
+    indexKey += '|';
+    for (char c : valueName) indexKey += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return indexKey;
+}
+
+void GroupPolicy::apply(const PolicyRecord& record, PolicyScope scope, size_t source) {
+    std::string_view name = record.valueName;
+
+    if (name.size() < 2 || name[0] != '*' || name[1] != '*') {
+        // A record with no value name and no data only creates the key
+        if (!name.empty() || record.type != RegistryValueType::None || !record.data.empty()) {
+            setValue(record, name, scope, source, false);
+        }
+        return;
+    }
+
+    if (startsWithIgnoreCase(name, "**del.")) {
+        deleteValue(scope, record.key, name.substr(6), source);
+    } else if (startsWithIgnoreCase(name, "**soft.")) {
+        setValue(record, name.substr(7), scope, source, true);
+    } else if (startsWithIgnoreCase(name, "**delvals")) {
+        deleteKey(scope, record.key, false, source);
+    } else if (equalsIgnoreCase(name, "**DeleteValues")) {
+        for (const auto& valueName : splitList(record)) {
+            deleteValue(scope, record.key, valueName, source);
+        }
+    } else if (equalsIgnoreCase(name, "**DeleteKeys")) {
+        for (const auto& key : splitList(record)) {
+            deleteKey(scope, key, true, source);
+        }
+    }
+    // **SecureKey and other control records do not change values
+}
+
+void GroupPolicy::setValue(const PolicyRecord& record, std::string_view valueName, PolicyScope scope, size_t source, bool soft) {
+    // **soft. values only apply when no earlier policy set the value
+    if (soft && find(scope, record.key, valueName) != nullptr) {
+        return;
+    }
+
+    PolicySetting& setting = settingFor(scope, record.key, valueName);
+    setting.type = record.type;
+    setting.data = record.data;
+    setting.deleted = false;
+    setting.source = source;
+}
+
+PolicySetting& GroupPolicy::settingFor(PolicyScope scope, std::string_view key, std::string_view valueName) {
+    auto inserted = settings.try_emplace(makeIndexKey(scope, key, valueName));
+    PolicySetting& setting = inserted.first->second;
+    setting.scope = scope;
+    setting.key.assign(key.data(), key.size());
+    setting.valueName.assign(valueName.data(), valueName.size());
+    if (inserted.second) {
+        keyIndex[makeKeyIndex(scope, key)].push_back(&setting);
+    }
+    return setting;
+}
+
+void GroupPolicy::deleteValue(PolicyScope scope, std::string_view key, std::string_view valueName, size_t source) {
+    deleteValue(settingFor(scope, key, valueName), source);
+}
+
+void GroupPolicy::deleteValue(PolicySetting& setting, size_t source) {
+    setting.type = RegistryValueType::None;
+    setting.data.clear();
+    setting.deleted = true;
+    setting.source = source;
+}
+
+// Values an earlier policy set under the key are recorded as deleted, like
+// **del., so a later file's deletion is not undone by what the registry holds
+void GroupPolicy::deleteKey(PolicyScope scope, std::string_view key, bool subkeys, size_t source) {
+    std::string index = makeKeyIndex(scope, key);
+    auto it = keyIndex.find(index);
+    if (it != keyIndex.end()) {
+        for (PolicySetting* setting : it->second) deleteValue(*setting, source);
+    }
+    if (!subkeys) return;
+
+    index += '\\';
+    for (it = keyIndex.lower_bound(index); it != keyIndex.end() && it->first.compare(0, index.size(), index) == 0; ++it) {
+        for (PolicySetting* setting : it->second) deleteValue(*setting, source);
+    }
+}
+
+const PolicySetting* GroupPolicy::find(PolicyScope scope, std::string_view key, std::string_view valueName) const {
+    auto it = settings.find(makeIndexKey(scope, key, valueName));
+    return it != settings.end() ? &it->second : nullptr;
+}
+
+std::vector<PolicyDrift> GroupPolicy::compare(const RegistryProvider& effective) const {
+    std::vector<PolicyDrift> drift;
+
+    for (const auto& entry : settings) {
+        const PolicySetting& setting = entry.second;
+        std::string path = fullKeyPath(setting);
+        bool present = effective.valueExists(path, setting.valueName);
+
+        if (setting.deleted) {
+            if (present) {
+                drift.push_back(PolicyDrift{ &setting, effective.readValue(path, setting.valueName), true });
+            }
+            continue;
+        }
+
+        // Binary and multi-string values cannot be compared through readValue
+        std::string expected = setting.text();
+        if (expected.empty() && !setting.data.empty()) {
+            continue;
+        }
+
+        std::string actual = present ? effective.readValue(path, setting.valueName) : std::string();
+        if (!present || actual != expected) {
+            drift.push_back(PolicyDrift{ &setting, actual, present });
+        }
+    }
+
+    return drift;
+}
+
+std::string GroupPolicy::fullKeyPath(const PolicySetting& setting) {
+    return (setting.scope == PolicyScope::Machine ? "HKEY_LOCAL_MACHINE\\" : "HKEY_CURRENT_USER\\") + setting.key;
+}
+
+bool GroupPolicy::splitPath(std::string_view keyPath, PolicyScope& scope, std::string_view& key) {
+    static const struct { const char* prefix; PolicyScope scope; } Roots[] = {
+        { "HKEY_LOCAL_MACHINE\\", PolicyScope::Machine }, { "HKLM:\\", PolicyScope::Machine },
+        { "HKLM\\", PolicyScope::Machine }, { "HKEY_CURRENT_USER\\", PolicyScope::User },
+        { "HKCU:\\", PolicyScope::User }, { "HKCU\\", PolicyScope::User }
+    };
+
+    for (const auto& root : Roots) {
+        if (startsWithIgnoreCase(keyPath, root.prefix)) {
+            scope = root.scope;
+            key = keyPath.substr(std::char_traits<char>::length(root.prefix));
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string GroupPolicy::readValue(const std::string& keyPath, const std::string& valueName) const {
+    PolicyScope scope;
+    std::string_view key;
+    if (!splitPath(keyPath, scope, key)) {
+        return std::string();
+    }
+
+    const PolicySetting* setting = find(scope, key, valueName);
+    return (setting != nullptr && !setting->deleted) ? setting->text() : std::string();
+}
+
+bool GroupPolicy::valueExists(const std::string& keyPath, const std::string& valueName) const {
+    PolicyScope scope;
+    std::string_view key;
+    if (!splitPath(keyPath, scope, key)) {
+        return false;
+    }
+
+    const PolicySetting* setting = find(scope, key, valueName);
+    return setting != nullptr && !setting->deleted;
+}
+
+bool GroupPolicy::enumerateSubkeys(const std::string& keyPath, std::vector<std::string>& names) const {
+    PolicyScope scope;
+    std::string_view key;
+    if (!splitPath(keyPath, scope, key)) {
+        return false;
+    }
+
+    std::string index = makeKeyIndex(scope, key);
+    bool found = keyIndex.count(index) != 0;
+    std::set<std::string> children;
+    index += '\\';
+    for (auto it = keyIndex.lower_bound(index); it != keyIndex.end() && it->first.compare(0, index.size(), index) == 0; ++it) {
+        found = true;
+        const std::string& child = it->second.front()->key;
+        size_t end = child.find('\\', key.size() + 1);
+        children.insert(child.substr(key.size() + 1, end == std::string::npos ? std::string::npos : end - key.size() - 1));
+    }
+
+    names.insert(names.end(), children.begin(), children.end());
+    return found;
+}
+
+bool GroupPolicy::enumerateValues(const std::string& keyPath, std::vector<std::string>& names) const {
+    PolicyScope scope;
+    std::string_view key;
+    if (!splitPath(keyPath, scope, key)) {
+        return false;
+    }
+
+    auto it = keyIndex.find(makeKeyIndex(scope, key));
+    if (it == keyIndex.end()) {
+        return false;
+    }
+
+    std::set<std::string> values;
+    for (const PolicySetting* setting : it->second) {
+        if (!setting->deleted && !setting->valueName.empty()) {
+            values.insert(setting->valueName);
+        }
+    }
+
+    names.insert(names.end(), values.begin(), values.end());
+    return true;
+}
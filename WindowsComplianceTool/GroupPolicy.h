@@ -0,0 +1,111 @@
+#pragma once
+#include "RegistryHive.h"
+#include "RegistryProvider.h"
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Side of a GPO a Registry.pol file belongs to
+enum class PolicyScope {
+    Machine,    // HKEY_LOCAL_MACHINE (GroupPolicy\Machine\Registry.pol)
+    User        // HKEY_CURRENT_USER (GroupPolicy\User\Registry.pol)
+};
+
+// One record of a Registry.pol file, names converted to UTF-8.
+// Control records keep their "**" value names (**del.X, **delvals., ...).
+struct PolicyRecord {
+    std::string key;
+    std::string valueName;
+    RegistryValueType type = RegistryValueType::None;
+    std::string data;           // raw value bytes
+};
+
+// Parser for the binary PReg format: "PReg" + version 1, then records of
+// [key;value;type;size;data] with UTF-16LE names and delimiters.
+class RegistryPolFile {
+public:
+    static bool loadFromFile(const std::string& path, std::vector<PolicyRecord>& records);
+    static bool parse(std::string_view bytes, std::vector<PolicyRecord>& records);
+};
+
+// A registry setting as configured by policy
+struct PolicySetting {
+    PolicyScope scope = PolicyScope::Machine;
+    std::string key;
+    std::string valueName;
+    RegistryValueType type = RegistryValueType::None;
+    std::string data;
+    bool deleted = false;       // policy removes the value (**del., **delvals., **DeleteKeys)
+    size_t source = 0;          // index of the file that set it (see sources())
+
+    // Value formatted like ComplianceCheck::readRegistryValue
+    std::string text() const { return RegistryHive::formatValue(type, data); }
+};
+
+// Setting whose policy value differs from the effective registry
+struct PolicyDrift {
+    const PolicySetting* setting;
+    std::string effectiveValue;     // empty if the value is missing
+    bool effectivePresent;
+};
+
+// Merged view of one or more Registry.pol files applied in order (local
+// policy first, then site, domain and OU GPOs), indexed by scope, key and
+// value name. As a RegistryProvider it answers HKLM / HKCU reads with
+// what policy configures, so the same checks can score "configured by
+// policy" next to the effective registry.
+class GroupPolicy : public RegistryProvider {
+public:
+    // Merge a Registry.pol file; later files take precedence
+    bool loadFile(const std::string& path, PolicyScope scope);
+    bool loadMemory(std::string_view bytes, PolicyScope scope, const std::string& sourceName = "");
+
+    // Merge Machine\Registry.pol and User\Registry.pol of a GPO folder
+    // (a SYSVOL policy folder or %SystemRoot%\System32\GroupPolicy)
+    bool loadDirectory(const std::string& directory);
+
+    void clear();
+    size_t size() const { return settings.size(); }
+    const std::vector<std::string>& sources() const { return sourceNames; }
+
+    // Setting for a value, nullptr if policy does not configure it
+    const PolicySetting* find(PolicyScope scope, std::string_view key, std::string_view valueName) const;
+
+    // Every configured setting (unordered)
+    template <typename Fn>
+    void forEachSetting(Fn&& fn) const {
+        for (const auto& entry : settings) fn(entry.second);
+    }
+
+    // Settings whose value is not in effect on the given registry
+    std::vector<PolicyDrift> compare(const RegistryProvider& effective) const;
+
+    // Full registry path of a setting's key ("HKEY_LOCAL_MACHINE\...")
+    static std::string fullKeyPath(const PolicySetting& setting);
+
+    std::string readValue(const std::string& keyPath, const std::string& valueName) const override;
+    bool valueExists(const std::string& keyPath, const std::string& valueName) const override;
+    bool enumerateSubkeys(const std::string& keyPath, std::vector<std::string>& names) const override;
+    bool enumerateValues(const std::string& keyPath, std::vector<std::string>& names) const override;
+
+private:
+    std::unordered_map<std::string, PolicySetting> settings;
+    std::vector<std::string> sourceNames;
+
+    // Settings by scope and lower-case key, ordered so a key's subkeys
+    // follow it; node pointers stay valid as settings grows
+    std::map<std::string, std::vector<PolicySetting*>> keyIndex;
+
+    static std::string makeKeyIndex(PolicyScope scope, std::string_view key);
+    static std::string makeIndexKey(PolicyScope scope, std::string_view key, std::string_view valueName);
+    static bool splitPath(std::string_view keyPath, PolicyScope& scope, std::string_view& key);
+
+    void apply(const PolicyRecord& record, PolicyScope scope, size_t source);
+    void setValue(const PolicyRecord& record, std::string_view valueName, PolicyScope scope, size_t source, bool soft);
+    void deleteValue(PolicyScope scope, std::string_view key, std::string_view valueName, size_t source);
+    PolicySetting& settingFor(PolicyScope scope, std::string_view key, std::string_view valueName);
+    void deleteValue(PolicySetting& setting, size_t source);
+    void deleteKey(PolicyScope scope, std::string_view key, bool subkeys, size_t source);
+};
@@ -1,70 +1,137 @@
 #include "InstalledSoftwareCheck.h"
-#include <sstream>
+#include "CsvReader.h"
+#include "PolicyTables.h"
+#include "SoftwareInventory.h"
+#include "VulnerabilityDatabase.h"
+#include "RegistryProvider.h"
 #include <vector>
 #include <algorithm>
+#include <filesystem>
 
 ComplianceResult InstalledSoftwareCheck::performCheck() {
-    ComplianceResult result("Installed Software Audit",
-                           "Lists all installed applications and flags potentially risky or outdated ones.",
-                           CheckStatus::Pass, Severity::Low, 100);
+    SoftwareInventory inventory;
     
-    result.details.push_back("Auditing installed software...");
+    if (registryProvider) {
+        // Offline hives: walk the Uninstall keys directly
+        inventory.loadFromRegistry(*registryProvider);
+    } else {
+        // Export the Uninstall keys (64-bit and WOW6432Node) as CSV; one row per application
+        std::string regCommand = "Get-ItemProperty HKLM:\\Software\\Microsoft\\Windows\\CurrentVersion\\Uninstall\\*, HKLM:\\Software\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall\\* -ErrorAction SilentlyContinue | Where-Object {$_.DisplayName -ne $null} | Select-Object DisplayName, DisplayVersion, Publisher, InstallDate";
+        CsvReader table;
+        executePowerShellCsv(regCommand, table);
+        inventory.loadFromCsv(table);
+    }
     
-    // Get installed software using PowerShell
-    std::string psCommand = "Get-WmiObject -Class Win32_Product | Select-Object Name, Version, InstallDate | Sort-Object Name | Format-Table -AutoSize";
-    std::string output = executePowerShell(psCommand);
+    // Load the local database once and keep it for later scans
+    if (!vulnerabilities) {
+        std::string path = dataFilePath("VulnerableSoftware.csv");
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            auto database = std::make_shared<VulnerabilityDatabase>();
+            if (database->loadFromFile(path)) {
+                vulnerabilities = database;
+            }
+        }
+    }
     
-    // Also check via registry (more reliable)
-    std::string regCommand = "Get-ItemProperty HKLM:\\Software\\Microsoft\\Windows\\CurrentVersion\\Uninstall\\* | Select-Object DisplayName, DisplayVersion, Publisher | Where-Object {$_.DisplayName -ne $null} | Sort-Object DisplayName | Format-Table -AutoSize";
-    std::string regOutput = executePowerShell(regCommand);
+    return evaluate(inventory, vulnerabilities.get());
+}
+
+ComplianceResult InstalledSoftwareCheck::evaluate(const SoftwareInventory& inventory, const VulnerabilityDatabase* vulnerabilities) {
+    ComplianceResult result("Installed Software Audit",
+                           "Lists all installed applications and flags potentially risky or outdated ones.",
+                           CheckStatus::Pass, Severity::Low, 100);
     
-    int totalSoftware = 0;
+    int totalSoftware = static_cast<int>(inventory.size());
     std::vector<std::string> riskySoftware;
     std::vector<std::string> outdatedSoftware;
     
-    // Count software from registry output
-    size_t pos = 0;
-    while ((pos = regOutput.find("DisplayName", pos)) != std::string::npos) {
-        totalSoftware++;
-        pos += 11;
-    }
-    
     // Check for potentially risky software (common examples)
     std::vector<std::string> riskyKeywords = {
         "torrent", "crack", "keygen", "serial", "hack", "cracked",
         "p2p", "file sharing", "remote desktop", "vnc"
     };
+    std::vector<bool> keywordFound(riskyKeywords.size(), false);
+    
+    std::string lowerName;
+    for (const auto& software : inventory.records()) {
+        lowerName = software.name;
+        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+        
+        for (size_t k = 0; k < riskyKeywords.size(); ++k) {
+            if (!keywordFound[k] && lowerName.find(riskyKeywords[k]) != std::string::npos) {
+                keywordFound[k] = true;
+            }
+        }
+    }
     
-    std::string lowerOutput = regOutput;
-    std::transform(lowerOutput.begin(), lowerOutput.end(), lowerOutput.begin(), ::tolower);
-    
-    for (const auto& keyword : riskyKeywords) {
-        if (lowerOutput.find(keyword) != std::string::npos) {
-            riskySoftware.push_back(keyword);
+    for (size_t k = 0; k < riskyKeywords.size(); ++k) {
+        if (keywordFound[k]) {
+            riskySoftware.push_back(riskyKeywords[k]);
         }
     }
     
-    // Check for very old software (no version info or very old dates)
-    // This is a simplified check - in production, you'd check actual version dates
+    // Match installed versions against known vulnerable version ranges
+    struct VulnerableApp {
+        const SoftwareRecord* software;
+        const VulnerabilityEntry* worst;
+        size_t count;
+    };
+    std::vector<VulnerableApp> vulnerableSoftware;
+    
+    if (vulnerabilities != nullptr) {
+        for (const auto& software : inventory.records()) {
+            VulnerableApp app{ &software, nullptr, 0 };
+            vulnerabilities->forEachMatch(software.productKey, software.version, [&](const VulnerabilityEntry& entry) {
+                if (app.worst == nullptr || static_cast<int>(entry.severity) > static_cast<int>(app.worst->severity)) {
+                    app.worst = &entry;
+                }
+                app.count++;
+            });
+            if (app.count > 0) {
+                vulnerableSoftware.push_back(app);
+            }
+        }
+        
+        std::sort(vulnerableSoftware.begin(), vulnerableSoftware.end(), [](const VulnerableApp& a, const VulnerableApp& b) {
+            return static_cast<int>(a.worst->severity) > static_cast<int>(b.worst->severity);
+        });
+    }
     
-    std::stringstream details;
-    details << "Total Installed Applications: " << totalSoftware << "\n";
+    result.findings.number(FindingKey::InstalledApplications, totalSoftware);
+    result.findings.number(FindingKey::RiskySoftwareTypes, static_cast<int64_t>(riskySoftware.size()));
+    for (const auto& keyword : riskySoftware) {
+        result.findings.item(FindingKey::RiskySoftware, keyword);
+    }
     
-    if (!riskySoftware.empty()) {
-        details << "Potentially Risky Software Detected: " << riskySoftware.size() << " types\n";
-        details << "Keywords found: ";
-        for (size_t i = 0; i < riskySoftware.size(); ++i) {
-            details << riskySoftware[i];
-            if (i < riskySoftware.size() - 1) details << ", ";
+    if (vulnerabilities != nullptr) {
+        result.findings.number(FindingKey::VulnerableVersions, static_cast<int64_t>(vulnerableSoftware.size()));
+        result.findings.number(FindingKey::VulnerableRangesChecked, static_cast<int64_t>(vulnerabilities->size()));
+        
+        const size_t maxListed = 10;
+        std::string name, reason;
+        for (size_t i = 0; i < vulnerableSoftware.size() && i < maxListed; ++i) {
+            const VulnerableApp& app = vulnerableSoftware[i];
+            name.assign(app.software->name);
+            if (app.software->name.find(app.software->versionText) == std::string::npos) {
+                name.append(" ").append(app.software->versionText);
+            }
+            reason.assign(app.worst->id);
+            if (app.worst->fixed.valid()) {
+                reason.append(" (fixed in ").append(app.worst->fixedText).append(")");
+            }
+            if (app.count > 1) {
+                reason.append(" and ").append(std::to_string(app.count - 1)).append(" more");
+            }
+            result.findings.item(FindingKey::VulnerableSoftware, name, reason, app.worst->severity);
+        }
+        if (vulnerableSoftware.size() > maxListed) {
+            result.findings.number(FindingKey::More, static_cast<int64_t>(vulnerableSoftware.size() - maxListed));
         }
     } else {
-        details << "No obviously risky software detected.";
+        result.findings.message(FindingKey::VulnerabilityDatabaseMissing);
     }
     
-    details << "\n\nNote: This is a basic audit. Review installed software manually for security compliance.";
-    
-    result.details.push_back(details.str());
-    
     // Calculate score
     int score = 100;
     
@@ -72,31 +139,46 @@ ComplianceResult InstalledSoftwareCheck::performCheck() {
     if (!riskySoftware.empty()) {
         score -= riskySoftware.size() * 15;
     }
+    for (const auto& keyword : riskySoftware) {
+        result.attribution.add(keyword, 15);
+    }
+    
+    // Penalty for known vulnerable versions, weighted by the worst issue in each
+    for (const auto& app : vulnerableSoftware) {
+        int penalty = 0;
+        switch (app.worst->severity) {
+        case Severity::Critical: penalty = 25; break;
+        case Severity::High: penalty = 15; break;
+        case Severity::Medium: penalty = 10; break;
+        case Severity::Low: penalty = 5; break;
+        }
+        score -= penalty;
+        result.attribution.add(app.software->name, penalty);
+    }
     
     // Penalty for too many installed applications (indicates poor software management)
-    if (totalSoftware > 100) {
-        score -= 10;
-    } else if (totalSoftware > 200) {
+    if (totalSoftware > 200) {
         score -= 20;
+        result.attribution.add("Installed application count", 20);
+    } else if (totalSoftware > 100) {
+        score -= 10;
+        result.attribution.add("Installed application count", 10);
     }
     
     if (score < 0) score = 0;
     
     result.score = score;
     
-    if (score >= 90) {
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "Installed software appears compliant. Regularly review and update applications.";
-    } else if (score >= 70) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Some potentially risky software detected. Review and remove unnecessary or unauthorized applications.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.severity = Severity::High;
-        result.recommendation = "Multiple potentially risky software applications detected. Conduct a thorough software audit and remove unauthorized applications immediately.";
-    }
+    const char* advice[] = {
+        "Installed software appears compliant. Regularly review and update applications.",
+        vulnerableSoftware.empty()
+            ? "Some potentially risky software detected. Review and remove unnecessary or unauthorized applications."
+            : "Known vulnerable software versions detected. Update the listed applications to their fixed versions.",
+        vulnerableSoftware.empty()
+            ? "Multiple potentially risky software applications detected. Conduct a thorough software audit and remove unauthorized applications immediately."
+            : "Multiple vulnerable or risky applications detected. Patch or remove the listed applications immediately and review software management."
+    };
+    result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score)];
     
     return result;
 }
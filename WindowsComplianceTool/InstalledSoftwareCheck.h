@@ -1,9 +1,22 @@
 #pragma once
 #include "ComplianceCheck.h"
+#include <memory>
+
+class SoftwareInventory;
+class VulnerabilityDatabase;
 
 class InstalledSoftwareCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "Installed Software Audit"; }
-};
+    
+    // Vulnerable-version database shared across scans; when unset,
+    // VulnerableSoftware.csv in the working directory is loaded if present
+    void setVulnerabilityDatabase(std::shared_ptr<const VulnerabilityDatabase> database) { vulnerabilities = std::move(database); }
+    
+    // Score a software inventory, matching versions against the database when given (no system access)
+    static ComplianceResult evaluate(const SoftwareInventory& inventory, const VulnerabilityDatabase* vulnerabilities = nullptr);
 
+private:
+    std::shared_ptr<const VulnerabilityDatabase> vulnerabilities;
+};
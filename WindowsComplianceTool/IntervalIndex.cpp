@@ -0,0 +1,29 @@
+#include "IntervalIndex.h"
+#include <algorithm>
+
+void IntervalIndex::add(uint32_t low, uint32_t high, uint32_t id) {
+    intervals.push_back(Interval{ low, high, id });
+}
+
+void IntervalIndex::build() {
+    std::sort(intervals.begin(), intervals.end(), [](const Interval& a, const Interval& b) {
+        return a.low < b.low;
+    });
+    maxHigh.assign(intervals.size(), 0);
+    buildNode(0, intervals.size());
+}
+
+void IntervalIndex::clear() {
+    intervals.clear();
+    maxHigh.clear();
+}
+
+uint32_t IntervalIndex::buildNode(size_t begin, size_t end) {
+    if (begin >= end) return 0;
+    size_t mid = begin + (end - begin) / 2;
+    uint32_t high = intervals[mid].high;
+    high = std::max(high, buildNode(begin, mid));
+    high = std::max(high, buildNode(mid + 1, end));
+    maxHigh[mid] = high;
+    return high;
+}
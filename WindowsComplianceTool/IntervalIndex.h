@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Static interval tree over closed [low, high] ranges of 32-bit values
+// (ports, IPv4 addresses). Intervals are sorted by low bound and the
+// sorted array is treated as an implicit balanced tree whose nodes keep
+// the largest high bound of their subtree, so a query descends only into
+// subtrees that can still hold a match (O(log n) per reported interval).
+class IntervalIndex {
+public:
+    void add(uint32_t low, uint32_t high, uint32_t id);
+
+    // Sort and compute subtree bounds; call after the last add()
+    void build();
+
+    void clear();
+    size_t size() const { return intervals.size(); }
+
+    // Intervals that contain all of [low, high]: fn(id), return false to stop
+    template <typename Fn>
+    void forEachContaining(uint32_t low, uint32_t high, Fn&& fn) const {
+        query(0, intervals.size(), low, high, fn);
+    }
+
+    // Intervals that overlap [low, high]: fn(id), return false to stop
+    template <typename Fn>
+    void forEachOverlapping(uint32_t low, uint32_t high, Fn&& fn) const {
+        query(0, intervals.size(), high, low, fn);
+    }
+
+private:
+    struct Interval {
+        uint32_t low;
+        uint32_t high;
+        uint32_t id;
+    };
+
+    std::vector<Interval> intervals;    // sorted by low
+    std::vector<uint32_t> maxHigh;      // largest high in the subtree rooted at each index
+
+    uint32_t buildNode(size_t begin, size_t end);
+
+    // Report intervals in [begin, end) with low <= lowLimit and high >= highLimit
+    template <typename Fn>
+    bool query(size_t begin, size_t end, uint32_t lowLimit, uint32_t highLimit, Fn& fn) const {
+        if (begin >= end) return true;
+        size_t mid = begin + (end - begin) / 2;
+        if (maxHigh[mid] < highLimit) return true;
+
+        if (!query(begin, mid, lowLimit, highLimit, fn)) return false;
+
+        // Every interval right of mid starts at or after mid's low bound
+        if (intervals[mid].low > lowLimit) return true;
+        if (intervals[mid].high >= highLimit && !fn(intervals[mid].id)) return false;
+        return query(mid + 1, end, lowLimit, highLimit, fn);
+    }
+};
@@ -0,0 +1,278 @@
+#include "LogonAnomalies.h"
+#include "EvtxParser.h"
+#include "SpscRing.h"
+#include "TextUtil.h"
+#include <thread>
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+using TextUtil::hashIgnoreCase;
+using TextUtil::startsWithIgnoreCase;
+
+// Special-privilege logons that Windows itself produces constantly
+bool isServiceLogon(std::string_view account) {
+    return equalsIgnoreCase(account, "SYSTEM") || equalsIgnoreCase(account, "LOCAL SERVICE") ||
+           equalsIgnoreCase(account, "NETWORK SERVICE") || startsWithIgnoreCase(account, "DWM-") ||
+           startsWithIgnoreCase(account, "UMFD-") || (!account.empty() && account.back() == '$');
+}
+
+const uint64_t TicksPerSecond = 10000000;
+
+// Events handed between the decoding and the detecting thread at a time
+const size_t BatchSize = 256;
+
+const size_t CounterCount = 6;
+
+Severity severityOf(LogonAnomaly::Kind kind) {
+    switch (kind) {
+        case LogonAnomaly::Kind::SuccessAfterFailures: return Severity::Critical;
+        case LogonAnomaly::Kind::AccountFailures:
+        case LogonAnomaly::Kind::SourceFailures:
+        case LogonAnomaly::Kind::SourceLockouts: return Severity::High;
+        default: return Severity::Medium;
+    }
+}
+
+} // namespace
+
+LogonAnomalyDetector::LogonAnomalyDetector(const LogonThresholds& thresholds) : limits(thresholds) {
+    const uint32_t perKind[CounterCount] = {
+        limits.failuresPerAccount, limits.failuresPerSource, 1,
+        limits.lockoutsPerAccount, limits.lockoutsPerSource, limits.privilegedLogonsPerAccount
+    };
+    for (size_t i = 0; i < CounterCount; ++i) {
+        counters[i].threshold = perKind[i] > 0 ? perKind[i] : 1;
+    }
+    nameOffsets.push_back(0);
+    nameSlots.assign(1024, NoName);
+}
+
+uint32_t LogonAnomalyDetector::intern(std::string_view text) {
+    if (text.empty() || text == "-") return NoName;
+
+    uint32_t hash = hashIgnoreCase(text);
+    size_t mask = nameSlots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t id = nameSlots[slot];
+        if (id == NoName) {
+            id = static_cast<uint32_t>(nameHashes.size());
+            nameSlots[slot] = id;
+            nameHashes.push_back(hash);
+            namePool.append(text.data(), text.size());
+            nameOffsets.push_back(static_cast<uint32_t>(namePool.size()));
+            if (nameHashes.size() * 2 > nameSlots.size()) growNameSlots();
+            return id;
+        }
+        if (nameHashes[id] == hash && equalsIgnoreCase(name(id), text)) return id;
+    }
+}
+
+void LogonAnomalyDetector::growNameSlots() {
+    nameSlots.assign(nameSlots.size() * 2, NoName);
+    size_t mask = nameSlots.size() - 1;
+    for (uint32_t id = 0; id < nameHashes.size(); ++id) {
+        size_t slot = nameHashes[id] & mask;
+        while (nameSlots[slot] != NoName) slot = (slot + 1) & mask;
+        nameSlots[slot] = id;
+    }
+}
+
+std::string_view LogonAnomalyDetector::name(uint32_t id) const {
+    if (id >= nameHashes.size()) return std::string_view();
+    return std::string_view(namePool).substr(nameOffsets[id], nameOffsets[id + 1] - nameOffsets[id]);
+}
+
+bool LogonAnomalyDetector::decode(const EventRecordSet& events, const EventRecord& record, LogonEvent& event) {
+    if (record.eventId != 4624 && record.eventId != 4625 && record.eventId != 4771 &&
+        record.eventId != 4740 && record.eventId != 4672) {
+        return false;
+    }
+
+    // Field names are resolved once per record set
+    if (fieldSource != &events) {
+        fieldSource = &events;
+        targetUserField = events.fieldId("TargetUserName");
+        subjectUserField = events.fieldId("SubjectUserName");
+        targetDomainField = events.fieldId("TargetDomainName");
+        ipAddressField = events.fieldId("IpAddress");
+        workstationField = events.fieldId("WorkstationName");
+        logonTypeField = events.fieldId("LogonType");
+    }
+
+    event.timestamp = record.timestamp;
+    event.eventId = record.eventId;
+    event.logonType = 0;
+    event.source = NoName;
+
+    if (record.eventId == 4672) {
+        std::string_view account = events.field(record, subjectUserField);
+        if (isServiceLogon(account)) return false;
+        event.account = intern(account);
+        return event.account != NoName;
+    }
+
+    event.account = intern(events.field(record, targetUserField));
+    if (record.eventId == 4740) {
+        // Lockouts name the computer the failed attempts came from
+        event.source = intern(events.field(record, targetDomainField));
+    } else {
+        std::string_view source = events.field(record, ipAddressField);
+        if (source.empty() || source == "-") source = events.field(record, workstationField);
+        event.source = intern(source);
+
+        uint32_t logonType = 0;
+        for (char c : events.field(record, logonTypeField)) {
+            if (c < '0' || c > '9') break;
+            logonType = logonType * 10 + static_cast<uint32_t>(c - '0');
+        }
+        event.logonType = static_cast<uint8_t>(logonType < 256 ? logonType : 0);
+    }
+    return event.account != NoName || event.source != NoName;
+}
+
+uint32_t LogonAnomalyDetector::seconds(uint64_t timestamp) {
+    if (!haveBase) {
+        baseTime = timestamp;
+        haveBase = true;
+    }
+    return timestamp > baseTime ? static_cast<uint32_t>((timestamp - baseTime) / TicksPerSecond) : 0;
+}
+
+bool LogonAnomalyDetector::overThreshold(LogonAnomaly::Kind kind, uint32_t key, uint32_t time) const {
+    const SlidingCounter& counter = counters[static_cast<size_t>(kind)];
+    if (key >= counter.filled.size() || counter.filled[key] < counter.threshold) return false;
+    uint32_t oldest = counter.times[static_cast<size_t>(key) * counter.threshold + counter.next[key]];
+    return time >= oldest && time - oldest <= limits.windowSeconds;
+}
+
+bool LogonAnomalyDetector::record(LogonAnomaly::Kind kind, uint32_t key, uint32_t time, uint64_t timestamp) {
+    SlidingCounter& counter = counters[static_cast<size_t>(kind)];
+    if (key >= counter.next.size()) {
+        size_t keys = static_cast<size_t>(key) + 1;
+        if (keys < counter.next.size() * 2) keys = counter.next.size() * 2;
+        counter.times.resize(keys * counter.threshold);
+        counter.next.resize(keys);
+        counter.filled.resize(keys);
+        counter.anomaly.resize(keys, NoName);
+    }
+
+    // Overwrite the oldest of the last `threshold` times
+    uint32_t& next = counter.next[key];
+    counter.times[static_cast<size_t>(key) * counter.threshold + next] = time;
+    next = next + 1 == counter.threshold ? 0 : next + 1;
+    if (counter.filled[key] < counter.threshold) counter.filled[key]++;
+
+    uint32_t index = counter.anomaly[key];
+    if (index != NoName) {
+        found[index].lastSeen = timestamp;
+        found[index].events++;
+        return true;
+    }
+    if (!overThreshold(kind, key, time)) return false;
+    raise(kind, severityOf(kind), key, timestamp);
+    return true;
+}
+
+void LogonAnomalyDetector::raise(LogonAnomaly::Kind kind, Severity severity, uint32_t key, uint64_t timestamp) {
+    SlidingCounter& counter = counters[static_cast<size_t>(kind)];
+    if (key >= counter.anomaly.size()) counter.anomaly.resize(static_cast<size_t>(key) + 1, NoName);
+    counter.anomaly[key] = static_cast<uint32_t>(found.size());
+    found.push_back({ kind, severity, key, timestamp, timestamp, counter.threshold });
+}
+
+void LogonAnomalyDetector::process(const LogonEvent& event) {
+    processed++;
+    uint32_t time = seconds(event.timestamp);
+
+    switch (event.eventId) {
+        case 4625:
+        case 4771:
+            failures++;
+            if (event.account != NoName) record(LogonAnomaly::Kind::AccountFailures, event.account, time, event.timestamp);
+            if (event.source != NoName) record(LogonAnomaly::Kind::SourceFailures, event.source, time, event.timestamp);
+            break;
+        case 4624:
+            // A success while the account is being guessed at: the guess may have worked
+            if (event.account != NoName && overThreshold(LogonAnomaly::Kind::AccountFailures, event.account, time)) {
+                SlidingCounter& counter = counters[static_cast<size_t>(LogonAnomaly::Kind::SuccessAfterFailures)];
+                uint32_t index = event.account < counter.anomaly.size() ? counter.anomaly[event.account] : NoName;
+                if (index == NoName) {
+                    raise(LogonAnomaly::Kind::SuccessAfterFailures, Severity::Critical, event.account, event.timestamp);
+                } else {
+                    found[index].lastSeen = event.timestamp;
+                    found[index].events++;
+                }
+            }
+            break;
+        case 4740:
+            lockouts++;
+            if (event.account != NoName) record(LogonAnomaly::Kind::AccountLockouts, event.account, time, event.timestamp);
+            if (event.source != NoName) record(LogonAnomaly::Kind::SourceLockouts, event.source, time, event.timestamp);
+            break;
+        case 4672:
+            privileged++;
+            if (event.account != NoName) record(LogonAnomaly::Kind::PrivilegedLogons, event.account, time, event.timestamp);
+            break;
+        default:
+            break;
+    }
+}
+
+void LogonAnomalyDetector::process(const LogonEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        process(events[i]);
+    }
+}
+
+void LogonAnomalyDetector::replay(const EventRecordSet& events) {
+    const std::vector<EventRecord>& records = events.records();
+    LogonEvent batch[BatchSize];
+
+    // On one core the two sides would only take turns: decode and detect in
+    // batches on this thread instead
+    if (std::thread::hardware_concurrency() < 2) {
+        size_t pending = 0;
+        for (const auto& record : records) {
+            if (decode(events, record, batch[pending]) && ++pending == BatchSize) {
+                process(batch, pending);
+                pending = 0;
+            }
+        }
+        process(batch, pending);
+        return;
+    }
+
+    // The producer decodes and interns names; this thread only touches the
+    // counters, so the two share nothing but the ring
+    SpscRing<LogonEvent> ring(16384);
+    std::thread producer([&]() {
+        LogonEvent decoded[BatchSize];
+        size_t pending = 0;
+        auto flush = [&]() {
+            for (size_t pushed = 0; pushed < pending;) {
+                size_t count = ring.push(decoded + pushed, pending - pushed);
+                if (count == 0) std::this_thread::yield();
+                pushed += count;
+            }
+            pending = 0;
+        };
+        for (const auto& record : records) {
+            if (decode(events, record, decoded[pending]) && ++pending == BatchSize) flush();
+        }
+        flush();
+        ring.close();
+    });
+
+    for (;;) {
+        size_t count = ring.pop(batch, BatchSize);
+        if (count > 0) {
+            process(batch, count);
+        } else if (ring.finished()) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
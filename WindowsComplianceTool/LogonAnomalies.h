@@ -0,0 +1,127 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct EventRecord;
+class EventRecordSet;
+
+// Security event reduced to what the detector needs; names are ids in the
+// detector's name table
+struct LogonEvent {
+    uint64_t timestamp = 0;     // FILETIME
+    uint32_t account = 0;
+    uint32_t source = 0;        // IP address, workstation or caller computer; NoName if absent
+    uint16_t eventId = 0;       // 4624, 4625, 4672, 4740, 4771
+    uint8_t logonType = 0;
+};
+
+struct LogonThresholds {
+    uint32_t windowSeconds = 300;
+    uint32_t failuresPerAccount = 10;
+    uint32_t failuresPerSource = 20;
+    uint32_t lockoutsPerAccount = 3;
+    uint32_t lockoutsPerSource = 5;
+    uint32_t privilegedLogonsPerAccount = 50;
+};
+
+struct LogonAnomaly {
+    enum class Kind {
+        AccountFailures,        // failed logons for one account
+        SourceFailures,         // failed logons from one source (brute force or password spray)
+        SuccessAfterFailures,   // logon succeeded while the account's failures were over threshold
+        AccountLockouts,
+        SourceLockouts,         // lockouts caused by one caller computer
+        PrivilegedLogons        // special-privilege logons (4672) for one account
+    };
+
+    Kind kind;
+    Severity severity;
+    uint32_t name;              // account or source id
+    uint64_t firstSeen;         // FILETIME the threshold was crossed
+    uint64_t lastSeen;
+    uint32_t events;            // matching events from the crossing on
+};
+
+// Sliding-window detector for brute force, lockout storms and privileged
+// logon bursts. Each (kind, account or source) counter keeps the times of
+// its last threshold events in a small ring, so "threshold events within
+// the window" is one subtraction per event, exact, and independent of the
+// window length. Names are interned into dense ids through an
+// open-addressing table keyed by a case-insensitive hash, so the
+// per-event path performs no allocation.
+//
+// replay() decodes records on a producer thread and feeds them through a
+// lock-free ring buffer to the detector on the calling thread. Names are
+// interned by the decoding side; read them back only after the stream has
+// been drained.
+class LogonAnomalyDetector {
+public:
+    explicit LogonAnomalyDetector(const LogonThresholds& thresholds = LogonThresholds());
+
+    // Reduce an event record, false if the event is not one the detector uses
+    bool decode(const EventRecordSet& events, const EventRecord& record, LogonEvent& event);
+
+    // Consume events in time order
+    void process(const LogonEvent& event);
+    void process(const LogonEvent* events, size_t count);
+
+    // Decode and process every record, streaming through a ring buffer
+    void replay(const EventRecordSet& events);
+
+    // Intern a name (case-insensitive), NoName for empty and "-"
+    uint32_t intern(std::string_view name);
+    std::string_view name(uint32_t id) const;
+
+    const std::vector<LogonAnomaly>& anomalies() const { return found; }
+    const LogonThresholds& thresholds() const { return limits; }
+
+    // Events consumed by kind
+    size_t processedCount() const { return processed; }
+    size_t failureCount() const { return failures; }
+    size_t lockoutCount() const { return lockouts; }
+    size_t privilegedCount() const { return privileged; }
+
+    static constexpr uint32_t NoName = 0xFFFFFFFFu;
+
+private:
+    // Ring of the last `threshold` event times per key
+    struct SlidingCounter {
+        uint32_t threshold = 1;
+        std::vector<uint32_t> times;        // key * threshold + slot
+        std::vector<uint32_t> next;         // next slot per key
+        std::vector<uint32_t> filled;       // events seen per key, capped at threshold
+        std::vector<uint32_t> anomaly;      // index into found, NoName if not raised
+    };
+
+    LogonThresholds limits;
+    SlidingCounter counters[6];             // by LogonAnomaly::Kind, SuccessAfterFailures unused
+    std::vector<LogonAnomaly> found;
+
+    // Name table: offsets into namePool, open-addressing slots of name ids
+    std::string namePool;
+    std::vector<uint32_t> nameOffsets;
+    std::vector<uint32_t> nameSlots;
+    std::vector<uint32_t> nameHashes;
+
+    uint64_t baseTime = 0;                  // FILETIME of the first event, counters use seconds from it
+    bool haveBase = false;
+
+    size_t processed = 0;
+    size_t failures = 0;
+    size_t lockouts = 0;
+    size_t privileged = 0;
+
+    // Field ids of the record set being decoded
+    const EventRecordSet* fieldSource = nullptr;
+    int targetUserField = -1, subjectUserField = -1, targetDomainField = -1;
+    int ipAddressField = -1, workstationField = -1, logonTypeField = -1;
+
+    uint32_t seconds(uint64_t timestamp);
+    bool record(LogonAnomaly::Kind kind, uint32_t key, uint32_t time, uint64_t timestamp);
+    bool overThreshold(LogonAnomaly::Kind kind, uint32_t key, uint32_t time) const;
+    void raise(LogonAnomaly::Kind kind, Severity severity, uint32_t key, uint64_t timestamp);
+    void growNameSlots();
+};
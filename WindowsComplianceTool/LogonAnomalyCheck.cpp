@@ -0,0 +1,130 @@
+#include "LogonAnomalyCheck.h"
+#include "EvtxParser.h"
+#include "PolicyTables.h"
+#include "SecurityLogExport.h"
+
+namespace {
+
+const char* kindName(LogonAnomaly::Kind kind) {
+    switch (kind) {
+        case LogonAnomaly::Kind::AccountFailures: return "Failed logons for account";
+        case LogonAnomaly::Kind::SourceFailures: return "Failed logons from source";
+        case LogonAnomaly::Kind::SuccessAfterFailures: return "Successful logon during failures for account";
+        case LogonAnomaly::Kind::AccountLockouts: return "Lockouts of account";
+        case LogonAnomaly::Kind::SourceLockouts: return "Lockouts caused by";
+        case LogonAnomaly::Kind::PrivilegedLogons: return "Privileged logons for account";
+    }
+    return "Anomaly";
+}
+
+} // namespace
+
+const std::vector<uint16_t>& LogonAnomalyCheck::detectorEventIds() {
+    static const std::vector<uint16_t> ids = {
+        4624, 4625, 4771,       // logon succeeded, failed, Kerberos pre-authentication failed
+        4672,                   // special privileges assigned
+        4740                    // account locked out
+    };
+    return ids;
+}
+
+ComplianceResult LogonAnomalyCheck::performCheck() {
+    // Replay the last 7 days of the Security log through the detector
+    std::shared_ptr<SecurityLogExport> securityLog = exportSecurityLog();
+    
+    EvtxParser parser;
+    parser.setEventFilter(detectorEventIds());
+    parser.setFieldFilter({ "TargetUserName", "TargetDomainName", "SubjectUserName", "IpAddress", "WorkstationName", "LogonType" });
+    
+    EventRecordSet events;
+    bool eventsLoaded = parser.parseFile(securityLog->path(), events);
+    
+    if (!eventsLoaded) {
+        return evaluate(nullptr);
+    }
+    
+    LogonAnomalyDetector detector(thresholds);
+    detector.replay(events);
+    return evaluate(&detector);
+}
+
+ComplianceResult LogonAnomalyCheck::evaluate(const LogonAnomalyDetector* detector) {
+    ComplianceResult result("Logon Anomaly Detection",
+                           "Detects brute-force attempts, lockout storms and bursts of privileged logons in the Security log.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    if (detector == nullptr) {
+        result.findings.message(FindingKey::SecurityLogUnavailable);
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "Run the tool elevated so the Security log can be read, and verify logon auditing is enabled.";
+        return result;
+    }
+    
+    const std::vector<LogonAnomaly>& anomalies = detector->anomalies();
+    const LogonThresholds& limits = detector->thresholds();
+    
+    int score = 100;
+    int critical = 0;
+    for (const auto& anomaly : anomalies) {
+        int penalty = 10;
+        if (anomaly.severity == Severity::Critical) {
+            critical++;
+            penalty = 30;
+        } else if (anomaly.severity == Severity::High) {
+            penalty = 20;
+        }
+        score -= penalty;
+        result.attribution.add(detector->name(anomaly.name), penalty);
+    }
+    if (score < 0) score = 0;
+    
+    result.findings.number(FindingKey::EventsAnalyzed, static_cast<int64_t>(detector->processedCount()));
+    result.findings.number(FindingKey::FailedLogons, static_cast<int64_t>(detector->failureCount()));
+    result.findings.number(FindingKey::AccountLockouts, static_cast<int64_t>(detector->lockoutCount()));
+    result.findings.number(FindingKey::PrivilegedLogons, static_cast<int64_t>(detector->privilegedCount()));
+    result.findings.number(FindingKey::DetectionWindow, limits.windowSeconds);
+    result.findings.number(FindingKey::FailuresPerAccount, limits.failuresPerAccount);
+    result.findings.number(FindingKey::FailuresPerSource, limits.failuresPerSource);
+    result.findings.number(FindingKey::Anomalies, static_cast<int64_t>(anomalies.size()));
+    
+    // Most severe first
+    const size_t maxListed = 10;
+    size_t listed = 0;
+    std::string name, reason;
+    for (Severity severity : { Severity::Critical, Severity::High, Severity::Medium }) {
+        for (const auto& anomaly : anomalies) {
+            if (anomaly.severity != severity || listed >= maxListed) continue;
+            name.assign(kindName(anomaly.kind)).append(" ").append(detector->name(anomaly.name));
+            reason.assign(std::to_string(anomaly.events)).append(" events");
+            result.findings.item(FindingKey::LogonAnomaly, name, reason, anomaly.severity);
+            listed++;
+        }
+    }
+    if (anomalies.size() > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(anomalies.size() - maxListed));
+    }
+    
+    result.score = score;
+    
+    if (detector->processedCount() == 0) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "No logon events were found. Enable auditing of logon success and failure.";
+    } else {
+        const char* advice[] = {
+            anomalies.empty()
+                ? "No logon anomalies detected. System is compliant."
+                : "Review the listed privileged logon activity.",
+            "Investigate the listed accounts and sources; block sources that keep failing and review lockout policy.",
+            critical > 0
+                ? "A logon succeeded while its account was under attack. Treat the account as compromised: reset its password and review its sessions."
+                : "Repeated logon failures indicate password guessing. Block the sources and enforce account lockout."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, critical > 0)];
+    }
+    
+    return result;
+}
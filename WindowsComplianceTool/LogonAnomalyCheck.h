@@ -0,0 +1,22 @@
+#pragma once
+#include "ComplianceCheck.h"
+#include "LogonAnomalies.h"
+
+class LogonAnomalyCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Logon Anomaly Detection"; }
+    
+    // Window and per-account / per-source limits; defaults suit a workstation
+    void setThresholds(const LogonThresholds& values) { thresholds = values; }
+    
+    // Event ids the detector consumes
+    static const std::vector<uint16_t>& detectorEventIds();
+    
+    // Score the anomalies found in a replayed log; nullptr when the log could
+    // not be read (no system access)
+    static ComplianceResult evaluate(const LogonAnomalyDetector* detector);
+
+private:
+    LogonThresholds thresholds;
+};
@@ -40,12 +40,17 @@ MainForm::MainForm()
     : m_hwnd(nullptr), m_hInstance(nullptr), m_currentTab(0),
     m_scanInProgress(false), m_gdiplusToken(0), m_graphics(nullptr),
     m_animProgress(0.0f), m_animating(false), m_animTimer(0),
-    m_hoveredCard(-1), m_tabControl(nullptr), m_scanButton(nullptr),
+    m_hoveredCard(-1), m_tabControl(nullptr), m_scanButton(nullptr), m_baselineButton(nullptr),
     m_exportTextButton(nullptr), m_exportJSONButton(nullptr) {
     m_canvasRect = { 0, 0, 0, 0 };
+    m_engine.setDataDirectory(ComplianceEngine::defaultDataDirectory());
 }
 
 MainForm::~MainForm() {
+    // The worker uses the engine; wait for it before members go away
+    if (m_baselineThread.joinable()) {
+        m_baselineThread.join();
+    }
     CleanupGDIPlus();
 }
 
@@ -139,6 +144,14 @@ LRESULT MainForm::HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam) {
         OnDrawItem(wParam, lParam);
         return TRUE;
 
+    case WM_BASELINE_PROGRESS:
+        OnBaselineProgress(static_cast<size_t>(wParam), static_cast<size_t>(lParam));
+        return 0;
+
+    case WM_BASELINE_DONE:
+        OnBaselineFinished(wParam != 0);
+        return 0;
+
     case WM_DESTROY:
         OnDestroy();
         return 0;
@@ -293,6 +306,13 @@ void MainForm::CreateButtons() {
         m_hwnd, (HMENU)IDC_SCAN_BUTTON, nullptr, nullptr
     );
 
+    m_baselineButton = CreateWindowEx(
+        0, L"BUTTON", L" Record Baseline",
+        WS_CHILD | BS_OWNERDRAW,
+        210, 75, 180, 42,
+        m_hwnd, (HMENU)IDC_BASELINE_BUTTON, nullptr, nullptr
+    );
+
     m_exportTextButton = CreateWindowEx(
         0, L"BUTTON", L" Export Text",
         WS_CHILD | BS_OWNERDRAW,
@@ -318,6 +338,12 @@ void MainForm::OnCommand(WPARAM wParam) {
     if (id == IDC_SCAN_BUTTON) {
         PerformScan();
     }
+    else if (id == IDC_BASELINE_BUTTON) {
+        if (MessageBoxA(m_hwnd, "Record the binaries on disk now as the trusted integrity baseline?",
+                        "Record Baseline", MB_YESNO | MB_ICONQUESTION) == IDYES) {
+            RecordBaseline();
+        }
+    }
     else if (id == IDC_EXPORT_TEXT_BUTTON) {
         OPENFILENAMEW ofn = {};
         wchar_t szFile[260] = L"compliance_report.txt";
@@ -370,6 +396,7 @@ void MainForm::OnNotify(WPARAM wParam, LPARAM lParam) {
         m_currentTab = TabCtrl_GetCurSel(m_tabControl);
 
         ShowWindow(m_scanButton, (m_currentTab == TAB_DASHBOARD) ? SW_SHOW : SW_HIDE);
+        ShowWindow(m_baselineButton, (m_currentTab == TAB_DASHBOARD) ? SW_SHOW : SW_HIDE);
         ShowWindow(m_exportTextButton, (m_currentTab == TAB_REPORTS) ? SW_SHOW : SW_HIDE);
         ShowWindow(m_exportJSONButton, (m_currentTab == TAB_REPORTS) ? SW_SHOW : SW_HIDE);
 
@@ -486,7 +513,7 @@ void MainForm::DrawDashboard(Graphics* g) {
 
         for (size_t i = 0; i < results.size(); i++) {
             ModuleCard card;
-            card.name = results[i].moduleName;
+            card.name.assign(results[i].moduleName);
             card.score = results[i].score;
             card.status = results[i].status;
             card.severity = results[i].severity;
@@ -890,6 +917,9 @@ void MainForm::OnSize() {
     if (m_scanButton) {
         SetWindowPos(m_scanButton, nullptr, 20, 75, 180, 42, SWP_NOZORDER);
     }
+    if (m_baselineButton) {
+        SetWindowPos(m_baselineButton, nullptr, 210, 75, 180, 42, SWP_NOZORDER);
+    }
     if (m_exportTextButton) {
         SetWindowPos(m_exportTextButton, nullptr, 20, 75, 150, 42, SWP_NOZORDER);
     }
@@ -964,7 +994,18 @@ void MainForm::PerformScan() {
     EnableScanControls(false);
     StartAnimation();
 
+    // The scan runs on this thread, so show the provisional score in the
+    // title as each module finishes
+    m_engine.setProgressHandler([this](const ProvisionalScore& progress) {
+        std::wostringstream title;
+        title << L"Windows Compliance Tool - scanning " << progress.completed << L"/"
+              << (progress.completed + progress.pending) << L": " << progress.score
+              << L"% (final " << progress.lower << L"-" << progress.upper << L"%)";
+        SetWindowTextW(m_hwnd, title.str().c_str());
+    });
     m_engine.performFullScan();
+    m_engine.setProgressHandler(nullptr);
+    SetWindowTextW(m_hwnd, L"Windows Compliance Tool");
 
     int score = m_engine.getOverallComplianceScore();
     m_scoreHistory.push_back(score);
@@ -980,6 +1021,47 @@ void MainForm::PerformScan() {
     MessageBoxA(m_hwnd, "Compliance scan completed successfully!", "Scan Complete", MB_OK | MB_ICONINFORMATION);
 }
 
+void MainForm::RecordBaseline() {
+    if (m_scanInProgress) return;
+
+    m_scanInProgress = true;
+    EnableScanControls(false);
+    SetWindowTextW(m_hwnd, L"Windows Compliance Tool - recording baseline");
+
+    // Hashing every binary takes minutes on a cold cache, so a worker does
+    // it and posts its progress and result back to this window
+    HWND hwnd = m_hwnd;
+    m_baselineThread = std::thread([this, hwnd]() {
+        bool recorded = m_engine.recordIntegrityBaseline([hwnd](size_t done, size_t total) {
+            PostMessage(hwnd, WM_BASELINE_PROGRESS, static_cast<WPARAM>(done), static_cast<LPARAM>(total));
+        });
+        PostMessage(hwnd, WM_BASELINE_DONE, recorded ? 1 : 0, 0);
+    });
+}
+
+void MainForm::OnBaselineProgress(size_t done, size_t total) {
+    std::wostringstream title;
+    title << L"Windows Compliance Tool - recording baseline " << done << L"/" << total << L" files";
+    if (total > 0) {
+        title << L" (" << done * 100 / total << L"%)";
+    }
+    SetWindowTextW(m_hwnd, title.str().c_str());
+}
+
+void MainForm::OnBaselineFinished(bool recorded) {
+    if (m_baselineThread.joinable()) {
+        m_baselineThread.join();
+    }
+    SetWindowTextW(m_hwnd, L"Windows Compliance Tool");
+
+    m_scanInProgress = false;
+    EnableScanControls(true);
+
+    MessageBoxA(m_hwnd, recorded ? ("Baseline recorded in " + m_engine.getDataDirectory()).c_str()
+                                 : "No baseline was recorded. Check that a data folder is available and the program directories are readable.",
+                "Record Baseline", MB_OK | (recorded ? MB_ICONINFORMATION : MB_ICONWARNING));
+}
+
 void MainForm::UpdateDashboard() {
     InvalidateRect(m_hwnd, NULL, FALSE);
 }
@@ -990,6 +1072,7 @@ void MainForm::UpdateResultsDisplay() {
 
 void MainForm::EnableScanControls(bool enable) {
     EnableWindow(m_scanButton, enable);
+    EnableWindow(m_baselineButton, enable);
     EnableWindow(m_exportTextButton, enable);
     EnableWindow(m_exportJSONButton, enable);
 }
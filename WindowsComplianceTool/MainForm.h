@@ -6,6 +6,7 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <thread>
 #include "ComplianceEngine.h"
 #include "ReportGenerator.h"
 
@@ -87,6 +88,9 @@ private:
 
     // Scan operations
     void PerformScan();
+    void RecordBaseline();
+    void OnBaselineProgress(size_t done, size_t total);
+    void OnBaselineFinished(bool recorded);
     void UpdateDashboard();
     void UpdateResultsDisplay();
     void EnableScanControls(bool enable);
@@ -111,6 +115,7 @@ private:
     // Controls - FIXED: All control handles now properly declared
     HWND m_tabControl;
     HWND m_scanButton;
+    HWND m_baselineButton;
     HWND m_exportTextButton;
     HWND m_exportJSONButton;
 
@@ -122,6 +127,9 @@ private:
     ComplianceEngine m_engine;
     bool m_scanInProgress;
 
+    // Hashes the integrity baseline off the UI thread
+    std::thread m_baselineThread;
+
     // Animation state
     float m_animProgress;
     bool m_animating;
@@ -146,11 +154,18 @@ private:
     enum {
         IDC_TAB = 1000,
         IDC_SCAN_BUTTON,
+        IDC_BASELINE_BUTTON,
         IDC_EXPORT_TEXT_BUTTON,
         IDC_EXPORT_JSON_BUTTON,
         TIMER_ANIMATION = 2000
     };
 
+    // Messages posted by the baseline worker
+    enum {
+        WM_BASELINE_PROGRESS = WM_APP + 2,     // wParam files done, lParam total
+        WM_BASELINE_DONE                       // wParam nonzero if recorded
+    };
+
     // Canvas area for custom drawing
     RECT m_canvasRect;
 };
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file (CreateFileMapping on Windows,
+// mmap elsewhere). Used by the offline readers so large hive and log files
+// are parsed in place instead of being copied into memory.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Opened by the native path, wide on Windows
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* bytes() const { return data; }
+    size_t size() const { return length; }
+    std::string_view view() const { return std::string_view(reinterpret_cast<const char*>(data), length); }
+
+private:
+    const unsigned char* data = nullptr;
+    size_t length = 0;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -1,113 +1,144 @@
 #include "NetworkSharesCheck.h"
-#include <sstream>
+#include "CsvReader.h"
+#include "PolicyTables.h"
+#include "SecurityDescriptor.h"
 #include <vector>
 
 ComplianceResult NetworkSharesCheck::performCheck() {
+    // Shares with their share permissions and the NTFS permissions of the shared folder, as SDDL
+    CsvReader shares;
+    executePowerShellCsv("Get-SmbShare | Select-Object Name, Path, Description, ShareType, SecurityDescriptor, @{Name='PathSddl';Expression={ if ($_.Path) { (Get-Acl -Path $_.Path -ErrorAction SilentlyContinue).Sddl } }}", shares);
+    
+    return evaluate(shares);
+}
+
+ComplianceResult NetworkSharesCheck::evaluate(const CsvReader& shares) {
     ComplianceResult result("Network Shares Check",
                            "Identifies open network shares and their permissions.",
                            CheckStatus::Pass, Severity::Low, 100);
     
-    result.details.push_back("Checking network shares...");
-    
-    // Get network shares using PowerShell
-    std::string psCommand = "Get-SmbShare | Select-Object Name, Path, Description, ShareType | Format-List";
-    std::string output = executePowerShell(psCommand);
-    
-    // Also get share permissions
-    std::string permCommand = "Get-SmbShare | ForEach-Object { $share = $_.Name; Get-SmbShareAccess -Name $share | Select-Object @{Name='Share';Expression={$share}}, AccountName, AccessRight, AccessControlType }";
-    std::string permOutput = executePowerShell(permCommand);
-    
-    int totalShares = 0;
-    int publicShares = 0;
+    int totalShares = static_cast<int>(shares.rowCount());
     int adminOnlyShares = 0;
-    std::vector<std::string> shareNames;
     
-    // Count shares
-    size_t pos = 0;
-    while ((pos = output.find("Name", pos)) != std::string::npos) {
-        totalShares++;
+    // Principals that make a share public when they have access
+    static const WellKnownPrincipal BroadPrincipals[] = {
+        WellKnownPrincipal::Anonymous, WellKnownPrincipal::Everyone, WellKnownPrincipal::Guests,
+        WellKnownPrincipal::AuthenticatedUsers
+    };
+    
+    struct ExposedShare {
+        std::string_view name;
+        WellKnownPrincipal principal;
+        bool writable;
+    };
+    std::vector<ExposedShare> exposedShares;
+    int publicReadShares = 0;
+    int publicWriteShares = 0;
+    int anonymousShares = 0;
+    int unreadableShares = 0;
+    
+    // Share and folder ACLs repeat across shares; each distinct descriptor is parsed and evaluated once
+    SecurityDescriptorCache descriptors;
+    
+    int nameColumn = shares.columnIndex("Name");
+    int shareSddlColumn = shares.columnIndex("SecurityDescriptor");
+    int pathSddlColumn = shares.columnIndex("PathSddl");
+    for (size_t i = 0; i < shares.rowCount(); ++i) {
+        CsvReader::Row row = shares.row(i);
+        std::string_view shareName = row[nameColumn];
+        if (shareName.empty()) {
+            continue;
+        }
         
-        // Extract share name
-        size_t nameStart = output.find(":", pos) + 1;
-        size_t nameEnd = output.find("\n", nameStart);
-        if (nameEnd != std::string::npos) {
-            std::string shareName = output.substr(nameStart, nameEnd - nameStart);
-            shareName.erase(0, shareName.find_first_not_of(" \t"));
-            shareName.erase(shareName.find_last_not_of(" \t") + 1);
-            if (!shareName.empty() && shareName != "Name") {
-                shareNames.push_back(shareName);
-            }
+        // Check for admin-only shares (default shares like C$, ADMIN$, etc.)
+        if (shareName.back() == '$') {
+            adminOnlyShares++;
         }
         
-        pos += 4;
-    }
-    
-    // Check for public access (Everyone or Authenticated Users with Full Control)
-    if (permOutput.find("Everyone") != std::string::npos || 
-        permOutput.find("Authenticated Users") != std::string::npos) {
-        // Count how many shares have public access
-        size_t permPos = 0;
-        while ((permPos = permOutput.find("Everyone", permPos)) != std::string::npos ||
-               (permPos = permOutput.find("Authenticated Users", permPos)) != std::string::npos) {
-            publicShares++;
-            if (permPos != std::string::npos) {
-                permPos += 10;
+        std::string_view shareSddl = row[shareSddlColumn];
+        uint32_t shareAcl = shareSddl.empty() ? SecurityDescriptorCache::InvalidDescriptor : descriptors.addSddl(shareSddl);
+        if (shareAcl == SecurityDescriptorCache::InvalidDescriptor) {
+            unreadableShares++;
+            continue;
+        }
+        std::string_view pathSddl = row[pathSddlColumn];
+        uint32_t folderAcl = pathSddl.empty() ? SecurityDescriptorCache::InvalidDescriptor : descriptors.addSddl(pathSddl);
+        
+        // Network access is the intersection of share and folder permissions
+        bool exposed = false;
+        bool writable = false;
+        WellKnownPrincipal widest = WellKnownPrincipal::AuthenticatedUsers;
+        for (WellKnownPrincipal principal : BroadPrincipals) {
+            uint32_t mask = descriptors.effectiveAccess(shareAcl).mask(principal);
+            if (folderAcl != SecurityDescriptorCache::InvalidDescriptor) {
+                mask &= descriptors.effectiveAccess(folderAcl).mask(principal);
+            }
+            if (!AccessMask::canRead(mask) && !AccessMask::canWrite(mask)) {
+                continue;
+            }
+            if (!exposed) {
+                widest = principal;
+                exposed = true;
             }
+            writable = writable || AccessMask::canWrite(mask);
         }
-    }
-    
-    // Check for admin-only shares (default shares like C$, ADMIN$, etc.)
-    for (const auto& share : shareNames) {
-        if (share.back() == '$') {
-            adminOnlyShares++;
+        
+        if (exposed) {
+            exposedShares.push_back({ shareName, widest, writable });
+            if (widest == WellKnownPrincipal::Anonymous) anonymousShares++;
+            if (writable) publicWriteShares++;
+            else publicReadShares++;
         }
     }
     
-    std::stringstream details;
-    details << "Total Network Shares: " << totalShares << "\n";
-    details << "Admin Shares (hidden): " << adminOnlyShares << "\n";
-    details << "Shares with Public Access: " << publicShares;
-    
-    if (!shareNames.empty()) {
-        details << "\n\nShare Names:\n";
-        for (const auto& name : shareNames) {
-            details << "  - " << name << "\n";
-        }
+    result.findings.number(FindingKey::TotalShares, totalShares);
+    result.findings.number(FindingKey::AdminShares, adminOnlyShares);
+    result.findings.number(FindingKey::WritableShares, publicWriteShares);
+    result.findings.number(FindingKey::ReadableShares, publicReadShares);
+    result.findings.number(FindingKey::AnonymousShares, anonymousShares);
+    result.findings.number(FindingKey::SecurityDescriptors, static_cast<int64_t>(descriptors.size()));
+    if (unreadableShares > 0) {
+        result.findings.number(FindingKey::UnreadableShares, unreadableShares);
     }
     
-    result.details.push_back(details.str());
+    const size_t maxListed = 20;
+    for (size_t i = 0; i < exposedShares.size() && i < maxListed; ++i) {
+        result.findings.item(FindingKey::ExposedShare, exposedShares[i].name,
+                             std::string(exposedShares[i].writable ? "writable" : "readable") + " (widest access: " +
+                                 SecurityDescriptorCache::principalName(exposedShares[i].principal) + ")");
+    }
+    if (exposedShares.size() > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(exposedShares.size() - maxListed));
+    }
     
     // Calculate score
     int score = 100;
     
-    // Penalty for public shares
-    if (publicShares > 0) {
-        score -= publicShares * 20;
+    // Penalty for public shares, heaviest when anyone can write or no logon is needed
+    score -= publicWriteShares * 25;
+    score -= publicReadShares * 10;
+    score -= anonymousShares * 10;
+    for (const auto& share : exposedShares) {
+        result.attribution.add(share.name, (share.writable ? 25 : 10) + (share.principal == WellKnownPrincipal::Anonymous ? 10 : 0));
     }
     
     // Small penalty for many custom shares (indicates potential exposure)
     int customShares = totalShares - adminOnlyShares;
     if (customShares > 5) {
         score -= 10;
+        result.attribution.add("Custom share count", 10);
     }
     
     if (score < 0) score = 0;
     
     result.score = score;
     
-    if (score >= 90) {
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "Network shares are properly configured. System is compliant.";
-    } else if (score >= 70) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Some network shares have public access. Review share permissions and restrict access to authorized users only.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.severity = Severity::High;
-        result.recommendation = "Network shares have excessive public access. This poses a security risk. Immediately restrict share permissions to authorized users only.";
-    }
+    const char* advice[] = {
+        "Network shares are properly configured. System is compliant.",
+        "Some network shares have public access. Review share permissions and restrict access to authorized users only.",
+        "Network shares have excessive public access. This poses a security risk. Immediately restrict share permissions to authorized users only."
+    };
+    result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score)];
     
     return result;
 }
@@ -1,8 +1,14 @@
 #pragma once
 #include "ComplianceCheck.h"
 
+class CsvReader;
+
 class NetworkSharesCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "Network Shares Check"; }
+    
+    // Score Get-SmbShare rows with share (SecurityDescriptor) and folder
+    // (PathSddl) permissions by effective access (no system access)
+    static ComplianceResult evaluate(const CsvReader& shares);
 };
@@ -0,0 +1,170 @@
+#include "OfflineRegistry.h"
+#include "TextUtil.h"
+#include <cstdio>
+#include <filesystem>
+
+using TextUtil::equalsIgnoreCase;
+using TextUtil::startsWithIgnoreCase;
+
+bool OfflineRegistry::mount(const std::string& mountName, std::unique_ptr<RegistryHive> hive) {
+    for (auto& mounted : hives) {
+        if (equalsIgnoreCase(mounted.name, mountName)) {
+            mounted.hive = std::move(hive);
+            resolveCurrentControlSet();
+            return true;
+        }
+    }
+
+    hives.push_back(MountedHive{ mountName, std::move(hive) });
+    resolveCurrentControlSet();
+    return true;
+}
+
+bool OfflineRegistry::loadHive(const std::string& mountName, const std::string& path) {
+    auto hive = std::make_unique<RegistryHive>();
+    if (!hive->open(path)) {
+        return false;
+    }
+    return mount(mountName, std::move(hive));
+}
+
+bool OfflineRegistry::loadHiveMemory(const std::string& mountName, const void* data, size_t size) {
+    auto hive = std::make_unique<RegistryHive>();
+    if (!hive->openMemory(data, size)) {
+        return false;
+    }
+    return mount(mountName, std::move(hive));
+}
+
+bool OfflineRegistry::loadDirectory(const std::string& directory) {
+    static const char* const StandardHives[] = { "SOFTWARE", "SYSTEM", "SAM", "SECURITY" };
+
+    bool loaded = false;
+    for (const char* name : StandardHives) {
+        std::filesystem::path path = std::filesystem::path(directory) / name;
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec) && loadHive(name, path.string())) {
+            loaded = true;
+        }
+    }
+    return loaded;
+}
+
+void OfflineRegistry::resolveCurrentControlSet() {
+    const RegistryHive* system = hive("SYSTEM");
+    if (system == nullptr) {
+        return;
+    }
+
+    uint32_t current = 0;
+    RegistryHive::Value value = system->findValue(system->findKey("Select"), "Current");
+    if (value && system->valueDword(value, current) && current > 0 && current < 1000) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "ControlSet%03u", current);
+        currentControlSet = name;
+    }
+}
+
+const RegistryHive* OfflineRegistry::hive(std::string_view mountName) const {
+    for (const auto& mounted : hives) {
+        if (equalsIgnoreCase(mounted.name, mountName)) {
+            return mounted.hive.get();
+        }
+    }
+    return nullptr;
+}
+
+bool OfflineRegistry::resolve(std::string_view keyPath, const RegistryHive*& target, RegistryHive::Key& key) const {
+    // Only HKEY_LOCAL_MACHINE hives are mounted
+    if (startsWithIgnoreCase(keyPath, "HKEY_LOCAL_MACHINE\\")) keyPath.remove_prefix(19);
+    else if (startsWithIgnoreCase(keyPath, "HKLM:\\")) keyPath.remove_prefix(6);
+    else if (startsWithIgnoreCase(keyPath, "HKLM\\")) keyPath.remove_prefix(5);
+    else return false;
+
+    size_t slash = keyPath.find('\\');
+    std::string_view hiveName = keyPath.substr(0, slash);
+    std::string_view rest = (slash == std::string_view::npos) ? std::string_view() : keyPath.substr(slash + 1);
+
+    target = hive(hiveName);
+    if (target == nullptr) {
+        return false;
+    }
+
+    RegistryHive::Key start = target->root();
+
+    // CurrentControlSet is a volatile link; follow Select\Current instead
+    if (equalsIgnoreCase(hiveName, "SYSTEM") && startsWithIgnoreCase(rest, "CurrentControlSet") &&
+        (rest.size() == 17 || rest[17] == '\\')) {
+        start = target->findSubkey(start, currentControlSet);
+        rest = rest.size() > 17 ? rest.substr(18) : std::string_view();
+    }
+
+    key = target->findKey(start, rest);
+    return static_cast<bool>(key);
+}
+
+std::string OfflineRegistry::readValue(const std::string& keyPath, const std::string& valueName) const {
+    const RegistryHive* target = nullptr;
+    RegistryHive::Key key;
+    if (!resolve(keyPath, target, key)) {
+        return std::string();
+    }
+
+    RegistryHive::Value value = target->findValue(key, valueName);
+    return value ? target->valueString(value) : std::string();
+}
+
+bool OfflineRegistry::valueExists(const std::string& keyPath, const std::string& valueName) const {
+    const RegistryHive* target = nullptr;
+    RegistryHive::Key key;
+    if (!resolve(keyPath, target, key)) {
+        return false;
+    }
+    return static_cast<bool>(target->findValue(key, valueName));
+}
+
+bool OfflineRegistry::enumerateSubkeys(const std::string& keyPath, std::vector<std::string>& names) const {
+    const RegistryHive* target = nullptr;
+    RegistryHive::Key key;
+    if (!resolve(keyPath, target, key)) {
+        return false;
+    }
+
+    names.reserve(names.size() + target->subkeyCount(key));
+    target->forEachSubkey(key, [&](RegistryHive::Key child) {
+        names.push_back(target->keyName(child));
+        return true;
+    });
+    return true;
+}
+
+bool OfflineRegistry::enumerateValues(const std::string& keyPath, std::vector<std::string>& names) const {
+    const RegistryHive* target = nullptr;
+    RegistryHive::Key key;
+    if (!resolve(keyPath, target, key)) {
+        return false;
+    }
+
+    names.reserve(names.size() + target->valueCount(key));
+    target->forEachValue(key, [&](RegistryHive::Value value) {
+        names.push_back(target->valueName(value));
+        return true;
+    });
+    return true;
+}
+
+bool OfflineRegistry::readValues(const std::string& keyPath, std::vector<std::pair<std::string, std::string>>& values) const {
+    const RegistryHive* target = nullptr;
+    RegistryHive::Key key;
+    if (!resolve(keyPath, target, key)) {
+        return false;
+    }
+
+    // One path resolution for the whole key
+    values.reserve(values.size() + target->valueCount(key));
+    target->forEachValue(key, [&](RegistryHive::Value value) {
+        values.emplace_back(target->valueName(value), target->valueString(value));
+        return true;
+    });
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "RegistryHive.h"
+#include "RegistryProvider.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// RegistryProvider backed by offline hive files. Full paths such as
+// "HKEY_LOCAL_MACHINE\SYSTEM\CurrentControlSet\Services\Netlogon\Parameters"
+// are routed to the mounted hive (SOFTWARE, SYSTEM, SAM, SECURITY), and
+// CurrentControlSet is resolved through SYSTEM\Select\Current.
+class OfflineRegistry : public RegistryProvider {
+public:
+    // Mount every standard hive file found in a directory (e.g. a copy of
+    // System32\config or the output of `reg save`)
+    bool loadDirectory(const std::string& directory);
+
+    // Mount one hive under an HKLM name ("SOFTWARE", "SYSTEM", ...)
+    bool loadHive(const std::string& mountName, const std::string& path);
+
+    // Mount a hive image already in memory; the caller keeps it alive
+    bool loadHiveMemory(const std::string& mountName, const void* data, size_t size);
+
+    size_t hiveCount() const { return hives.size(); }
+    const RegistryHive* hive(std::string_view mountName) const override;
+
+    // Resolve a full key path to its hive and key
+    bool resolve(std::string_view keyPath, const RegistryHive*& hive, RegistryHive::Key& key) const;
+
+    std::string readValue(const std::string& keyPath, const std::string& valueName) const override;
+    bool valueExists(const std::string& keyPath, const std::string& valueName) const override;
+    bool enumerateSubkeys(const std::string& keyPath, std::vector<std::string>& names) const override;
+    bool enumerateValues(const std::string& keyPath, std::vector<std::string>& names) const override;
+    bool readValues(const std::string& keyPath, std::vector<std::pair<std::string, std::string>>& values) const override;
+
+private:
+    struct MountedHive {
+        std::string name;
+        std::unique_ptr<RegistryHive> hive;
+    };
+
+    std::vector<MountedHive> hives;
+    std::string currentControlSet = "ControlSet001";
+
+    bool mount(const std::string& mountName, std::unique_ptr<RegistryHive> hive);
+    void resolveCurrentControlSet();
+};
@@ -1,141 +1,130 @@
 #include "PasswordPolicyCheck.h"
+#include "PolicyTables.h"
+#include "SecurityPolicy.h"
 #include <sstream>
+#include <filesystem>
 
 ComplianceResult PasswordPolicyCheck::performCheck() {
-    ComplianceResult result("Password Policy Review",
-                           "Evaluates password length, complexity, and expiration settings.",
-                           CheckStatus::Pass, Severity::Low, 100);
+    // Export the local security policy once; [System Access] answers every
+    // account-policy question in a single pass
+    AccountPolicy policy;
+    std::string source;
+    std::string infPath = tempProbePath("secpol", ".inf");
+    executePowerShell("secedit /export /cfg '" + infPath + "' /areas SECURITYPOLICY /quiet");
+    
+    SecurityPolicy secPolicy;
+    if (secPolicy.loadFromFile(infPath)) {
+        secPolicy.getAccountPolicy(policy);
+        source = "local security policy export (secedit)";
+    }
+    std::error_code ec;
+    std::filesystem::remove(infPath, ec);
     
-    result.details.push_back("Checking password policy settings...");
-    
-    // Check password policy using registry
-    int minLength = 0;
-    bool complexityRequired = false;
-    int maxAge = 0;
-    int minAge = 0;
-    int historySize = 0;
-    
-    // Minimum password length
-    std::string minLengthStr = readRegistryValue(
-        "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
-        "MinimumPasswordLength");
-    if (!minLengthStr.empty()) {
-        minLength = std::stoi(minLengthStr);
-    } else {
-        // Try alternative location
-        minLengthStr = readRegistryValue(
-            "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Policies\\System",
+    // Fall back to net accounts if the export was not available
+    if (policy.minPasswordLength < 0) {
+        if (NetAccountsParser::parse(executePowerShell("net accounts"), policy)) {
+            source = "net accounts";
+        }
+    }
+    
+    // Registry values as a last resort for anything still missing
+    if (policy.minPasswordLength < 0) {
+        std::string minLengthStr = readRegistryValue(
+            "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
             "MinimumPasswordLength");
+        if (minLengthStr.empty()) {
+            // Try alternative location
+            minLengthStr = readRegistryValue(
+                "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Policies\\System",
+                "MinimumPasswordLength");
+        }
         if (!minLengthStr.empty()) {
-            minLength = std::stoi(minLengthStr);
+            policy.minPasswordLength = std::stoi(minLengthStr);
         }
     }
     
-    // Password complexity
-    std::string complexityStr = readRegistryValue(
-        "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Policies\\System",
-        "PasswordComplexity");
-    complexityRequired = (complexityStr == "1");
-    
-    // Maximum password age
-    std::string maxAgeStr = readRegistryValue(
-        "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
-        "MaximumPasswordAge");
-    if (!maxAgeStr.empty()) {
-        maxAge = std::stoi(maxAgeStr);
+    if (policy.passwordComplexity < 0) {
+        std::string complexityStr = readRegistryValue(
+            "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Policies\\System",
+            "PasswordComplexity");
+        if (!complexityStr.empty()) {
+            policy.passwordComplexity = std::stoi(complexityStr);
+        }
     }
     
-    // Minimum password age
-    std::string minAgeStr = readRegistryValue(
-        "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
-        "MinimumPasswordAge");
-    if (!minAgeStr.empty()) {
-        minAge = std::stoi(minAgeStr);
+    if (policy.maxPasswordAgeDays < 0) {
+        std::string maxAgeStr = readRegistryValue(
+            "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
+            "MaximumPasswordAge");
+        if (!maxAgeStr.empty()) {
+            policy.maxPasswordAgeDays = std::stoi(maxAgeStr);
+        }
     }
     
-    // Password history
-    std::string historyStr = readRegistryValue(
-        "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
-        "PasswordHistoryLength");
-    if (!historyStr.empty()) {
-        historySize = std::stoi(historyStr);
+    if (policy.minPasswordAgeDays < 0) {
+        std::string minAgeStr = readRegistryValue(
+            "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
+            "MinimumPasswordAge");
+        if (!minAgeStr.empty()) {
+            policy.minPasswordAgeDays = std::stoi(minAgeStr);
+        }
     }
     
-    // Use PowerShell as fallback for more accurate results
-    std::string psOutput = executePowerShell("Get-ADDefaultDomainPasswordPolicy -ErrorAction SilentlyContinue | Select-Object MinPasswordLength, PasswordHistoryCount, MaxPasswordAge, MinPasswordAge, ComplexityEnabled | Format-List");
-    
-    // If PowerShell worked, try to parse it
-    if (psOutput.find("MinPasswordLength") != std::string::npos) {
-        // Parse PowerShell output if available
-        // For now, we'll use registry values
+    if (policy.passwordHistorySize < 0) {
+        std::string historyStr = readRegistryValue(
+            "HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\Netlogon\\Parameters",
+            "PasswordHistoryLength");
+        if (!historyStr.empty()) {
+            policy.passwordHistorySize = std::stoi(historyStr);
+        }
     }
     
-    // If registry values are not available, use PowerShell net accounts command
-    if (minLength == 0) {
-        std::string netAccounts = executePowerShell("net accounts");
-        // Parse net accounts output
-        if (netAccounts.find("Minimum password length") != std::string::npos) {
-            // Extract minimum length from output
-            size_t pos = netAccounts.find("Minimum password length");
-            if (pos != std::string::npos) {
-                size_t start = netAccounts.find(":", pos) + 1;
-                size_t end = netAccounts.find("\n", start);
-                if (end == std::string::npos) end = netAccounts.length();
-                std::string lenStr = netAccounts.substr(start, end - start);
-                // Remove whitespace
-                lenStr.erase(0, lenStr.find_first_not_of(" \t"));
-                lenStr.erase(lenStr.find_last_not_of(" \t") + 1);
-                if (!lenStr.empty()) {
-                    minLength = std::stoi(lenStr);
-                }
-            }
-        }
+    return evaluate(policy, source);
+}
+
+ComplianceResult PasswordPolicyCheck::evaluate(const AccountPolicy& policy, const std::string& source) {
+    ComplianceResult result("Password Policy Review",
+                           "Evaluates password length, complexity, and expiration settings.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    if (!source.empty()) {
+        result.findings.text(FindingKey::Source, source);
     }
     
-    std::stringstream details;
-    details << "Minimum Password Length: " << (minLength > 0 ? std::to_string(minLength) : "Not configured") << "\n";
-    details << "Complexity Required: " << (complexityRequired ? "Yes" : "No") << "\n";
-    details << "Maximum Password Age: " << (maxAge > 0 ? std::to_string(maxAge) + " days" : "Not configured") << "\n";
-    details << "Minimum Password Age: " << (minAge > 0 ? std::to_string(minAge) + " days" : "Not configured") << "\n";
-    details << "Password History: " << (historySize > 0 ? std::to_string(historySize) + " passwords" : "Not configured");
+    int minLength = policy.minPasswordLength > 0 ? policy.minPasswordLength : 0;
+    bool complexityRequired = (policy.passwordComplexity == 1);
+    int maxAge = policy.maxPasswordAgeDays > 0 ? policy.maxPasswordAgeDays : 0;
+    int minAge = policy.minPasswordAgeDays > 0 ? policy.minPasswordAgeDays : 0;
+    int historySize = policy.passwordHistorySize > 0 ? policy.passwordHistorySize : 0;
     
-    result.details.push_back(details.str());
+    result.findings.number(FindingKey::MinimumPasswordLength, minLength);
+    result.findings.flag(FindingKey::PasswordComplexity, complexityRequired);
+    result.findings.number(FindingKey::MaximumPasswordAge, maxAge);
+    result.findings.number(FindingKey::MinimumPasswordAge, minAge);
+    result.findings.number(FindingKey::PasswordHistory, historySize);
+    result.findings.number(FindingKey::LockoutThreshold, policy.lockoutThreshold > 0 ? policy.lockoutThreshold : 0);
     
     // Calculate score based on NIST/ISO recommendations
     // Recommended: min length >= 8, complexity enabled, max age <= 90 days, history >= 12
     int score = 0;
-    int issues = 0;
     
+    // Points missed on each setting are attributed to it
     if (minLength >= 8) score += 25;
-    else if (minLength >= 6) score += 15;
-    else issues++;
+    else if (minLength >= 6) { score += 15; result.attribution.add("MinimumPasswordLength", 10); }
+    else result.attribution.add("MinimumPasswordLength", 25);
     
     if (complexityRequired) score += 25;
-    else issues++;
+    else result.attribution.add("PasswordComplexity", 25);
     
     if (maxAge > 0 && maxAge <= 90) score += 25;
-    else if (maxAge > 90) issues++;
-    else score += 15; // Not configured is better than too long
+    else if (maxAge > 90) result.attribution.add("MaximumPasswordAge", 25);
+    else { score += 15; result.attribution.add("MaximumPasswordAge", 10); } // Not configured is better than too long
     
     if (historySize >= 12) score += 25;
-    else if (historySize > 0) score += 15;
-    else issues++;
-    
-    result.score = score;
-    
-    if (score >= 90) {
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "Password policy meets security standards. System is compliant.";
-    } else if (score >= 70) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Password policy needs improvement. Consider increasing minimum length to 8+ characters, enabling complexity, and setting appropriate age limits.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.severity = (issues >= 3) ? Severity::High : Severity::Medium;
-        result.recommendation = "Password policy does not meet security standards. Configure minimum length (8+), enable complexity requirements, and set password expiration (max 90 days).";
-    }
+    else if (historySize > 0) { score += 15; result.attribution.add("PasswordHistorySize", 10); }
+    else result.attribution.add("PasswordHistorySize", 25);
+    
+    PolicyTables::applyScore<PasswordStatusPolicy>(result, score);
     
     return result;
 }
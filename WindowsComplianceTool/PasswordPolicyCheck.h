@@ -1,9 +1,13 @@
 #pragma once
 #include "ComplianceCheck.h"
 
+struct AccountPolicy;
+
 class PasswordPolicyCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "Password Policy Review"; }
+    
+    // Score collected account policy values (no system access)
+    static ComplianceResult evaluate(const AccountPolicy& policy, const std::string& source = "");
 };
-
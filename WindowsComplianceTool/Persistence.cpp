@@ -0,0 +1,383 @@
+#include "Persistence.h"
+#include "CsvReader.h"
+#include "RegistryHive.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+namespace {
+
+using TextUtil::containsIgnoreCase;
+using TextUtil::equalsIgnoreCase;
+using TextUtil::startsWithIgnoreCase;
+using TextUtil::toLower;
+using TextUtil::trim;
+
+struct Expansion {
+    const char* from;
+    const char* to;
+};
+
+// Environment variables and NT path forms found in ImagePath and autorun values
+const Expansion Expansions[] = {
+    { "\\??\\", "" }, { "%SystemRoot%", "C:\\Windows" }, { "%windir%", "C:\\Windows" },
+    { "%ProgramFiles(x86)%", "C:\\Program Files (x86)" }, { "%ProgramFiles%", "C:\\Program Files" },
+    { "%CommonProgramFiles%", "C:\\Program Files\\Common Files" }, { "%ProgramData%", "C:\\ProgramData" },
+    { "%SystemDrive%", "C:" }, { "\\SystemRoot\\", "C:\\Windows\\" }, { "System32\\", "C:\\Windows\\System32\\" }
+};
+
+// Program extensions a command line may start with
+const char* const ProgramExtensions[] = { ".exe", ".dll", ".com", ".bat", ".cmd", ".scr", ".ps1", ".vbs", ".js" };
+
+// Directories under the protected trees that users can still write to
+const char* const WritableSystemDirectories[] = {
+    "c:\\windows\\temp\\", "c:\\windows\\tasks\\", "c:\\windows\\tracing\\",
+    "c:\\windows\\system32\\tasks\\", "c:\\windows\\system32\\spool\\drivers\\color\\"
+};
+
+// Per-user locations left unexpanded in task and autorun commands
+const char* const UserProfileVariables[] = {
+    "%userprofile%", "%appdata%", "%localappdata%", "%temp%", "%tmp%", "%public%", "%homepath%", "%onedrive%"
+};
+
+const char* const SystemDirectories[] = { "c:\\windows\\", "c:\\program files\\", "c:\\program files (x86)\\" };
+
+// Run-style keys of the SOFTWARE hive
+struct AutorunKey {
+    const char* path;
+    AutorunLocation location;
+};
+
+const AutorunKey AutorunKeys[] = {
+    { "Microsoft\\Windows\\CurrentVersion\\Run", AutorunLocation::Run },
+    { "Microsoft\\Windows\\CurrentVersion\\RunOnce", AutorunLocation::RunOnce },
+    { "Microsoft\\Windows\\CurrentVersion\\Policies\\Explorer\\Run", AutorunLocation::Run },
+    { "WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Run", AutorunLocation::Run },
+    { "WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\RunOnce", AutorunLocation::RunOnce }
+};
+
+const char* const ImageFileExecutionOptionsKeys[] = {
+    "Microsoft\\Windows NT\\CurrentVersion\\Image File Execution Options",
+    "WOW6432Node\\Microsoft\\Windows NT\\CurrentVersion\\Image File Execution Options"
+};
+
+const char* const WinlogonKey = "Microsoft\\Windows NT\\CurrentVersion\\Winlogon";
+
+uint32_t parseStartMode(std::string_view mode) {
+    if (equalsIgnoreCase(mode, "Boot")) return 0;
+    if (equalsIgnoreCase(mode, "System")) return 1;
+    if (equalsIgnoreCase(mode, "Auto")) return 2;
+    if (equalsIgnoreCase(mode, "Disabled")) return 4;
+    return 3;
+}
+
+uint32_t parseServiceType(std::string_view type) {
+    if (equalsIgnoreCase(type, "Kernel Driver")) return 0x01;
+    if (equalsIgnoreCase(type, "File System Driver")) return 0x02;
+    if (equalsIgnoreCase(type, "Share Process")) return 0x20;
+    return 0x10;
+}
+
+const char* locationName(AutorunLocation location) {
+    switch (location) {
+        case AutorunLocation::Run: return "Run";
+        case AutorunLocation::RunOnce: return "RunOnce";
+        case AutorunLocation::Winlogon: return "Winlogon";
+        case AutorunLocation::ImageFileExecutionOptions: return "IFEO";
+        default: return "Unknown";
+    }
+}
+
+} // namespace
+
+bool ServiceEntry::runsAsSystem() const {
+    return account.empty() || equalsIgnoreCase(account, "LocalSystem") || equalsIgnoreCase(account, ".\\LocalSystem") ||
+           equalsIgnoreCase(account, "NT AUTHORITY\\SYSTEM");
+}
+
+void PersistenceInventory::clear() {
+    serviceEntries.clear();
+    autorunEntries.clear();
+}
+
+void PersistenceInventory::addAutorun(AutorunLocation location, std::string_view name, std::string_view command) {
+    AutorunEntry entry;
+    entry.location = location;
+    entry.name = std::string(name);
+    entry.command = std::string(trim(command));
+    autorunEntries.push_back(std::move(entry));
+}
+
+std::string PersistenceInventory::executablePath(std::string_view commandLine) {
+    std::string_view text = trim(commandLine);
+    std::string_view program;
+
+    if (!text.empty() && text.front() == '"') {
+        size_t close = text.find('"', 1);
+        program = text.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1);
+    } else {
+        // Unquoted: the first program extension that ends a path component
+        std::string lower = toLower(text);
+        size_t end = std::string::npos;
+        for (const char* extension : ProgramExtensions) {
+            size_t length = std::char_traits<char>::length(extension);
+            for (size_t pos = lower.find(extension); pos != std::string::npos; pos = lower.find(extension, pos + 1)) {
+                size_t after = pos + length;
+                if (after == lower.size() || lower[after] == ' ' || lower[after] == ',' || lower[after] == '"') {
+                    if (after < end) end = after;
+                    break;
+                }
+            }
+        }
+        program = end != std::string::npos ? text.substr(0, end) : text.substr(0, text.find(' '));
+    }
+
+    std::string path(trim(program));
+    for (const auto& expansion : Expansions) {
+        size_t length = std::char_traits<char>::length(expansion.from);
+        if (startsWithIgnoreCase(path, expansion.from)) {
+            path = expansion.to + path.substr(length);
+        }
+    }
+
+    // A bare program name is found on the system path
+    if (!path.empty() && path.find('\\') == std::string::npos && path.find('/') == std::string::npos) {
+        path = "C:\\Windows\\System32\\" + path;
+    }
+    return path;
+}
+
+bool PersistenceInventory::isUnquotedPathWithSpaces(std::string_view imagePath) {
+    std::string_view text = trim(imagePath);
+    if (text.empty() || text.front() == '"') return false;
+    std::string lower = toLower(text);
+    size_t exe = lower.find(".exe");
+    if (exe == std::string::npos) return false;
+    return lower.find(' ') < exe;
+}
+
+bool PersistenceInventory::isSystemPath(std::string_view path) {
+    for (const char* directory : SystemDirectories) {
+        if (startsWithIgnoreCase(path, directory)) return true;
+    }
+    return false;
+}
+
+bool PersistenceInventory::isUserWritablePath(std::string_view path) {
+    std::string lower = toLower(path);
+    if (lower.find("\\users\\") != std::string::npos || lower.find("\\appdata\\") != std::string::npos ||
+        lower.find("\\temp\\") != std::string::npos || lower.compare(0, 15, "c:\\programdata\\") == 0) {
+        return true;
+    }
+    for (const char* directory : WritableSystemDirectories) {
+        if (lower.compare(0, std::char_traits<char>::length(directory), directory) == 0) return true;
+    }
+    for (const char* variable : UserProfileVariables) {
+        if (lower.compare(0, std::char_traits<char>::length(variable), variable) == 0) return true;
+    }
+    if (isSystemPath(lower)) return false;
+
+    // Authenticated Users may create folders at a drive root, so any
+    // directory outside the protected trees is writable by default
+    bool driveRooted = lower.size() > 3 && std::isalpha(static_cast<unsigned char>(lower[0])) && lower[1] == ':' && lower[2] == '\\';
+    return driveRooted && lower.find('\\', 3) != std::string::npos;
+}
+
+bool PersistenceInventory::loadFromHives(const RegistryHive* system, const RegistryHive* software) {
+    if (system != nullptr) loadServices(*system);
+    if (software != nullptr) loadAutoruns(*software);
+    return !serviceEntries.empty() || !autorunEntries.empty();
+}
+
+void PersistenceInventory::loadServices(const RegistryHive& system) {
+    // CurrentControlSet is the set named by Select\Current
+    uint32_t current = 1;
+    if (RegistryHive::Key select = system.findKey("Select")) {
+        if (RegistryHive::Value value = system.findValue(select, "Current")) system.valueDword(value, current);
+    }
+    char controlSet[32];
+    std::snprintf(controlSet, sizeof(controlSet), "ControlSet%03u\\Services", current);
+    RegistryHive::Key services = system.findKey(controlSet);
+    if (!services) return;
+
+    system.forEachSubkey(services, [&](RegistryHive::Key key) {
+        ServiceEntry service;
+        service.name = system.keyName(key);
+        system.forEachValue(key, [&](RegistryHive::Value value) {
+            std::string name = system.valueName(value);
+            if (equalsIgnoreCase(name, "ImagePath")) service.imagePath = system.valueString(value);
+            else if (equalsIgnoreCase(name, "DisplayName")) service.displayName = system.valueString(value);
+            else if (equalsIgnoreCase(name, "ObjectName")) service.account = system.valueString(value);
+            else if (equalsIgnoreCase(name, "Start")) system.valueDword(value, service.start);
+            else if (equalsIgnoreCase(name, "Type")) system.valueDword(value, service.type);
+            return true;
+        });
+        if (RegistryHive::Key parameters = system.findSubkey(key, "Parameters")) {
+            if (RegistryHive::Value dll = system.findValue(parameters, "ServiceDll")) service.serviceDll = system.valueString(dll);
+        }
+        serviceEntries.push_back(std::move(service));
+        return true;
+    });
+}
+
+void PersistenceInventory::loadAutoruns(const RegistryHive& software) {
+    for (const auto& autorunKey : AutorunKeys) {
+        RegistryHive::Key key = software.findKey(autorunKey.path);
+        if (!key) continue;
+        software.forEachValue(key, [&](RegistryHive::Value value) {
+            std::string command = software.valueString(value);
+            if (!command.empty()) addAutorun(autorunKey.location, software.valueName(value), command);
+            return true;
+        });
+    }
+
+    if (RegistryHive::Key winlogon = software.findKey(WinlogonKey)) {
+        for (const char* name : { "Shell", "Userinit" }) {
+            RegistryHive::Value value = software.findValue(winlogon, name);
+            if (value) addAutorun(AutorunLocation::Winlogon, name, software.valueString(value));
+        }
+    }
+
+    for (const char* path : ImageFileExecutionOptionsKeys) {
+        RegistryHive::Key options = software.findKey(path);
+        if (!options) continue;
+        software.forEachSubkey(options, [&](RegistryHive::Key image) {
+            RegistryHive::Value debugger = software.findValue(image, "Debugger");
+            if (debugger) {
+                std::string command = software.valueString(debugger);
+                if (!command.empty()) addAutorun(AutorunLocation::ImageFileExecutionOptions, software.keyName(image), command);
+            }
+            return true;
+        });
+    }
+}
+
+bool PersistenceInventory::loadServicesCsv(const CsvReader& table) {
+    int nameColumn = table.columnIndex("Name");
+    int displayColumn = table.columnIndex("DisplayName");
+    int pathColumn = table.columnIndex("PathName");
+    int startColumn = table.columnIndex("StartMode");
+    int accountColumn = table.columnIndex("StartName");
+    int typeColumn = table.columnIndex("ServiceType");
+
+    size_t before = serviceEntries.size();
+    serviceEntries.reserve(before + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        ServiceEntry service;
+        service.name = row.value(nameColumn);
+        if (service.name.empty()) continue;
+        service.displayName = row.value(displayColumn);
+        service.imagePath = row.value(pathColumn);
+        service.account = row.value(accountColumn);
+        service.start = parseStartMode(row[startColumn]);
+        service.type = parseServiceType(row[typeColumn]);
+        serviceEntries.push_back(std::move(service));
+    }
+    return serviceEntries.size() > before;
+}
+
+bool PersistenceInventory::loadAutorunsCsv(const CsvReader& table) {
+    int locationColumn = table.columnIndex("Location");
+    int nameColumn = table.columnIndex("Name");
+    int commandColumn = table.columnIndex("Command");
+
+    size_t before = autorunEntries.size();
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        std::string command = row.value(commandColumn);
+        if (trim(command).empty()) continue;
+
+        std::string_view location = row[locationColumn];
+        AutorunLocation kind = AutorunLocation::Run;
+        if (containsIgnoreCase(location, "RunOnce")) kind = AutorunLocation::RunOnce;
+        else if (containsIgnoreCase(location, "Winlogon")) kind = AutorunLocation::Winlogon;
+        else if (containsIgnoreCase(location, "IFEO") || containsIgnoreCase(location, "Image File Execution Options")) {
+            kind = AutorunLocation::ImageFileExecutionOptions;
+        }
+        addAutorun(kind, row.value(nameColumn), command);
+    }
+    return autorunEntries.size() > before;
+}
+
+std::vector<PersistenceFinding> PersistenceInventory::analyze() const {
+    std::vector<PersistenceFinding> findings;
+
+    for (uint32_t i = 0; i < serviceEntries.size(); ++i) {
+        const ServiceEntry& service = serviceEntries[i];
+        if (!service.isWin32() || service.start == 4 || service.imagePath.empty()) {
+            continue;
+        }
+        bool system = service.runsAsSystem();
+
+        if (isUnquotedPathWithSpaces(service.imagePath)) {
+            findings.push_back({ PersistenceFinding::Kind::UnquotedServicePath, true, i,
+                                 system ? Severity::High : Severity::Medium,
+                                 "Unquoted path with spaces: " + service.imagePath });
+        }
+
+        std::string binary = executablePath(service.imagePath);
+        if (isUserWritablePath(binary)) {
+            findings.push_back({ PersistenceFinding::Kind::WritableServiceBinary, true, i,
+                                 system ? Severity::Critical : Severity::High,
+                                 "Binary in a user-writable directory: " + binary });
+        } else if (!service.serviceDll.empty()) {
+            std::string dll = executablePath(service.serviceDll);
+            if (isUserWritablePath(dll)) {
+                findings.push_back({ PersistenceFinding::Kind::WritableServiceBinary, true, i,
+                                     system ? Severity::Critical : Severity::High,
+                                     "ServiceDll in a user-writable directory: " + dll });
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < autorunEntries.size(); ++i) {
+        const AutorunEntry& autorun = autorunEntries[i];
+        std::string program = executablePath(autorun.command);
+
+        if (autorun.location == AutorunLocation::ImageFileExecutionOptions) {
+            findings.push_back({ PersistenceFinding::Kind::DebuggerHijack, false, i, Severity::High,
+                                 "Debugger for " + autorun.name + ": " + autorun.command });
+            continue;
+        }
+
+        if (autorun.location == AutorunLocation::Winlogon) {
+            // Defaults: Shell = explorer.exe, Userinit = C:\Windows\system32\userinit.exe,
+            bool modified;
+            if (equalsIgnoreCase(autorun.name, "Shell")) {
+                std::string_view shell = trim(autorun.command);
+                modified = !equalsIgnoreCase(shell, "explorer.exe") && !equalsIgnoreCase(shell, "explorer.exe,") &&
+                           !equalsIgnoreCase(program, "C:\\Windows\\explorer.exe");
+            } else {
+                size_t programs = 0;
+                std::string_view rest = autorun.command;
+                while (!rest.empty()) {
+                    size_t comma = rest.find(',');
+                    if (!trim(rest.substr(0, comma)).empty()) programs++;
+                    rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+                }
+                modified = programs != 1 || !equalsIgnoreCase(program, "C:\\Windows\\System32\\userinit.exe");
+            }
+            if (modified) {
+                findings.push_back({ PersistenceFinding::Kind::WinlogonModified, false, i, Severity::High,
+                                     "Winlogon " + autorun.name + " is " + autorun.command });
+            }
+            continue;
+        }
+
+        if (isUserWritablePath(program)) {
+            findings.push_back({ PersistenceFinding::Kind::WritableAutorun, false, i, Severity::High,
+                                 std::string(locationName(autorun.location)) + " entry starts " + program +
+                                 " from a user-writable directory" });
+        } else if (!isSystemPath(program)) {
+            findings.push_back({ PersistenceFinding::Kind::UnknownAutorun, false, i, Severity::Low,
+                                 std::string(locationName(autorun.location)) + " entry outside Windows and Program Files: " + program });
+        }
+    }
+
+    std::stable_sort(findings.begin(), findings.end(), [](const PersistenceFinding& a, const PersistenceFinding& b) {
+        return static_cast<int>(a.severity) > static_cast<int>(b.severity);
+    });
+    return findings;
+}
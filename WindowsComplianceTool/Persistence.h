@@ -0,0 +1,104 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class CsvReader;
+class RegistryHive;
+
+// One Services subkey (or Win32_Service row)
+struct ServiceEntry {
+    std::string name;
+    std::string displayName;
+    std::string imagePath;      // as configured, environment variables unexpanded
+    std::string serviceDll;     // Parameters\ServiceDll of svchost services
+    std::string account;        // ObjectName, empty = LocalSystem
+    uint32_t start = 3;         // 0 boot, 1 system, 2 automatic, 3 manual, 4 disabled
+    uint32_t type = 0x10;       // SERVICE_* type bits
+
+    bool isWin32() const { return (type & 0x30) != 0; }
+    bool runsAsSystem() const;
+};
+
+enum class AutorunLocation : uint8_t {
+    Run,
+    RunOnce,
+    Winlogon,                   // Shell / Userinit
+    ImageFileExecutionOptions   // Debugger of an IFEO subkey
+};
+
+struct AutorunEntry {
+    AutorunLocation location = AutorunLocation::Run;
+    std::string name;           // value name, or the image name for IFEO
+    std::string command;
+};
+
+struct PersistenceFinding {
+    enum class Kind {
+        UnquotedServicePath,    // space in an unquoted image path lets C:\Program.exe run first
+        WritableServiceBinary,  // service binary or ServiceDll in a user-writable directory
+        WritableAutorun,        // autorun binary in a user-writable directory
+        DebuggerHijack,         // IFEO Debugger redirects an image to another program
+        WinlogonModified,       // Shell / Userinit differ from the Windows defaults
+        UnknownAutorun          // autorun outside the Windows and Program Files directories
+    };
+
+    Kind kind;
+    bool service;               // entry indexes services() rather than autoruns()
+    uint32_t entry;
+    Severity severity;
+    std::string reason;
+};
+
+// Services and autorun locations read in one pass over the SYSTEM and
+// SOFTWARE hives: every Services subkey and Run/RunOnce, Winlogon and
+// Image File Execution Options entry is visited through the hive's subkey
+// index, without a path lookup per key. Writable locations are judged
+// from the path (user profiles, ProgramData, Temp, folders outside the
+// protected Windows and Program Files trees) since NTFS ACLs are not
+// part of the hives.
+class PersistenceInventory {
+public:
+    // Either hive may be null
+    bool loadFromHives(const RegistryHive* system, const RegistryHive* software);
+
+    // Win32_Service rows: Name, DisplayName, PathName, StartMode, StartName, ServiceType
+    bool loadServicesCsv(const CsvReader& table);
+
+    // Autorun rows: Location (Run / RunOnce key path, Winlogon, IFEO), Name, Command
+    bool loadAutorunsCsv(const CsvReader& table);
+
+    void addService(ServiceEntry service) { serviceEntries.push_back(std::move(service)); }
+    void addAutorun(AutorunLocation location, std::string_view name, std::string_view command);
+
+    void clear();
+    const std::vector<ServiceEntry>& services() const { return serviceEntries; }
+    const std::vector<AutorunEntry>& autoruns() const { return autorunEntries; }
+
+    // Findings for enabled Win32 services and all autoruns, most severe first
+    std::vector<PersistenceFinding> analyze() const;
+
+    // Program a command line starts, with quotes and arguments removed and
+    // %SystemRoot%, \SystemRoot\ and \??\ forms expanded: "C:\Windows\..."
+    static std::string executablePath(std::string_view commandLine);
+
+    // Unquoted image path whose directories contain a space before the executable
+    static bool isUnquotedPathWithSpaces(std::string_view imagePath);
+
+    // Directory users can write to by default (expanded path, or one starting
+    // with a per-user variable such as %AppData%)
+    static bool isUserWritablePath(std::string_view path);
+
+    // Under the Windows or Program Files directories (expanded path)
+    static bool isSystemPath(std::string_view path);
+
+private:
+    std::vector<ServiceEntry> serviceEntries;
+    std::vector<AutorunEntry> autorunEntries;
+
+    void loadServices(const RegistryHive& system);
+    void loadAutoruns(const RegistryHive& software);
+};
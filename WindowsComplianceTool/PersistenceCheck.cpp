@@ -0,0 +1,116 @@
+#include "PersistenceCheck.h"
+#include "CsvReader.h"
+#include "Persistence.h"
+#include "PolicyTables.h"
+#include "RegistryProvider.h"
+
+ComplianceResult PersistenceCheck::performCheck() {
+    PersistenceInventory inventory;
+    
+    // Offline hives: stream the Services subtree and autorun keys straight from hive data
+    const RegistryHive* system = registryProvider ? registryProvider->hive("SYSTEM") : nullptr;
+    const RegistryHive* software = registryProvider ? registryProvider->hive("SOFTWARE") : nullptr;
+    if (system != nullptr || software != nullptr) {
+        inventory.loadFromHives(system, software);
+    } else {
+        CsvReader services;
+        executePowerShellCsv("Get-CimInstance Win32_Service | Select-Object Name, DisplayName, PathName, StartMode, StartName, ServiceType", services);
+        inventory.loadServicesCsv(services);
+        
+        // Run/RunOnce values, Winlogon Shell/Userinit and IFEO debuggers as Location/Name/Command rows
+        std::string psCommand = "& { foreach ($key in 'HKLM:\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Run', 'HKLM:\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\RunOnce', 'HKLM:\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Policies\\Explorer\\Run', 'HKLM:\\SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Run', 'HKLM:\\SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\RunOnce') { $item = Get-Item -Path $key -ErrorAction SilentlyContinue; if ($item) { foreach ($name in $item.GetValueNames()) { [pscustomobject]@{ Location = $key; Name = $name; Command = $item.GetValue($name) } } } }; $winlogon = Get-Item -Path 'HKLM:\\SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Winlogon' -ErrorAction SilentlyContinue; if ($winlogon) { foreach ($name in 'Shell', 'Userinit') { [pscustomobject]@{ Location = 'Winlogon'; Name = $name; Command = $winlogon.GetValue($name) } } }; foreach ($key in 'HKLM:\\SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Image File Execution Options', 'HKLM:\\SOFTWARE\\WOW6432Node\\Microsoft\\Windows NT\\CurrentVersion\\Image File Execution Options') { Get-ChildItem -Path $key -ErrorAction SilentlyContinue | ForEach-Object { $debugger = $_.GetValue('Debugger'); if ($debugger) { [pscustomobject]@{ Location = 'IFEO'; Name = $_.PSChildName; Command = $debugger } } } } }";
+        CsvReader autoruns;
+        executePowerShellCsv(psCommand, autoruns);
+        inventory.loadAutorunsCsv(autoruns);
+    }
+    
+    return evaluate(inventory);
+}
+
+ComplianceResult PersistenceCheck::evaluate(const PersistenceInventory& inventory) {
+    ComplianceResult result("Services and Autoruns",
+                           "Audits service image paths and autorun locations for hijackable or unexpected entries.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    std::vector<PersistenceFinding> findings = inventory.analyze();
+    
+    int unquoted = 0, writable = 0, hijacks = 0, unknown = 0;
+    int score = 100;
+    int unknownPenalty = 0;
+    bool critical = false;
+    for (const auto& finding : findings) {
+        switch (finding.kind) {
+        case PersistenceFinding::Kind::UnquotedServicePath:
+            unquoted++;
+            break;
+        case PersistenceFinding::Kind::WritableServiceBinary:
+        case PersistenceFinding::Kind::WritableAutorun:
+            writable++;
+            break;
+        case PersistenceFinding::Kind::DebuggerHijack:
+        case PersistenceFinding::Kind::WinlogonModified:
+            hijacks++;
+            break;
+        case PersistenceFinding::Kind::UnknownAutorun:
+            unknown++;
+            break;
+        }
+        
+        int penalty = 0;
+        if (finding.severity == Severity::Critical) {
+            penalty = 25;
+            critical = true;
+        } else if (finding.severity == Severity::High) {
+            penalty = 15;
+        } else if (finding.severity == Severity::Medium) {
+            penalty = 5;
+        } else {
+            unknownPenalty++;
+        }
+        score -= penalty;
+        result.attribution.add(finding.service ? inventory.services()[finding.entry].name
+                                               : inventory.autoruns()[finding.entry].name, penalty);
+    }
+    
+    // Unrecognized autoruns need review but are not proof of compromise; cap their weight
+    score -= (unknownPenalty > 10 ? 10 : unknownPenalty);
+    result.attribution.add("Unrecognized autoruns", unknownPenalty > 10 ? 10 : unknownPenalty);
+    if (score < 0) score = 0;
+    
+    result.findings.number(FindingKey::Services, static_cast<int64_t>(inventory.services().size()));
+    result.findings.number(FindingKey::AutorunEntries, static_cast<int64_t>(inventory.autoruns().size()));
+    result.findings.number(FindingKey::UnquotedServicePaths, unquoted);
+    result.findings.number(FindingKey::WritableBinaries, writable);
+    result.findings.number(FindingKey::DebuggerHijacks, hijacks);
+    result.findings.number(FindingKey::UnknownAutoruns, unknown);
+    
+    const size_t maxListed = 10;
+    for (size_t i = 0; i < findings.size() && i < maxListed; ++i) {
+        const PersistenceFinding& finding = findings[i];
+        const std::string& name = finding.service ? inventory.services()[finding.entry].name
+                                                  : inventory.autoruns()[finding.entry].name;
+        result.findings.item(FindingKey::PersistenceIssue, name, finding.reason, finding.severity);
+    }
+    if (findings.size() > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(findings.size() - maxListed));
+    }
+    result.score = score;
+    
+    if (inventory.services().empty() && inventory.autoruns().empty()) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "No services or autorun entries could be read. Verify the SYSTEM and SOFTWARE hives are accessible.";
+    } else {
+        const char* advice[] = {
+            unknown > 0
+                ? "No hijackable services or autoruns found. Review the autoruns outside the system directories."
+                : "Service paths and autorun locations are protected. System is compliant.",
+            "Quote service image paths containing spaces and move service and autorun binaries out of user-writable directories.",
+            "Services or autoruns can be hijacked by unprivileged users. Fix the listed paths and remove unexpected debugger and Winlogon entries immediately."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, critical)];
+    }
+    
+    return result;
+}
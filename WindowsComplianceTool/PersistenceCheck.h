@@ -0,0 +1,13 @@
+#pragma once
+#include "ComplianceCheck.h"
+
+class PersistenceInventory;
+
+class PersistenceCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Services and Autoruns"; }
+    
+    // Score unquoted and writable service paths and suspicious autoruns (no system access)
+    static ComplianceResult evaluate(const PersistenceInventory& inventory);
+};
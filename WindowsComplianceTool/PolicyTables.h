@@ -0,0 +1,399 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Built-in scoring policies as compile-time tables. Every table is checked
+// by static_assert where it is defined, so a malformed default profile
+// fails the build instead of producing odd scores, and nothing is parsed
+// at run time. Evaluation is instantiated per table (the table is a
+// template argument), so band lookups compile to a few comparisons.
+
+// Status, severity and advice for scores from minScore up to the band above
+struct ScoreBand {
+    int minScore;
+    CheckStatus status;
+    Severity severity;
+    const char* recommendation;     // nullptr: the check writes its own
+};
+
+// Score bands, highest first; the last band starts at 0
+template <size_t N>
+struct StatusPolicy {
+    ScoreBand bands[N];
+};
+
+// Fixed score for a count of enabled items, indexed by the count
+template <size_t N>
+struct ScoreLadder {
+    int scores[N];
+};
+
+// Points lost per item, at most cap in total, never below floor
+struct PenaltyRule {
+    int perItem;
+    int cap;
+    int floor;
+};
+
+// Weight of a module of each severity in the overall score
+struct SeverityWeights {
+    int low;
+    int medium;
+    int high;
+    int critical;
+};
+
+// Highest score a module reports at each severity
+struct SeverityCeilings {
+    int low;
+    int medium;
+    int high;
+    int critical;
+};
+
+namespace PolicyTables {
+
+constexpr bool isScore(int score) { return score >= 0 && score <= 100; }
+
+// Bands strictly descending, ending at 0, and severity never easing as
+// the score drops
+template <size_t N>
+constexpr bool isValid(const StatusPolicy<N>& policy) {
+    if (policy.bands[N - 1].minScore != 0) return false;
+    for (size_t i = 0; i < N; ++i) {
+        if (!isScore(policy.bands[i].minScore)) return false;
+        if (i > 0 && (policy.bands[i].minScore >= policy.bands[i - 1].minScore ||
+                      static_cast<int>(policy.bands[i].severity) < static_cast<int>(policy.bands[i - 1].severity))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Scores within 0..100, rising with the count and reaching 100
+template <size_t N>
+constexpr bool isValid(const ScoreLadder<N>& ladder) {
+    for (size_t i = 0; i < N; ++i) {
+        if (!isScore(ladder.scores[i])) return false;
+        if (i > 0 && ladder.scores[i] <= ladder.scores[i - 1]) return false;
+    }
+    return ladder.scores[N - 1] == 100;
+}
+
+constexpr bool isValid(const PenaltyRule& rule) {
+    return rule.perItem > 0 && rule.cap >= rule.perItem && isScore(rule.cap) && isScore(rule.floor);
+}
+
+constexpr bool isValid(const SeverityWeights& weights) {
+    return weights.low > 0 && weights.low <= weights.medium &&
+           weights.medium <= weights.high && weights.high <= weights.critical;
+}
+
+// Low reaches 100 (a passing module) and severity never rises with the
+// ceiling
+constexpr bool isValid(const SeverityCeilings& ceilings) {
+    return ceilings.low == 100 && isScore(ceilings.critical) && ceilings.critical <= ceilings.high &&
+           ceilings.high <= ceilings.medium && ceilings.medium <= ceilings.low;
+}
+
+// Index of the band a score falls in
+template <const auto& Policy>
+constexpr size_t bandIndex(int score) {
+    constexpr size_t count = sizeof(Policy.bands) / sizeof(Policy.bands[0]);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        if (score >= Policy.bands[i].minScore) return i;
+    }
+    return count - 1;
+}
+
+template <const auto& Policy>
+constexpr const ScoreBand& band(int score) { return Policy.bands[bandIndex<Policy>(score)]; }
+
+template <const auto& Ladder>
+constexpr int ladderScore(size_t count) {
+    constexpr size_t last = sizeof(Ladder.scores) / sizeof(Ladder.scores[0]) - 1;
+    return Ladder.scores[count < last ? count : last];
+}
+
+// Score after the penalty for count items; the floor only limits the
+// penalty, it never raises a score that was already lower
+template <const auto& Rule>
+constexpr int applyPenalty(int score, int count) {
+    if (count <= 0) return score;
+    int penalty = count >= Rule.cap / Rule.perItem ? Rule.cap : count * Rule.perItem;
+    int reduced = score - penalty;
+    if (reduced < Rule.floor) reduced = score < Rule.floor ? score : Rule.floor;
+    return reduced;
+}
+
+template <const auto& Weights>
+constexpr int weight(Severity severity) {
+    switch (severity) {
+        case Severity::Critical: return Weights.critical;
+        case Severity::High: return Weights.high;
+        case Severity::Medium: return Weights.medium;
+        default: return Weights.low;
+    }
+}
+
+// A module's weight in the overall score; a module that does not apply to
+// the host counts for nothing
+template <const auto& Weights>
+int weight(const ComplianceResult& result) {
+    return result.status == CheckStatus::NotApplicable ? 0 : weight<Weights>(result.severity);
+}
+
+// calculateOverallScore: module scores averaged by weight
+template <const auto& Weights>
+int overallScore(const std::vector<ComplianceResult>& results) {
+    int64_t weighted = 0;
+    int64_t total = 0;
+    for (const auto& result : results) {
+        int moduleWeight = weight<Weights>(result);
+        weighted += static_cast<int64_t>(result.score) * moduleWeight;
+        total += moduleWeight;
+    }
+    return total > 0 ? static_cast<int>(weighted / total) : 0;
+}
+
+// Severity of a score in its band; critical raises a failing score to
+// Critical
+template <const auto& Policy>
+constexpr Severity severity(int score, bool critical = false) {
+    const ScoreBand& entry = band<Policy>(score);
+    return critical && entry.status == CheckStatus::Fail ? Severity::Critical : entry.severity;
+}
+
+// Highest score the policy gives a severity (a failing band counts for
+// Critical, which critical raises it to), or -1 if it never does
+template <const auto& Policy>
+constexpr int highestScore(Severity severity) {
+    constexpr size_t count = sizeof(Policy.bands) / sizeof(Policy.bands[0]);
+    for (size_t i = 0; i < count; ++i) {
+        const ScoreBand& entry = Policy.bands[i];
+        if (entry.severity == severity || (severity == Severity::Critical && entry.status == CheckStatus::Fail)) {
+            return i == 0 ? 100 : Policy.bands[i - 1].minScore - 1;
+        }
+    }
+    return -1;
+}
+
+template <const auto& Ceilings>
+constexpr int ceiling(Severity severity) {
+    switch (severity) {
+        case Severity::Critical: return Ceilings.critical;
+        case Severity::High: return Ceilings.high;
+        case Severity::Medium: return Ceilings.medium;
+        default: return Ceilings.low;
+    }
+}
+
+// The scoring path every check shares: score, status, severity and the
+// band's recommendation if it has one. Returns the band index so checks
+// with their own advice can pick it per band.
+template <const auto& Policy>
+size_t applyScore(ComplianceResult& result, int score, bool critical = false) {
+    size_t index = bandIndex<Policy>(score);
+    const ScoreBand& entry = Policy.bands[index];
+    result.score = score;
+    result.status = entry.status;
+    result.severity = severity<Policy>(score, critical);
+    if (entry.recommendation != nullptr) result.recommendation = entry.recommendation;
+    return index;
+}
+
+} // namespace PolicyTables
+
+// Default profile
+
+// calculateOverallScore weights
+inline constexpr SeverityWeights ModuleWeights = { 1, 2, 3, 4 };
+static_assert(PolicyTables::isValid(ModuleWeights), "severity weights must be positive and rise with severity");
+
+// Status most checks derive from their score; they supply their own advice
+// for each band
+inline constexpr StatusPolicy<3> DefaultStatusPolicy = { {
+    { 90, CheckStatus::Pass, Severity::Low, nullptr },
+    { 70, CheckStatus::Warning, Severity::Medium, nullptr },
+    { 0, CheckStatus::Fail, Severity::High, nullptr }
+} };
+static_assert(PolicyTables::isValid(DefaultStatusPolicy), "default status bands are malformed");
+
+// Firewall: score by number of enabled profiles (Domain, Private, Public)
+inline constexpr ScoreLadder<4> FirewallProfileScores = { { 0, 33, 67, 100 } };
+static_assert(PolicyTables::isValid(FirewallProfileScores), "firewall ladder must rise to 100");
+
+inline constexpr StatusPolicy<4> FirewallStatusPolicy = { {
+    { 100, CheckStatus::Pass, Severity::Low,
+      "All firewall profiles are enabled. System is compliant." },
+    { 67, CheckStatus::Warning, Severity::Medium,
+      "One or more firewall profiles are disabled. Enable all profiles for maximum security." },
+    { 33, CheckStatus::Fail, Severity::High,
+      "Multiple firewall profiles are disabled. This poses a significant security risk. Enable all profiles immediately." },
+    { 0, CheckStatus::Fail, Severity::Critical,
+      "Windows Firewall is completely disabled. This is a critical security risk. Enable the firewall immediately." }
+} };
+static_assert(PolicyTables::isValid(FirewallStatusPolicy), "firewall status bands are malformed");
+static_assert(PolicyTables::band<FirewallStatusPolicy>(FirewallProfileScores.scores[3]).status == CheckStatus::Pass &&
+              PolicyTables::band<FirewallStatusPolicy>(FirewallProfileScores.scores[2]).status == CheckStatus::Warning &&
+              PolicyTables::band<FirewallStatusPolicy>(FirewallProfileScores.scores[1]).severity == Severity::High &&
+              PolicyTables::band<FirewallStatusPolicy>(FirewallProfileScores.scores[0]).severity == Severity::Critical,
+              "each firewall ladder step must land in its own band");
+
+// Windows Update: base score by configuration, less pending updates
+struct UpdateScores {
+    int automatic;                  // automatic updates on and the service running
+    int serviceOnly;                // service running, automatic install off
+    int stopped;
+};
+
+inline constexpr UpdateScores WindowsUpdateScores = { 100, 50, 0 };
+inline constexpr PenaltyRule PendingUpdatePenalty = { 2, 20, 70 };
+static_assert(PolicyTables::isValid(PendingUpdatePenalty), "pending update penalty is malformed");
+static_assert(WindowsUpdateScores.automatic == 100 && WindowsUpdateScores.serviceOnly < PendingUpdatePenalty.floor &&
+              WindowsUpdateScores.stopped < WindowsUpdateScores.serviceOnly,
+              "pending updates must never drop automatic updates to the service-only score");
+
+inline constexpr StatusPolicy<4> WindowsUpdateStatusPolicy = { {
+    { 90, CheckStatus::Pass, Severity::Low,
+      "Windows Update is properly configured. Consider installing pending updates if any." },
+    { 70, CheckStatus::Warning, Severity::Medium,
+      "Windows Update is enabled but has pending updates. Install updates to maintain security." },
+    { 50, CheckStatus::Warning, Severity::Medium,
+      "Windows Update service is running but automatic updates are not fully configured. Enable automatic installation of updates." },
+    { 0, CheckStatus::Fail, Severity::High,
+      "Windows Update is disabled or not functioning. Enable automatic updates immediately to ensure system security." }
+} };
+static_assert(PolicyTables::isValid(WindowsUpdateStatusPolicy), "Windows Update status bands are malformed");
+static_assert(PolicyTables::band<WindowsUpdateStatusPolicy>(PendingUpdatePenalty.floor).minScore == PendingUpdatePenalty.floor,
+              "the pending update floor must start a band");
+
+// Password policy: four settings worth 25 points each, 15 when partly
+// met. Three or more settings failing outright leave at most 25 points,
+// and two or fewer at least 30, so that split is a band of its own.
+inline constexpr StatusPolicy<4> PasswordStatusPolicy = { {
+    { 90, CheckStatus::Pass, Severity::Low,
+      "Password policy meets security standards. System is compliant." },
+    { 70, CheckStatus::Warning, Severity::Medium,
+      "Password policy needs improvement. Consider increasing minimum length to 8+ characters, enabling complexity, and setting appropriate age limits." },
+    { 30, CheckStatus::Fail, Severity::Medium,
+      "Password policy does not meet security standards. Configure minimum length (8+), enable complexity requirements, and set password expiration (max 90 days)." },
+    { 0, CheckStatus::Fail, Severity::High,
+      "Password policy does not meet security standards. Configure minimum length (8+), enable complexity requirements, and set password expiration (max 90 days)." }
+} };
+static_assert(PolicyTables::isValid(PasswordStatusPolicy), "password status bands are malformed");
+
+// Antivirus: score by how far the product gets (installed, enabled,
+// definitions up to date)
+inline constexpr ScoreLadder<4> AntivirusStageScores = { { 0, 40, 70, 100 } };
+static_assert(PolicyTables::isValid(AntivirusStageScores), "antivirus ladder must rise to 100");
+
+inline constexpr StatusPolicy<4> AntivirusStatusPolicy = { {
+    { 100, CheckStatus::Pass, Severity::Low,
+      "Antivirus is installed, enabled, and up-to-date. System is compliant." },
+    { 70, CheckStatus::Warning, Severity::Medium,
+      "Antivirus is installed and enabled but may not be up-to-date. Update your antivirus definitions." },
+    { 40, CheckStatus::Fail, Severity::High,
+      "Antivirus is installed but disabled. Enable your antivirus software immediately." },
+    { 0, CheckStatus::Fail, Severity::Critical,
+      "No antivirus software detected. Install and enable antivirus protection immediately." }
+} };
+static_assert(PolicyTables::isValid(AntivirusStatusPolicy), "antivirus status bands are malformed");
+static_assert(PolicyTables::bandIndex<AntivirusStatusPolicy>(AntivirusStageScores.scores[3]) == 0 &&
+              PolicyTables::bandIndex<AntivirusStatusPolicy>(AntivirusStageScores.scores[2]) == 1 &&
+              PolicyTables::bandIndex<AntivirusStatusPolicy>(AntivirusStageScores.scores[1]) == 2 &&
+              PolicyTables::bandIndex<AntivirusStatusPolicy>(AntivirusStageScores.scores[0]) == 3,
+              "each antivirus ladder step must land in its own band");
+
+// BitLocker: score by how much is encrypted (the system drive, then every
+// drive); banded by DefaultStatusPolicy
+inline constexpr ScoreLadder<3> BitLockerScores = { { 20, 70, 100 } };
+static_assert(PolicyTables::isValid(BitLockerScores), "BitLocker ladder must rise to 100");
+static_assert(PolicyTables::bandIndex<DefaultStatusPolicy>(BitLockerScores.scores[2]) == 0 &&
+              PolicyTables::bandIndex<DefaultStatusPolicy>(BitLockerScores.scores[1]) == 1 &&
+              PolicyTables::bandIndex<DefaultStatusPolicy>(BitLockerScores.scores[0]) == 2,
+              "each BitLocker ladder step must land in its own band");
+
+// System logging: 20 points for the EventLog service and 20 per audit
+// category. The check raises the 60 band to High when the Security log
+// was cleared, which caps the score at 80.
+inline constexpr StatusPolicy<4> SystemLoggingStatusPolicy = { {
+    { 90, CheckStatus::Pass, Severity::Low,
+      "Event logging is properly configured. System is compliant." },
+    { 60, CheckStatus::Warning, Severity::Medium,
+      "Event logging is partially configured. Enable all recommended audit policies for comprehensive security monitoring." },
+    { 20, CheckStatus::Warning, Severity::Medium,
+      "Event logging service is running but audit policies need improvement. Enable logon, object access, policy change, and account management auditing." },
+    { 0, CheckStatus::Fail, Severity::High,
+      "Event logging is not properly configured. Enable the Event Log service and configure audit policies for security monitoring." }
+} };
+static_assert(PolicyTables::isValid(SystemLoggingStatusPolicy), "system logging status bands are malformed");
+
+// Highest score any module reports at each severity, over the status
+// policies above (90 and up passes at Low everywhere; the firewall and
+// antivirus warn up to 99, a cleared Security log reports High up to 80).
+// Bounds the overall score while a scan is still running.
+inline constexpr SeverityCeilings ModuleScoreCeilings = { 100, 99, 89, 69 };
+static_assert(PolicyTables::isValid(ModuleScoreCeilings), "score ceilings are malformed");
+
+template <const auto& Policy>
+constexpr bool withinCeilings() {
+    for (Severity severity : { Severity::Low, Severity::Medium, Severity::High, Severity::Critical }) {
+        if (PolicyTables::highestScore<Policy>(severity) > PolicyTables::ceiling<ModuleScoreCeilings>(severity)) return false;
+    }
+    return true;
+}
+static_assert(withinCeilings<DefaultStatusPolicy>() && withinCeilings<FirewallStatusPolicy>() &&
+              withinCeilings<WindowsUpdateStatusPolicy>() && withinCeilings<PasswordStatusPolicy>() &&
+              withinCeilings<AntivirusStatusPolicy>() && withinCeilings<SystemLoggingStatusPolicy>(),
+              "a status policy scores a severity above its ceiling");
+
+// Quick scan: what a module is assumed to cost and how often it fails
+// before the scan history has measured it
+struct ModulePrior {
+    const char* module;
+    int costMs;
+    Severity severity;              // severity when it fails
+    int failurePercent;
+};
+
+namespace PolicyTables {
+
+constexpr bool isValid(const ModulePrior& prior) {
+    return prior.module != nullptr && prior.costMs > 0 && isScore(prior.failurePercent);
+}
+
+template <size_t N>
+constexpr bool isValid(const ModulePrior (&priors)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+        if (!isValid(priors[i])) return false;
+    }
+    return true;
+}
+
+} // namespace PolicyTables
+
+inline constexpr ModulePrior DefaultModulePrior = { "", 1000, Severity::Medium, 30 };
+
+inline constexpr ModulePrior QuickScanPriors[] = {
+    { "Firewall Status", 300, Severity::High, 20 },
+    { "Firewall Rule Analysis", 1500, Severity::High, 30 },
+    { "Antivirus Status", 800, Severity::Critical, 10 },
+    { "Password Policy Review", 500, Severity::Medium, 40 },
+    { "Windows Update Status", 5000, Severity::High, 40 },
+    { "User Account Review", 1000, Severity::High, 30 },
+    { "Disk Encryption (BitLocker)", 800, Severity::High, 50 },
+    { "System Logging Verification", 500, Severity::Medium, 30 },
+    { "Installed Software Audit", 3000, Severity::High, 40 },
+    { "Network Shares Check", 500, Severity::Medium, 20 },
+    { "Services and Autoruns", 1500, Severity::High, 20 },
+    { "Scheduled Tasks", 1500, Severity::Medium, 20 },
+    { "Binary Integrity", 20000, Severity::High, 10 },
+    { "Logon Anomaly Detection", 4000, Severity::High, 20 },
+    { "Security Baseline", 1500, Severity::High, 60 },
+    { "Policy Rules", 1500, Severity::High, 50 }
+};
+static_assert(PolicyTables::isValid(DefaultModulePrior) && PolicyTables::isValid(QuickScanPriors),
+              "quick scan priors need a positive cost and a failure rate within 0..100");
@@ -0,0 +1,454 @@
+#include "RegistryHive.h"
+#include "TextEncoding.h"
+#include <cstring>
+
+namespace {
+
+using BinaryRead::readU16;
+using BinaryRead::readU32;
+
+const uint32_t BaseBlockSize = 4096;
+const uint16_t KeyCompressedName = 0x0020;
+const uint16_t ValueCompressedName = 0x0001;
+const uint32_t DataInlineFlag = 0x80000000u;
+const uint32_t BigDataSegmentSize = 16344;
+
+// Smallest cells a key or value can occupy (size field plus fixed header),
+// used to bound counts read from the hive
+const uint32_t MinKeyCellSize = 4 + 0x4C;
+const uint32_t MinValueCellSize = 4 + 0x14;
+
+// Upper-case a UTF-16 code unit for ASCII and Latin-1 letters
+inline uint32_t upcase(uint32_t c) {
+    if (c >= 'a' && c <= 'z') return c - 32;
+    if (c >= 0xE0 && c <= 0xFE && c != 0xF7) return c - 32;
+    return c;
+}
+
+// Decode the next UTF-16 code unit from a UTF-8 query string.
+// Supplementary characters are returned as a surrogate pair via pending.
+uint32_t nextQueryUnit(std::string_view query, size_t& pos, uint32_t& pending) {
+    if (pending != 0) {
+        uint32_t unit = pending;
+        pending = 0;
+        return unit;
+    }
+
+    unsigned char c = static_cast<unsigned char>(query[pos++]);
+    if (c < 0x80) return c;
+
+    uint32_t cp = 0;
+    int extra = 0;
+    if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; extra = 1; }
+    else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; extra = 2; }
+    else { cp = c & 0x07; extra = 3; }
+
+    while (extra-- > 0 && pos < query.size()) {
+        cp = (cp << 6) | (static_cast<unsigned char>(query[pos++]) & 0x3F);
+    }
+
+    if (cp >= 0x10000) {
+        cp -= 0x10000;
+        pending = 0xDC00 + (cp & 0x3FF);
+        return 0xD800 + (cp >> 10);
+    }
+    return cp;
+}
+
+} // namespace
+
+bool RegistryHive::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+
+    base = file.bytes();
+    size = file.size();
+    if (!initialize()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool RegistryHive::openMemory(const void* data, size_t length) {
+    close();
+    base = static_cast<const unsigned char*>(data);
+    size = length;
+    if (!initialize()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RegistryHive::close() {
+    file.close();
+    base = nullptr;
+    size = 0;
+    rootKey = Key();
+    minorVersion = 0;
+}
+
+bool RegistryHive::initialize() {
+    if (base == nullptr || size < BaseBlockSize + 32) {
+        return false;
+    }
+
+    if (std::memcmp(base, "regf", 4) != 0 || std::memcmp(base + BaseBlockSize, "hbin", 4) != 0) {
+        return false;
+    }
+
+    minorVersion = readU32(base + 0x18);
+    rootKey = Key{ readU32(base + 0x24) };
+    return keyCell(rootKey) != nullptr;
+}
+
+const unsigned char* RegistryHive::cell(uint32_t offset, uint64_t minSize) const {
+    if (offset == 0 || offset == 0xFFFFFFFFu) {
+        return nullptr;
+    }
+
+    uint64_t start = static_cast<uint64_t>(BaseBlockSize) + offset;
+    if (minSize > size || start + 4 + minSize > size) {
+        return nullptr;
+    }
+
+    // Allocated cells have a negative size; negated in 64 bits, which is
+    // defined for INT32_MIN too
+    int64_t cellSize = static_cast<int32_t>(readU32(base + start));
+    if (cellSize >= 0 || static_cast<uint64_t>(-cellSize) < 4 + minSize) {
+        return nullptr;
+    }
+
+    return base + start + 4;
+}
+
+const unsigned char* RegistryHive::keyCell(Key key) const {
+    const unsigned char* nk = cell(key.cell, 0x4C);
+    if (nk == nullptr || nk[0] != 'n' || nk[1] != 'k') {
+        return nullptr;
+    }
+    if (cell(key.cell, 0x4C + readU16(nk + 0x48)) == nullptr) {
+        return nullptr;
+    }
+    return nk;
+}
+
+const unsigned char* RegistryHive::valueCell(Value value) const {
+    const unsigned char* vk = cell(value.cell, 0x14);
+    if (vk == nullptr || vk[0] != 'v' || vk[1] != 'k') {
+        return nullptr;
+    }
+    if (cell(value.cell, 0x14 + readU16(vk + 2)) == nullptr) {
+        return nullptr;
+    }
+    return vk;
+}
+
+int RegistryHive::compareName(const unsigned char* name, size_t length, bool compressed, std::string_view query) {
+    size_t units = compressed ? length : length / 2;
+    size_t pos = 0;
+    uint32_t pending = 0;
+
+    for (size_t i = 0; i < units; ++i) {
+        if (pos >= query.size() && pending == 0) {
+            return 1;
+        }
+
+        uint32_t a = compressed ? name[i] : static_cast<uint32_t>(readU16(name + i * 2));
+        uint32_t b = nextQueryUnit(query, pos, pending);
+
+        a = upcase(a);
+        b = upcase(b);
+        if (a != b) {
+            return a < b ? -1 : 1;
+        }
+    }
+
+    return (pos < query.size() || pending != 0) ? -1 : 0;
+}
+
+std::string RegistryHive::nameToUtf8(const unsigned char* name, size_t length, bool compressed) {
+    if (!compressed) {
+        return TextEncoding::utf16LEToUtf8(reinterpret_cast<const char*>(name), length);
+    }
+
+    // Compressed names are Latin-1
+    std::string out;
+    out.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = name[i];
+        if (c < 0x80) {
+            out += static_cast<char>(c);
+        } else {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
+
+int RegistryHive::compareKeyName(uint32_t keyOffset, std::string_view query) const {
+    const unsigned char* nk = keyCell(Key{ keyOffset });
+    if (nk == nullptr) {
+        return 1;
+    }
+    bool compressed = (readU16(nk + 2) & KeyCompressedName) != 0;
+    return compareName(nk + 0x4C, readU16(nk + 0x48), compressed, query);
+}
+
+RegistryHive::Key RegistryHive::searchList(uint32_t listOffset, std::string_view name, int depth) const {
+    const unsigned char* list = cell(listOffset, 4);
+    if (list == nullptr || depth > 2) {
+        return Key();
+    }
+
+    uint16_t count = readU16(list + 2);
+
+    // ri: list of lists, each covering an ordered range of names
+    if (list[0] == 'r' && list[1] == 'i') {
+        if (cell(listOffset, 4 + count * 4) == nullptr) return Key();
+        for (uint16_t i = 0; i < count; ++i) {
+            Key found = searchList(readU32(list + 4 + i * 4), name, depth + 1);
+            if (found) return found;
+        }
+        return Key();
+    }
+
+    uint32_t stride = (list[0] == 'l' && list[1] == 'i') ? 4 : 8;
+    bool indexed = (list[0] == 'l' && (list[1] == 'f' || list[1] == 'h' || list[1] == 'i'));
+    if (!indexed || cell(listOffset, 4 + count * stride) == nullptr) {
+        return Key();
+    }
+
+    // Entries are sorted by upper-cased name
+    int low = 0;
+    int high = static_cast<int>(count) - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        uint32_t offset = readU32(list + 4 + mid * stride);
+        int cmp = compareKeyName(offset, name);
+        if (cmp == 0) {
+            return Key{ offset };
+        }
+        if (cmp < 0) low = mid + 1;
+        else high = mid - 1;
+    }
+
+    return Key();
+}
+
+RegistryHive::Key RegistryHive::findSubkey(Key parent, std::string_view name) const {
+    const unsigned char* nk = keyCell(parent);
+    if (nk == nullptr || readU32(nk + 0x14) == 0) {
+        return Key();
+    }
+    return searchList(readU32(nk + 0x1C), name, 0);
+}
+
+RegistryHive::Key RegistryHive::findKey(Key parent, std::string_view path) const {
+    Key current = parent;
+    size_t pos = 0;
+
+    while (current && pos < path.size()) {
+        size_t end = path.find('\\', pos);
+        if (end == std::string_view::npos) end = path.size();
+
+        if (end > pos) {
+            current = findSubkey(current, path.substr(pos, end - pos));
+        }
+        pos = end + 1;
+    }
+
+    return current;
+}
+
+RegistryHive::Value RegistryHive::findValue(Key key, std::string_view name) const {
+    Value found;
+    forEachValue(key, [&](Value value) {
+        const unsigned char* vk = valueCell(value);
+        bool compressed = (readU16(vk + 0x10) & ValueCompressedName) != 0;
+        if (compareName(vk + 0x14, readU16(vk + 2), compressed, name) == 0) {
+            found = value;
+            return false;
+        }
+        return true;
+    });
+    return found;
+}
+
+uint32_t RegistryHive::subkeyCount(Key key) const {
+    const unsigned char* nk = keyCell(key);
+    if (nk == nullptr) return 0;
+    uint32_t count = readU32(nk + 0x14);
+    size_t limit = size / MinKeyCellSize;
+    return count < limit ? count : static_cast<uint32_t>(limit);
+}
+
+uint32_t RegistryHive::valueCount(Key key) const {
+    const unsigned char* nk = keyCell(key);
+    if (nk == nullptr) return 0;
+    // Each value also takes a 4-byte entry in the key's value list
+    uint32_t count = readU32(nk + 0x24);
+    size_t limit = size / (MinValueCellSize + 4);
+    return count < limit ? count : static_cast<uint32_t>(limit);
+}
+
+std::string RegistryHive::keyName(Key key) const {
+    const unsigned char* nk = keyCell(key);
+    if (nk == nullptr) return std::string();
+    bool compressed = (readU16(nk + 2) & KeyCompressedName) != 0;
+    return nameToUtf8(nk + 0x4C, readU16(nk + 0x48), compressed);
+}
+
+std::string RegistryHive::valueName(Value value) const {
+    const unsigned char* vk = valueCell(value);
+    if (vk == nullptr) return std::string();
+    bool compressed = (readU16(vk + 0x10) & ValueCompressedName) != 0;
+    return nameToUtf8(vk + 0x14, readU16(vk + 2), compressed);
+}
+
+bool RegistryHive::keyNameEquals(Key key, std::string_view name) const {
+    return compareKeyName(key.cell, name) == 0;
+}
+
+uint64_t RegistryHive::lastWriteTime(Key key) const {
+    const unsigned char* nk = keyCell(key);
+    if (nk == nullptr) return 0;
+    uint64_t value;
+    std::memcpy(&value, nk + 4, sizeof(value));
+    return value;
+}
+
+RegistryValueType RegistryHive::valueType(Value value) const {
+    const unsigned char* vk = valueCell(value);
+    return vk != nullptr ? static_cast<RegistryValueType>(readU32(vk + 0x0C)) : RegistryValueType::None;
+}
+
+std::string_view RegistryHive::valueData(Value value, std::string& scratch) const {
+    const unsigned char* vk = valueCell(value);
+    if (vk == nullptr) {
+        return std::string_view();
+    }
+
+    uint32_t dataSize = readU32(vk + 4);
+
+    // Up to 4 bytes are stored in the offset field itself
+    if (dataSize & DataInlineFlag) {
+        uint32_t length = dataSize & ~DataInlineFlag;
+        if (length > 4) length = 4;
+        return std::string_view(reinterpret_cast<const char*>(vk + 8), length);
+    }
+
+    uint32_t dataOffset = readU32(vk + 8);
+
+    // Hive version 1.4+ splits data larger than one segment into a "db" record
+    if (dataSize > BigDataSegmentSize && minorVersion >= 4) {
+        const unsigned char* db = cell(dataOffset, 8);
+        if (db != nullptr && db[0] == 'd' && db[1] == 'b') {
+            uint16_t segments = readU16(db + 2);
+            const unsigned char* list = cell(readU32(db + 4), segments * 4u);
+            if (list == nullptr) return std::string_view();
+
+            scratch.clear();
+            // The segments are cells in the file, so the data cannot exceed it
+            scratch.reserve(dataSize < size ? dataSize : size);
+            for (uint16_t i = 0; i < segments && scratch.size() < dataSize; ++i) {
+                uint32_t chunk = dataSize - static_cast<uint32_t>(scratch.size());
+                if (chunk > BigDataSegmentSize) chunk = BigDataSegmentSize;
+                const unsigned char* segment = cell(readU32(list + i * 4), chunk);
+                if (segment == nullptr) return std::string_view();
+                scratch.append(reinterpret_cast<const char*>(segment), chunk);
+            }
+            return scratch;
+        }
+    }
+
+    const unsigned char* data = cell(dataOffset, dataSize);
+    if (data == nullptr) {
+        return std::string_view();
+    }
+    return std::string_view(reinterpret_cast<const char*>(data), dataSize);
+}
+
+bool RegistryHive::valueDword(Value value, uint32_t& result) const {
+    std::string scratch;
+    std::string_view data = valueData(value, scratch);
+    RegistryValueType type = valueType(value);
+
+    if (data.size() < 4 || (type != RegistryValueType::Dword && type != RegistryValueType::DwordBigEndian)) {
+        return false;
+    }
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+    result = readU32(p);
+    if (type == RegistryValueType::DwordBigEndian) {
+        result = (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+    }
+    return true;
+}
+
+bool RegistryHive::valueQword(Value value, uint64_t& result) const {
+    std::string scratch;
+    std::string_view data = valueData(value, scratch);
+    if (data.size() < 8 || valueType(value) != RegistryValueType::Qword) {
+        return false;
+    }
+    std::memcpy(&result, data.data(), sizeof(result));
+    return true;
+}
+
+std::string RegistryHive::valueString(Value value) const {
+    std::string scratch;
+    return formatValue(valueType(value), valueData(value, scratch));
+}
+
+std::string RegistryHive::formatValue(RegistryValueType type, std::string_view data) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+
+    switch (type) {
+    case RegistryValueType::String:
+    case RegistryValueType::ExpandString: {
+        std::string text = TextEncoding::utf16LEToUtf8(data.data(), data.size());
+        size_t nul = text.find('\0');
+        if (nul != std::string::npos) text.resize(nul);
+        return text;
+    }
+    case RegistryValueType::Dword:
+        return data.size() >= 4 ? std::to_string(readU32(p)) : std::string();
+    case RegistryValueType::DwordBigEndian:
+        if (data.size() < 4) return std::string();
+        return std::to_string((static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]);
+    case RegistryValueType::Qword: {
+        if (data.size() < 8) return std::string();
+        uint64_t qword;
+        std::memcpy(&qword, p, sizeof(qword));
+        return std::to_string(qword);
+    }
+    default:
+        return std::string();
+    }
+}
+
+std::vector<std::string> RegistryHive::valueMultiString(Value value) const {
+    std::vector<std::string> strings;
+    if (valueType(value) != RegistryValueType::MultiString) {
+        return strings;
+    }
+
+    std::string scratch;
+    std::string_view data = valueData(value, scratch);
+    std::string text = TextEncoding::utf16LEToUtf8(data.data(), data.size());
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t nul = text.find('\0', pos);
+        if (nul == std::string::npos) nul = text.size();
+        if (nul == pos) break;
+        strings.push_back(text.substr(pos, nul - pos));
+        pos = nul + 1;
+    }
+    return strings;
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include "BinaryRead.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Registry value data types (REG_* values, named to avoid the windows.h macros)
+enum class RegistryValueType : uint32_t {
+    None = 0,
+    String = 1,
+    ExpandString = 2,
+    Binary = 3,
+    Dword = 4,
+    DwordBigEndian = 5,
+    Link = 6,
+    MultiString = 7,
+    Qword = 11
+};
+
+// Reader for offline registry hive files (regf format: SOFTWARE, SYSTEM,
+// SAM, SECURITY, NTUSER.DAT). The hive is memory-mapped and every key and
+// value is addressed by its cell offset, so lookups never copy key data.
+// Subkey lookups binary-search the sorted lf/lh/li index lists (and walk
+// ri lists of lists) instead of scanning every child.
+//
+// Transaction logs (.LOG1/.LOG2) are not replayed; capture hives with
+// `reg save` or from a clean shutdown.
+class RegistryHive {
+public:
+    struct Key {
+        uint32_t cell = 0;
+        explicit operator bool() const { return cell != 0; }
+    };
+
+    struct Value {
+        uint32_t cell = 0;
+        explicit operator bool() const { return cell != 0; }
+    };
+
+    // Map a hive file
+    bool open(const std::string& path);
+
+    // Use a hive image already in memory; the caller keeps it alive
+    bool openMemory(const void* data, size_t size);
+
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    Key root() const { return rootKey; }
+
+    // Backslash-separated path relative to the hive root (case-insensitive)
+    Key findKey(std::string_view path) const { return findKey(rootKey, path); }
+    Key findKey(Key parent, std::string_view path) const;
+
+    // Direct child lookup through the subkey index
+    Key findSubkey(Key parent, std::string_view name) const;
+
+    // Value lookup by name; an empty name is the key's default value
+    Value findValue(Key key, std::string_view name) const;
+
+    // Counts from the key cell, capped at what the mapped hive could hold
+    // so callers can size containers from them
+    uint32_t subkeyCount(Key key) const;
+    uint32_t valueCount(Key key) const;
+
+    // Visit every child key in index order; return false from fn to stop
+    template <typename Fn>
+    void forEachSubkey(Key key, Fn&& fn) const {
+        const unsigned char* nk = keyCell(key);
+        if (nk == nullptr || BinaryRead::readU32(nk + 0x14) == 0) return;
+        visitSubkeyList(BinaryRead::readU32(nk + 0x1C), fn, 0);
+    }
+
+    // Visit every value of a key; return false from fn to stop
+    template <typename Fn>
+    void forEachValue(Key key, Fn&& fn) const {
+        const unsigned char* nk = keyCell(key);
+        if (nk == nullptr) return;
+        // The count comes from the hive; sized in 64 bits so it cannot wrap
+        uint32_t count = BinaryRead::readU32(nk + 0x24);
+        const unsigned char* list = cell(BinaryRead::readU32(nk + 0x28), static_cast<uint64_t>(count) * 4);
+        if (list == nullptr) return;
+        for (uint32_t i = 0; i < count; ++i) {
+            Value value{ BinaryRead::readU32(list + static_cast<size_t>(i) * 4) };
+            if (valueCell(value) != nullptr && !fn(value)) return;
+        }
+    }
+
+    // Names converted to UTF-8
+    std::string keyName(Key key) const;
+    std::string valueName(Value value) const;
+
+    // Case-insensitive name comparison without conversion
+    bool keyNameEquals(Key key, std::string_view name) const;
+
+    // Key last write time (FILETIME, 100ns ticks since 1601)
+    uint64_t lastWriteTime(Key key) const;
+
+    RegistryValueType valueType(Value value) const;
+
+    // Raw value bytes. Points into the mapped hive except for big-data
+    // values (> 16 KB), which are assembled into scratch.
+    std::string_view valueData(Value value, std::string& scratch) const;
+
+    bool valueDword(Value value, uint32_t& result) const;
+    bool valueQword(Value value, uint64_t& result) const;
+
+    // String form matching ComplianceCheck::readRegistryValue:
+    // REG_SZ / REG_EXPAND_SZ as UTF-8, REG_DWORD / REG_QWORD as decimal
+    std::string valueString(Value value) const;
+
+    // Same conversion for value data from another source (e.g. Registry.pol)
+    static std::string formatValue(RegistryValueType type, std::string_view data);
+
+    std::vector<std::string> valueMultiString(Value value) const;
+
+private:
+    MappedFile file;
+    const unsigned char* base = nullptr;   // start of the file image
+    size_t size = 0;
+    Key rootKey;
+    uint32_t minorVersion = 0;
+
+    bool initialize();
+
+    // Cell data (after the size field) if at least minSize bytes are in bounds
+    const unsigned char* cell(uint32_t offset, uint64_t minSize) const;
+    const unsigned char* keyCell(Key key) const;
+    const unsigned char* valueCell(Value value) const;
+
+    // Compare a stored name against a UTF-8 query the way the registry
+    // orders subkeys (upper-cased UTF-16 code units)
+    static int compareName(const unsigned char* name, size_t length, bool compressed, std::string_view query);
+    static std::string nameToUtf8(const unsigned char* name, size_t length, bool compressed);
+
+    int compareKeyName(uint32_t keyOffset, std::string_view query) const;
+    Key searchList(uint32_t listOffset, std::string_view name, int depth) const;
+
+    template <typename Fn>
+    bool visitSubkeyList(uint32_t listOffset, Fn& fn, int depth) const {
+        const unsigned char* list = cell(listOffset, 4);
+        if (list == nullptr || depth > 2) return true;
+
+        uint16_t count = BinaryRead::readU16(list + 2);
+        bool indexRoot = list[0] == 'r' && list[1] == 'i';
+        bool offsetsOnly = indexRoot || (list[0] == 'l' && list[1] == 'i');
+        uint32_t stride = offsetsOnly ? 4 : 8;
+        if (cell(listOffset, 4 + count * stride) == nullptr) return true;
+
+        for (uint16_t i = 0; i < count; ++i) {
+            uint32_t offset = BinaryRead::readU32(list + 4 + i * stride);
+            if (indexRoot) {
+                if (!visitSubkeyList(offset, fn, depth + 1)) return false;
+            } else if (keyCell(Key{ offset }) != nullptr) {
+                if (!fn(Key{ offset })) return false;
+            }
+        }
+        return true;
+    }
+};
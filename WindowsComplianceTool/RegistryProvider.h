@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class RegistryHive;
+
+// Source of registry data for the compliance checks. Checks without a
+// provider read the live registry; OfflineRegistry answers the same
+// questions from hive files captured on another machine.
+class RegistryProvider {
+public:
+    virtual ~RegistryProvider() = default;
+
+    // Same contract as ComplianceCheck::readRegistryValue: REG_SZ / REG_EXPAND_SZ
+    // as text, REG_DWORD as decimal, empty string if missing
+    virtual std::string readValue(const std::string& keyPath, const std::string& valueName) const = 0;
+
+    virtual bool valueExists(const std::string& keyPath, const std::string& valueName) const = 0;
+
+    // Child key names of keyPath; false if the key does not exist
+    virtual bool enumerateSubkeys(const std::string& keyPath, std::vector<std::string>& names) const = 0;
+
+    // Value names of keyPath; false if the key does not exist
+    virtual bool enumerateValues(const std::string& keyPath, std::vector<std::string>& names) const = 0;
+
+    // Every value of keyPath as (name, text) pairs formatted like readValue;
+    // false if the key does not exist. The default reads them one by one.
+    virtual bool readValues(const std::string& keyPath, std::vector<std::pair<std::string, std::string>>& values) const {
+        std::vector<std::string> names;
+        if (!enumerateValues(keyPath, names)) return false;
+        for (auto& name : names) {
+            std::string value = readValue(keyPath, name);
+            values.emplace_back(std::move(name), std::move(value));
+        }
+        return true;
+    }
+
+    // Mounted hive ("SAM", "SECURITY", ...) for binary records the text
+    // interface cannot express; nullptr when reading the live registry
+    virtual const RegistryHive* hive(std::string_view /*mountName*/) const { return nullptr; }
+};
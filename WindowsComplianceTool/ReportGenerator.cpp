@@ -3,7 +3,7 @@
 #include <iomanip>
 #include <algorithm>
 
-std::string ReportGenerator::escapeJSON(const std::string& str) {
+std::string ReportGenerator::escapeJSON(std::string_view str) {
     std::string escaped;
     for (char c : str) {
         switch (c) {
@@ -53,6 +53,59 @@ bool ReportGenerator::generateTextReport(const ComplianceEngine& engine, const s
     
     file << "Overall Compliance Score: " << engine.getOverallComplianceScore() << "%\n\n";
     
+    const QuickScanSummary& quickScan = engine.getQuickScanSummary();
+    if (quickScan.performed) {
+        file << "Quick Scan: " << engine.getResults().size() << " modules in " << quickScan.elapsedMs
+             << " ms (budget " << quickScan.budgetMs << " ms), risk coverage "
+             << static_cast<int>(quickScan.coverage * 100 + 0.5) << "%\n";
+        if (!quickScan.skipped.empty()) {
+            file << "Skipped:";
+            for (size_t i = 0; i < quickScan.skipped.size(); ++i) {
+                file << (i == 0 ? " " : ", ") << quickScan.skipped[i];
+            }
+            file << "\n";
+        }
+        file << "\n";
+    }
+    
+    if (engine.wasStoppedEarly()) {
+        const ProvisionalScore& provisional = engine.getProvisionalScore();
+        file << "Stopped Early: " << provisional.completed << " modules run, " << provisional.pending
+             << " not run; final score between " << provisional.lower << "% and " << provisional.upper << "%\n\n";
+    }
+    
+    std::vector<ScoreLoss> losses = engine.getTopContributors(10);
+    if (!losses.empty()) {
+        file << "Largest Score Losses:\n";
+        file << "----------------------------------------\n";
+        for (const auto& loss : losses) {
+            const ComplianceResult& result = engine.getResults()[loss.result];
+            file << "  -" << std::fixed << std::setprecision(1) << loss.points << "  " << result.moduleName;
+            if (!loss.setting.empty()) file << ": " << loss.setting;
+            file << "\n";
+        }
+        file << "\n";
+    }
+    
+    const FrameworkMap* frameworks = engine.getFrameworkMap();
+    if (frameworks && !engine.getFrameworkScores().empty()) {
+        file << "Framework Scores:\n";
+        file << "----------------------------------------\n";
+        const auto& requirements = engine.getRequirementOutcomes();
+        for (const auto& framework : engine.getFrameworkScores()) {
+            file << frameworks->frameworks()[framework.framework] << ": " << framework.score << "% ("
+                 << framework.passed << " of " << framework.assessed << " assessed requirements met, "
+                 << (framework.requirements - framework.assessed) << " not assessed)\n";
+            for (size_t i = 0; i < requirements.size(); ++i) {
+                const FrameworkRequirement& requirement = frameworks->requirements()[i];
+                if (requirement.framework != framework.framework || !requirements[i].assessed() || requirements[i].passed()) continue;
+                file << "  " << requirement.id << " " << requirement.title << ": " << requirements[i].score << "% ("
+                     << requirements[i].failed << " of " << requirements[i].controls << " controls failed)\n";
+            }
+        }
+        file << "\n";
+    }
+    
     const auto& results = engine.getResults();
     
     file << "Module Results:\n";
@@ -66,11 +119,9 @@ bool ReportGenerator::generateTextReport(const ComplianceEngine& engine, const s
         file << "Description: " << result.description << "\n";
         file << "Recommendation: " << result.recommendation << "\n";
         
-        if (!result.details.empty()) {
+        if (!result.findings.empty()) {
             file << "Details:\n";
-            for (const auto& detail : result.details) {
-                file << "  " << detail << "\n";
-            }
+            result.findings.render(file, "  ");
         }
         file << "\n";
     }
@@ -88,6 +139,70 @@ bool ReportGenerator::generateJSONReport(const ComplianceEngine& engine, const s
     file << "{\n";
     file << "  \"reportVersion\": \"2.0\",\n";
     file << "  \"overallScore\": " << engine.getOverallComplianceScore() << ",\n";
+    
+    const QuickScanSummary& quickScan = engine.getQuickScanSummary();
+    if (quickScan.performed) {
+        file << "  \"quickScan\": {\n";
+        file << "    \"budgetMs\": " << quickScan.budgetMs << ",\n";
+        file << "    \"estimatedMs\": " << quickScan.estimatedMs << ",\n";
+        file << "    \"elapsedMs\": " << quickScan.elapsedMs << ",\n";
+        file << "    \"coverage\": " << static_cast<int>(quickScan.coverage * 100 + 0.5) << ",\n";
+        file << "    \"skipped\": [";
+        for (size_t i = 0; i < quickScan.skipped.size(); ++i) {
+            file << (i == 0 ? "" : ", ") << "\"" << escapeJSON(quickScan.skipped[i]) << "\"";
+        }
+        file << "]\n";
+        file << "  },\n";
+    }
+    
+    if (engine.wasStoppedEarly()) {
+        const ProvisionalScore& provisional = engine.getProvisionalScore();
+        file << "  \"stoppedEarly\": {\n";
+        file << "    \"completed\": " << provisional.completed << ",\n";
+        file << "    \"pending\": " << provisional.pending << ",\n";
+        file << "    \"lowerBound\": " << provisional.lower << ",\n";
+        file << "    \"upperBound\": " << provisional.upper << "\n";
+        file << "  },\n";
+    }
+    
+    std::vector<ScoreLoss> losses = engine.getTopContributors(10);
+    file << "  \"scoreLosses\": [";
+    for (size_t i = 0; i < losses.size(); ++i) {
+        file << (i == 0 ? "\n" : ",\n") << "    { \"module\": \"" << escapeJSON(engine.getResults()[losses[i].result].moduleName)
+             << "\", \"setting\": \"" << escapeJSON(losses[i].setting) << "\", \"points\": "
+             << std::fixed << std::setprecision(2) << losses[i].points << " }";
+    }
+    file << (losses.empty() ? "],\n" : "\n  ],\n");
+    
+    const FrameworkMap* frameworks = engine.getFrameworkMap();
+    const auto& frameworkScores = engine.getFrameworkScores();
+    if (frameworks && !frameworkScores.empty()) {
+        const auto& requirements = engine.getRequirementOutcomes();
+        file << "  \"frameworks\": [\n";
+        for (size_t i = 0; i < frameworkScores.size(); ++i) {
+            const auto& framework = frameworkScores[i];
+            file << "    {\n";
+            file << "      \"name\": \"" << escapeJSON(frameworks->frameworks()[framework.framework]) << "\",\n";
+            file << "      \"score\": " << framework.score << ",\n";
+            file << "      \"requirements\": " << framework.requirements << ",\n";
+            file << "      \"assessed\": " << framework.assessed << ",\n";
+            file << "      \"passed\": " << framework.passed << ",\n";
+            file << "      \"failedRequirements\": [";
+            bool first = true;
+            for (size_t j = 0; j < requirements.size(); ++j) {
+                const FrameworkRequirement& requirement = frameworks->requirements()[j];
+                if (requirement.framework != framework.framework || !requirements[j].assessed() || requirements[j].passed()) continue;
+                file << (first ? "" : ", ") << "\"" << escapeJSON(requirement.id) << "\"";
+                first = false;
+            }
+            file << "]\n";
+            file << "    }";
+            if (i < frameworkScores.size() - 1) file << ",";
+            file << "\n";
+        }
+        file << "  ],\n";
+    }
+    
     file << "  \"modules\": [\n";
     
     const auto& results = engine.getResults();
@@ -101,11 +216,49 @@ bool ReportGenerator::generateJSONReport(const ComplianceEngine& engine, const s
         file << "      \"severity\": \"" << severityToString(result.severity) << "\",\n";
         file << "      \"score\": " << result.score << ",\n";
         file << "      \"recommendation\": \"" << escapeJSON(result.recommendation) << "\",\n";
+        file << "      \"attribution\": [";
+        for (size_t j = 0; j < result.attribution.size(); ++j) {
+            file << (j == 0 ? "" : ", ") << "{ \"setting\": \"" << escapeJSON(result.attribution[j].setting)
+                 << "\", \"points\": " << std::fixed << std::setprecision(2) << result.attribution[j].points << " }";
+        }
+        file << "],\n";
+        file << "      \"findings\": [\n";
+        
+        for (size_t j = 0; j < result.findings.size(); ++j) {
+            const Finding& finding = result.findings[j];
+            file << "        { \"key\": \"" << Findings::name(finding.key) << "\"";
+            switch (Findings::format(finding.key)) {
+                case FindingFormat::Text:
+                    file << ", \"text\": \"" << escapeJSON(result.findings.textOf(finding)) << "\"";
+                    break;
+                case FindingFormat::Item:
+                    file << ", \"name\": \"" << escapeJSON(result.findings.textOf(finding))
+                         << "\", \"reason\": \"" << escapeJSON(result.findings.reasonOf(finding))
+                         << "\", \"severity\": \"" << severityToString(finding.severity) << "\"";
+                    break;
+                case FindingFormat::Message:
+                    break;
+                case FindingFormat::YesNo:
+                case FindingFormat::EnabledDisabled:
+                case FindingFormat::RunningStopped:
+                    file << ", \"value\": " << (finding.value ? "true" : "false");
+                    break;
+                default:
+                    file << ", \"value\": " << finding.value;
+                    break;
+            }
+            file << " }";
+            if (j < result.findings.size() - 1) file << ",";
+            file << "\n";
+        }
+        
+        file << "      ],\n";
         file << "      \"details\": [\n";
         
-        for (size_t j = 0; j < result.details.size(); ++j) {
-            file << "        \"" << escapeJSON(result.details[j]) << "\"";
-            if (j < result.details.size() - 1) file << ",";
+        std::vector<std::string> details = result.findings.renderLines();
+        for (size_t j = 0; j < details.size(); ++j) {
+            file << "        \"" << escapeJSON(details[j]) << "\"";
+            if (j < details.size() - 1) file << ",";
             file << "\n";
         }
         
@@ -217,11 +370,9 @@ bool ReportGenerator::generateDetailedTextReport(const ComplianceEngine& engine,
         file << "Description: " << result.description << "\n";
         file << "Recommendation: " << result.recommendation << "\n";
         
-        if (!result.details.empty()) {
+        if (!result.findings.empty()) {
             file << "Details:\n";
-            for (const auto& detail : result.details) {
-                file << "  " << detail << "\n";
-            }
+            result.findings.render(file, "  ");
         }
         file << "\n";
     }
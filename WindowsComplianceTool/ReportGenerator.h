@@ -2,6 +2,7 @@
 #include "ComplianceResult.h"
 #include "ComplianceEngine.h"
 #include <string>
+#include <string_view>
 #include <fstream>
 
 class ReportGenerator {
@@ -16,7 +17,7 @@ public:
     static bool generateDetailedTextReport(const ComplianceEngine& engine, const std::string& filename);
 
 private:
-    static std::string escapeJSON(const std::string& str);
+    static std::string escapeJSON(std::string_view str);
     static std::string statusToString(CheckStatus status);
     static std::string severityToString(Severity severity);
 };
@@ -0,0 +1,12 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Revision numbers for loaded definitions, unique across the process. A
+// definition takes a new one whenever its contents change, so work cached
+// against it is redone even when a replacement sits at the same address.
+// 0 is never issued; it stands for a definition that was never filled.
+inline uint64_t nextRevision() {
+    static std::atomic<uint64_t> counter{ 0 };
+    return ++counter;
+}
@@ -0,0 +1,903 @@
+#include "RulePack.h"
+#include "FactTable.h"
+#include "PolicyTables.h"
+#include "Revision.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+using TextUtil::containsIgnoreCase;
+using TextUtil::equalsIgnoreCase;
+using TextUtil::startsWithIgnoreCase;
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+bool isNameStart(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+const std::string_view SecurityPolicyPrefix = "SecurityPolicy\\";
+
+bool isSecurityPolicy(std::string_view name) {
+    return startsWithIgnoreCase(name, SecurityPolicyPrefix);
+}
+
+enum class TokenKind { Number, Name, Text, Fact, Symbol };
+
+struct Token {
+    TokenKind kind;
+    std::string_view text;
+    int64_t number;
+};
+
+// Split one line into tokens; '#' starts a comment outside text and fact names
+bool tokenize(std::string_view line, std::vector<Token>& tokens, std::string& error) {
+    tokens.clear();
+    size_t i = 0;
+    while (i < line.size()) {
+        char c = line[i];
+        if (isSpace(c)) {
+            ++i;
+        } else if (c == '#') {
+            break;
+        } else if (isDigit(c)) {
+            size_t start = i;
+            int64_t value = 0;
+            while (i < line.size() && isDigit(line[i])) {
+                if (value > 100000000000000000) {
+                    error = "number too large";
+                    return false;
+                }
+                value = value * 10 + (line[i++] - '0');
+            }
+            tokens.push_back({ TokenKind::Number, line.substr(start, i - start), value });
+        } else if (isNameStart(c)) {
+            size_t start = i;
+            while (i < line.size() && (isNameStart(line[i]) || isDigit(line[i]))) ++i;
+            tokens.push_back({ TokenKind::Name, line.substr(start, i - start), 0 });
+        } else if (c == '"' || c == '[') {
+            char close = c == '"' ? '"' : ']';
+            size_t end = line.find(close, i + 1);
+            if (end == std::string_view::npos) {
+                error = c == '"' ? "unterminated text" : "unterminated fact name";
+                return false;
+            }
+            tokens.push_back({ c == '"' ? TokenKind::Text : TokenKind::Fact, line.substr(i + 1, end - i - 1), 0 });
+            i = end + 1;
+        } else {
+            static const char* const Symbols[] = { "==", "!=", "<=", ">=", "+=", "-=", "??", "<", ">", "=", "+", "-", "*", "/", "(", ")", "," };
+            bool matched = false;
+            for (const char* symbol : Symbols) {
+                std::string_view candidate(symbol);
+                if (line.compare(i, candidate.size(), candidate) == 0) {
+                    tokens.push_back({ TokenKind::Symbol, line.substr(i, candidate.size()), 0 });
+                    i += candidate.size();
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) {
+                error = std::string("unexpected character '") + c + "'";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool parseStatus(std::string_view text, CheckStatus& status) {
+    if (equalsIgnoreCase(text, "Pass")) status = CheckStatus::Pass;
+    else if (equalsIgnoreCase(text, "Warning")) status = CheckStatus::Warning;
+    else if (equalsIgnoreCase(text, "Fail")) status = CheckStatus::Fail;
+    else return false;
+    return true;
+}
+
+bool parseSeverity(std::string_view text, Severity& severity) {
+    if (equalsIgnoreCase(text, "Low")) severity = Severity::Low;
+    else if (equalsIgnoreCase(text, "Medium")) severity = Severity::Medium;
+    else if (equalsIgnoreCase(text, "High")) severity = Severity::High;
+    else if (equalsIgnoreCase(text, "Critical")) severity = Severity::Critical;
+    else return false;
+    return true;
+}
+
+bool isKeyword(std::string_view name) {
+    static const char* const Keywords[] = { "rule", "end", "let", "score", "raise", "band", "when", "and", "or", "not",
+                                            "if", "min", "max", "count", "exists", "contains", "true", "false" };
+    for (const char* keyword : Keywords) {
+        if (name == keyword) return true;
+    }
+    return false;
+}
+
+// Interpreter values: a number, or unknown when a fact is missing or not numeric
+struct Value {
+    int64_t number;
+    bool known;
+};
+
+// Fact values are at most 18 digits; arithmetic stays within that range or
+// becomes unknown, so nothing overflows
+const int64_t ValueLimit = 1000000000000000000;
+
+inline bool truthy(const Value& value) { return value.known && value.number != 0; }
+
+inline Value bounded(int64_t number, bool known) {
+    if (number > ValueLimit || number < -ValueLimit) return { 0, false };
+    return { number, known };
+}
+
+} // namespace
+
+// Recursive-descent compiler from rule text to RulePack bytecode
+class RuleCompiler {
+public:
+    explicit RuleCompiler(RulePack& target) : pack(target) {}
+
+    bool compile(std::string_view source);
+    const std::string& error() const { return errorText; }
+
+private:
+    RulePack& pack;
+    std::vector<Token> tokens;
+    size_t pos = 0, limit = 0;
+    std::vector<std::string> locals;
+    uint32_t depth = 0, maxDepth = 0;
+    std::string errorText;
+
+    bool fail(const std::string& message) {
+        if (errorText.empty()) errorText = message;
+        return false;
+    }
+
+    bool atEnd() const { return pos >= limit; }
+    bool peekSymbol(std::string_view symbol) const {
+        return !atEnd() && tokens[pos].kind == TokenKind::Symbol && tokens[pos].text == symbol;
+    }
+    bool peekName(std::string_view name) const {
+        return !atEnd() && tokens[pos].kind == TokenKind::Name && tokens[pos].text == name;
+    }
+    bool expectSymbol(std::string_view symbol) {
+        if (!peekSymbol(symbol)) return fail("expected '" + std::string(symbol) + "'");
+        ++pos;
+        return true;
+    }
+
+    uint32_t emit(RuleOp op, int32_t operand = 0, uint16_t aux = 0);
+    bool fuse(RuleOp fused);
+    void emitComparison(RuleOp op);
+    void patch(uint32_t jump) { pack.program[jump].operand = static_cast<int32_t>(pack.program.size()); }
+    uint32_t factSlot(std::string_view name);
+
+    bool statement(PolicyRule& rule);
+    bool expressionRange(size_t begin, size_t end);
+    bool condition(size_t whenPos);
+    bool finishRule(PolicyRule& rule);
+
+    bool parseOr();
+    bool parseAnd();
+    bool parseNot();
+    bool parseComparison();
+    bool parseSum();
+    bool parseTerm();
+    bool parseUnary();
+    bool parseCoalesce();
+    bool parsePrimary();
+    bool parseCall(std::string_view function);
+};
+
+uint32_t RuleCompiler::emit(RuleOp op, int32_t operand, uint16_t aux) {
+    int delta = 0;
+    switch (op) {
+        case RuleOp::PushInt: case RuleOp::PushFact: case RuleOp::FactExists: case RuleOp::TextEqual:
+        case RuleOp::TextContains: case RuleOp::LoadLocal: case RuleOp::LoadScore:
+            delta = 1;
+            break;
+        case RuleOp::PushFactOr:
+        case RuleOp::FactEqual: case RuleOp::FactNotEqual: case RuleOp::FactLess: case RuleOp::FactLessEqual:
+        case RuleOp::FactGreater: case RuleOp::FactGreaterEqual:
+            delta = 1;
+            break;
+        case RuleOp::Negate: case RuleOp::Not: case RuleOp::Raise:
+            delta = 0;
+            break;
+        case RuleOp::Select:
+            delta = -2;
+            break;
+        case RuleOp::Count:
+            delta = 1 - operand;
+            break;
+        default:
+            delta = -1;
+            break;
+    }
+    depth = static_cast<uint32_t>(static_cast<int>(depth) + delta);
+    if (depth > maxDepth) maxDepth = depth;
+    pack.program.push_back({ op, aux, operand });
+    return static_cast<uint32_t>(pack.program.size() - 1);
+}
+
+// [fact] <op> <integer> becomes one instruction; a bare fact is the only
+// left operand whose code ends in PushFact
+bool RuleCompiler::fuse(RuleOp fused) {
+    size_t size = pack.program.size();
+    if (size < 2 || pack.program[size - 2].op != RuleOp::PushFact || pack.program[size - 1].op != RuleOp::PushInt ||
+        pack.program[size - 2].operand > 0xFFFF) {
+        return false;
+    }
+    uint16_t slot = static_cast<uint16_t>(pack.program[size - 2].operand);
+    int32_t constant = pack.program[size - 1].operand;
+    pack.program.resize(size - 2);
+    depth -= 2;
+    emit(fused, constant, slot);
+    return true;
+}
+
+void RuleCompiler::emitComparison(RuleOp op) {
+    RuleOp fused = static_cast<RuleOp>(static_cast<int>(RuleOp::FactEqual) + (static_cast<int>(op) - static_cast<int>(RuleOp::Equal)));
+    if (!fuse(fused)) emit(op);
+}
+
+uint32_t RuleCompiler::factSlot(std::string_view name) {
+    std::string canonical = isSecurityPolicy(name) ? std::string(name) : FactTable::canonicalKeyPath(name);
+    uint32_t hash = FactTable::hashName(canonical);
+    auto range = pack.factSlots.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (equalsIgnoreCase(pack.facts[it->second], canonical)) return it->second;
+    }
+    uint32_t slot = static_cast<uint32_t>(pack.facts.size());
+    pack.facts.push_back(std::move(canonical));
+    pack.factHashes.push_back(hash);
+    pack.factSlots.emplace(hash, slot);
+    return slot;
+}
+
+bool RuleCompiler::parseOr() {
+    if (!parseAnd()) return false;
+    while (peekName("or")) {
+        ++pos;
+        if (!parseAnd()) return false;
+        emit(RuleOp::Or);
+    }
+    return true;
+}
+
+bool RuleCompiler::parseAnd() {
+    if (!parseNot()) return false;
+    while (peekName("and")) {
+        ++pos;
+        if (!parseNot()) return false;
+        emit(RuleOp::And);
+    }
+    return true;
+}
+
+bool RuleCompiler::parseNot() {
+    if (peekName("not")) {
+        ++pos;
+        if (!parseNot()) return false;
+        emit(RuleOp::Not);
+        return true;
+    }
+    return parseComparison();
+}
+
+bool RuleCompiler::parseComparison() {
+    if (!parseSum()) return false;
+    static const struct { const char* symbol; RuleOp op; } Comparisons[] = {
+        { "==", RuleOp::Equal }, { "!=", RuleOp::NotEqual }, { "<", RuleOp::Less },
+        { "<=", RuleOp::LessEqual }, { ">", RuleOp::Greater }, { ">=", RuleOp::GreaterEqual }
+    };
+    for (const auto& entry : Comparisons) {
+        if (peekSymbol(entry.symbol)) {
+            ++pos;
+            if (!parseSum()) return false;
+            emitComparison(entry.op);
+            return true;
+        }
+    }
+    return true;
+}
+
+bool RuleCompiler::parseSum() {
+    if (!parseTerm()) return false;
+    while (peekSymbol("+") || peekSymbol("-")) {
+        bool add = tokens[pos++].text == "+";
+        if (!parseTerm()) return false;
+        emit(add ? RuleOp::Add : RuleOp::Subtract);
+    }
+    return true;
+}
+
+bool RuleCompiler::parseTerm() {
+    if (!parseUnary()) return false;
+    while (peekSymbol("*") || peekSymbol("/")) {
+        bool multiply = tokens[pos++].text == "*";
+        if (!parseUnary()) return false;
+        emit(multiply ? RuleOp::Multiply : RuleOp::Divide);
+    }
+    return true;
+}
+
+bool RuleCompiler::parseUnary() {
+    if (peekSymbol("-")) {
+        ++pos;
+        if (!parseUnary()) return false;
+        emit(RuleOp::Negate);
+        return true;
+    }
+    return parseCoalesce();
+}
+
+bool RuleCompiler::parseCoalesce() {
+    if (!parsePrimary()) return false;
+    while (peekSymbol("??")) {
+        ++pos;
+        if (!parsePrimary()) return false;
+        if (!fuse(RuleOp::PushFactOr)) emit(RuleOp::Coalesce);
+    }
+    return true;
+}
+
+bool RuleCompiler::parsePrimary() {
+    if (atEnd()) return fail("expression expected");
+    const Token& token = tokens[pos++];
+
+    switch (token.kind) {
+        case TokenKind::Number:
+            if (token.number > 0x7FFFFFFF) return fail("number too large");
+            emit(RuleOp::PushInt, static_cast<int32_t>(token.number));
+            return true;
+
+        case TokenKind::Text:
+            return fail("text can only be compared with a fact");
+
+        case TokenKind::Fact: {
+            int32_t slot = static_cast<int32_t>(factSlot(token.text));
+            // Text comparisons bind to the fact directly
+            bool equal = peekSymbol("=="), notEqual = peekSymbol("!="), contains = peekName("contains");
+            if ((equal || notEqual || contains) && pos + 1 < limit && tokens[pos + 1].kind == TokenKind::Text) {
+                if (pack.strings.size() >= 0xFFFF) return fail("too many text constants");
+                pack.strings.emplace_back(tokens[pos + 1].text);
+                uint16_t text = static_cast<uint16_t>(pack.strings.size() - 1);
+                pos += 2;
+                emit(contains ? RuleOp::TextContains : RuleOp::TextEqual, slot, text);
+                if (notEqual) emit(RuleOp::Not);
+                return true;
+            }
+            if (contains) return fail("contains needs a text value");
+            emit(RuleOp::PushFact, slot);
+            return true;
+        }
+
+        case TokenKind::Symbol:
+            if (token.text == "(") {
+                if (!parseOr()) return false;
+                return expectSymbol(")");
+            }
+            return fail("unexpected '" + std::string(token.text) + "'");
+
+        case TokenKind::Name:
+            break;
+    }
+
+    std::string_view name = token.text;
+    if (name == "true" || name == "false") {
+        emit(RuleOp::PushInt, name == "true" ? 1 : 0);
+        return true;
+    }
+    if (name == "score") {
+        emit(RuleOp::LoadScore);
+        return true;
+    }
+    if (name == "exists") {
+        if (atEnd() || tokens[pos].kind != TokenKind::Fact) return fail("exists needs a [fact]");
+        emit(RuleOp::FactExists, static_cast<int32_t>(factSlot(tokens[pos++].text)));
+        return true;
+    }
+    if (name == "if" || name == "min" || name == "max" || name == "count") {
+        return parseCall(name);
+    }
+    for (size_t i = 0; i < locals.size(); ++i) {
+        if (locals[i] == name) {
+            emit(RuleOp::LoadLocal, static_cast<int32_t>(i));
+            return true;
+        }
+    }
+    return fail("unknown name '" + std::string(name) + "'");
+}
+
+bool RuleCompiler::parseCall(std::string_view function) {
+    if (!expectSymbol("(")) return false;
+    int arguments = 0;
+    if (!peekSymbol(")")) {
+        do {
+            if (arguments > 0) ++pos;
+            if (!parseOr()) return false;
+            arguments++;
+        } while (peekSymbol(","));
+    }
+    if (!expectSymbol(")")) return false;
+
+    if (function == "count") {
+        if (arguments == 0) return fail("count needs at least one condition");
+        emit(RuleOp::Count, arguments);
+    } else if (function == "if") {
+        if (arguments != 3) return fail("if takes a condition and two values");
+        emit(RuleOp::Select);
+    } else {
+        if (arguments < 2) return fail(std::string(function) + " takes at least two values");
+        for (int i = 1; i < arguments; ++i) emit(function == "min" ? RuleOp::Min : RuleOp::Max);
+    }
+    return true;
+}
+
+bool RuleCompiler::expressionRange(size_t begin, size_t end) {
+    pos = begin;
+    limit = end;
+    if (!parseOr()) return false;
+    if (!atEnd()) return fail("unexpected '" + std::string(tokens[pos].text) + "'");
+    return true;
+}
+
+// "when <expr>" is compiled ahead of the statement it guards
+bool RuleCompiler::condition(size_t whenPos) {
+    if (whenPos + 1 >= tokens.size()) return fail("when needs a condition");
+    return expressionRange(whenPos + 1, tokens.size());
+}
+
+bool RuleCompiler::statement(PolicyRule& rule) {
+    std::string_view keyword = tokens[0].text;
+    size_t whenPos = tokens.size();
+    for (size_t i = 1; i < tokens.size(); ++i) {
+        if (tokens[i].kind == TokenKind::Name && tokens[i].text == "when") {
+            whenPos = i;
+            break;
+        }
+    }
+
+    if (keyword == "let") {
+        if (whenPos != tokens.size()) return fail("let cannot be conditional");
+        if (tokens.size() < 4 || tokens[1].kind != TokenKind::Name || tokens[2].text != "=") return fail("expected let <name> = <expression>");
+        std::string name(tokens[1].text);
+        if (isKeyword(name)) return fail("'" + name + "' is a keyword");
+        if (!expressionRange(3, tokens.size())) return false;
+        size_t slot = 0;
+        while (slot < locals.size() && locals[slot] != name) ++slot;
+        if (slot == locals.size()) {
+            if (locals.size() >= RulePack::MaxLocals) return fail("too many locals");
+            locals.push_back(name);
+        }
+        emit(RuleOp::StoreLocal, static_cast<int32_t>(slot));
+        return true;
+    }
+
+    if (keyword == "score" || keyword == "raise") {
+        uint32_t jump = 0;
+        bool guarded = whenPos != tokens.size();
+        if (guarded) {
+            if (!condition(whenPos)) return false;
+            jump = emit(RuleOp::JumpIfFalse);
+        }
+        if (keyword == "score") {
+            if (tokens.size() < 3 || tokens[1].kind != TokenKind::Symbol ||
+                (tokens[1].text != "=" && tokens[1].text != "+=" && tokens[1].text != "-=")) {
+                return fail("expected score =, += or -= <expression>");
+            }
+            if (!expressionRange(2, whenPos)) return false;
+            emit(tokens[1].text == "=" ? RuleOp::SetScore : tokens[1].text == "+=" ? RuleOp::AddScore : RuleOp::SubScore);
+        } else {
+            Severity severity;
+            if (whenPos != 2 || tokens[1].kind != TokenKind::Name || !parseSeverity(tokens[1].text, severity)) {
+                return fail("expected raise <Low|Medium|High|Critical> [when <condition>]");
+            }
+            emit(RuleOp::Raise, static_cast<int32_t>(severity));
+        }
+        if (guarded) patch(jump);
+        return true;
+    }
+
+    if (keyword == "band") {
+        RuleBand band;
+        bool valid = (tokens.size() == 4 || tokens.size() == 5) && tokens[1].kind == TokenKind::Number &&
+                     tokens[2].kind == TokenKind::Name && parseStatus(tokens[2].text, band.status) &&
+                     tokens[3].kind == TokenKind::Name && parseSeverity(tokens[3].text, band.severity) &&
+                     (tokens.size() == 4 || tokens[4].kind == TokenKind::Text);
+        if (!valid) return fail("expected band <min score> <Pass|Warning|Fail> <severity> [\"advice\"]");
+        band.minScore = static_cast<int>(tokens[1].number);
+        if (!PolicyTables::isScore(band.minScore)) return fail("band score must be within 0..100");
+        if (!rule.bands.empty() && band.minScore >= rule.bands.back().minScore) return fail("bands must be listed highest first");
+        if (tokens.size() == 5) band.recommendation = std::string(tokens[4].text);
+        rule.bands.push_back(std::move(band));
+        return true;
+    }
+
+    return fail("unknown statement '" + std::string(keyword) + "'");
+}
+
+bool RuleCompiler::finishRule(PolicyRule& rule) {
+    if (rule.bands.empty()) {
+        for (const ScoreBand& band : DefaultStatusPolicy.bands) {
+            rule.bands.push_back({ band.minScore, band.status, band.severity, std::string() });
+        }
+    } else if (rule.bands.back().minScore != 0) {
+        return fail("the last band must start at 0");
+    }
+    if (maxDepth > RulePack::MaxStack) return fail("expressions too deep");
+    rule.codeEnd = static_cast<uint32_t>(pack.program.size());
+    pack.entries.push_back(std::move(rule));
+    return true;
+}
+
+bool RuleCompiler::compile(std::string_view source) {
+    PolicyRule rule;
+    bool inRule = false;
+    size_t lineNumber = 0;
+    size_t lineStart = 0;
+    std::string tokenError;
+
+    while (lineStart <= source.size()) {
+        size_t lineEnd = source.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = source.size();
+        std::string_view line = source.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        lineNumber++;
+
+        // The rule header is split by hand: ids may contain any character but '"'
+        std::string_view header = line;
+        while (!header.empty() && isSpace(header.front())) header.remove_prefix(1);
+        bool isHeader = header.size() > 4 && header.compare(0, 4, "rule") == 0 && isSpace(header[4]);
+
+        bool ok = true;
+        if (isHeader) {
+            // rule <id> "<title>"
+            size_t quote = header.find('"');
+            size_t close = quote == std::string_view::npos ? quote : header.find('"', quote + 1);
+            std::string_view id = header.substr(5, quote == std::string_view::npos ? std::string_view::npos : quote - 5);
+            while (!id.empty() && isSpace(id.front())) id.remove_prefix(1);
+            while (!id.empty() && isSpace(id.back())) id.remove_suffix(1);
+            if (inRule) {
+                ok = fail("missing end before rule");
+            } else if (id.empty() || close == std::string_view::npos) {
+                ok = fail("expected rule <id> \"<title>\"");
+            } else {
+                rule = PolicyRule();
+                rule.id = std::string(id);
+                rule.title = std::string(header.substr(quote + 1, close - quote - 1));
+                rule.codeBegin = static_cast<uint32_t>(pack.program.size());
+                locals.clear();
+                depth = maxDepth = 0;
+                inRule = true;
+            }
+        } else if (!tokenize(line, tokens, tokenError)) {
+            ok = fail(tokenError);
+        } else if (tokens.empty()) {
+            continue;
+        } else if (tokens[0].kind != TokenKind::Name) {
+            ok = fail("statement expected");
+        } else if (!inRule) {
+            ok = fail("statement outside a rule");
+        } else if (tokens[0].text == "end") {
+            ok = tokens.size() == 1 ? finishRule(rule) : fail("unexpected text after end");
+            inRule = false;
+        } else {
+            ok = statement(rule);
+        }
+
+        if (!ok) {
+            errorText = "line " + std::to_string(lineNumber) + ": " + errorText;
+            return false;
+        }
+    }
+
+    if (inRule) {
+        errorText = "line " + std::to_string(lineNumber) + ": rule " + rule.id + " has no end";
+        return false;
+    }
+    return true;
+}
+
+bool RulePack::compile(std::string_view source) {
+    // Compile into a copy so a bad pack leaves this one unchanged
+    RulePack staged(*this);
+    RuleCompiler compiler(staged);
+    if (!compiler.compile(source)) {
+        errorText = compiler.error();
+        return false;
+    }
+    staged.errorText.clear();
+    *this = std::move(staged);
+    revisionId = nextRevision();
+    return true;
+}
+
+bool RulePack::loadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        errorText = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return compile(buffer.str());
+}
+
+std::vector<uint32_t> RulePack::slotsRead(uint32_t rule) const {
+    std::vector<uint32_t> slots;
+    for (uint32_t i = entries[rule].codeBegin; i < entries[rule].codeEnd; ++i) {
+        const RuleInstruction& instruction = program[i];
+        switch (instruction.op) {
+            case RuleOp::PushFact: case RuleOp::FactExists: case RuleOp::TextEqual: case RuleOp::TextContains:
+                slots.push_back(static_cast<uint32_t>(instruction.operand));
+                break;
+            case RuleOp::PushFactOr:
+            case RuleOp::FactEqual: case RuleOp::FactNotEqual: case RuleOp::FactLess: case RuleOp::FactLessEqual:
+            case RuleOp::FactGreater: case RuleOp::FactGreaterEqual:
+                slots.push_back(instruction.aux);
+                break;
+            default:
+                break;
+        }
+    }
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    return slots;
+}
+
+std::vector<std::string> RulePack::registryKeys() const {
+    std::vector<std::string> keys;
+    for (const auto& name : facts) {
+        if (isSecurityPolicy(name)) continue;
+        size_t separator = name.rfind('\\');
+        if (separator == std::string::npos) continue;
+        std::string_view key(name.data(), separator);
+        bool seen = false;
+        for (const auto& existing : keys) {
+            if (equalsIgnoreCase(existing, key)) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) keys.emplace_back(key);
+    }
+    return keys;
+}
+
+bool RulePack::usesSecurityPolicy() const {
+    for (const auto& name : facts) {
+        if (isSecurityPolicy(name)) return true;
+    }
+    return false;
+}
+
+void RulePack::resolve(const FactTable& table, std::vector<RuleFact>& resolved) const {
+    resolved.resize(facts.size());
+    for (size_t slot = 0; slot < facts.size(); ++slot) {
+        RuleFact& fact = resolved[slot];
+        fact.id = table.find(facts[slot], factHashes[slot]);
+        fact.number = 0;
+        fact.numeric = fact.id != FactTable::NotFound && table.number(fact.id, fact.number);
+    }
+}
+
+RuleOutcome RulePack::evaluate(uint32_t index, const FactTable& table, const std::vector<RuleFact>& resolved) const {
+    const PolicyRule& rule = entries[index];
+    Value stack[MaxStack];
+    Value locals[MaxLocals];     // the compiler only allows reads after a let
+    Value* top = stack;
+    int64_t score = 100;
+    int raised = 0;
+
+    const RuleInstruction* code = program.data();
+    uint32_t pc = rule.codeBegin;
+    while (pc < rule.codeEnd) {
+        const RuleInstruction& instruction = code[pc++];
+        switch (instruction.op) {
+            case RuleOp::PushInt:
+                *top++ = { instruction.operand, true };
+                break;
+            case RuleOp::PushFact: {
+                const RuleFact& fact = resolved[instruction.operand];
+                *top++ = { fact.number, fact.numeric };
+                break;
+            }
+            case RuleOp::PushFactOr: {
+                const RuleFact& fact = resolved[instruction.aux];
+                *top++ = { fact.numeric ? fact.number : instruction.operand, true };
+                break;
+            }
+            case RuleOp::FactExists:
+                *top++ = { resolved[instruction.operand].id != FactTable::NotFound ? 1 : 0, true };
+                break;
+            case RuleOp::TextEqual:
+            case RuleOp::TextContains: {
+                uint32_t id = resolved[instruction.operand].id;
+                if (id == FactTable::NotFound) {
+                    *top++ = { 0, false };
+                } else {
+                    const std::string& text = strings[instruction.aux];
+                    bool match = instruction.op == RuleOp::TextEqual ? equalsIgnoreCase(table.value(id), text)
+                                                                     : containsIgnoreCase(table.value(id), text);
+                    *top++ = { match ? 1 : 0, true };
+                }
+                break;
+            }
+            case RuleOp::LoadLocal:
+                *top++ = locals[instruction.operand];
+                break;
+            case RuleOp::LoadScore:
+                *top++ = { score, true };
+                break;
+            case RuleOp::StoreLocal:
+                locals[instruction.operand] = *--top;
+                break;
+            case RuleOp::SetScore:
+            case RuleOp::AddScore:
+            case RuleOp::SubScore: {
+                Value value = *--top;
+                if (!value.known) break;
+                if (instruction.op == RuleOp::SetScore) score = value.number;
+                else if (instruction.op == RuleOp::AddScore) score += value.number;
+                else score -= value.number;
+                // Keep the running score bounded; it is clamped to 0..100 at the end
+                if (score > ValueLimit) score = ValueLimit;
+                if (score < -ValueLimit) score = -ValueLimit;
+                break;
+            }
+            case RuleOp::Add: {
+                Value b = *--top;
+                Value& a = top[-1];
+                a = bounded(a.number + b.number, a.known && b.known);
+                break;
+            }
+            case RuleOp::Subtract: {
+                Value b = *--top;
+                Value& a = top[-1];
+                a = bounded(a.number - b.number, a.known && b.known);
+                break;
+            }
+            case RuleOp::Multiply: {
+                Value b = *--top;
+                Value& a = top[-1];
+                int64_t magnitude = b.number < 0 ? -b.number : b.number;
+                if (!a.known || !b.known || (magnitude != 0 && (a.number > ValueLimit / magnitude || a.number < -ValueLimit / magnitude))) {
+                    a = { 0, false };
+                } else {
+                    a.number *= b.number;
+                }
+                break;
+            }
+            case RuleOp::Divide: {
+                Value b = *--top;
+                Value& a = top[-1];
+                a = a.known && b.known && b.number != 0 ? Value{ a.number / b.number, true } : Value{ 0, false };
+                break;
+            }
+            case RuleOp::Min: {
+                Value b = *--top;
+                Value& a = top[-1];
+                a = { b.number < a.number ? b.number : a.number, a.known && b.known };
+                break;
+            }
+            case RuleOp::Max: {
+                Value b = *--top;
+                Value& a = top[-1];
+                a = { b.number > a.number ? b.number : a.number, a.known && b.known };
+                break;
+            }
+            case RuleOp::Coalesce: {
+                Value b = *--top;
+                if (!top[-1].known) top[-1] = b;
+                break;
+            }
+            // Comparisons: unknown if either side is unknown
+            case RuleOp::Equal:
+                --top;
+                top[-1] = { top[-1].number == top[0].number ? 1 : 0, top[-1].known && top[0].known };
+                break;
+            case RuleOp::NotEqual:
+                --top;
+                top[-1] = { top[-1].number != top[0].number ? 1 : 0, top[-1].known && top[0].known };
+                break;
+            case RuleOp::Less:
+                --top;
+                top[-1] = { top[-1].number < top[0].number ? 1 : 0, top[-1].known && top[0].known };
+                break;
+            case RuleOp::LessEqual:
+                --top;
+                top[-1] = { top[-1].number <= top[0].number ? 1 : 0, top[-1].known && top[0].known };
+                break;
+            case RuleOp::Greater:
+                --top;
+                top[-1] = { top[-1].number > top[0].number ? 1 : 0, top[-1].known && top[0].known };
+                break;
+            case RuleOp::GreaterEqual:
+                --top;
+                top[-1] = { top[-1].number >= top[0].number ? 1 : 0, top[-1].known && top[0].known };
+                break;
+            case RuleOp::FactEqual:
+            case RuleOp::FactNotEqual:
+            case RuleOp::FactLess:
+            case RuleOp::FactLessEqual:
+            case RuleOp::FactGreater:
+            case RuleOp::FactGreaterEqual: {
+                const RuleFact& fact = resolved[instruction.aux];
+                int64_t constant = instruction.operand;
+                bool result;
+                switch (instruction.op) {
+                    case RuleOp::FactEqual: result = fact.number == constant; break;
+                    case RuleOp::FactNotEqual: result = fact.number != constant; break;
+                    case RuleOp::FactLess: result = fact.number < constant; break;
+                    case RuleOp::FactLessEqual: result = fact.number <= constant; break;
+                    case RuleOp::FactGreater: result = fact.number > constant; break;
+                    default: result = fact.number >= constant; break;
+                }
+                *top++ = { result ? 1 : 0, fact.numeric };
+                break;
+            }
+            case RuleOp::And:
+            case RuleOp::Or: {
+                // Three-valued: a known false (and) or true (or) decides, otherwise unknown stays unknown
+                Value b = *--top;
+                Value& a = top[-1];
+                bool decisive = instruction.op == RuleOp::Or;
+                if ((a.known && (a.number != 0) == decisive) || (b.known && (b.number != 0) == decisive)) {
+                    a = { decisive ? 1 : 0, true };
+                } else if (a.known && b.known) {
+                    a = { decisive ? 0 : 1, true };
+                } else {
+                    a = { 0, false };
+                }
+                break;
+            }
+            case RuleOp::Negate:
+                top[-1].number = -top[-1].number;
+                break;
+            case RuleOp::Not:
+                if (top[-1].known) top[-1].number = top[-1].number == 0 ? 1 : 0;
+                break;
+            case RuleOp::Select: {
+                Value otherwise = *--top;
+                Value then = *--top;
+                top[-1] = truthy(top[-1]) ? then : otherwise;
+                break;
+            }
+            case RuleOp::Count: {
+                int64_t count = 0;
+                for (int32_t i = 0; i < instruction.operand; ++i) {
+                    if (truthy(*--top)) count++;
+                }
+                *top++ = { count, true };
+                break;
+            }
+            case RuleOp::JumpIfFalse:
+                if (!truthy(*--top)) pc = static_cast<uint32_t>(instruction.operand);
+                break;
+            case RuleOp::Raise:
+                if (instruction.operand > raised) raised = instruction.operand;
+                break;
+        }
+    }
+
+    int finalScore = static_cast<int>(score < 0 ? 0 : score > 100 ? 100 : score);
+    uint32_t band = 0;
+    while (band + 1 < rule.bands.size() && finalScore < rule.bands[band].minScore) ++band;
+    const RuleBand& entry = rule.bands[band];
+    Severity severity = entry.severity;
+    if (entry.status == CheckStatus::Fail && raised > static_cast<int>(severity)) {
+        severity = static_cast<Severity>(raised);
+    }
+    return { index, finalScore, entry.status, severity, band };
+}
+
+void RulePack::evaluate(const FactTable& table, std::vector<RuleOutcome>& outcomes) const {
+    std::vector<RuleFact> resolved;
+    resolve(table, resolved);
+    outcomes.clear();
+    outcomes.reserve(entries.size());
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        outcomes.push_back(evaluate(i, table, resolved));
+    }
+}
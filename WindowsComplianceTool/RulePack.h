@@ -0,0 +1,133 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class FactTable;
+
+// Policy rules written as text, compiled once into bytecode and run by a
+// small stack interpreter over a host's FactTable, so policy changes need
+// no rebuild. Facts are resolved to ids once per host; rules then read
+// them by slot without hashing.
+//
+//   # Firewall profiles: 100 / 67 / 33 / 0 by the number enabled
+//   rule FW-01 "Firewall Status"
+//       let enabled = count([HKLM\...\DomainProfile\EnableFirewall] == 1, ...)
+//       score = if(enabled == 3, 100, if(enabled == 2, 67, if(enabled == 1, 33, 0)))
+//       band 100 Pass Low "All firewall profiles are enabled."
+//       band 67 Warning Medium "Enable all profiles."
+//       band 0 Fail Critical "Enable the firewall immediately."
+//   end
+//
+// Statements, one per line:
+//   let <name> = <expr>                  local value
+//   score = | += | -= <expr> [when <expr>]   score starts at 100, clamped to 0..100
+//   raise <Severity> [when <expr>]       severity of a failing result, at least this
+//   band <min> <Pass|Warning|Fail> <Severity> ["advice"]   highest first, last at 0;
+//                                        without bands the default 90 / 70 bands apply
+//
+// Expressions: integers, [fact name] (registry "HKLM\key\value" or
+// "SecurityPolicy\section\key"), locals, score, + - * /, comparisons,
+// and / or / not, a ?? b (b when a is unknown), min, max, if(c, a, b),
+// count(c1, c2, ...), exists [fact], [fact] == / != / contains "text".
+// A missing or non-numeric fact is unknown; comparisons with it are
+// unknown, unknown conditions are false and unknown scores change nothing.
+
+enum class RuleOp : uint8_t {
+    PushInt, PushFact, FactExists, TextEqual, TextContains, LoadLocal, LoadScore,
+    StoreLocal, SetScore, AddScore, SubScore,
+    Add, Subtract, Multiply, Divide, Min, Max, Coalesce,
+    Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, And, Or,
+    Negate, Not, Select, Count,
+    PushFactOr, FactEqual, FactNotEqual, FactLess, FactLessEqual, FactGreater, FactGreaterEqual,
+    JumpIfFalse, Raise
+};
+
+// PushFactOr and Fact<comparison> fuse PushFact, PushInt and a ?? or a
+// comparison, the most common shapes in rules
+struct RuleInstruction {
+    RuleOp op;
+    uint16_t aux;                   // text constant for TextEqual / TextContains, fact slot for fused ops
+    int32_t operand;
+};
+
+struct RuleBand {
+    int minScore;
+    CheckStatus status;
+    Severity severity;
+    std::string recommendation;
+};
+
+struct PolicyRule {
+    std::string id;
+    std::string title;
+    uint32_t codeBegin = 0, codeEnd = 0;    // range in the pack's program
+    std::vector<RuleBand> bands;
+};
+
+struct RuleOutcome {
+    uint32_t rule;                  // index into RulePack::rules()
+    int score;
+    CheckStatus status;
+    Severity severity;
+    uint32_t band;                  // index into the rule's bands
+};
+
+// One fact as the rules read it on one host
+struct RuleFact {
+    uint32_t id;                    // FactTable id, FactTable::NotFound if absent
+    bool numeric;
+    int64_t number;
+};
+
+class RulePack {
+public:
+    static constexpr uint32_t MaxStack = 32;
+    static constexpr uint32_t MaxLocals = 16;
+
+    bool loadFile(const std::string& path);
+
+    // Compile and append every rule in source; on an error nothing is
+    // added and error() names the line
+    bool compile(std::string_view source);
+    const std::string& error() const { return errorText; }
+
+    const std::vector<PolicyRule>& rules() const { return entries; }
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    size_t instructionCount() const { return program.size(); }
+
+    // Changes with every successful compile (see Revision.h)
+    uint64_t revision() const { return revisionId; }
+
+    // Facts the rules read, each once
+    const std::vector<std::string>& factNames() const { return facts; }
+    std::vector<std::string> registryKeys() const;
+    bool usesSecurityPolicy() const;
+
+    // Fact slots one rule reads, each once, so a changed fact re-runs only
+    // the rules that read it
+    std::vector<uint32_t> slotsRead(uint32_t rule) const;
+
+    // Every fact slot looked up once per host, numbers copied out so rules
+    // read them without touching the table
+    void resolve(const FactTable& table, std::vector<RuleFact>& resolved) const;
+
+    RuleOutcome evaluate(uint32_t rule, const FactTable& table, const std::vector<RuleFact>& resolved) const;
+    void evaluate(const FactTable& table, std::vector<RuleOutcome>& outcomes) const;
+
+private:
+    std::vector<PolicyRule> entries;
+    std::vector<RuleInstruction> program;
+    std::vector<std::string> strings;       // text constants
+    std::vector<std::string> facts;         // canonical fact names by slot
+    std::vector<uint32_t> factHashes;
+    std::unordered_multimap<uint32_t, uint32_t> factSlots;     // hash -> slot
+    std::string errorText;
+    uint64_t revisionId = 0;
+
+    friend class RuleCompiler;
+};
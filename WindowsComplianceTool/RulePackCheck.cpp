@@ -0,0 +1,121 @@
+#include "RulePackCheck.h"
+#include "FactTable.h"
+#include "PolicyTables.h"
+#include <filesystem>
+
+void RulePackCheck::collectFacts(const RulePack& rules, FactTable& facts) {
+    collectSettings(rules.registryKeys(), rules.usesSecurityPolicy(), facts);
+}
+
+ComplianceResult RulePackCheck::performCheck() {
+    outcomes.clear();
+    facts.clear();
+    
+    // Compile the local rules once and keep them for later scans
+    std::string loadError;
+    if (!pack) {
+        std::string path = dataFilePath("PolicyRules.rules");
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            auto rules = std::make_shared<RulePack>();
+            if (rules->loadFile(path)) {
+                pack = rules;
+            } else {
+                loadError = rules->error();
+            }
+        }
+    }
+    
+    if (!pack) {
+        ComplianceResult result("Policy Rules",
+                               "Evaluates the site's policy rules against collected registry and security policy settings.",
+                               CheckStatus::NotApplicable, Severity::Medium, 0);
+        if (loadError.empty()) result.findings.message(FindingKey::RulesMissing);
+        else result.findings.text(FindingKey::RuleLoadError, loadError);
+        result.recommendation = "Place PolicyRules.rules next to the executable or configure a rule pack.";
+        return result;
+    }
+    
+    collectFacts(*pack, facts);
+    return evaluate(*pack, facts, outcomes);
+}
+
+ComplianceResult RulePackCheck::evaluate(const RulePack& rules, const FactTable& facts) {
+    std::vector<RuleOutcome> outcomes;
+    return evaluate(rules, facts, outcomes);
+}
+
+ComplianceResult RulePackCheck::evaluate(const RulePack& rules, const FactTable& facts, std::vector<RuleOutcome>& outcomes) {
+    ComplianceResult result("Policy Rules",
+                           "Evaluates the site's policy rules against collected registry and security policy settings.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    rules.evaluate(facts, outcomes);
+    
+    int weightedScore = 0, totalWeight = 0;
+    int passed = 0, warnings = 0, failed = 0, criticalFailed = 0;
+    for (const auto& outcome : outcomes) {
+        int weight = PolicyTables::weight<ModuleWeights>(outcome.severity);
+        weightedScore += outcome.score * weight;
+        totalWeight += weight;
+        if (outcome.status == CheckStatus::Pass) passed++;
+        else if (outcome.status == CheckStatus::Warning) warnings++;
+        else failed++;
+        if (outcome.status == CheckStatus::Fail && outcome.severity == Severity::Critical) criticalFailed++;
+    }
+    int score = totalWeight > 0 ? weightedScore / totalWeight : 0;
+    
+    // A rule costs its missing points at its share of the weight
+    for (const auto& outcome : outcomes) {
+        if (outcome.score >= 100) continue;
+        result.attribution.add(rules.rules()[outcome.rule].id,
+                               static_cast<float>(100 - outcome.score) * PolicyTables::weight<ModuleWeights>(outcome.severity) / totalWeight);
+    }
+    
+    result.findings.number(FindingKey::Rules, static_cast<int64_t>(outcomes.size()));
+    result.findings.number(FindingKey::RuleInstructions, static_cast<int64_t>(rules.instructionCount()));
+    result.findings.number(FindingKey::PassedRules, passed);
+    result.findings.number(FindingKey::WarningRules, warnings);
+    result.findings.number(FindingKey::FailedRules, failed);
+    result.findings.number(FindingKey::SettingsCollected, static_cast<int64_t>(facts.size()));
+    
+    // Most severe results first
+    const size_t maxListed = 10;
+    size_t listed = 0;
+    for (Severity severity : { Severity::Critical, Severity::High, Severity::Medium, Severity::Low }) {
+        for (const auto& outcome : outcomes) {
+            if (outcome.status == CheckStatus::Pass || outcome.severity != severity || listed >= maxListed) continue;
+            const PolicyRule& rule = rules.rules()[outcome.rule];
+            std::string reason = rule.title + ": " + std::to_string(outcome.score) +
+                                 (outcome.status == CheckStatus::Fail ? " (fail)" : " (warning)");
+            const std::string& advice = rule.bands[outcome.band].recommendation;
+            if (!advice.empty()) reason += " - " + advice;
+            result.findings.item(FindingKey::RuleResult, rule.id, reason, outcome.severity);
+            listed++;
+        }
+    }
+    if (static_cast<size_t>(warnings + failed) > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(warnings + failed - maxListed));
+    }
+    
+    result.score = score;
+    
+    if (outcomes.empty() || facts.empty()) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.attribution.clear();
+        result.recommendation = "No settings could be collected for the policy rules. Run the tool elevated or provide offline hives.";
+    } else {
+        const char* advice[] = {
+            failed + warnings == 0
+                ? "All policy rules pass. System is compliant."
+                : "Review the rules reporting warnings.",
+            "Remediate the settings behind the listed rules.",
+            "The host fails several policy rules. Remediate the listed settings and rescan."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, criticalFailed > 0)];
+    }
+    
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "ComplianceCheck.h"
+#include "FactTable.h"
+#include "RulePack.h"
+#include <memory>
+#include <vector>
+
+class RulePackCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Policy Rules"; }
+    
+    // Compiled rules shared across scans; when unset, PolicyRules.rules in
+    // the working directory is compiled if present
+    void setRulePack(std::shared_ptr<const RulePack> rules) { pack = std::move(rules); }
+    const std::shared_ptr<const RulePack>& getRulePack() const { return pack; }
+    
+    // Settings collected by the last scan
+    const FactTable& getFacts() const { return facts; }
+    
+    // Per-rule outcomes of the last scan, kept for framework scoring and
+    // what-if simulation
+    const std::vector<RuleOutcome>& getOutcomes() const { return outcomes; }
+    
+    // Collect every setting the rules read into one fact table
+    void collectFacts(const RulePack& rules, FactTable& facts);
+    
+    // Run every rule and weight each rule's score by its resulting severity,
+    // as calculateOverallScore weights modules (no system access)
+    static ComplianceResult evaluate(const RulePack& rules, const FactTable& facts);
+    static ComplianceResult evaluate(const RulePack& rules, const FactTable& facts, std::vector<RuleOutcome>& outcomes);
+
+private:
+    std::shared_ptr<const RulePack> pack;
+    FactTable facts;
+    std::vector<RuleOutcome> outcomes;
+};
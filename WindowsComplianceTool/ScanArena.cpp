@@ -0,0 +1,51 @@
+#include "ScanArena.h"
+
+namespace {
+
+thread_local std::pmr::memory_resource* currentArena = nullptr;
+
+} // namespace
+
+std::pmr::memory_resource* ScanArena::current() {
+    return currentArena != nullptr ? currentArena : std::pmr::get_default_resource();
+}
+
+ScanArena::Scope::Scope(ScanArena& arena) : previous(currentArena) {
+    currentArena = arena.resource();
+}
+
+ScanArena::Scope::~Scope() {
+    currentArena = previous;
+}
+
+void ScanArena::release() {
+    for (const auto& block : large) {
+        arena.upstream_resource()->deallocate(block.memory, block.bytes, block.alignment);
+    }
+    large.clear();
+    arena.release();
+}
+
+void* ScanArena::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes < LargeAllocation) return arena.allocate(bytes, alignment);
+    void* memory = arena.upstream_resource()->allocate(bytes, alignment);
+    large.push_back({ memory, bytes, alignment });
+    return memory;
+}
+
+void ScanArena::do_deallocate(void* memory, size_t bytes, size_t alignment) {
+    if (bytes < LargeAllocation) return;
+    // Few are live at once; the newest is usually the one going
+    for (size_t i = large.size(); i-- > 0;) {
+        if (large[i].memory == memory) {
+            arena.upstream_resource()->deallocate(memory, bytes, alignment);
+            large[i] = large.back();
+            large.pop_back();
+            return;
+        }
+    }
+}
+
+bool ScanArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Memory for one scan. Results, findings and probe tables built while a
+// Scope is active on a thread are carved from a few large blocks; nothing
+// is freed piecemeal and release() returns it all at once.
+//
+// Requests of LargeAllocation bytes or more (whole probe texts, big field
+// tables) go to the heap instead: a block sized for one of them would
+// strand the rest of the current block, and freeing them when their owner
+// goes keeps a regrown buffer from holding its old copy until release().
+//
+// The arena is not thread-safe: a Scope only covers the thread that
+// opened it, so worker threads inside a check keep the default resource.
+class ScanArena : private std::pmr::memory_resource {
+public:
+    static constexpr size_t InitialBlockSize = 64 * 1024;
+    static constexpr size_t LargeAllocation = 64 * 1024;
+
+    ScanArena() : arena(InitialBlockSize) {}
+    ~ScanArena() override { release(); }
+    ScanArena(const ScanArena&) = delete;
+    ScanArena& operator=(const ScanArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return this; }
+
+    // Frees every allocation; nothing built in the arena may be used after
+    void release();
+
+    // Memory for new scan objects on this thread: the innermost open
+    // arena, otherwise the default resource
+    static std::pmr::memory_resource* current();
+
+    // Routes current() to the arena until the scope closes
+    class Scope {
+    public:
+        explicit Scope(ScanArena& arena);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::pmr::memory_resource* previous;
+    };
+
+private:
+    struct Block {
+        void* memory;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::vector<Block> large;       // heap allocations not yet freed
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
@@ -0,0 +1,180 @@
+#include "ScanPlanner.h"
+#include "CsvReader.h"
+#include "PolicyTables.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+// Runs of prior evidence mixed into the measured failure rate
+const double PriorRuns = 2.0;
+
+// Weight of the newest run in the average duration
+const double DurationSmoothing = 0.3;
+
+const ModulePrior& priorFor(std::string_view module) {
+    for (const auto& prior : QuickScanPriors) {
+        if (module == prior.module) return prior;
+    }
+    return DefaultModulePrior;
+}
+
+const char* severityName(Severity severity) {
+    switch (severity) {
+        case Severity::Critical: return "Critical";
+        case Severity::High: return "High";
+        case Severity::Low: return "Low";
+        default: return "Medium";
+    }
+}
+
+uint32_t parseCount(std::string_view text) {
+    return static_cast<uint32_t>(std::strtoul(std::string(text).c_str(), nullptr, 10));
+}
+
+} // namespace
+
+ModuleHistory& ScanPlanner::entry(const std::string& module) {
+    auto found = index.find(module);
+    if (found != index.end()) return entries[found->second];
+    index.emplace(module, entries.size());
+    entries.emplace_back();
+    entries.back().module = module;
+    return entries.back();
+}
+
+const ModuleHistory* ScanPlanner::find(std::string_view module) const {
+    auto found = index.find(std::string(module));
+    return found != index.end() ? &entries[found->second] : nullptr;
+}
+
+bool ScanPlanner::loadFromCsv(const CsvReader& table) {
+    int moduleColumn = table.columnIndex("Module");
+    int runsColumn = table.columnIndex("Runs");
+    int assessedColumn = table.columnIndex("Assessed");
+    int failuresColumn = table.columnIndex("Failures");
+    int averageColumn = table.columnIndex("AverageMs");
+    int severityColumn = table.columnIndex("FailSeverity");
+    if (moduleColumn < 0 || runsColumn < 0 || averageColumn < 0) return false;
+
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        std::string module = row.value(moduleColumn);
+        if (module.empty()) continue;
+        ModuleHistory& history = entry(module);
+        history.runs = parseCount(row[runsColumn]);
+        history.assessed = parseCount(row[assessedColumn]);
+        history.failures = std::min(parseCount(row[failuresColumn]), history.assessed);
+        history.averageMs = std::strtod(std::string(row[averageColumn]).c_str(), nullptr);
+        history.hasFailed = !row[severityColumn].empty();
+        if (history.hasFailed) history.failSeverity = parseSeverity(row[severityColumn]);
+    }
+    return !entries.empty();
+}
+
+bool ScanPlanner::loadFile(const std::string& path) {
+    CsvReader table;
+    return table.loadFromFile(path) && loadFromCsv(table);
+}
+
+bool ScanPlanner::saveFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "Module,Runs,Assessed,Failures,AverageMs,FailSeverity\n";
+    for (const auto& history : entries) {
+        file << '"' << history.module << "\"," << history.runs << ',' << history.assessed << ','
+             << history.failures << ',' << static_cast<long long>(std::llround(history.averageMs)) << ','
+             << (history.hasFailed ? severityName(history.failSeverity) : "") << '\n';
+    }
+    return file.good();
+}
+
+void ScanPlanner::record(const std::string& module, double elapsedMs, const ComplianceResult& result) {
+    ModuleHistory& history = entry(module);
+    history.averageMs = history.runs == 0 ? elapsedMs
+                                          : history.averageMs + DurationSmoothing * (elapsedMs - history.averageMs);
+    history.runs++;
+    if (result.status == CheckStatus::NotApplicable) return;
+    history.assessed++;
+    if (result.status != CheckStatus::Pass) {
+        history.failures++;
+        history.failSeverity = result.severity;
+        history.hasFailed = true;
+    }
+}
+
+int ScanPlanner::estimatedCost(std::string_view module) const {
+    const ModuleHistory* history = find(module);
+    if (history == nullptr || history->runs == 0) return priorFor(module).costMs;
+    return std::max(1, static_cast<int>(std::lround(history->averageMs)));
+}
+
+double ScanPlanner::failureRate(std::string_view module) const {
+    const ModuleHistory* history = find(module);
+    double prior = priorFor(module).failurePercent / 100.0;
+    if (history == nullptr) return prior;
+    return (history->failures + prior * PriorRuns) / (history->assessed + PriorRuns);
+}
+
+double ScanPlanner::riskValue(std::string_view module) const {
+    const ModuleHistory* history = find(module);
+    Severity severity = history != nullptr && history->hasFailed ? history->failSeverity : priorFor(module).severity;
+    return PolicyTables::weight<ModuleWeights>(severity) * failureRate(module);
+}
+
+QuickScanPlan ScanPlanner::plan(const std::vector<std::string>& modules, int budgetMs) const {
+    QuickScanPlan result;
+    budgetMs = std::max(budgetMs, 0);
+
+    // Costs in units of the budget's resolution, rounded up so the choice
+    // never exceeds the budget; at most 1000 units keeps the table small
+    const int unitMs = std::max(1, (budgetMs + 999) / 1000);
+    const int capacity = budgetMs / unitMs;
+    std::vector<int> costs(modules.size());
+    std::vector<double> values(modules.size());
+    double totalValue = 0;
+    for (size_t i = 0; i < modules.size(); ++i) {
+        costs[i] = (estimatedCost(modules[i]) + unitMs - 1) / unitMs;
+        values[i] = riskValue(modules[i]);
+        totalValue += values[i];
+    }
+
+    // best[c]: highest value within c units; taken[i][c] records choices
+    std::vector<double> best(capacity + 1, 0.0);
+    std::vector<std::vector<bool>> taken(modules.size(), std::vector<bool>(capacity + 1, false));
+    for (size_t i = 0; i < modules.size(); ++i) {
+        for (int c = capacity; c >= costs[i]; --c) {
+            double with = best[c - costs[i]] + values[i];
+            if (with > best[c]) {
+                best[c] = with;
+                taken[i][c] = true;
+            }
+        }
+    }
+
+    std::vector<bool> chosen(modules.size(), false);
+    for (size_t i = modules.size(), c = static_cast<size_t>(capacity); i-- > 0;) {
+        if (taken[i][c]) {
+            chosen[i] = true;
+            c -= static_cast<size_t>(costs[i]);
+        }
+    }
+
+    double chosenValue = 0;
+    for (size_t i = 0; i < modules.size(); ++i) {
+        if (chosen[i]) {
+            result.selected.push_back(i);
+            result.estimatedMs += estimatedCost(modules[i]);
+            chosenValue += values[i];
+        } else {
+            result.skipped.push_back(i);
+        }
+    }
+    result.coverage = totalValue > 0 ? chosenValue / totalValue : (result.skipped.empty() ? 1.0 : 0.0);
+    return result;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CsvReader;
+
+// What past scans measured for one module
+struct ModuleHistory {
+    std::string module;
+    uint32_t runs = 0;
+    uint32_t assessed = 0;          // runs that were not NotApplicable
+    uint32_t failures = 0;          // assessed runs that did not pass
+    double averageMs = 0;           // exponentially weighted, recent scans count most
+    Severity failSeverity = Severity::Medium;   // severity of the latest failure
+    bool hasFailed = false;
+};
+
+// Modules chosen for a time budget
+struct QuickScanPlan {
+    std::vector<size_t> selected;   // indices into the planned modules, in order
+    std::vector<size_t> skipped;
+    int estimatedMs = 0;            // estimated cost of the selection
+    double coverage = 0;            // share of the total risk value selected, 0..1
+};
+
+// Module timings and failure rates across scans, and the quick-scan
+// choice they drive. A module's risk value is its severity weight (as
+// calculateOverallScore weights it) times its failure rate; its cost is
+// its average run time. Modules without history use QuickScanPriors, and
+// a few runs move the rate away from the prior.
+//
+// CSV columns: Module, Runs, Assessed, Failures, AverageMs, FailSeverity.
+class ScanPlanner {
+public:
+    bool loadFile(const std::string& path);
+    bool loadFromCsv(const CsvReader& table);
+    bool saveFile(const std::string& path) const;
+
+    // One module run: its duration and result
+    void record(const std::string& module, double elapsedMs, const ComplianceResult& result);
+
+    const ModuleHistory* find(std::string_view module) const;
+    const std::vector<ModuleHistory>& modules() const { return entries; }
+
+    int estimatedCost(std::string_view module) const;
+    double failureRate(std::string_view module) const;
+    double riskValue(std::string_view module) const;
+
+    // Modules that maximize the total risk value within budgetMs (0/1
+    // knapsack over costs rounded to the budget's resolution)
+    QuickScanPlan plan(const std::vector<std::string>& modules, int budgetMs) const;
+
+private:
+    std::vector<ModuleHistory> entries;
+    std::unordered_map<std::string, size_t> index;
+
+    ModuleHistory& entry(const std::string& module);
+};
@@ -0,0 +1,86 @@
+#include "ScheduledTaskCheck.h"
+#include "PolicyTables.h"
+#include "ScheduledTasks.h"
+#include <cstdlib>
+
+ComplianceResult ScheduledTaskCheck::performCheck() {
+    std::string directory = tasksDirectory;
+    if (directory.empty() && registryProvider) {
+        // Offline hives: the live host's tasks say nothing about the image
+        ComplianceResult result("Scheduled Tasks",
+                               "Audits scheduled task principals and actions for elevated tasks that can be hijacked.",
+                               CheckStatus::NotApplicable, Severity::Medium, 0);
+        result.recommendation = "Scanning offline registry data. Set the image's Windows\\System32\\Tasks directory to audit its scheduled tasks.";
+        return result;
+    }
+    if (directory.empty()) {
+        const char* systemRoot = std::getenv("SystemRoot");
+        directory = std::string(systemRoot != nullptr ? systemRoot : "C:\\Windows") + "\\System32\\Tasks";
+    }
+    
+    ScheduledTaskSet tasks;
+    tasks.loadDirectory(directory);
+    return evaluate(tasks);
+}
+
+ComplianceResult ScheduledTaskCheck::evaluate(const ScheduledTaskSet& tasks) {
+    ComplianceResult result("Scheduled Tasks",
+                           "Audits scheduled task principals and actions for elevated tasks that can be hijacked.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    int system = 0, elevated = 0, disabled = 0, hidden = 0;
+    for (const auto& task : tasks.tasks()) {
+        if (!task.enabled) disabled++;
+        if (task.runsAsSystem()) system++;
+        else if (task.highestPrivileges) elevated++;
+        if (task.hidden) hidden++;
+    }
+    
+    std::vector<ScheduledTaskFinding> findings = tasks.analyze();
+    
+    int score = 100;
+    bool critical = false;
+    for (const auto& finding : findings) {
+        int penalty = 15;
+        if (finding.severity == Severity::Critical) {
+            penalty = 25;
+            critical = true;
+        }
+        score -= penalty;
+        result.attribution.add(tasks.task(finding.task).path, penalty);
+    }
+    if (score < 0) score = 0;
+    
+    result.findings.number(FindingKey::Tasks, static_cast<int64_t>(tasks.size()));
+    result.findings.number(FindingKey::SystemTasks, system);
+    result.findings.number(FindingKey::ElevatedTasks, elevated);
+    result.findings.number(FindingKey::DisabledTasks, disabled);
+    result.findings.number(FindingKey::HiddenTasks, hidden);
+    result.findings.number(FindingKey::UnreadableTaskFiles, static_cast<int64_t>(tasks.unreadableCount()));
+    result.findings.number(FindingKey::WritableTaskActions, static_cast<int64_t>(findings.size()));
+    
+    const size_t maxListed = 10;
+    for (size_t i = 0; i < findings.size() && i < maxListed; ++i) {
+        result.findings.item(FindingKey::TaskIssue, tasks.task(findings[i].task).path, findings[i].reason, findings[i].severity);
+    }
+    if (findings.size() > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(findings.size() - maxListed));
+    }
+    result.score = score;
+    
+    if (tasks.size() == 0) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.recommendation = "No scheduled task definitions could be read. Run as administrator or point the check at the Tasks directory.";
+    } else {
+        const char* advice[] = {
+            "No elevated task starts code from a user-writable location. System is compliant.",
+            "Move the programs and scripts of elevated scheduled tasks into protected directories.",
+            "Unprivileged users can replace code run by SYSTEM or elevated scheduled tasks. Fix or disable the listed tasks immediately."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, critical)];
+    }
+    
+    return result;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "ComplianceCheck.h"
+
+class ScheduledTaskSet;
+
+class ScheduledTaskCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Scheduled Tasks"; }
+    
+    // Task definition tree to audit (e.g. the Tasks folder of an offline
+    // image); when unset, %SystemRoot%\System32\Tasks is read on a live
+    // scan and the module is not applicable with a registry provider
+    void setTasksDirectory(const std::string& directory) { tasksDirectory = directory; }
+    
+    // Score elevated tasks that start programs or scripts from user-writable paths (no system access)
+    static ComplianceResult evaluate(const ScheduledTaskSet& tasks);
+
+private:
+    std::string tasksDirectory;
+};
@@ -0,0 +1,282 @@
+#include "ScheduledTasks.h"
+#include "Persistence.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+#include "XmlReader.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+namespace {
+
+using TextUtil::equalsIgnoreCase;
+
+bool parseBool(std::string_view text) {
+    return equalsIgnoreCase(text, "true") || text == "1";
+}
+
+TaskLogonType parseLogonType(std::string_view text) {
+    if (text == "InteractiveToken") return TaskLogonType::InteractiveToken;
+    if (text == "Password") return TaskLogonType::Password;
+    if (text == "S4U") return TaskLogonType::S4U;
+    if (text == "ServiceAccount") return TaskLogonType::ServiceAccount;
+    if (text == "Group") return TaskLogonType::Group;
+    if (text == "InteractiveTokenOrPassword") return TaskLogonType::InteractiveTokenOrPassword;
+    return TaskLogonType::Unspecified;
+}
+
+uint32_t triggerBit(std::string_view element) {
+    if (element == "BootTrigger") return TriggerBoot;
+    if (element == "LogonTrigger") return TriggerLogon;
+    if (element == "TimeTrigger" || element == "CalendarTrigger") return TriggerTime;
+    if (element == "IdleTrigger") return TriggerIdle;
+    if (element == "EventTrigger") return TriggerEvent;
+    if (element == "RegistrationTrigger") return TriggerRegistration;
+    if (element == "SessionStateChangeTrigger") return TriggerSessionChange;
+    return 0;
+}
+
+// <Principal id="..."> of the task
+struct TaskPrincipal {
+    std::string id;
+    std::string userId;
+    std::string groupId;
+    TaskLogonType logonType = TaskLogonType::Unspecified;
+    bool highestPrivileges = false;
+};
+
+// Element nesting tracked while parsing; the fields read are at most four levels deep
+const size_t MaxDepth = 16;
+
+// Files an interpreter or loader argument may name
+const char* const ScriptExtensions[] = { ".ps1", ".psm1", ".bat", ".cmd", ".vbs", ".js", ".hta", ".exe", ".dll" };
+
+bool hasScriptExtension(std::string_view path) {
+    for (const char* extension : ScriptExtensions) {
+        size_t length = std::char_traits<char>::length(extension);
+        if (path.size() > length && equalsIgnoreCase(path.substr(path.size() - length), extension)) return true;
+    }
+    return false;
+}
+
+// Convert UTF-16LE task files into the caller's buffer; UTF-8 is used in place
+std::string_view taskText(std::string_view bytes, std::string& buffer) {
+    if (!TextEncoding::isUtf16LE(bytes)) return bytes;
+    size_t skip = (static_cast<unsigned char>(bytes[0]) == 0xFF && static_cast<unsigned char>(bytes[1]) == 0xFE) ? 2 : 0;
+    buffer.clear();
+    TextEncoding::appendUtf16LE(buffer, bytes.data() + skip, bytes.size() - skip);
+    return buffer;
+}
+
+// Argument tokens, splitting on spaces outside double quotes
+template <typename Fn>
+void forEachArgument(std::string_view arguments, Fn&& fn) {
+    size_t i = 0;
+    while (i < arguments.size()) {
+        while (i < arguments.size() && arguments[i] == ' ') i++;
+        size_t start = i;
+        bool quoted = false;
+        while (i < arguments.size() && (quoted || arguments[i] != ' ')) {
+            if (arguments[i] == '"') quoted = !quoted;
+            i++;
+        }
+        if (i > start) fn(arguments.substr(start, i - start));
+    }
+}
+
+} // namespace
+
+bool ScheduledTask::runsAsSystem() const {
+    return equalsIgnoreCase(userId, "S-1-5-18") || equalsIgnoreCase(userId, "SYSTEM") ||
+           equalsIgnoreCase(userId, "NT AUTHORITY\\SYSTEM") || equalsIgnoreCase(userId, "LocalSystem");
+}
+
+void ScheduledTaskSet::clear() {
+    taskList.clear();
+    unreadable = 0;
+}
+
+bool ScheduledTaskSet::parseTask(std::string_view document, ScheduledTask& task) {
+    XmlReader reader(document);
+    std::string_view stack[MaxDepth];
+    std::vector<TaskPrincipal> principals;
+    std::string context;
+    bool isTask = false;
+
+    for (XmlReader::Token token = reader.next(); token != XmlReader::Token::End; token = reader.next()) {
+        if (token == XmlReader::Token::Error) return false;
+        size_t depth = reader.depth();
+
+        if (token == XmlReader::Token::StartElement) {
+            std::string_view name = reader.name();
+            if (depth <= MaxDepth) stack[depth - 1] = name;
+            if (depth == 1) {
+                if (name != "Task") return false;
+                isTask = true;
+                continue;
+            }
+            if (depth > MaxDepth) continue;
+
+            std::string_view parent = stack[depth - 2];
+            if (parent == "Principals" && name == "Principal") {
+                principals.emplace_back();
+                XmlReader::decode(reader.attribute("id"), principals.back().id);
+            } else if (parent == "Triggers") {
+                task.triggers |= triggerBit(name);
+            } else if (depth == 2 && name == "Actions") {
+                XmlReader::decode(reader.attribute("Context"), context);
+            } else if (parent == "Actions") {
+                if (name == "Exec") task.actions.emplace_back();
+                else if (name == "ComHandler") task.comHandlers++;
+            }
+        } else if (token == XmlReader::Token::Text && depth >= 3 && depth <= MaxDepth) {
+            std::string_view element = stack[depth - 1];
+            std::string_view parent = stack[depth - 2];
+
+            if (parent == "RegistrationInfo" && element == "Author") {
+                reader.readText(task.author);
+            } else if (parent == "Settings" && depth == 3) {
+                if (element == "Enabled") task.enabled = parseBool(reader.text());
+                else if (element == "Hidden") task.hidden = parseBool(reader.text());
+            } else if (parent == "Principal" && !principals.empty()) {
+                TaskPrincipal& principal = principals.back();
+                if (element == "UserId") reader.readText(principal.userId);
+                else if (element == "GroupId") reader.readText(principal.groupId);
+                else if (element == "LogonType") principal.logonType = parseLogonType(reader.text());
+                else if (element == "RunLevel") principal.highestPrivileges = reader.text() == "HighestAvailable";
+            } else if (parent == "Exec" && stack[depth - 3] == "Actions" && !task.actions.empty()) {
+                TaskAction& action = task.actions.back();
+                if (element == "Command") reader.readText(action.command);
+                else if (element == "Arguments") reader.readText(action.arguments);
+                else if (element == "WorkingDirectory") reader.readText(action.workingDirectory);
+            }
+        }
+    }
+    if (!isTask) return false;
+
+    // Actions run as the principal named by their Context, else the only one
+    const TaskPrincipal* principal = principals.empty() ? nullptr : &principals.front();
+    for (const auto& candidate : principals) {
+        if (!context.empty() && candidate.id == context) principal = &candidate;
+    }
+    if (principal != nullptr) {
+        task.userId = principal->userId;
+        task.groupId = principal->groupId;
+        task.logonType = principal->logonType;
+        task.highestPrivileges = principal->highestPrivileges;
+    }
+    return true;
+}
+
+bool ScheduledTaskSet::add(std::string_view taskPath, std::string_view document) {
+    std::string buffer;
+    ScheduledTask task;
+    if (!parseTask(taskText(document, buffer), task)) {
+        unreadable++;
+        return false;
+    }
+    task.path = std::string(taskPath);
+    taskList.push_back(std::move(task));
+    return true;
+}
+
+bool ScheduledTaskSet::loadDirectory(const std::string& root) {
+    namespace fs = std::filesystem;
+
+    // Collect the file list first; task files have no extension
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec)) files.push_back(it->path());
+    }
+    if (files.empty()) return false;
+    std::sort(files.begin(), files.end());
+
+    std::vector<ScheduledTask> parsed(files.size());
+    std::vector<char> valid(files.size(), 0);
+
+    std::atomic<size_t> nextFile{ 0 };
+    auto worker = [&]() {
+        // Task files are a few KB: reading into reused buffers is cheaper than mapping each one
+        std::string bytes, buffer;
+        for (size_t i = nextFile++; i < files.size(); i = nextFile++) {
+            // Opened by the wide path: the names may be outside the ANSI code page
+            if (!TextEncoding::readFile(files[i], bytes)) continue;
+            valid[i] = parseTask(taskText(bytes, buffer), parsed[i]) ? 1 : 0;
+        }
+    };
+
+    // Files are small; keep a few per worker so thread start-up does not dominate
+    unsigned workers = threadCount != 0 ? threadCount : std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+    size_t maxWorkers = (files.size() + 15) / 16;
+    if (workers > maxWorkers) workers = static_cast<unsigned>(maxWorkers);
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Task path: "\Folder\Name" relative to the root
+    fs::path base(root);
+    taskList.reserve(taskList.size() + files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!valid[i]) {
+            unreadable++;
+            continue;
+        }
+        std::string relative = TextEncoding::pathToUtf8(files[i].lexically_relative(base));
+        std::replace(relative.begin(), relative.end(), '/', '\\');
+        parsed[i].path = "\\" + relative;
+        taskList.push_back(std::move(parsed[i]));
+    }
+    return !taskList.empty();
+}
+
+std::vector<ScheduledTaskFinding> ScheduledTaskSet::analyze() const {
+    std::vector<ScheduledTaskFinding> findings;
+
+    for (uint32_t i = 0; i < taskList.size(); ++i) {
+        const ScheduledTask& task = taskList[i];
+        if (!task.enabled || !task.runsElevated()) continue;
+        bool system = task.runsAsSystem();
+        Severity severity = system ? Severity::Critical : Severity::High;
+        const char* account = system ? "SYSTEM" : "highest privileges";
+
+        for (uint32_t a = 0; a < task.actions.size(); ++a) {
+            const TaskAction& action = task.actions[a];
+            std::string program = PersistenceInventory::executablePath(action.command);
+            if (PersistenceInventory::isUserWritablePath(program)) {
+                findings.push_back({ ScheduledTaskFinding::Kind::WritableProgram, i, a, severity,
+                                     std::string("Runs ") + program + " as " + account + " from a user-writable directory" });
+                continue;
+            }
+
+            // Interpreters and loaders started with a script or DLL the user can replace
+            std::string script;
+            forEachArgument(action.arguments, [&](std::string_view token) {
+                if (!script.empty() || (token.find('\\') == std::string_view::npos && token.find('%') == std::string_view::npos)) {
+                    return;
+                }
+                std::string path = PersistenceInventory::executablePath(token);
+                if (hasScriptExtension(path) && PersistenceInventory::isUserWritablePath(path)) script = path;
+            });
+            if (!script.empty()) {
+                findings.push_back({ ScheduledTaskFinding::Kind::WritableScript, i, a, severity,
+                                     std::string("Passes ") + script + " to " + program + " as " + account +
+                                     " from a user-writable directory" });
+            }
+        }
+    }
+
+    std::stable_sort(findings.begin(), findings.end(), [](const ScheduledTaskFinding& a, const ScheduledTaskFinding& b) {
+        return static_cast<int>(a.severity) > static_cast<int>(b.severity);
+    });
+    return findings;
+}
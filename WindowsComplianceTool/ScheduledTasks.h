@@ -0,0 +1,100 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Trigger bits of ScheduledTask::triggers
+const uint32_t TriggerBoot = 0x01;
+const uint32_t TriggerLogon = 0x02;
+const uint32_t TriggerTime = 0x04;          // TimeTrigger and CalendarTrigger
+const uint32_t TriggerIdle = 0x08;
+const uint32_t TriggerEvent = 0x10;
+const uint32_t TriggerRegistration = 0x20;
+const uint32_t TriggerSessionChange = 0x40;
+
+enum class TaskLogonType : uint8_t {
+    Unspecified,
+    InteractiveToken,
+    Password,
+    S4U,
+    ServiceAccount,
+    Group,
+    InteractiveTokenOrPassword
+};
+
+// Exec action of a task
+struct TaskAction {
+    std::string command;
+    std::string arguments;
+    std::string workingDirectory;
+};
+
+// One task definition file under %SystemRoot%\System32\Tasks
+struct ScheduledTask {
+    std::string path;           // task path relative to the Tasks directory, "\Microsoft\Windows\..."
+    std::string author;
+    std::string userId;         // principal the actions run as (SID or account name)
+    std::string groupId;
+    TaskLogonType logonType = TaskLogonType::Unspecified;
+    bool highestPrivileges = false;     // RunLevel HighestAvailable
+    bool enabled = true;
+    bool hidden = false;
+    uint32_t triggers = 0;              // Trigger* bits
+    uint32_t comHandlers = 0;           // ComHandler actions (not listed in actions)
+    std::vector<TaskAction> actions;
+
+    bool runsAsSystem() const;          // LocalSystem principal
+    bool runsElevated() const { return runsAsSystem() || highestPrivileges; }
+};
+
+struct ScheduledTaskFinding {
+    enum class Kind {
+        WritableProgram,    // action starts a program from a user-writable directory
+        WritableScript      // action arguments name a script or binary in a user-writable directory
+    };
+
+    Kind kind;
+    uint32_t task;
+    uint32_t action;
+    Severity severity;
+    std::string reason;
+};
+
+// Task Scheduler definitions read straight from the Tasks directory tree.
+// The tree holds hundreds of small XML files, so the file list is built
+// first and the files are then read and parsed by a pool of workers
+// pulling indexes from a shared counter. Each worker reuses its read and
+// UTF-16LE decode buffers and parses with the non-allocating XmlReader,
+// so only the extracted task fields are copied.
+class ScheduledTaskSet {
+public:
+    // Every task file under root (the Tasks directory or a copy of it)
+    bool loadDirectory(const std::string& root);
+
+    // One task definition, UTF-8 or UTF-16LE bytes; false if it is not a task
+    bool add(std::string_view taskPath, std::string_view document);
+
+    // Parse a UTF-8 task definition
+    static bool parseTask(std::string_view document, ScheduledTask& task);
+
+    // Worker threads for loadDirectory, 0 = hardware concurrency
+    void setThreadCount(unsigned count) { threadCount = count; }
+
+    void clear();
+    size_t size() const { return taskList.size(); }
+    const ScheduledTask& task(size_t index) const { return taskList[index]; }
+    const std::vector<ScheduledTask>& tasks() const { return taskList; }
+
+    // Files that could not be read or are not task definitions
+    size_t unreadableCount() const { return unreadable; }
+
+    // Findings for enabled tasks that run as SYSTEM or with highest privileges, most severe first
+    std::vector<ScheduledTaskFinding> analyze() const;
+
+private:
+    std::vector<ScheduledTask> taskList;
+    size_t unreadable = 0;
+    unsigned threadCount = 0;
+};
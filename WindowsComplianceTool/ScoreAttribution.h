@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// Points one input (a setting, account, share, application...) took off a
+// module's score
+struct ScoreContribution {
+    char setting[48];               // truncated, always NUL-terminated
+    float points;                   // fractional where the score is a weighted average
+};
+
+// The inputs that cost a module the most points. The buffer is fixed, so
+// recording never allocates and checks record every penalty they apply;
+// once it is full a larger contribution replaces the smallest and the
+// points dropped are still counted in total().
+class ScoreAttribution {
+public:
+    static constexpr size_t Capacity = 8;
+
+    void add(std::string_view setting, float points) {
+        if (!(points > 0)) return;
+        totalPoints += points;
+        size_t slot = count;
+        if (count == Capacity) {
+            slot = 0;
+            for (size_t i = 1; i < Capacity; ++i) {
+                if (entries[i].points < entries[slot].points) slot = i;
+            }
+            if (entries[slot].points >= points) return;
+        } else {
+            count++;
+        }
+        size_t length = setting.size() < sizeof(entries[slot].setting) - 1 ? setting.size() : sizeof(entries[slot].setting) - 1;
+        std::memcpy(entries[slot].setting, setting.data(), length);
+        entries[slot].setting[length] = '\0';
+        entries[slot].points = points;
+    }
+
+    void clear() { count = 0; totalPoints = 0; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const ScoreContribution& operator[](size_t i) const { return entries[i]; }
+    const ScoreContribution* begin() const { return entries.data(); }
+    const ScoreContribution* end() const { return entries.data() + count; }
+
+    // Every recorded point, including contributions no longer in the
+    // buffer. Can exceed the points lost when a score was clamped at 0.
+    float total() const { return totalPoints; }
+
+private:
+    std::array<ScoreContribution, Capacity> entries{};
+    size_t count = 0;
+    float totalPoints = 0;
+};
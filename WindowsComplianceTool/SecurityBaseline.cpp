@@ -0,0 +1,266 @@
+#include "SecurityBaseline.h"
+#include "CsvReader.h"
+#include "FactTable.h"
+#include "Revision.h"
+#include "TextUtil.h"
+#include <algorithm>
+
+namespace {
+
+using TextUtil::containsIgnoreCase;
+using TextUtil::equalsIgnoreCase;
+using TextUtil::lessIgnoreCase;
+using TextUtil::startsWithIgnoreCase;
+using TextUtil::trim;
+
+// Numbers in the definition may be padded
+bool parseNumber(std::string_view text, int64_t& value) {
+    return TextUtil::parseNumber(trim(text), value);
+}
+
+// Split on a separator, trimming each part
+std::vector<std::string> split(std::string_view text, char separator) {
+    std::vector<std::string> parts;
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t end = text.find(separator, pos);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view part = trim(text.substr(pos, end - pos));
+        if (!part.empty()) parts.emplace_back(part);
+        pos = end + 1;
+    }
+    return parts;
+}
+
+const std::string_view SecurityPolicyPrefix = "SecurityPolicy\\";
+
+bool isSecurityPolicy(std::string_view keyPath) {
+    return startsWithIgnoreCase(keyPath, SecurityPolicyPrefix);
+}
+
+} // namespace
+
+bool SecurityBaseline::parseComparator(std::string_view text, BaselineComparator& comparator) {
+    static const struct { const char* name; BaselineComparator comparator; } Names[] = {
+        { "=", BaselineComparator::Equal }, { "==", BaselineComparator::Equal },
+        { "!=", BaselineComparator::NotEqual }, { ">=", BaselineComparator::AtLeast },
+        { "<=", BaselineComparator::AtMost }, { "between", BaselineComparator::Between },
+        { "oneof", BaselineComparator::OneOf }, { "contains", BaselineComparator::Contains },
+        { "subset", BaselineComparator::Subset }, { "exists", BaselineComparator::Exists },
+        { "missing", BaselineComparator::Missing }
+    };
+    text = trim(text);
+    for (const auto& entry : Names) {
+        if (equalsIgnoreCase(text, entry.name)) {
+            comparator = entry.comparator;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* SecurityBaseline::comparatorSymbol(BaselineComparator comparator) {
+    switch (comparator) {
+        case BaselineComparator::Equal: return "=";
+        case BaselineComparator::NotEqual: return "!=";
+        case BaselineComparator::AtLeast: return ">=";
+        case BaselineComparator::AtMost: return "<=";
+        case BaselineComparator::Between: return "between";
+        case BaselineComparator::OneOf: return "one of";
+        case BaselineComparator::Contains: return "contains";
+        case BaselineComparator::Subset: return "only";
+        case BaselineComparator::Exists: return "set";
+        case BaselineComparator::Missing: return "not set";
+    }
+    return "";
+}
+
+std::string SecurityBaseline::describeExpected(const BaselineControl& control) {
+    if (control.comparator == BaselineComparator::Exists || control.comparator == BaselineComparator::Missing) {
+        return comparatorSymbol(control.comparator);
+    }
+    return std::string(comparatorSymbol(control.comparator)) + " " + control.expected;
+}
+
+bool SecurityBaseline::add(BaselineControl control) {
+    if (control.keyPath.empty() || control.valueName.empty()) return false;
+
+    // Fact names match what FactTable stores for the same setting
+    if (isSecurityPolicy(control.keyPath)) {
+        control.factName = FactTable::securityPolicyName(control.keyPath.substr(SecurityPolicyPrefix.size()), control.valueName);
+    } else {
+        control.keyPath = FactTable::canonicalKeyPath(control.keyPath);
+        control.factName = FactTable::registryName(control.keyPath, control.valueName);
+    }
+    control.factHash = FactTable::hashName(control.factName);
+
+    control.options.clear();
+    switch (control.comparator) {
+        case BaselineComparator::AtLeast:
+        case BaselineComparator::AtMost:
+            if (!parseNumber(control.expected, control.low)) return false;
+            control.high = control.low;
+            control.numeric = true;
+            break;
+        case BaselineComparator::Between: {
+            size_t dots = control.expected.find("..");
+            if (dots == std::string::npos ||
+                !parseNumber(std::string_view(control.expected).substr(0, dots), control.low) ||
+                !parseNumber(std::string_view(control.expected).substr(dots + 2), control.high) ||
+                control.low > control.high) {
+                return false;
+            }
+            control.numeric = true;
+            break;
+        }
+        case BaselineComparator::Equal:
+        case BaselineComparator::NotEqual:
+            control.numeric = parseNumber(control.expected, control.low);
+            control.high = control.low;
+            break;
+        case BaselineComparator::OneOf:
+        case BaselineComparator::Subset:
+            control.options = split(control.expected, '|');
+            if (control.options.empty() && control.comparator == BaselineComparator::OneOf) return false;
+            break;
+        default:
+            break;
+    }
+
+    // The default is a constant: decide once whether relying on it passes
+    if (control.hasDefault) {
+        int64_t number = 0;
+        bool numeric = parseNumber(control.defaultValue, number);
+        control.defaultPasses = control.comparator != BaselineComparator::Missing &&
+                                matches(control, control.defaultValue, numeric, number);
+    } else {
+        // Nothing set: passes only when the control asks for nothing
+        control.defaultPasses = control.comparator == BaselineComparator::Missing ||
+                                control.comparator == BaselineComparator::Subset;
+    }
+
+    entries.push_back(std::move(control));
+    revisionId = nextRevision();
+    return true;
+}
+
+bool SecurityBaseline::loadFromCsv(const CsvReader& table) {
+    int idColumn = table.columnIndex("Id");
+    int titleColumn = table.columnIndex("Title");
+    int severityColumn = table.columnIndex("Severity");
+    int pathColumn = table.columnIndex("Path");
+    int valueColumn = table.columnIndex("Value");
+    int comparatorColumn = table.columnIndex("Comparator");
+    int expectedColumn = table.columnIndex("Expected");
+    int defaultColumn = table.columnIndex("Default");
+    if (pathColumn < 0 || valueColumn < 0 || comparatorColumn < 0) return false;
+
+    entries.reserve(entries.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        BaselineControl control;
+        if (!parseComparator(row[comparatorColumn], control.comparator)) {
+            invalid++;
+            continue;
+        }
+        control.id = row.value(idColumn);
+        control.title = row.value(titleColumn);
+        control.severity = parseSeverity(row[severityColumn]);
+        control.keyPath = row.value(pathColumn);
+        control.valueName = row.value(valueColumn);
+        control.expected = row.value(expectedColumn);
+        control.defaultValue = row.value(defaultColumn);
+        control.hasDefault = !control.defaultValue.empty();
+        if (!add(std::move(control))) invalid++;
+    }
+    return !entries.empty();
+}
+
+bool SecurityBaseline::loadFile(const std::string& path) {
+    CsvReader table;
+    return table.loadFromFile(path) && loadFromCsv(table);
+}
+
+std::vector<std::string> SecurityBaseline::registryKeys() const {
+    std::vector<std::string> keys;
+    for (const auto& control : entries) {
+        if (!isSecurityPolicy(control.keyPath)) keys.push_back(control.keyPath);
+    }
+    std::sort(keys.begin(), keys.end(), [](const std::string& a, const std::string& b) {
+        return lessIgnoreCase(a, b);
+    });
+    keys.erase(std::unique(keys.begin(), keys.end(), [](const std::string& a, const std::string& b) {
+        return equalsIgnoreCase(a, b);
+    }), keys.end());
+    return keys;
+}
+
+bool SecurityBaseline::usesSecurityPolicy() const {
+    for (const auto& control : entries) {
+        if (isSecurityPolicy(control.keyPath)) return true;
+    }
+    return false;
+}
+
+bool SecurityBaseline::matches(const BaselineControl& control, std::string_view value, bool numeric, int64_t number) {
+    switch (control.comparator) {
+        case BaselineComparator::Equal:
+            return control.numeric && numeric ? number == control.low : equalsIgnoreCase(value, control.expected);
+        case BaselineComparator::NotEqual:
+            return control.numeric && numeric ? number != control.low : !equalsIgnoreCase(value, control.expected);
+        case BaselineComparator::AtLeast:
+            return numeric && number >= control.low;
+        case BaselineComparator::AtMost:
+            return numeric && number <= control.low;
+        case BaselineComparator::Between:
+            return numeric && number >= control.low && number <= control.high;
+        case BaselineComparator::OneOf:
+            for (const auto& option : control.options) {
+                if (equalsIgnoreCase(value, option)) return true;
+            }
+            return false;
+        case BaselineComparator::Contains:
+            return containsIgnoreCase(value, control.expected);
+        case BaselineComparator::Subset: {
+            // secedit lists holders as "*S-1-5-32-544,*S-1-5-32-545"
+            size_t pos = 0;
+            while (pos <= value.size()) {
+                size_t end = value.find(',', pos);
+                if (end == std::string_view::npos) end = value.size();
+                std::string_view holder = trim(value.substr(pos, end - pos));
+                pos = end + 1;
+                if (holder.empty()) continue;
+                bool allowed = false;
+                for (const auto& option : control.options) {
+                    if (equalsIgnoreCase(holder, option)) {
+                        allowed = true;
+                        break;
+                    }
+                }
+                if (!allowed) return false;
+            }
+            return true;
+        }
+        case BaselineComparator::Exists:
+            return true;
+        case BaselineComparator::Missing:
+            return false;
+    }
+    return false;
+}
+
+void SecurityBaseline::evaluate(const FactTable& facts, std::vector<BaselineOutcome>& outcomes) const {
+    outcomes.clear();
+    outcomes.reserve(entries.size());
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        outcomes.push_back(evaluate(i, facts, facts.find(entries[i].factName, entries[i].factHash)));
+    }
+}
+
+BaselineOutcome SecurityBaseline::evaluate(uint32_t index, const FactTable& facts, uint32_t fact) const {
+    const BaselineControl& control = entries[index];
+    if (fact == FactTable::NotFound) return { index, control.defaultPasses, false, fact };
+    int64_t number = 0;
+    bool numeric = facts.number(fact, number);
+    return { index, matches(control, facts.value(fact), numeric, number), true, fact };
+}
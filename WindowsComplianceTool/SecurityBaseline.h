@@ -0,0 +1,102 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CsvReader;
+class FactTable;
+
+// How a control's expected value is compared with the host's value
+enum class BaselineComparator {
+    Equal,          // =   numbers numerically, text case-insensitively
+    NotEqual,       // !=
+    AtLeast,        // >=
+    AtMost,         // <=
+    Between,        // low..high, inclusive
+    OneOf,          // a|b|c
+    Contains,       // case-insensitive substring
+    Subset,         // every comma-separated holder is one of a|b|c (user rights)
+    Exists,         // any value
+    Missing         // value must not be set
+};
+
+// One benchmark recommendation (a CIS or STIG control)
+struct BaselineControl {
+    std::string id;
+    std::string title;
+    std::string keyPath;            // registry key, or "SecurityPolicy\<section>" for secedit values
+    std::string valueName;
+    BaselineComparator comparator = BaselineComparator::Equal;
+    std::string expected;
+    std::string defaultValue;       // value Windows uses when the setting is absent
+    bool hasDefault = false;
+    Severity severity = Severity::Medium;
+
+    // Compiled by SecurityBaseline::add
+    std::string factName;
+    uint32_t factHash = 0;
+    bool numeric = false;           // expected is a number (or a numeric range)
+    int64_t low = 0, high = 0;
+    std::vector<std::string> options;
+    bool defaultPasses = false;
+};
+
+// Result of one control on one host
+struct BaselineOutcome {
+    uint32_t control;               // index into SecurityBaseline::controls()
+    bool passed;
+    bool configured;                // false if the host does not set the value
+    uint32_t fact;                  // FactTable id, FactTable::NotFound if not configured
+};
+
+// Benchmark definition: hundreds of expected settings, each compiled once
+// (fact name hashed, expected value parsed) so evaluating a host is one
+// hashed lookup and one comparison per control.
+//
+// CSV columns: Id, Title, Severity, Path, Value, Comparator, Expected and
+// optional Default. Path is a registry key (HKLM\... or
+// HKEY_LOCAL_MACHINE\...) or "SecurityPolicy\<section>" for secedit values.
+class SecurityBaseline {
+public:
+    bool loadFile(const std::string& path);
+    bool loadFromCsv(const CsvReader& table);
+
+    // Compile and append a control, false if its comparator or expected
+    // value cannot be used
+    bool add(BaselineControl control);
+
+    const std::vector<BaselineControl>& controls() const { return entries; }
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    // Changes with every control added (see Revision.h)
+    uint64_t revision() const { return revisionId; }
+
+    // Rows skipped when loading
+    size_t invalidCount() const { return invalid; }
+
+    // Registry keys the controls read, each once, for collecting facts
+    std::vector<std::string> registryKeys() const;
+    bool usesSecurityPolicy() const;
+
+    // Pass/fail of every control against one host's facts
+    void evaluate(const FactTable& facts, std::vector<BaselineOutcome>& outcomes) const;
+    
+    // One control, given the id of the fact it reads (NotFound if unset)
+    BaselineOutcome evaluate(uint32_t control, const FactTable& facts, uint32_t fact) const;
+
+    static bool parseComparator(std::string_view text, BaselineComparator& comparator);
+    static const char* comparatorSymbol(BaselineComparator comparator);
+
+    // Expected value as shown in reports (">= 14", "1|2", "not set")
+    static std::string describeExpected(const BaselineControl& control);
+
+private:
+    std::vector<BaselineControl> entries;
+    size_t invalid = 0;
+    uint64_t revisionId = 0;
+
+    static bool matches(const BaselineControl& control, std::string_view value, bool numeric, int64_t number);
+};
@@ -0,0 +1,120 @@
+#include "SecurityBaselineCheck.h"
+#include "FactTable.h"
+#include "PolicyTables.h"
+#include <filesystem>
+
+void SecurityBaselineCheck::collectFacts(const SecurityBaseline& definition, FactTable& facts) {
+    collectSettings(definition.registryKeys(), definition.usesSecurityPolicy(), facts);
+}
+
+ComplianceResult SecurityBaselineCheck::performCheck() {
+    outcomes.clear();
+    facts.clear();
+    
+    // Load the local benchmark once and keep it for later scans
+    if (!baseline) {
+        std::string path = dataFilePath("SecurityBaseline.csv");
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            auto definition = std::make_shared<SecurityBaseline>();
+            if (definition->loadFile(path)) {
+                baseline = definition;
+            }
+        }
+    }
+    
+    if (!baseline) {
+        ComplianceResult result("Security Baseline",
+                               "Compares registry and security policy settings against a CIS/STIG benchmark definition.",
+                               CheckStatus::NotApplicable, Severity::Medium, 0);
+        result.findings.message(FindingKey::BaselineMissing);
+        result.recommendation = "Place SecurityBaseline.csv next to the executable or configure a benchmark definition.";
+        return result;
+    }
+    
+    collectFacts(*baseline, facts);
+    return evaluate(*baseline, facts, outcomes);
+}
+
+ComplianceResult SecurityBaselineCheck::evaluate(const SecurityBaseline& definition, const FactTable& facts) {
+    std::vector<BaselineOutcome> outcomes;
+    return evaluate(definition, facts, outcomes);
+}
+
+ComplianceResult SecurityBaselineCheck::evaluate(const SecurityBaseline& definition, const FactTable& facts,
+                                                 std::vector<BaselineOutcome>& outcomes) {
+    ComplianceResult result("Security Baseline",
+                           "Compares registry and security policy settings against a CIS/STIG benchmark definition.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    definition.evaluate(facts, outcomes);
+    
+    int passedWeight = 0, totalWeight = 0;
+    int passed = 0, failed = 0, notConfigured = 0, criticalFailed = 0;
+    for (const auto& outcome : outcomes) {
+        const BaselineControl& control = definition.controls()[outcome.control];
+        int weight = PolicyTables::weight<ModuleWeights>(control.severity);
+        totalWeight += weight;
+        if (outcome.passed) {
+            passed++;
+            passedWeight += weight;
+        } else {
+            failed++;
+            if (!outcome.configured) notConfigured++;
+            if (control.severity == Severity::Critical) criticalFailed++;
+        }
+    }
+    int score = totalWeight > 0 ? passedWeight * 100 / totalWeight : 0;
+    
+    // A failed control costs its share of the weight
+    for (const auto& outcome : outcomes) {
+        if (outcome.passed) continue;
+        const BaselineControl& control = definition.controls()[outcome.control];
+        result.attribution.add(control.id, 100.0f * PolicyTables::weight<ModuleWeights>(control.severity) / totalWeight);
+    }
+    
+    result.findings.number(FindingKey::Controls, static_cast<int64_t>(outcomes.size()));
+    result.findings.number(FindingKey::PassedControls, passed);
+    result.findings.number(FindingKey::FailedControls, failed);
+    result.findings.number(FindingKey::NotConfiguredControls, notConfigured);
+    result.findings.number(FindingKey::SettingsCollected, static_cast<int64_t>(facts.size()));
+    
+    // Most severe failures first
+    const size_t maxListed = 10;
+    size_t listed = 0;
+    for (Severity severity : { Severity::Critical, Severity::High, Severity::Medium, Severity::Low }) {
+        for (const auto& outcome : outcomes) {
+            const BaselineControl& control = definition.controls()[outcome.control];
+            if (outcome.passed || control.severity != severity || listed >= maxListed) continue;
+            result.findings.item(FindingKey::FailedControl, control.id,
+                                 control.title + ": expected " + SecurityBaseline::describeExpected(control) + ", found " +
+                                     (outcome.configured ? "'" + facts.value(outcome.fact) + "'" : std::string("not configured")),
+                                 control.severity);
+            listed++;
+        }
+    }
+    if (static_cast<size_t>(failed) > maxListed) {
+        result.findings.number(FindingKey::More, static_cast<int64_t>(failed - maxListed));
+    }
+    
+    result.score = score;
+    
+    if (outcomes.empty() || facts.empty()) {
+        result.status = CheckStatus::NotApplicable;
+        result.severity = Severity::Medium;
+        result.score = 0;
+        result.attribution.clear();
+        result.recommendation = "No settings could be collected for the benchmark. Run the tool elevated or provide offline hives.";
+    } else {
+        const char* advice[] = {
+            failed == 0
+                ? "All benchmark controls pass. System is compliant."
+                : "Remediate the remaining failed controls.",
+            "Apply the benchmark's Group Policy settings for the failed controls.",
+            "The host deviates from the benchmark in many controls. Apply the benchmark GPO and rescan."
+        };
+        result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score, criticalFailed > 0)];
+    }
+    
+    return result;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "ComplianceCheck.h"
+#include "FactTable.h"
+#include "SecurityBaseline.h"
+#include <memory>
+#include <vector>
+
+class SecurityBaselineCheck : public ComplianceCheck {
+public:
+    ComplianceResult performCheck() override;
+    std::string getModuleName() const override { return "Security Baseline"; }
+    
+    // Benchmark definition shared across scans; when unset,
+    // SecurityBaseline.csv in the working directory is loaded if present
+    void setBaseline(std::shared_ptr<const SecurityBaseline> definition) { baseline = std::move(definition); }
+    const std::shared_ptr<const SecurityBaseline>& getBaseline() const { return baseline; }
+    
+    // Settings collected by the last scan
+    const FactTable& getFacts() const { return facts; }
+    
+    // Per-control outcomes of the last scan, kept for framework scoring and
+    // what-if simulation
+    const std::vector<BaselineOutcome>& getOutcomes() const { return outcomes; }
+    
+    // Collect every setting the baseline reads into one fact table:
+    // each registry key is read once, secedit is exported once
+    void collectFacts(const SecurityBaseline& definition, FactTable& facts);
+    
+    // Score per-control pass/fail, weighted by control severity (no system access)
+    static ComplianceResult evaluate(const SecurityBaseline& definition, const FactTable& facts);
+    static ComplianceResult evaluate(const SecurityBaseline& definition, const FactTable& facts,
+                                     std::vector<BaselineOutcome>& outcomes);
+
+private:
+    std::shared_ptr<const SecurityBaseline> baseline;
+    FactTable facts;
+    std::vector<BaselineOutcome> outcomes;
+};
@@ -0,0 +1,337 @@
+#include "SecurityDescriptor.h"
+#include "BinaryRead.h"
+#include <cctype>
+
+namespace {
+
+using BinaryRead::formatSid;
+using BinaryRead::readU16;
+using BinaryRead::readU32;
+
+struct NamedValue {
+    const char* name;
+    const char* value;
+};
+
+// SDDL SID abbreviations that do not depend on the domain
+const NamedValue SidAliases[] = {
+    { "WD", "S-1-1-0" }, { "CO", "S-1-3-0" }, { "CG", "S-1-3-1" }, { "OW", "S-1-3-4" },
+    { "NU", "S-1-5-2" }, { "IU", "S-1-5-4" }, { "SU", "S-1-5-6" }, { "AN", "S-1-5-7" },
+    { "ED", "S-1-5-9" }, { "PS", "S-1-5-10" }, { "AU", "S-1-5-11" }, { "RC", "S-1-5-12" },
+    { "SY", "S-1-5-18" }, { "LS", "S-1-5-19" }, { "NS", "S-1-5-20" }, { "WR", "S-1-5-33" },
+    { "BA", "S-1-5-32-544" }, { "BU", "S-1-5-32-545" }, { "BG", "S-1-5-32-546" }, { "PU", "S-1-5-32-547" },
+    { "AO", "S-1-5-32-548" }, { "SO", "S-1-5-32-549" }, { "PO", "S-1-5-32-550" }, { "BO", "S-1-5-32-551" },
+    { "RE", "S-1-5-32-552" }, { "RU", "S-1-5-32-554" }, { "RD", "S-1-5-32-555" }, { "NO", "S-1-5-32-556" },
+    { "MU", "S-1-5-32-558" }, { "LU", "S-1-5-32-559" }, { "HA", "S-1-5-32-578" }, { "RM", "S-1-5-32-580" },
+    { "AC", "S-1-15-2-1" }
+};
+
+struct NamedRight {
+    const char* name;
+    uint32_t mask;
+};
+
+const NamedRight Rights[] = {
+    { "GA", 0x10000000 }, { "GR", 0x80000000 }, { "GW", 0x40000000 }, { "GX", 0x20000000 },
+    { "RC", 0x00020000 }, { "SD", 0x00010000 }, { "WD", 0x00040000 }, { "WO", 0x00080000 },
+    { "RP", 0x00000010 }, { "WP", 0x00000020 }, { "CC", 0x00000001 }, { "DC", 0x00000002 },
+    { "LC", 0x00000004 }, { "SW", 0x00000008 }, { "LO", 0x00000080 }, { "DT", 0x00000040 },
+    { "CR", 0x00000100 }, { "FA", AccessMask::FileAllAccess }, { "FR", AccessMask::FileGenericRead },
+    { "FW", AccessMask::FileGenericWrite }, { "FX", AccessMask::FileGenericExecute },
+    { "KA", 0x000F003F }, { "KR", 0x00020019 }, { "KW", 0x00020006 }, { "KX", 0x00020019 }
+};
+
+// Group SIDs of each WellKnownPrincipal's network logon token
+const char* const PrincipalSids[][5] = {
+    { "S-1-1-0", "S-1-5-2", nullptr },                                  // Everyone
+    { "S-1-5-7", "S-1-5-2", nullptr },                                  // Anonymous
+    { "S-1-1-0", "S-1-5-11", "S-1-5-2", nullptr },                      // Authenticated Users
+    { "S-1-1-0", "S-1-5-11", "S-1-5-32-545", "S-1-5-2", nullptr },      // Users
+    { "S-1-1-0", "S-1-5-32-546", "S-1-5-2", nullptr }                   // Guests
+};
+
+const char* const PrincipalNames[] = { "Everyone", "Anonymous", "Authenticated Users", "Users", "Guests" };
+
+// File generic mapping
+uint32_t mapGenericRights(uint32_t mask) {
+    if (mask & 0x80000000) mask |= AccessMask::FileGenericRead;
+    if (mask & 0x40000000) mask |= AccessMask::FileGenericWrite;
+    if (mask & 0x20000000) mask |= AccessMask::FileGenericExecute;
+    if (mask & 0x10000000) mask |= AccessMask::FileAllAccess;
+    return mask & 0x0FFFFFFF;
+}
+
+bool parseRights(std::string_view text, uint32_t& mask) {
+    mask = 0;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        if (text.size() > 10) return false;
+        for (size_t i = 2; i < text.size(); ++i) {
+            char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+            uint32_t digit;
+            if (c >= '0' && c <= '9') digit = static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') digit = static_cast<uint32_t>(c - 'a' + 10);
+            else return false;
+            mask = (mask << 4) | digit;
+        }
+        return true;
+    }
+    if (!text.empty() && std::isdigit(static_cast<unsigned char>(text[0]))) {
+        uint64_t value = 0;
+        for (char c : text) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+            if (value > 0xFFFFFFFFu) return false;
+        }
+        mask = static_cast<uint32_t>(value);
+        return true;
+    }
+    if (text.size() % 2 != 0) return false;
+    for (size_t i = 0; i < text.size(); i += 2) {
+        std::string_view code = text.substr(i, 2);
+        bool known = false;
+        for (const auto& right : Rights) {
+            if (code == right.name) {
+                mask |= right.mask;
+                known = true;
+                break;
+            }
+        }
+        if (!known) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SecurityDescriptorCache::SecurityDescriptorCache(std::pmr::memory_resource* memory)
+    : aces(memory), descriptors(memory), sddlIndex(memory), binaryIndex(memory), sidIndex(memory),
+      sidNames(memory), key(memory) {
+    for (size_t p = 0; p < static_cast<size_t>(WellKnownPrincipal::Count); ++p) {
+        for (const char* const* sid = PrincipalSids[p]; *sid != nullptr; ++sid) {
+            tokens[p].push_back(internSid(*sid));
+        }
+    }
+}
+
+const char* SecurityDescriptorCache::principalName(WellKnownPrincipal principal) {
+    return PrincipalNames[static_cast<size_t>(principal)];
+}
+
+void SecurityDescriptorCache::clear() {
+    aces.clear();
+    descriptors.clear();
+    sddlIndex.clear();
+    binaryIndex.clear();
+}
+
+uint32_t SecurityDescriptorCache::internSid(std::string_view sid) {
+    for (const auto& alias : SidAliases) {
+        if (sid == alias.name) {
+            sid = alias.value;
+            break;
+        }
+    }
+
+    key.assign(sid);
+    auto it = sidIndex.find(key);
+    if (it != sidIndex.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(sidNames.size());
+    sidNames.push_back(key);
+    sidIndex.emplace(key, id);
+    return id;
+}
+
+uint32_t SecurityDescriptorCache::addSddl(std::string_view sddl) {
+    key.assign(sddl);
+    auto it = sddlIndex.find(key);
+    if (it != sddlIndex.end()) {
+        return it->second;
+    }
+
+    Descriptor descriptor;
+    size_t aceMark = aces.size();
+    uint32_t id = InvalidDescriptor;
+    if (parseSddl(sddl, descriptor)) {
+        id = finish(descriptor);
+    } else {
+        aces.resize(aceMark);
+    }
+    sddlIndex.emplace(std::string_view(sddl), id);
+    return id;
+}
+
+uint32_t SecurityDescriptorCache::addBinary(const void* data, size_t size) {
+    key.assign(static_cast<const char*>(data), size);
+    auto it = binaryIndex.find(key);
+    if (it != binaryIndex.end()) {
+        return it->second;
+    }
+
+    Descriptor descriptor;
+    size_t aceMark = aces.size();
+    uint32_t id = InvalidDescriptor;
+    if (parseBinary(static_cast<const unsigned char*>(data), size, descriptor)) {
+        id = finish(descriptor);
+    } else {
+        aces.resize(aceMark);
+    }
+    binaryIndex.emplace(std::string_view(static_cast<const char*>(data), size), id);
+    return id;
+}
+
+bool SecurityDescriptorCache::parseSddl(std::string_view sddl, Descriptor& descriptor) {
+    descriptor.firstAce = static_cast<uint32_t>(aces.size());
+
+    // Locate the D: section; section tags only appear outside parentheses
+    size_t dacl = std::string_view::npos;
+    size_t daclEnd = sddl.size();
+    int depth = 0;
+    for (size_t i = 0; i < sddl.size(); ++i) {
+        char c = sddl[i];
+        if (c == '(') depth++;
+        else if (c == ')') depth--;
+        else if (depth == 0 && i + 1 < sddl.size() && sddl[i + 1] == ':' && (c == 'O' || c == 'G' || c == 'D' || c == 'S')) {
+            if (dacl != std::string_view::npos && daclEnd == sddl.size()) daclEnd = i;
+            if (c == 'D') dacl = i + 2;
+        }
+    }
+    if (depth != 0) return false;
+    if (dacl == std::string_view::npos) {
+        return true;    // no DACL: unrestricted access
+    }
+
+    std::string_view section = sddl.substr(dacl, daclEnd - dacl);
+    size_t open = section.find('(');
+    std::string_view flags = section.substr(0, open);
+    if (flags.find("NO_ACCESS_CONTROL") != std::string_view::npos) {
+        return true;
+    }
+    descriptor.hasDacl = true;
+
+    while (open != std::string_view::npos) {
+        size_t close = section.find(')', open);
+        if (close == std::string_view::npos) return false;
+        std::string_view ace = section.substr(open + 1, close - open - 1);
+        open = section.find('(', close);
+
+        // type;flags;rights;object;inherited object;sid[;resource attribute]
+        std::string_view fields[6];
+        size_t count = 0;
+        size_t start = 0;
+        while (count < 6) {
+            size_t semi = ace.find(';', start);
+            fields[count++] = ace.substr(start, semi == std::string_view::npos ? std::string_view::npos : semi - start);
+            if (semi == std::string_view::npos) break;
+            start = semi + 1;
+        }
+        if (count < 6) return false;
+
+        AccessControlEntry entry;
+        std::string_view type = fields[0];
+        if (type == "A" || type == "OA" || type == "XA") entry.type = AceAllow;
+        else if (type == "D" || type == "OD") entry.type = AceDeny;
+        else continue;      // audit, alarm and conditional deny ACEs do not decide access here
+
+        entry.flags = 0;
+        for (size_t i = 0; i + 1 < fields[1].size(); i += 2) {
+            if (fields[1].substr(i, 2) == "IO") entry.flags |= AceInheritOnly;
+        }
+
+        uint32_t mask;
+        if (!parseRights(fields[2], mask) || fields[5].empty()) return false;
+        entry.mask = mapGenericRights(mask);
+        entry.sid = internSid(fields[5]);
+        aces.push_back(entry);
+    }
+    return true;
+}
+
+bool SecurityDescriptorCache::parseBinary(const unsigned char* data, size_t size, Descriptor& descriptor) {
+    descriptor.firstAce = static_cast<uint32_t>(aces.size());
+
+    // SECURITY_DESCRIPTOR_RELATIVE
+    if (size < 20 || data[0] != 1) return false;
+    uint16_t control = readU16(data + 2);
+    uint32_t daclOffset = readU32(data + 16);
+    if ((control & 0x0004) == 0 || daclOffset == 0) {
+        return true;    // SE_DACL_PRESENT clear: NULL DACL
+    }
+    if (daclOffset > size - 8) return false;
+
+    // ACL header
+    const unsigned char* acl = data + daclOffset;
+    size_t aclSize = readU16(acl + 2);
+    uint16_t aceCount = readU16(acl + 4);
+    if (aclSize < 8 || aclSize > size - daclOffset) return false;
+    descriptor.hasDacl = true;
+
+    size_t pos = 8;
+    std::string sid;
+    for (uint16_t i = 0; i < aceCount; ++i) {
+        if (pos + 4 > aclSize) return false;
+        const unsigned char* ace = acl + pos;
+        uint8_t aceType = ace[0];
+        uint8_t aceFlags = ace[1];
+        size_t aceSize = readU16(ace + 2);
+        if (aceSize < 8 || pos + aceSize > aclSize) return false;
+        pos += aceSize;
+
+        // ACCESS_ALLOWED/DENIED (0/1), object (5/6) and callback (9/10) ACEs
+        size_t sidOffset;
+        AccessControlEntry entry;
+        if (aceType == 0 || aceType == 1 || aceType == 9 || aceType == 10) {
+            sidOffset = 8;
+        } else if (aceType == 5 || aceType == 6) {
+            if (aceSize < 12) return false;
+            uint32_t objectFlags = readU32(ace + 8);
+            sidOffset = 12 + ((objectFlags & 1) ? 16 : 0) + ((objectFlags & 2) ? 16 : 0);
+        } else {
+            continue;
+        }
+        if (aceType == 10) continue;    // conditional deny may not apply
+
+        entry.type = (aceType == 1 || aceType == 6) ? AceDeny : AceAllow;
+        entry.flags = aceFlags & AceInheritOnly;
+        entry.mask = mapGenericRights(readU32(ace + 4));
+        if (sidOffset >= aceSize || !formatSid(ace + sidOffset, aceSize - sidOffset, sid)) return false;
+        entry.sid = internSid(sid);
+        aces.push_back(entry);
+    }
+    return true;
+}
+
+uint32_t SecurityDescriptorCache::finish(Descriptor& descriptor) {
+    descriptor.aceCount = static_cast<uint32_t>(aces.size()) - descriptor.firstAce;
+
+    for (size_t p = 0; p < static_cast<size_t>(WellKnownPrincipal::Count); ++p) {
+        if (!descriptor.hasDacl) {
+            descriptor.access.masks[p] = AccessMask::FileAllAccess;
+            continue;
+        }
+
+        uint32_t granted = 0;
+        uint32_t denied = 0;
+        for (uint32_t i = 0; i < descriptor.aceCount; ++i) {
+            const AccessControlEntry& ace = aces[descriptor.firstAce + i];
+            if (ace.flags & AceInheritOnly) continue;
+
+            bool member = false;
+            for (uint32_t sid : tokens[p]) {
+                if (sid == ace.sid) {
+                    member = true;
+                    break;
+                }
+            }
+            if (!member) continue;
+
+            if (ace.type == AceDeny) denied |= ace.mask & ~granted;
+            else granted |= ace.mask & ~denied;
+        }
+        descriptor.access.masks[p] = granted;
+    }
+
+    descriptors.push_back(descriptor);
+    return static_cast<uint32_t>(descriptors.size() - 1);
+}
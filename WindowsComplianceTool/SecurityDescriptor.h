@@ -0,0 +1,125 @@
+#pragma once
+#include "ScanArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Broad principals whose effective access is evaluated for every descriptor
+enum class WellKnownPrincipal : uint8_t {
+    Everyone,
+    Anonymous,
+    AuthenticatedUsers,
+    Users,
+    Guests,
+    Count
+};
+
+// Access mask bits (file and share rights, after generic mapping)
+namespace AccessMask {
+    const uint32_t ReadData = 0x00000001;
+    const uint32_t WriteData = 0x00000002;
+    const uint32_t AppendData = 0x00000004;
+    const uint32_t DeleteChild = 0x00000040;
+    const uint32_t Delete = 0x00010000;
+    const uint32_t WriteDac = 0x00040000;
+    const uint32_t WriteOwner = 0x00080000;
+    const uint32_t FileAllAccess = 0x001F01FF;
+    const uint32_t FileGenericRead = 0x00120089;
+    const uint32_t FileGenericWrite = 0x00120116;
+    const uint32_t FileGenericExecute = 0x001200A0;
+    const uint32_t ShareChange = 0x001301BF;
+    const uint32_t ShareRead = 0x001200A9;
+
+    inline bool canRead(uint32_t mask) { return (mask & ReadData) != 0; }
+    inline bool canWrite(uint32_t mask) {
+        return (mask & (WriteData | AppendData | DeleteChild | Delete | WriteDac | WriteOwner)) != 0;
+    }
+    inline bool fullControl(uint32_t mask) { return (mask & FileAllAccess) == FileAllAccess; }
+}
+
+// One DACL entry; the SID is an index into the owning cache's SID table
+struct AccessControlEntry {
+    uint32_t mask;
+    uint32_t sid;
+    uint8_t type;       // AceAllow, AceDeny
+    uint8_t flags;      // AceInheritOnly, ...
+};
+
+const uint8_t AceAllow = 0;
+const uint8_t AceDeny = 1;
+const uint8_t AceInheritOnly = 0x08;
+
+// Effective access masks of the well-known principals for one descriptor
+struct EffectiveAccess {
+    uint32_t masks[static_cast<size_t>(WellKnownPrincipal::Count)] = {};
+
+    uint32_t mask(WellKnownPrincipal principal) const { return masks[static_cast<size_t>(principal)]; }
+};
+
+// Security descriptors parsed from SDDL ("O:BAG:SYD:PAI(A;OICI;FA;;;SY)...")
+// or self-relative binary form. DACLs are stored as compact ACE arrays in
+// one shared vector, and each distinct descriptor is parsed and evaluated
+// once: shares and folders mostly reuse a handful of ACLs, so auditing
+// thousands of them costs a hash lookup each.
+//
+// Effective access follows AccessCheck for a token holding the principal's
+// group SIDs: ACEs are applied in order, a deny removes rights not already
+// granted, inherit-only ACEs are skipped and a missing (NULL) DACL grants
+// everything. Generic rights are mapped with the file generic mapping.
+class SecurityDescriptorCache {
+public:
+    explicit SecurityDescriptorCache(std::pmr::memory_resource* memory = ScanArena::current());
+
+    // Descriptor id, InvalidDescriptor if the text or data is malformed
+    uint32_t addSddl(std::string_view sddl);
+    uint32_t addBinary(const void* data, size_t size);
+
+    const EffectiveAccess& effectiveAccess(uint32_t descriptor) const { return descriptors[descriptor].access; }
+    bool hasDacl(uint32_t descriptor) const { return descriptors[descriptor].hasDacl; }
+
+    // DACL entries of a descriptor: fn(const AccessControlEntry&, sidText)
+    template <typename Fn>
+    void forEachAce(uint32_t descriptor, Fn&& fn) const {
+        const Descriptor& d = descriptors[descriptor];
+        for (uint32_t i = 0; i < d.aceCount; ++i) {
+            const AccessControlEntry& ace = aces[d.firstAce + i];
+            fn(ace, std::string_view(sidNames[ace.sid]));
+        }
+    }
+
+    size_t size() const { return descriptors.size(); }
+    size_t aceCount() const { return aces.size(); }
+    void clear();
+
+    static const char* principalName(WellKnownPrincipal principal);
+
+    static const uint32_t InvalidDescriptor = 0xFFFFFFFFu;
+
+private:
+    struct Descriptor {
+        uint32_t firstAce = 0;
+        uint32_t aceCount = 0;
+        bool hasDacl = false;
+        EffectiveAccess access;
+    };
+
+    std::pmr::vector<AccessControlEntry> aces;
+    std::pmr::vector<Descriptor> descriptors;
+    std::pmr::unordered_map<std::pmr::string, uint32_t> sddlIndex;
+    std::pmr::unordered_map<std::pmr::string, uint32_t> binaryIndex;
+    std::pmr::unordered_map<std::pmr::string, uint32_t> sidIndex;    // "S-1-5-11" -> SID id
+    std::pmr::vector<std::pmr::string> sidNames;
+    std::pmr::string key;          // lookup key, reused so repeated descriptors do not allocate
+
+    // Group SIDs in each principal's network logon token
+    std::vector<uint32_t> tokens[static_cast<size_t>(WellKnownPrincipal::Count)];
+
+    uint32_t internSid(std::string_view sid);
+    bool parseSddl(std::string_view sddl, Descriptor& descriptor);
+    bool parseBinary(const unsigned char* data, size_t size, Descriptor& descriptor);
+    uint32_t finish(Descriptor& descriptor);
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+// The Security log's last 7 days, exported once with wevtutil and replayed
+// by every check of a scan that reads it. The file is deleted with the object.
+class SecurityLogExport {
+public:
+    SecurityLogExport() = default;
+    SecurityLogExport(const SecurityLogExport&) = delete;
+    SecurityLogExport& operator=(const SecurityLogExport&) = delete;
+
+    ~SecurityLogExport() {
+        if (!evtxPath.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(evtxPath, ec);
+        }
+    }
+
+    // Empty until the export has been attempted
+    const std::string& path() const { return evtxPath; }
+    void setPath(std::string value) { evtxPath = std::move(value); }
+
+private:
+    std::string evtxPath;
+};
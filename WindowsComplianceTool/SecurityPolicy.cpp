@@ -0,0 +1,199 @@
+#include "SecurityPolicy.h"
+#include "TextEncoding.h"
+#include "TextUtil.h"
+#include <cctype>
+#include <climits>
+
+namespace {
+
+using TextUtil::trim;
+
+void appendLower(std::string& out, std::string_view s) {
+    for (char c : s) {
+        out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+bool parseInt(std::string_view s, int& value) {
+    int64_t number;
+    if (!TextUtil::parseNumber(trim(s), number) || number < -INT_MAX || number > INT_MAX) return false;
+    value = static_cast<int>(number);
+    return true;
+}
+
+bool startsWith(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+std::string SecurityPolicy::makeKey(std::string_view section, std::string_view key) {
+    std::string composite;
+    composite.reserve(section.size() + key.size() + 1);
+    appendLower(composite, section);
+    composite += '\\';
+    appendLower(composite, key);
+    return composite;
+}
+
+bool SecurityPolicy::loadFromFile(const std::string& path) {
+    std::string text;
+    if (!TextEncoding::readTextFile(path, text)) {
+        return false;
+    }
+    return parse(text);
+}
+
+bool SecurityPolicy::parse(std::string_view text) {
+    std::string_view section;
+    size_t pos = 0;
+    size_t before = settings.size();
+
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+
+        std::string_view line = trim(text.substr(pos, end - pos));
+        pos = end + 1;
+
+        if (line.empty() || line[0] == ';') {
+            continue;
+        }
+
+        if (line[0] == '[') {
+            size_t close = line.find(']');
+            section = (close == std::string_view::npos) ? line.substr(1) : line.substr(1, close - 1);
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string_view::npos) {
+            continue;
+        }
+
+        std::string_view key = trim(line.substr(0, eq));
+        std::string_view value = trim(line.substr(eq + 1));
+
+        // Strip surrounding quotes ("Administrator")
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+
+        settings[makeKey(section, key)] = std::string(value);
+    }
+
+    return settings.size() > before;
+}
+
+const std::string* SecurityPolicy::find(std::string_view section, std::string_view key) const {
+    auto it = settings.find(makeKey(section, key));
+    return it != settings.end() ? &it->second : nullptr;
+}
+
+bool SecurityPolicy::getInt(std::string_view section, std::string_view key, int& value) const {
+    const std::string* raw = find(section, key);
+    return raw != nullptr && parseInt(*raw, value);
+}
+
+int SecurityPolicy::getAuditFlags(std::string_view auditKey) const {
+    int value = 0;
+    if (!getInt("Event Audit", auditKey, value)) {
+        return -1;
+    }
+    return value & (AuditSuccess | AuditFailure);
+}
+
+std::vector<std::string> SecurityPolicy::getPrivilegeHolders(std::string_view privilege) const {
+    std::vector<std::string> holders;
+    const std::string* raw = find("Privilege Rights", privilege);
+    if (raw == nullptr) {
+        return holders;
+    }
+
+    std::string_view list(*raw);
+    size_t pos = 0;
+    while (pos <= list.size()) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string_view::npos) comma = list.size();
+
+        std::string_view holder = trim(list.substr(pos, comma - pos));
+        if (!holder.empty()) {
+            holders.emplace_back(holder);
+        }
+        pos = comma + 1;
+    }
+
+    return holders;
+}
+
+void SecurityPolicy::getAccountPolicy(AccountPolicy& policy) const {
+    const std::string_view section = "System Access";
+    int value = 0;
+
+    if (getInt(section, "MinimumPasswordLength", value)) policy.minPasswordLength = value;
+    if (getInt(section, "MinimumPasswordAge", value)) policy.minPasswordAgeDays = value;
+    if (getInt(section, "PasswordHistorySize", value)) policy.passwordHistorySize = value;
+    if (getInt(section, "PasswordComplexity", value)) policy.passwordComplexity = value;
+    if (getInt(section, "LockoutBadCount", value)) policy.lockoutThreshold = value;
+    if (getInt(section, "LockoutDuration", value)) policy.lockoutDurationMinutes = value;
+    if (getInt(section, "ResetLockoutCount", value)) policy.lockoutWindowMinutes = value;
+    if (getInt(section, "ForceLogoffWhenHourExpire", value)) policy.forceLogoffMinutes = value;
+
+    // secedit reports "never expires" as -1
+    if (getInt(section, "MaximumPasswordAge", value)) {
+        policy.maxPasswordAgeDays = value < 0 ? 0 : value;
+    }
+}
+
+bool NetAccountsParser::parse(std::string_view output, AccountPolicy& policy) {
+    bool recognised = false;
+    size_t pos = 0;
+
+    while (pos < output.size()) {
+        size_t end = output.find('\n', pos);
+        if (end == std::string_view::npos) end = output.size();
+
+        std::string_view line = trim(output.substr(pos, end - pos));
+        pos = end + 1;
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+
+        std::string_view label = trim(line.substr(0, colon));
+        std::string_view text = trim(line.substr(colon + 1));
+
+        // "Never", "None" and "Unlimited" map to 0 (no limit / disabled)
+        int value = 0;
+        bool numeric = parseInt(text, value);
+        if (!numeric && (text == "Never" || text == "None" || text == "Unlimited")) {
+            value = 0;
+            numeric = true;
+        }
+
+        if (startsWith(label, "Computer role")) {
+            policy.computerRole = std::string(text);
+            recognised = true;
+            continue;
+        }
+
+        if (!numeric) {
+            continue;
+        }
+
+        if (startsWith(label, "Force user logoff")) policy.forceLogoffMinutes = value;
+        else if (startsWith(label, "Minimum password age")) policy.minPasswordAgeDays = value;
+        else if (startsWith(label, "Maximum password age")) policy.maxPasswordAgeDays = value;
+        else if (startsWith(label, "Minimum password length")) policy.minPasswordLength = value;
+        else if (startsWith(label, "Length of password history")) policy.passwordHistorySize = value;
+        else if (startsWith(label, "Lockout threshold")) policy.lockoutThreshold = value;
+        else if (startsWith(label, "Lockout duration")) policy.lockoutDurationMinutes = value;
+        else if (startsWith(label, "Lockout observation window")) policy.lockoutWindowMinutes = value;
+        else continue;
+
+        recognised = true;
+    }
+
+    return recognised;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Account policy values gathered from secedit or net accounts.
+// -1 means the value was not reported by the source.
+struct AccountPolicy {
+    int minPasswordLength = -1;
+    int maxPasswordAgeDays = -1;      // 0 = passwords never expire
+    int minPasswordAgeDays = -1;
+    int passwordHistorySize = -1;
+    int passwordComplexity = -1;      // 1 = enabled
+    int lockoutThreshold = -1;        // 0 = never lock out
+    int lockoutDurationMinutes = -1;
+    int lockoutWindowMinutes = -1;
+    int forceLogoffMinutes = -1;      // 0 = never
+    std::string computerRole;
+};
+
+// Event Audit values as stored by secedit ([Event Audit] section)
+enum AuditFlags {
+    AuditNone = 0,
+    AuditSuccess = 1,
+    AuditFailure = 2
+};
+
+// Parsed `secedit /export` INF file.
+// Every "key = value" pair of every section is stored in one hash table
+// keyed by "section\key" (lower case), so [System Access], [Event Audit]
+// and [Privilege Rights] lookups are answered from a single export.
+class SecurityPolicy {
+public:
+    // Load an INF file (secedit writes UTF-16LE)
+    bool loadFromFile(const std::string& path);
+
+    // Parse INF text that is already UTF-8
+    bool parse(std::string_view text);
+
+    void clear() { settings.clear(); }
+    size_t size() const { return settings.size(); }
+
+    // Raw value lookup (case-insensitive), nullptr if missing
+    const std::string* find(std::string_view section, std::string_view key) const;
+
+    // Integer value lookup, returns false if missing or not numeric
+    bool getInt(std::string_view section, std::string_view key, int& value) const;
+
+    // [Event Audit] value as AuditFlags bits, -1 if missing
+    int getAuditFlags(std::string_view auditKey) const;
+
+    // [Privilege Rights] holders (SIDs keep their leading '*')
+    std::vector<std::string> getPrivilegeHolders(std::string_view privilege) const;
+
+    // Fill the [System Access] account policy fields
+    void getAccountPolicy(AccountPolicy& policy) const;
+
+    // Every value: fn(section and key as "section\key" in lower case, value)
+    template <typename Fn>
+    void forEachSetting(Fn&& fn) const {
+        for (const auto& entry : settings) fn(std::string_view(entry.first), std::string_view(entry.second));
+    }
+
+private:
+    std::unordered_map<std::string, std::string> settings;
+
+    static std::string makeKey(std::string_view section, std::string_view key);
+};
+
+// Structured parser for `net accounts` console output
+class NetAccountsParser {
+public:
+    // Returns true if at least one known field was recognised
+    static bool parse(std::string_view output, AccountPolicy& policy);
+};
@@ -0,0 +1,240 @@
+#include "Sha256.h"
+#include <cstring>
+
+// x86 SHA extensions (Goldmont, Ice Lake, Zen and later), chosen at run time
+#if defined(__x86_64__) || defined(_M_X64)
+#define SHA256_USE_SHANI 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHANI_TARGET
+#else
+#include <cpuid.h>
+#define SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
+namespace {
+
+const uint32_t RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotateRight(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+inline uint32_t loadBigEndian(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+#ifdef SHA256_USE_SHANI
+bool hasShaExtensions() {
+    unsigned int leaf1[4] = {}, leaf7[4] = {};
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    leaf1[2] = static_cast<unsigned int>(regs[2]);
+    __cpuidex(regs, 7, 0);
+    leaf7[1] = static_cast<unsigned int>(regs[1]);
+#else
+    if (__get_cpuid_max(0, nullptr) < 7) return false;
+    __get_cpuid(1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3]);
+    __get_cpuid_count(7, 0, &leaf7[0], &leaf7[1], &leaf7[2], &leaf7[3]);
+#endif
+    bool ssse3 = (leaf1[2] & (1u << 9)) != 0;
+    bool sse41 = (leaf1[2] & (1u << 19)) != 0;
+    bool sha = (leaf7[1] & (1u << 29)) != 0;
+    return ssse3 && sse41 && sha;
+}
+
+// Four rounds per step with sha256rnds2; the message schedule uses
+// sha256msg1/sha256msg2 on the previous four steps' words
+SHANI_TARGET void transformShaNi(uint32_t state[8], const uint8_t* blocks, size_t count) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+    // State as ABEF / CDGH register pairs
+    __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+    for (size_t block = 0; block < count; ++block, blocks += 64) {
+        __m128i abefSaved = abef;
+        __m128i cdghSaved = cdgh;
+        __m128i words[4];
+
+        for (int step = 0; step < 16; ++step) {
+            __m128i& current = words[step & 3];
+            if (step < 4) {
+                current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + step * 16)), byteSwap);
+            } else {
+                __m128i schedule = _mm_sha256msg1_epu32(current, words[(step - 3) & 3]);
+                schedule = _mm_add_epi32(schedule, _mm_alignr_epi8(words[(step - 1) & 3], words[(step - 2) & 3], 4));
+                current = _mm_sha256msg2_epu32(schedule, words[(step - 1) & 3]);
+            }
+            __m128i message = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&RoundConstants[step * 4])));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+        }
+
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+const bool UseShaExtensions = hasShaExtensions();
+#endif
+
+} // namespace
+
+void Sha256::reset() {
+    static const uint32_t Initial[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    std::memcpy(state, Initial, sizeof(state));
+    length = 0;
+    buffered = 0;
+}
+
+void Sha256::transform(const uint8_t* blocks, size_t count) {
+#ifdef SHA256_USE_SHANI
+    if (UseShaExtensions) {
+        transformShaNi(state, blocks, count);
+        return;
+    }
+#endif
+
+    uint32_t w[64];
+    for (size_t block = 0; block < count; ++block, blocks += 64) {
+        for (int i = 0; i < 16; ++i) {
+            w[i] = loadBigEndian(blocks + i * 4);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t choose = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + choose + RoundConstants[i] + w[i];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + majority;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+void Sha256::update(const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    length += size;
+
+    if (buffered > 0) {
+        size_t take = 64 - buffered < size ? 64 - buffered : size;
+        std::memcpy(buffer + buffered, p, take);
+        buffered += take;
+        p += take;
+        size -= take;
+        if (buffered < 64) return;
+        transform(buffer, 1);
+        buffered = 0;
+    }
+
+    // Whole blocks directly from the input
+    size_t blocks = size / 64;
+    if (blocks > 0) {
+        transform(p, blocks);
+        p += blocks * 64;
+        size -= blocks * 64;
+    }
+
+    if (size > 0) {
+        std::memcpy(buffer, p, size);
+        buffered = size;
+    }
+}
+
+Sha256::Digest Sha256::finish() {
+    uint64_t bitLength = length * 8;
+
+    // 0x80, zero padding to 56 mod 64, then the big-endian bit length
+    uint8_t padding[72] = { 0x80 };
+    size_t padLength = (buffered < 56 ? 56 : 120) - buffered;
+    for (int i = 0; i < 8; ++i) {
+        padding[padLength + i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    update(padding, padLength + 8);
+
+    Digest digest;
+    for (int i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+    }
+    reset();
+    return digest;
+}
+
+Sha256::Digest Sha256::hash(const void* data, size_t size) {
+    Sha256 hasher;
+    hasher.update(data, size);
+    return hasher.finish();
+}
+
+std::string Sha256::toHex(const Digest& digest) {
+    static const char Hex[] = "0123456789abcdef";
+    std::string text(64, '0');
+    for (size_t i = 0; i < digest.size(); ++i) {
+        text[i * 2] = Hex[digest[i] >> 4];
+        text[i * 2 + 1] = Hex[digest[i] & 0x0F];
+    }
+    return text;
+}
+
+bool Sha256::fromHex(std::string_view text, Digest& digest) {
+    if (text.size() != 64) return false;
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    for (size_t i = 0; i < digest.size(); ++i) {
+        int high = nibble(text[i * 2]);
+        int low = nibble(text[i * 2 + 1]);
+        if (high < 0 || low < 0) return false;
+        digest[i] = static_cast<uint8_t>(high << 4 | low);
+    }
+    return true;
+}
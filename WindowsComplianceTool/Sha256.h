@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// SHA-256 (FIPS 180-4) for file integrity hashes. Input is consumed in
+// 64-byte blocks straight from the caller's buffer; only a partial block
+// is copied. On x86-64 CPUs with the SHA extensions the blocks are hashed
+// with the sha256rnds2/msg1/msg2 instructions, otherwise in portable code.
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256() { reset(); }
+
+    void reset();
+    void update(const void* data, size_t size);
+    Digest finish();
+
+    static Digest hash(const void* data, size_t size);
+
+    // Lower-case hex, 64 characters
+    static std::string toHex(const Digest& digest);
+    static bool fromHex(std::string_view text, Digest& digest);
+
+private:
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t buffer[64];
+    size_t buffered;
+
+    void transform(const uint8_t* blocks, size_t count);
+};
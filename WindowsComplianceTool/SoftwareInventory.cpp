@@ -0,0 +1,168 @@
+#include "SoftwareInventory.h"
+#include "CsvReader.h"
+#include "RegistryProvider.h"
+#include <cctype>
+
+bool SoftwareVersion::parse(std::string_view text, SoftwareVersion& version) {
+    version = SoftwareVersion();
+
+    size_t pos = 0;
+    while (pos < text.size() && !std::isdigit(static_cast<unsigned char>(text[pos]))) {
+        pos++;
+    }
+
+    while (pos < text.size() && version.count < 4) {
+        if (!std::isdigit(static_cast<unsigned char>(text[pos]))) break;
+
+        uint64_t value = 0;
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+            value = value * 10 + static_cast<uint64_t>(text[pos] - '0');
+            if (value > 0xFFFFFFFFu) value = 0xFFFFFFFFu;
+            pos++;
+        }
+        version.parts[version.count++] = static_cast<uint32_t>(value);
+
+        if (pos < text.size() && text[pos] == '.') pos++;
+        else break;
+    }
+
+    return version.valid();
+}
+
+int SoftwareVersion::compare(const SoftwareVersion& a, const SoftwareVersion& b) {
+    for (int i = 0; i < 4; ++i) {
+        if (a.parts[i] != b.parts[i]) {
+            return a.parts[i] < b.parts[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+std::string SoftwareVersion::toString() const {
+    std::string text;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (i > 0) text += '.';
+        text += std::to_string(parts[i]);
+    }
+    return text;
+}
+
+namespace {
+    // Version numbers ("24.08", "v3.0.20") and architecture tags carry no product identity
+    bool isQualifierToken(std::string_view token) {
+        if (token.empty() || token == "-") return true;
+
+        std::string_view digits = token;
+        if (digits.size() > 1 && (digits[0] == 'v' || digits[0] == 'V')) digits.remove_prefix(1);
+        bool version = std::isdigit(static_cast<unsigned char>(digits[0])) != 0;
+        for (char c : digits) {
+            if (!std::isdigit(static_cast<unsigned char>(c)) && c != '.') version = false;
+        }
+        if (version) return true;
+
+        static const char* const Architectures[] = { "x64", "x86", "amd64", "arm64", "64-bit", "32-bit" };
+        for (const char* arch : Architectures) {
+            std::string_view tag(arch);
+            if (token.size() == tag.size()) {
+                bool same = true;
+                for (size_t i = 0; i < tag.size(); ++i) {
+                    if (std::tolower(static_cast<unsigned char>(token[i])) != tag[i]) same = false;
+                }
+                if (same) return true;
+            }
+        }
+        return false;
+    }
+}
+
+std::string SoftwareInventory::normalizeProductName(std::string_view name) {
+    std::string key;
+    key.reserve(name.size());
+
+    size_t pos = 0;
+    int depth = 0;
+    while (pos < name.size()) {
+        // Split on whitespace, skipping parenthesized qualifiers
+        while (pos < name.size() && (std::isspace(static_cast<unsigned char>(name[pos])) || depth > 0 || name[pos] == '(' || name[pos] == ')')) {
+            if (name[pos] == '(') depth++;
+            else if (name[pos] == ')' && depth > 0) depth--;
+            pos++;
+        }
+
+        size_t start = pos;
+        while (pos < name.size() && !std::isspace(static_cast<unsigned char>(name[pos])) && name[pos] != '(') {
+            pos++;
+        }
+
+        std::string_view token = name.substr(start, pos - start);
+        if (isQualifierToken(token)) continue;
+
+        if (!key.empty()) key += ' ';
+        for (char c : token) key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    return key;
+}
+
+void SoftwareInventory::add(std::string_view name, std::string_view version, std::string_view publisher, std::string_view installDate) {
+    SoftwareRecord record;
+    record.name.assign(name.data(), name.size());
+    record.productKey = normalizeProductName(name);
+    record.versionText.assign(version.data(), version.size());
+    SoftwareVersion::parse(version, record.version);
+    record.publisher.assign(publisher.data(), publisher.size());
+
+    // InstallDate is YYYYMMDD when present
+    if (installDate.size() == 8) {
+        uint32_t date = 0;
+        bool digits = true;
+        for (char c : installDate) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) digits = false;
+            date = date * 10 + static_cast<uint32_t>(c - '0');
+        }
+        if (digits) record.installDate = date;
+    }
+
+    entries.push_back(std::move(record));
+}
+
+bool SoftwareInventory::loadFromCsv(const CsvReader& table) {
+    int nameColumn = table.columnIndex("DisplayName");
+    if (nameColumn < 0) {
+        return false;
+    }
+    int versionColumn = table.columnIndex("DisplayVersion");
+    int publisherColumn = table.columnIndex("Publisher");
+    int dateColumn = table.columnIndex("InstallDate");
+
+    entries.reserve(entries.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        if (row[nameColumn].empty()) continue;
+        add(row[nameColumn], row[versionColumn], row[publisherColumn], row[dateColumn]);
+    }
+    return true;
+}
+
+bool SoftwareInventory::loadFromRegistry(const RegistryProvider& registry) {
+    static const char* const UninstallKeys[] = {
+        "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall",
+        "HKEY_LOCAL_MACHINE\\SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall"
+    };
+
+    bool found = false;
+    for (const char* root : UninstallKeys) {
+        std::vector<std::string> subkeys;
+        if (!registry.enumerateSubkeys(root, subkeys)) continue;
+        found = true;
+
+        for (const auto& subkey : subkeys) {
+            std::string keyPath = std::string(root) + "\\" + subkey;
+            std::string name = registry.readValue(keyPath, "DisplayName");
+            if (name.empty()) continue;
+            add(name, registry.readValue(keyPath, "DisplayVersion"), registry.readValue(keyPath, "Publisher"),
+                registry.readValue(keyPath, "InstallDate"));
+        }
+    }
+    return found;
+}
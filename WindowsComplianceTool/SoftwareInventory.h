@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CsvReader;
+class RegistryProvider;
+
+// Dotted numeric version ("24.08", "3.0.20.0", "v1.2"). Up to four
+// components; missing components compare as zero, so 1.2 == 1.2.0.0.
+struct SoftwareVersion {
+    uint32_t parts[4] = { 0, 0, 0, 0 };
+    uint8_t count = 0;          // components present, 0 = unparsed / unknown
+
+    bool valid() const { return count > 0; }
+
+    // Leading text such as "v" or "Version " is skipped; parsing stops at
+    // the first character that is not a digit or dot
+    static bool parse(std::string_view text, SoftwareVersion& version);
+
+    static int compare(const SoftwareVersion& a, const SoftwareVersion& b);
+    bool operator<(const SoftwareVersion& other) const { return compare(*this, other) < 0; }
+    bool operator==(const SoftwareVersion& other) const { return compare(*this, other) == 0; }
+
+    std::string toString() const;
+};
+
+// One installed application (an Uninstall key)
+struct SoftwareRecord {
+    std::string name;
+    std::string productKey;     // normalized name used for vulnerability lookups
+    std::string versionText;
+    SoftwareVersion version;
+    std::string publisher;
+    uint32_t installDate = 0;   // YYYYMMDD, 0 if unknown
+};
+
+// Typed installed-software inventory built from the Uninstall keys
+class SoftwareInventory {
+public:
+    // Rows with DisplayName, DisplayVersion, Publisher, InstallDate columns
+    bool loadFromCsv(const CsvReader& table);
+
+    // Read the 64-bit and WOW6432Node Uninstall keys through a provider
+    // (live or offline hives)
+    bool loadFromRegistry(const RegistryProvider& registry);
+
+    void add(std::string_view name, std::string_view version, std::string_view publisher, std::string_view installDate);
+    void clear() { entries.clear(); }
+
+    const std::vector<SoftwareRecord>& records() const { return entries; }
+    size_t size() const { return entries.size(); }
+
+    // Lower-case product name without version numbers, architecture tags
+    // and parenthesized qualifiers: "7-Zip 24.08 (x64)" -> "7-zip",
+    // "Mozilla Firefox (x64 en-US)" -> "mozilla firefox"
+    static std::string normalizeProductName(std::string_view name);
+
+private:
+    std::vector<SoftwareRecord> entries;
+};
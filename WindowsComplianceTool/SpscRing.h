@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue between one producer and one consumer thread.
+// Capacity is a power of two; head and tail are free-running counters on
+// separate cache lines, and each side caches the other's counter so a
+// batch push or pop touches the shared atomics once.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacityPowerOfTwo = 65536)
+        : slots(roundUp(capacityPowerOfTwo)), mask(slots.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return slots.size(); }
+
+    // Producer: copy up to count items, returns how many fit
+    size_t push(const T* items, size_t count) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - cachedHead + count > slots.size()) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+        }
+        size_t space = slots.size() - (tail - cachedHead);
+        if (count > space) count = space;
+        for (size_t i = 0; i < count; ++i) {
+            slots[(tail + i) & mask] = items[i];
+        }
+        tailIndex.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer: move up to max items into out, returns how many were taken
+    size_t pop(T* out, size_t max) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (cachedTail - head < max) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+        }
+        size_t available = cachedTail - head;
+        if (max > available) max = available;
+        for (size_t i = 0; i < max; ++i) {
+            out[i] = slots[(head + i) & mask];
+        }
+        headIndex.store(head + max, std::memory_order_release);
+        return max;
+    }
+
+    // Producer: no more items will be pushed
+    void close() { closed.store(true, std::memory_order_release); }
+
+    // Consumer: closed and drained
+    bool finished() const {
+        return closed.load(std::memory_order_acquire) &&
+               headIndex.load(std::memory_order_relaxed) == tailIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    static size_t roundUp(size_t value) {
+        size_t capacity = 2;
+        while (capacity < value) capacity <<= 1;
+        return capacity;
+    }
+
+    std::vector<T> slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> headIndex{ 0 };
+    size_t cachedTail = 0;          // consumer's view of tailIndex
+    alignas(64) std::atomic<size_t> tailIndex{ 0 };
+    size_t cachedHead = 0;          // producer's view of headIndex
+    alignas(64) std::atomic<bool> closed{ false };
+};
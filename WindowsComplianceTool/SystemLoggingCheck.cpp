@@ -1,20 +1,70 @@
 #include "SystemLoggingCheck.h"
-#include <sstream>
+#include "EvtxParser.h"
+#include "PolicyTables.h"
+#include "SecurityLogExport.h"
+#include <cstdlib>
+
+namespace {
+
+bool isLogonEvent(uint16_t id) {
+    return id == 4624 || id == 4625 || id == 4634 || id == 4647 || id == 4648 || id == 4672;
+}
+
+bool isAccountManagementEvent(uint16_t id) {
+    return (id >= 4720 && id <= 4740) || id == 4756 || id == 4767;
+}
+
+bool isPolicyChangeEvent(uint16_t id) {
+    return id == 4719 || id == 4739 || id == 4713 || id == 4706 || id == 4707;
+}
+
+} // namespace
+
+const std::vector<uint16_t>& SystemLoggingCheck::evidenceEventIds() {
+    static const std::vector<uint16_t> ids = {
+        1102,                                               // audit log cleared
+        4624, 4625, 4634, 4647, 4648, 4672,                 // logon
+        4720, 4722, 4723, 4724, 4725, 4726, 4728, 4732,     // account management
+        4738, 4740, 4756, 4767,
+        4706, 4707, 4713, 4719, 4739                        // policy change
+    };
+    return ids;
+}
 
 ComplianceResult SystemLoggingCheck::performCheck() {
-    ComplianceResult result("System Logging Verification",
-                           "Checks if Windows Event Logging is active for security and audit tracking.",
-                           CheckStatus::Pass, Severity::Low, 100);
-    
-    result.details.push_back("Checking Windows Event Logging configuration...");
-    
     // Check if Event Log service is running
     std::string serviceStatus = executePowerShell("Get-Service -Name EventLog | Select-Object -ExpandProperty Status");
-    bool serviceRunning = (serviceStatus.find("Running") != std::string::npos);
     
     // Check audit policy settings
     std::string auditPolicy = executePowerShell("auditpol /get /category:*");
     
+    // Check event log sizes
+    std::string securityLogSize = executePowerShell("(Get-EventLog -LogName Security -ErrorAction SilentlyContinue).MaximumKilobytes");
+    
+    // Read the last 7 days of the Security log to see whether the audit
+    // policy actually produces events
+    std::shared_ptr<SecurityLogExport> securityLog = exportSecurityLog();
+    
+    EvtxParser parser;
+    // Only event ids are counted, so EventData is not decoded
+    parser.setEventFilter(evidenceEventIds());
+    parser.setDecodeFields(false);
+    
+    EventRecordSet securityEvents;
+    bool eventsLoaded = parser.parseFile(securityLog->path(), securityEvents);
+    
+    return evaluate(serviceStatus, auditPolicy, securityLogSize, eventsLoaded ? &securityEvents : nullptr);
+}
+
+ComplianceResult SystemLoggingCheck::evaluate(const std::string& serviceStatus, const std::string& auditPolicy,
+                                              const std::string& securityLogSize,
+                                              const EventRecordSet* securityEvents) {
+    ComplianceResult result("System Logging Verification",
+                           "Checks if Windows Event Logging is active for security and audit tracking.",
+                           CheckStatus::Pass, Severity::Low, 100);
+    
+    bool serviceRunning = (serviceStatus.find("Running") != std::string::npos);
+    
     bool logonAuditing = false;
     bool objectAccessAuditing = false;
     bool policyChangeAuditing = false;
@@ -49,56 +99,77 @@ ComplianceResult SystemLoggingCheck::performCheck() {
         }
     }
     
-    // Check event log sizes
-    std::string securityLogSize = executePowerShell("(Get-EventLog -LogName Security -ErrorAction SilentlyContinue).MaximumKilobytes");
-    std::string applicationLogSize = executePowerShell("(Get-EventLog -LogName Application -ErrorAction SilentlyContinue).MaximumKilobytes");
-    std::string systemLogSize = executePowerShell("(Get-EventLog -LogName System -ErrorAction SilentlyContinue).MaximumKilobytes");
+    // Count audit evidence in the exported Security log
+    size_t logonEvents = 0;
+    size_t accountEvents = 0;
+    size_t policyEvents = 0;
+    size_t logCleared = 0;
+    if (securityEvents != nullptr) {
+        for (const auto& event : securityEvents->records()) {
+            if (event.eventId == 1102) logCleared++;
+            else if (isLogonEvent(event.eventId)) logonEvents++;
+            else if (isAccountManagementEvent(event.eventId)) accountEvents++;
+            else if (isPolicyChangeEvent(event.eventId)) policyEvents++;
+        }
+    }
     
-    std::stringstream details;
-    details << "Event Log Service: " << (serviceRunning ? "Running" : "Stopped") << "\n";
-    details << "Logon Auditing: " << (logonAuditing ? "Enabled" : "Disabled") << "\n";
-    details << "Object Access Auditing: " << (objectAccessAuditing ? "Enabled" : "Disabled") << "\n";
-    details << "Policy Change Auditing: " << (policyChangeAuditing ? "Enabled" : "Disabled") << "\n";
-    details << "Account Management Auditing: " << (accountManagementAuditing ? "Enabled" : "Disabled");
+    // Every running machine logs on within a week; no logon events means
+    // the configured policy is not taking effect (overridden, or log full)
+    bool logonIneffective = securityEvents != nullptr && logonAuditing && logonEvents == 0;
+    
+    result.findings.flag(FindingKey::EventLogService, serviceRunning);
+    result.findings.flag(FindingKey::LogonAuditing, logonAuditing);
+    result.findings.flag(FindingKey::ObjectAccessAuditing, objectAccessAuditing);
+    result.findings.flag(FindingKey::PolicyChangeAuditing, policyChangeAuditing);
+    result.findings.flag(FindingKey::AccountManagementAuditing, accountManagementAuditing);
     
     if (!securityLogSize.empty() && securityLogSize.find_first_of("0123456789") != std::string::npos) {
-        details << "\nSecurity Log Size: " << securityLogSize << " KB";
+        result.findings.number(FindingKey::SecurityLogSize, std::strtoll(securityLogSize.c_str(), nullptr, 10));
     }
     
-    result.details.push_back(details.str());
+    if (securityEvents != nullptr) {
+        result.findings.number(FindingKey::SecurityEventsParsed, static_cast<int64_t>(securityEvents->size()));
+        result.findings.number(FindingKey::LogonEvents, static_cast<int64_t>(logonEvents));
+        result.findings.number(FindingKey::AccountManagementEvents, static_cast<int64_t>(accountEvents));
+        result.findings.number(FindingKey::PolicyChangeEvents, static_cast<int64_t>(policyEvents));
+        if (logCleared > 0) {
+            result.findings.number(FindingKey::SecurityLogCleared, static_cast<int64_t>(logCleared));
+        }
+        if (logonIneffective) {
+            result.findings.message(FindingKey::LogonAuditingIneffective);
+        }
+    }
     
     // Calculate score
     int score = 0;
     
     if (!serviceRunning) {
         score = 0;
+        result.attribution.add("EventLog service", 100);
     } else {
         score = 20; // Base score for service running
         
-        if (logonAuditing) score += 20;
+        // Points missed on each audit category are attributed to it
+        if (logonAuditing && !logonIneffective) score += 20;
+        else result.attribution.add("Audit Logon", 20);
         if (objectAccessAuditing) score += 20;
+        else result.attribution.add("Audit Object Access", 20);
         if (policyChangeAuditing) score += 20;
+        else result.attribution.add("Audit Policy Change", 20);
         if (accountManagementAuditing) score += 20;
+        else result.attribution.add("Audit Account Management", 20);
     }
     
-    result.score = score;
-    
-    if (score >= 90) {
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "Event logging is properly configured. System is compliant.";
-    } else if (score >= 60) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Event logging is partially configured. Enable all recommended audit policies for comprehensive security monitoring.";
-    } else if (score >= 20) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Event logging service is running but audit policies need improvement. Enable logon, object access, policy change, and account management auditing.";
-    } else {
-        result.status = CheckStatus::Fail;
+    // A cleared Security log removes the audit trail
+    if (logCleared > 0) {
+        result.attribution.add("Security log cleared", score >= 20 ? 20 : score);
+        score = score >= 20 ? score - 20 : 0;
+    }
+    
+    size_t band = PolicyTables::applyScore<SystemLoggingStatusPolicy>(result, score);
+    if (logCleared > 0 && band == 1) {
         result.severity = Severity::High;
-        result.recommendation = "Event logging is not properly configured. Enable the Event Log service and configure audit policies for security monitoring.";
+        result.recommendation = "The Security log was cleared recently. Investigate who cleared it (event 1102) and forward Security events to a central collector.";
     }
     
     return result;
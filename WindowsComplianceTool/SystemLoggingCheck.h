@@ -1,9 +1,21 @@
 #pragma once
 #include "ComplianceCheck.h"
+#include <cstdint>
+#include <vector>
+
+class EventRecordSet;
 
 class SystemLoggingCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "System Logging Verification"; }
-};
+    
+    // Score EventLog service status, auditpol output, log size and, when
+    // available, recent Security log events (no system access)
+    static ComplianceResult evaluate(const std::string& serviceStatus, const std::string& auditPolicy,
+                                     const std::string& securityLogSize,
+                                     const EventRecordSet* securityEvents = nullptr);
 
+    // Security log event IDs used as evidence that auditing is effective
+    static const std::vector<uint16_t>& evidenceEventIds();
+};
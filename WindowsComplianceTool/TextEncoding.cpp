@@ -0,0 +1,187 @@
+#include "TextEncoding.h"
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXT_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Shared by the std::string and std::pmr::string overloads
+
+template <typename String>
+void appendUtf16(String& out, const char* data, size_t byteCount) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    size_t units = byteCount / 2;
+    size_t i = 0;
+
+#ifdef TEXT_USE_SSE2
+    const __m128i highMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    char narrow[16];
+#endif
+
+    while (i < units) {
+        size_t blockEnd = units;
+
+#ifdef TEXT_USE_SSE2
+        // Narrow 8 ASCII code units at a time; a block with any non-ASCII
+        // unit falls through to the scalar loop below
+        if (i + 8 <= units) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 2));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, highMask), zero)) == 0xFFFF) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(narrow), _mm_packus_epi16(chunk, chunk));
+                out.append(narrow, 8);
+                i += 8;
+                continue;
+            }
+            blockEnd = i + 8;
+        }
+#endif
+
+        for (; i < blockEnd; ++i) {
+            unsigned int cp = p[i * 2] | (p[i * 2 + 1] << 8);
+
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+                continue;
+            }
+
+            // Surrogate pair
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < units) {
+                unsigned int lo = p[(i + 1) * 2] | (p[(i + 1) * 2 + 1] << 8);
+                if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    ++i;
+                }
+            }
+
+            if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+    }
+}
+
+template <typename String>
+void appendText(String& out, std::string_view bytes) {
+    if (bytes.size() >= 3 &&
+        static_cast<unsigned char>(bytes[0]) == 0xEF &&
+        static_cast<unsigned char>(bytes[1]) == 0xBB &&
+        static_cast<unsigned char>(bytes[2]) == 0xBF) {
+        out.append(bytes.data() + 3, bytes.size() - 3);
+        return;
+    }
+
+    if (TextEncoding::isUtf16LE(bytes)) {
+        size_t skip = (static_cast<unsigned char>(bytes[0]) == 0xFF) ? 2 : 0;
+        out.reserve(out.size() + (bytes.size() - skip) / 2);
+        appendUtf16(out, bytes.data() + skip, bytes.size() - skip);
+        return;
+    }
+
+    out.append(bytes.data(), bytes.size());
+}
+
+} // namespace
+
+bool TextEncoding::readFile(const std::filesystem::path& path, std::string& bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+
+    bytes.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (size > 0 && !file.read(&bytes[0], size)) {
+        bytes.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool TextEncoding::readTextFile(const std::string& path, std::string& text) {
+    std::string bytes;
+    if (!readFile(path, bytes)) {
+        return false;
+    }
+
+    text = toUtf8(bytes);
+    return true;
+}
+
+#ifdef _WIN32
+std::string TextEncoding::pathToUtf8(const std::filesystem::path& path) {
+    const std::wstring& wide = path.native();
+    if (wide.empty()) return std::string();
+    int length = WideCharToMultiByte(CP_UTF8, 0, wide.data(), static_cast<int>(wide.size()), nullptr, 0, nullptr, nullptr);
+    std::string out(length > 0 ? length : 0, '\0');
+    if (length > 0) {
+        WideCharToMultiByte(CP_UTF8, 0, wide.data(), static_cast<int>(wide.size()), &out[0], length, nullptr, nullptr);
+    }
+    return out;
+}
+#else
+std::string TextEncoding::pathToUtf8(const std::filesystem::path& path) {
+    return path.string();
+}
+#endif
+
+bool TextEncoding::isUtf16LE(std::string_view bytes) {
+    if (bytes.size() < 2) return false;
+
+    unsigned char b0 = static_cast<unsigned char>(bytes[0]);
+    unsigned char b1 = static_cast<unsigned char>(bytes[1]);
+
+    // Explicit BOM
+    if (b0 == 0xFF && b1 == 0xFE) return true;
+
+    // No BOM: ASCII text encoded as UTF-16LE has a zero high byte
+    return b0 != 0 && b1 == 0;
+}
+
+std::string TextEncoding::toUtf8(std::string_view bytes) {
+    std::string out;
+    appendText(out, bytes);
+    return out;
+}
+
+void TextEncoding::appendUtf8(std::pmr::string& out, std::string_view bytes) {
+    appendText(out, bytes);
+}
+
+std::string TextEncoding::utf16LEToUtf8(const char* data, size_t byteCount) {
+    std::string out;
+    out.reserve(byteCount / 2);
+    appendUtf16LE(out, data, byteCount);
+    return out;
+}
+
+void TextEncoding::appendUtf16LE(std::string& out, const char* data, size_t byteCount) {
+    appendUtf16(out, data, byteCount);
+}
+
+void TextEncoding::appendUtf16LE(std::pmr::string& out, const char* data, size_t byteCount) {
+    appendUtf16(out, data, byteCount);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <filesystem>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+// Helpers for reading probe output files written by Windows tools
+// (secedit, Export-Csv, wevtutil) which may be UTF-8 or UTF-16LE.
+class TextEncoding {
+public:
+    // Read a whole file into memory as raw bytes
+    static bool readFile(const std::filesystem::path& path, std::string& bytes);
+
+    // Read a file and convert it to UTF-8 (BOM is stripped)
+    static bool readTextFile(const std::string& path, std::string& text);
+
+    // Convert raw bytes to UTF-8, detecting UTF-16LE and UTF-8 byte order marks
+    static std::string toUtf8(std::string_view bytes);
+    static void appendUtf8(std::pmr::string& out, std::string_view bytes);
+
+    // Convert UTF-16LE code units (no BOM) to UTF-8
+    static std::string utf16LEToUtf8(const char* data, size_t byteCount);
+    static void appendUtf16LE(std::string& out, const char* data, size_t byteCount);
+    static void appendUtf16LE(std::pmr::string& out, const char* data, size_t byteCount);
+
+    // Path as UTF-8. path::string() converts through the ANSI code page on
+    // Windows and throws for names outside it.
+    static std::string pathToUtf8(const std::filesystem::path& path);
+
+    // True if the buffer starts with a UTF-16LE BOM or looks like UTF-16LE text
+    static bool isUtf16LE(std::string_view bytes);
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Case-insensitive helpers for the identifiers the parsers compare:
+// registry paths and value names, policy keys, account and file names.
+// Folding is ASCII only; std::tolower's locale lookup dominates otherwise.
+// Trimming and number parsing shared by the text parsers follow.
+namespace TextUtil {
+
+inline unsigned char foldCase(char c) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    return byte >= 'A' && byte <= 'Z' ? static_cast<unsigned char>(byte + ('a' - 'A')) : byte;
+}
+
+inline bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i] && foldCase(a[i]) != foldCase(b[i])) return false;
+    }
+    return true;
+}
+
+inline bool startsWithIgnoreCase(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && equalsIgnoreCase(text.substr(0, prefix.size()), prefix);
+}
+
+inline bool containsIgnoreCase(std::string_view text, std::string_view part) {
+    if (part.size() > text.size()) return false;
+    for (size_t i = 0; i + part.size() <= text.size(); ++i) {
+        if (equalsIgnoreCase(text.substr(i, part.size()), part)) return true;
+    }
+    return false;
+}
+
+// Ordering consistent with equalsIgnoreCase
+inline bool lessIgnoreCase(std::string_view a, std::string_view b) {
+    size_t length = a.size() < b.size() ? a.size() : b.size();
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char ca = foldCase(a[i]);
+        unsigned char cb = foldCase(b[i]);
+        if (ca != cb) return ca < cb;
+    }
+    return a.size() < b.size();
+}
+
+inline std::string toLower(std::string_view text) {
+    std::string result(text);
+    for (char& c : result) c = static_cast<char>(foldCase(c));
+    return result;
+}
+
+// FNV-1a over the folded bytes; equal for names equalsIgnoreCase matches
+inline uint32_t hashIgnoreCase(std::string_view text) {
+    uint32_t hash = 2166136261u;
+    for (char c : text) {
+        hash = (hash ^ foldCase(c)) * 16777619u;
+    }
+    return hash;
+}
+
+// ASCII whitespace, as std::isspace in the C locale
+inline bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && isSpace(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+// Signed decimal integer making up the whole text, at most 18 digits so
+// it cannot overflow
+inline bool parseNumber(std::string_view text, int64_t& value) {
+    bool negative = !text.empty() && text.front() == '-';
+    if (negative) text.remove_prefix(1);
+    if (text.empty() || text.size() > 18) return false;
+    int64_t result = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+        result = result * 10 + (c - '0');
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+// Decimal digits at the start of the text ("22621.3007" -> 22621); 0 if
+// there are none or they do not fit in 32 bits
+inline uint32_t leadingNumber(std::string_view text) {
+    uint64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') break;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+        if (value > 0xFFFFFFFFu) return 0;
+    }
+    return static_cast<uint32_t>(value);
+}
+
+} // namespace TextUtil
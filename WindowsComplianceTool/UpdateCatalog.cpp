@@ -0,0 +1,225 @@
+#include "UpdateCatalog.h"
+#include "CsvReader.h"
+#include "RegistryProvider.h"
+#include "TextUtil.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+// Builds, revisions and KB numbers are the digits a field starts with
+using TextUtil::leadingNumber;
+
+} // namespace
+
+uint32_t InstalledUpdates::parseKb(std::string_view text) {
+    // "KB5034441" anywhere in the text (package names embed it between '_' and '~')
+    for (size_t pos = 0; pos + 2 < text.size(); ++pos) {
+        if ((text[pos] == 'K' || text[pos] == 'k') && (text[pos + 1] == 'B' || text[pos + 1] == 'b') &&
+            std::isdigit(static_cast<unsigned char>(text[pos + 2]))) {
+            return leadingNumber(text.substr(pos + 2));
+        }
+    }
+
+    // Bare KB number
+    if (!text.empty() && std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return leadingNumber(text);
+    }
+    return 0;
+}
+
+uint32_t InstalledUpdates::parseRollupRevision(std::string_view name) {
+    // The version is the last '~' field: build.revision.x.y
+    if (name.find("RollupFix") == std::string_view::npos) return 0;
+    size_t tilde = name.rfind('~');
+    if (tilde == std::string_view::npos) return 0;
+    std::string_view version = name.substr(tilde + 1);
+    size_t dot = version.find('.');
+    return dot != std::string_view::npos ? leadingNumber(version.substr(dot + 1)) : 0;
+}
+
+void InstalledUpdates::add(std::string_view name) {
+    uint32_t revision = parseRollupRevision(name);
+    if (revision != 0) {
+        // Superseded rollups can stay staged; the newest one counts
+        if (revision > osRevision) osRevision = revision;
+        return;
+    }
+    uint32_t kb = parseKb(name);
+    if (kb != 0) {
+        kbs.insert(kb);
+    }
+}
+
+bool InstalledUpdates::covers(const UpdateEntry& entry) const {
+    if (contains(entry.kb)) return true;
+    return entry.revision != 0 && entry.build == osBuild && osRevision >= entry.revision;
+}
+
+bool InstalledUpdates::loadFromCsv(const CsvReader& table) {
+    int idColumn = table.columnIndex("HotFixID");
+    if (idColumn < 0) {
+        return false;
+    }
+
+    kbs.reserve(kbs.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        add(table.row(i)[idColumn]);
+    }
+    return true;
+}
+
+bool InstalledUpdates::loadFromRegistry(const RegistryProvider& registry) {
+    const char* currentVersion = "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion";
+    osBuild = leadingNumber(registry.readValue(currentVersion, "CurrentBuild"));
+    uint32_t revision = leadingNumber(registry.readValue(currentVersion, "UBR"));
+    if (revision > osRevision) osRevision = revision;
+
+    std::vector<std::string> packages;
+    if (!registry.enumerateSubkeys("HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Component Based Servicing\\Packages", packages)) {
+        return osBuild != 0;
+    }
+
+    kbs.reserve(kbs.size() + packages.size());
+    for (const auto& package : packages) {
+        add(package);
+    }
+    return true;
+}
+
+bool UpdateCatalog::loadFromFile(const std::string& path) {
+    CsvReader table;
+    if (!table.loadFromFile(path)) {
+        return false;
+    }
+    return loadFromCsv(table);
+}
+
+bool UpdateCatalog::loadFromCsv(const CsvReader& table) {
+    int kbColumn = table.columnIndex("KB");
+    int buildColumn = table.columnIndex("Build");
+    int revisionColumn = table.columnIndex("Revision");
+    int titleColumn = table.columnIndex("Title");
+    int severityColumn = table.columnIndex("Severity");
+    int releasedColumn = table.columnIndex("Released");
+    int supersedesColumn = table.columnIndex("Supersedes");
+    if (kbColumn < 0) {
+        return false;
+    }
+
+    entries.reserve(entries.size() + table.rowCount());
+    std::vector<uint32_t> supersedes;
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        uint32_t kb = InstalledUpdates::parseKb(row[kbColumn]);
+        if (kb == 0) continue;
+
+        supersedes.clear();
+        std::string_view list = row[supersedesColumn];
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t end = list.find_first_of("; ,", pos);
+            if (end == std::string_view::npos) end = list.size();
+            uint32_t old = InstalledUpdates::parseKb(list.substr(pos, end - pos));
+            if (old != 0) supersedes.push_back(old);
+            pos = end + 1;
+        }
+
+        add(kb, leadingNumber(row[buildColumn]), row[titleColumn], parseSeverity(row[severityColumn]),
+            row[releasedColumn], supersedes, revisionColumn >= 0 ? leadingNumber(row[revisionColumn]) : 0);
+    }
+
+    build();
+    return true;
+}
+
+void UpdateCatalog::add(uint32_t kb, uint32_t build, std::string_view title, Severity severity, std::string_view released,
+                        const std::vector<uint32_t>& supersedes, uint32_t revision) {
+    UpdateEntry entry;
+    entry.kb = kb;
+    entry.build = build;
+    entry.revision = revision;
+    entry.title.assign(title.data(), title.size());
+    entry.severity = severity;
+    entry.released.assign(released.data(), released.size());
+    entry.firstSuperseded = static_cast<uint32_t>(superseded.size());
+    entry.supersededCount = static_cast<uint32_t>(supersedes.size());
+    superseded.insert(superseded.end(), supersedes.begin(), supersedes.end());
+    entries.push_back(std::move(entry));
+}
+
+void UpdateCatalog::build() {
+    byKb.clear();
+    byKb.reserve(entries.size());
+    std::vector<uint32_t> builds;
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        byKb.emplace(entries[i].kb, i);
+        if (entries[i].build != 0) builds.push_back(entries[i].build);
+    }
+    std::sort(builds.begin(), builds.end());
+    builds.erase(std::unique(builds.begin(), builds.end()), builds.end());
+    builds.push_back(0);    // hosts of builds the catalog does not list get the build-independent updates
+
+    // Current updates of a build: applicable entries that no other applicable entry supersedes.
+    // Supersedence is transitive through the chain, so only the newest update of each chain is
+    // current, and a host that installed it (or anything newer) is not missing the older ones.
+    currentByBuild.clear();
+    std::unordered_set<uint32_t> replaced;
+    for (uint32_t build : builds) {
+        replaced.clear();
+        for (const auto& entry : entries) {
+            if (entry.build != 0 && entry.build != build) continue;
+            replaced.insert(supersededBegin(entry), supersededEnd(entry));
+        }
+
+        std::vector<uint32_t>& current = currentByBuild[build];
+        for (uint32_t i = 0; i < entries.size(); ++i) {
+            const UpdateEntry& entry = entries[i];
+            if (entry.build != 0 && entry.build != build) continue;
+            if (replaced.count(entry.kb) == 0) current.push_back(i);
+        }
+
+        // Most severe, then newest first, so evaluate() output needs no sorting
+        std::sort(current.begin(), current.end(), [this](uint32_t a, uint32_t b) {
+            if (entries[a].severity != entries[b].severity) {
+                return static_cast<int>(entries[a].severity) > static_cast<int>(entries[b].severity);
+            }
+            return entries[a].released > entries[b].released;
+        });
+    }
+}
+
+void UpdateCatalog::clear() {
+    entries.clear();
+    superseded.clear();
+    byKb.clear();
+    currentByBuild.clear();
+}
+
+const UpdateEntry* UpdateCatalog::find(uint32_t kb) const {
+    auto it = byKb.find(kb);
+    return it != byKb.end() ? &entries[it->second] : nullptr;
+}
+
+const std::vector<uint32_t>& UpdateCatalog::currentUpdates(uint32_t build) const {
+    static const std::vector<uint32_t> none;
+    auto it = currentByBuild.find(build);
+    if (it == currentByBuild.end()) it = currentByBuild.find(0);
+    return it != currentByBuild.end() ? it->second : none;
+}
+
+PatchGap UpdateCatalog::evaluate(const InstalledUpdates& host) const {
+    PatchGap gap;
+    const std::vector<uint32_t>& current = currentUpdates(host.build());
+    gap.applicable = current.size();
+
+    for (uint32_t index : current) {
+        const UpdateEntry& entry = entries[index];
+        if (host.covers(entry)) {
+            gap.installed++;
+        } else {
+            gap.missing.push_back(&entry);
+        }
+    }
+    return gap;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "ComplianceResult.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class CsvReader;
+class RegistryProvider;
+
+// One update of the local catalog
+struct UpdateEntry {
+    uint32_t kb = 0;
+    uint32_t build = 0;         // OS build it applies to (e.g. 22631), 0 = any build
+    uint32_t revision = 0;      // cumulative updates: the UBR they bring the build to, 0 = none
+    std::string title;
+    Severity severity = Severity::Medium;
+    std::string released;       // YYYY-MM-DD
+    uint32_t firstSuperseded = 0;
+    uint32_t supersededCount = 0;
+};
+
+// Updates installed on one host: OS build and revision plus installed KB
+// numbers. Cumulative updates are servicing packages without a KB in
+// their name (Package_for_RollupFix~...~22621.3007.1.7), so they are
+// recognized by the revision they bring the build to.
+class InstalledUpdates {
+public:
+    // Get-HotFix export (HotFixID column)
+    bool loadFromCsv(const CsvReader& table);
+
+    // CurrentBuild, UBR and Component Based Servicing package names (live or offline hives)
+    bool loadFromRegistry(const RegistryProvider& registry);
+
+    // "KB5034441", "5034441", a servicing package name containing KB<n>,
+    // or a RollupFix package, which raises the revision
+    void add(std::string_view name);
+    void setBuild(uint32_t value) { osBuild = value; }
+    void setRevision(uint32_t value) { osRevision = value; }
+
+    uint32_t build() const { return osBuild; }
+    uint32_t revision() const { return osRevision; }
+    bool contains(uint32_t kb) const { return kbs.count(kb) != 0; }
+    size_t size() const { return kbs.size(); }
+
+    // Installed by KB, or a cumulative update of the host's build whose
+    // revision the host has reached
+    bool covers(const UpdateEntry& entry) const;
+
+    // KB number in text, 0 if there is none
+    static uint32_t parseKb(std::string_view text);
+
+    // Revision (UBR) of a RollupFix package name, 0 for other names
+    static uint32_t parseRollupRevision(std::string_view name);
+
+private:
+    uint32_t osBuild = 0;
+    uint32_t osRevision = 0;
+    std::unordered_set<uint32_t> kbs;
+};
+
+// Missing updates for one host
+struct PatchGap {
+    size_t applicable = 0;          // current (not superseded) updates for the build
+    size_t installed = 0;           // of those, installed
+    std::vector<const UpdateEntry*> missing;    // most severe first
+};
+
+// Locally stored update catalog with supersedence chains. After build(),
+// the current updates of every build (those no applicable update
+// supersedes) are precomputed, so evaluating a host is one hash lookup
+// per current update and needs no update service or network.
+//
+// CSV format (header required, Supersedes is a ';' or space separated KB list,
+// the Revision column is optional):
+//   KB,Build,Revision,Title,Severity,Released,Supersedes
+//   5034441,19045,3930,2024-01 Cumulative Update,Critical,2024-01-09,5033372;5032189
+class UpdateCatalog {
+public:
+    bool loadFromFile(const std::string& path);
+    bool loadFromCsv(const CsvReader& table);
+
+    // Add an update; call build() before evaluating hosts
+    void add(uint32_t kb, uint32_t build, std::string_view title, Severity severity, std::string_view released,
+             const std::vector<uint32_t>& supersedes, uint32_t revision = 0);
+
+    // Index the catalog and resolve supersedence per build
+    void build();
+
+    void clear();
+    size_t size() const { return entries.size(); }
+    const UpdateEntry* find(uint32_t kb) const;     // first entry for the KB
+
+    // Updates an entry replaces
+    const uint32_t* supersededBegin(const UpdateEntry& entry) const { return superseded.data() + entry.firstSuperseded; }
+    const uint32_t* supersededEnd(const UpdateEntry& entry) const { return supersededBegin(entry) + entry.supersededCount; }
+
+    PatchGap evaluate(const InstalledUpdates& host) const;
+
+private:
+    std::vector<UpdateEntry> entries;
+    std::vector<uint32_t> superseded;
+    std::unordered_map<uint32_t, uint32_t> byKb;                        // KB -> entry index
+    std::unordered_map<uint32_t, std::vector<uint32_t>> currentByBuild; // build -> current entry indexes
+
+    const std::vector<uint32_t>& currentUpdates(uint32_t build) const;
+};
@@ -1,77 +1,157 @@
 #include "UserAccountCheck.h"
-#include <sstream>
+#include "AccountDirectory.h"
+#include "CsvReader.h"
+#include "PolicyTables.h"
+#include "RegistryProvider.h"
+#include <chrono>
 #include <vector>
 
+namespace {
+
+// FILETIME ticks (100 ns since 1601) per day, and the offset of the Unix epoch
+const uint64_t TicksPerDay = 864000000000ull;
+const uint64_t UnixEpochTicks = 116444736000000000ull;
+
+// Enabled accounts without a logon for this long are reported as stale
+const uint64_t StaleLogonDays = 90;
+
+uint64_t currentFileTime() {
+    auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    return UnixEpochTicks + static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count()) * 10;
+}
+
+const uint32_t GuestRid = 501;
+
+} // namespace
+
 ComplianceResult UserAccountCheck::performCheck() {
+    AccountDirectory accounts;
+    
+    // Offline: users and group memberships straight from the SAM hive
+    const RegistryHive* sam = registryProvider ? registryProvider->hive("SAM") : nullptr;
+    if (sam != nullptr) {
+        accounts.loadFromSam(*sam);
+    } else {
+        // Local users, and the members of every local group, keyed by SID
+        CsvReader users;
+        executePowerShellCsv("Get-LocalUser | Select-Object Name, @{Name='SID';Expression={$_.SID.Value}}, Enabled, @{Name='PasswordNeverExpires';Expression={-not $_.PasswordExpires}}, PasswordRequired, @{Name='LastLogon';Expression={ if ($_.LastLogon) { $_.LastLogon.ToFileTimeUtc() } }}", users);
+        
+        CsvReader memberships;
+        executePowerShellCsv("Get-LocalGroup | ForEach-Object { $g = $_; Get-LocalGroupMember -Group $g -ErrorAction SilentlyContinue | Select-Object @{Name='Group';Expression={$g.Name}}, @{Name='GroupSID';Expression={$g.SID.Value}}, Name, @{Name='SID';Expression={$_.SID.Value}}, ObjectClass }", memberships);
+        
+        accounts.loadFromCsv(users, memberships);
+    }
+    
+    return evaluate(accounts, currentFileTime());
+}
+
+ComplianceResult UserAccountCheck::evaluate(const AccountDirectory& accounts, uint64_t now) {
     ComplianceResult result("User Account Review",
                            "Lists local accounts and identifies unnecessary or admin-level users.",
                            CheckStatus::Pass, Severity::Low, 100);
     
-    result.details.push_back("Reviewing local user accounts...");
-    
-    // Get local user accounts using PowerShell
-    std::string psCommand = "Get-LocalUser | Select-Object Name, Enabled, Description, PrincipalSource | Format-List";
-    std::string output = executePowerShell(psCommand);
-    
-    // Also get admin accounts
-    std::string adminCommand = "Get-LocalGroupMember -Group 'Administrators' | Select-Object Name, PrincipalSource | Format-List";
-    std::string adminOutput = executePowerShell(adminCommand);
-    
     int totalUsers = 0;
     int enabledUsers = 0;
-    int adminUsers = 0;
     int disabledUsers = 0;
-    std::vector<std::string> adminAccountNames;
-    
-    // Count users from output
-    size_t pos = 0;
-    while ((pos = output.find("Name", pos)) != std::string::npos) {
-        totalUsers++;
-        pos += 4;
+    int neverExpiringUsers = 0;
+    int passwordNotRequiredUsers = 0;
+    int staleUsers = 0;
+    bool guestEnabled = false;
+    
+    // Enabled principals with privileged rights; via is the direct group that grants them
+    struct PrivilegedAccount {
+        uint32_t id;
+        uint32_t via;
+        uint32_t groups;
+    };
+    std::vector<PrivilegedAccount> adminAccounts;
+    std::vector<PrivilegedAccount> operatorAccounts;
+    int nestedAdmins = 0;
+    
+    for (uint32_t id = 0; id < accounts.size(); ++id) {
+        const Principal& principal = accounts.principal(id);
+        if (principal.kind == PrincipalKind::Group) {
+            continue;
+        }
+        bool enabled = (principal.flags & AccountDisabled) == 0;
         
-        // Check if enabled
-        size_t enabledPos = output.find("Enabled", pos);
-        if (enabledPos != std::string::npos && enabledPos < pos + 200) {
-            if (output.find("True", enabledPos) != std::string::npos) {
-                enabledUsers++;
-            } else {
+        if (principal.kind == PrincipalKind::User && (principal.flags & AccountLocal)) {
+            totalUsers++;
+            if (!enabled) {
                 disabledUsers++;
+            } else {
+                enabledUsers++;
+                if (principal.flags & AccountPasswordNeverExpires) neverExpiringUsers++;
+                if (principal.flags & AccountPasswordNotRequired) passwordNotRequiredUsers++;
+                if (principal.rid() == GuestRid) guestEnabled = true;
+                if (now != 0 && principal.lastLogon != 0 && principal.lastLogon < now &&
+                    (now - principal.lastLogon) / TicksPerDay > StaleLogonDays) {
+                    staleUsers++;
+                }
             }
         }
-    }
-    
-    // Count admin users
-    pos = 0;
-    while ((pos = adminOutput.find("Name", pos)) != std::string::npos) {
-        adminUsers++;
-        size_t nameStart = adminOutput.find(":", pos) + 1;
-        size_t nameEnd = adminOutput.find("\n", nameStart);
-        if (nameEnd != std::string::npos) {
-            std::string adminName = adminOutput.substr(nameStart, nameEnd - nameStart);
-            // Remove whitespace
-            adminName.erase(0, adminName.find_first_not_of(" \t"));
-            adminName.erase(adminName.find_last_not_of(" \t") + 1);
-            if (!adminName.empty() && adminName.find("Administrator") == std::string::npos) {
-                adminAccountNames.push_back(adminName);
+        
+        uint32_t groups = accounts.privilegedGroups(id);
+        if (!enabled || groups == 0) {
+            continue;
+        }
+        
+        // Prefer a direct privileged group; otherwise name the group it is nested through
+        uint32_t wanted = (groups & AdministrativeGroups) ? AdministrativeGroups : groups;
+        uint32_t via = AccountDirectory::NoPrincipal;
+        bool direct = false;
+        accounts.forEachGroup(id, [&](uint32_t group) {
+            if (direct || (accounts.privilegedGroups(group) & wanted) == 0) return;
+            if (accounts.ownPrivilege(group) & wanted) {
+                via = group;
+                direct = true;
+            } else if (via == AccountDirectory::NoPrincipal) {
+                via = group;
             }
+        });
+        
+        if (groups & AdministrativeGroups) {
+            adminAccounts.push_back({ id, via, groups });
+            if (!direct) nestedAdmins++;
+        } else {
+            operatorAccounts.push_back({ id, via, groups });
         }
-        pos += 4;
     }
-    
-    std::stringstream details;
-    details << "Total Local Users: " << totalUsers << "\n";
-    details << "Enabled Users: " << enabledUsers << "\n";
-    details << "Disabled Users: " << disabledUsers << "\n";
-    details << "Administrator Accounts: " << adminUsers;
-    
-    if (!adminAccountNames.empty()) {
-        details << "\n\nAdmin Accounts (excluding built-in Administrator):\n";
-        for (const auto& name : adminAccountNames) {
-            details << "  - " << name << "\n";
-        }
+    int adminUsers = static_cast<int>(adminAccounts.size());
+    
+    result.findings.number(FindingKey::TotalUsers, totalUsers);
+    result.findings.number(FindingKey::EnabledUsers, enabledUsers);
+    result.findings.number(FindingKey::DisabledUsers, disabledUsers);
+    result.findings.number(FindingKey::AdminAccounts, adminUsers);
+    if (nestedAdmins > 0) {
+        result.findings.number(FindingKey::NestedAdminAccounts, nestedAdmins);
+    }
+    result.findings.number(FindingKey::OtherPrivilegedAccounts, static_cast<int64_t>(operatorAccounts.size()));
+    result.findings.number(FindingKey::PasswordNeverExpires, neverExpiringUsers);
+    result.findings.number(FindingKey::PasswordNotRequired, passwordNotRequiredUsers);
+    if (now != 0) {
+        result.findings.number(FindingKey::StaleAccounts, staleUsers);
+    }
+    if (guestEnabled) {
+        result.findings.flag(FindingKey::GuestAccount, true);
     }
     
-    result.details.push_back(details.str());
+    const size_t maxListed = 20;
+    std::string via;
+    auto listAccounts = [&](FindingKey key, const std::vector<PrivilegedAccount>& list) {
+        for (size_t i = 0; i < list.size() && i < maxListed; ++i) {
+            via.clear();
+            if (list[i].via != AccountDirectory::NoPrincipal) {
+                via.assign("via ").append(accounts.principal(list[i].via).name);
+            }
+            result.findings.item(key, accounts.principal(list[i].id).name, via);
+        }
+        if (list.size() > maxListed) {
+            result.findings.number(FindingKey::More, static_cast<int64_t>(list.size() - maxListed));
+        }
+    };
+    listAccounts(FindingKey::AdminAccount, adminAccounts);
+    listAccounts(FindingKey::PrivilegedAccount, operatorAccounts);
     
     // Calculate score
     int score = 100;
@@ -80,17 +160,41 @@ ComplianceResult UserAccountCheck::performCheck() {
     // Penalty for too many admin accounts
     if (adminUsers > 2) {
         score -= (adminUsers - 2) * 10;
+        result.attribution.add("Administrator accounts", (adminUsers - 2) * 10);
         issues++;
     }
     
     // Penalty for disabled accounts (potential security risk if not needed)
     if (disabledUsers > 0) {
         score -= 10;
+        result.attribution.add("Disabled accounts", 10);
     }
     
     // Penalty for too many total users (indicates poor account management)
     if (totalUsers > 10) {
         score -= 10;
+        result.attribution.add("Local account count", 10);
+        issues++;
+    }
+    
+    // Penalties for weak account settings
+    if (guestEnabled) {
+        score -= 20;
+        result.attribution.add("Guest account", 20);
+        issues++;
+    }
+    if (passwordNotRequiredUsers > 0) {
+        score -= 15;
+        result.attribution.add("Password not required", 15);
+        issues++;
+    }
+    if (neverExpiringUsers > 0) {
+        score -= 5;
+        result.attribution.add("Password never expires", 5);
+    }
+    if (staleUsers > 0) {
+        score -= 10;
+        result.attribution.add("Stale accounts", 10);
         issues++;
     }
     
@@ -98,20 +202,12 @@ ComplianceResult UserAccountCheck::performCheck() {
     
     result.score = score;
     
-    if (score >= 90) {
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "User account configuration is appropriate. System is compliant.";
-    } else if (score >= 70) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Review user accounts. Consider removing unnecessary accounts and limiting administrator access.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.severity = Severity::High;
-        result.recommendation = "User account configuration needs attention. Reduce the number of administrator accounts and remove unused accounts.";
-    }
+    const char* advice[] = {
+        "User account configuration is appropriate. System is compliant.",
+        "Review user accounts. Consider removing unnecessary accounts and limiting administrator access.",
+        "User account configuration needs attention. Reduce the number of administrator accounts and remove unused accounts."
+    };
+    result.recommendation = advice[PolicyTables::applyScore<DefaultStatusPolicy>(result, score)];
     
     return result;
 }
-
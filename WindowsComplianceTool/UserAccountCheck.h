@@ -1,9 +1,15 @@
 #pragma once
 #include "ComplianceCheck.h"
+#include <cstdint>
+
+class AccountDirectory;
 
 class UserAccountCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "User Account Review"; }
+    
+    // Score accounts and effective group memberships; now is a FILETIME used
+    // to age last logons, 0 skips the stale-account test (no system access)
+    static ComplianceResult evaluate(const AccountDirectory& accounts, uint64_t now);
 };
-
@@ -0,0 +1,121 @@
+#include "VulnerabilityDatabase.h"
+#include "CsvReader.h"
+#include <algorithm>
+
+namespace {
+
+// Open-ended ranges (no fixed version) sort above every real version
+SoftwareVersion unboundedVersion() {
+    SoftwareVersion version;
+    for (auto& part : version.parts) part = 0xFFFFFFFFu;
+    version.count = 4;
+    return version;
+}
+
+} // namespace
+
+bool VulnerabilityEntry::affects(const SoftwareVersion& version) const {
+    if (introduced.valid() && version < introduced) return false;
+    if (fixed.valid() && !(version < fixed)) return false;
+    return true;
+}
+
+bool VulnerabilityDatabase::loadFromFile(const std::string& path) {
+    CsvReader table;
+    if (!table.loadFromFile(path)) {
+        return false;
+    }
+    return loadFromCsv(table);
+}
+
+bool VulnerabilityDatabase::loadFromCsv(const CsvReader& table) {
+    int productColumn = table.columnIndex("Product");
+    int introducedColumn = table.columnIndex("Introduced");
+    int fixedColumn = table.columnIndex("Fixed");
+    int idColumn = table.columnIndex("Id");
+    int severityColumn = table.columnIndex("Severity");
+    if (productColumn < 0 || (introducedColumn < 0 && fixedColumn < 0)) {
+        return false;
+    }
+
+    entries.reserve(entries.size() + table.rowCount());
+    for (size_t i = 0; i < table.rowCount(); ++i) {
+        CsvReader::Row row = table.row(i);
+        if (row[productColumn].empty()) continue;
+        add(row[productColumn], row[introducedColumn], row[fixedColumn], row[idColumn],
+            parseSeverity(row[severityColumn]));
+    }
+
+    build();
+    return true;
+}
+
+void VulnerabilityDatabase::add(std::string_view product, std::string_view introduced, std::string_view fixed,
+                                std::string_view id, Severity severity) {
+    VulnerabilityEntry entry;
+    entry.product = SoftwareInventory::normalizeProductName(product);
+    if (entry.product.empty()) return;
+    SoftwareVersion::parse(introduced, entry.introduced);
+    SoftwareVersion::parse(fixed, entry.fixed);
+    entry.fixedText.assign(fixed.data(), fixed.size());
+    entry.id.assign(id.data(), id.size());
+    entry.severity = severity;
+    entries.push_back(std::move(entry));
+}
+
+void VulnerabilityDatabase::build() {
+    std::sort(entries.begin(), entries.end(), [](const VulnerabilityEntry& a, const VulnerabilityEntry& b) {
+        int cmp = a.product.compare(b.product);
+        if (cmp != 0) return cmp < 0;
+        return a.introduced < b.introduced;
+    });
+
+    products.clear();
+    maxFixed.assign(entries.size(), SoftwareVersion());
+
+    size_t begin = 0;
+    while (begin < entries.size()) {
+        size_t end = begin;
+        SoftwareVersion runningMax;
+        while (end < entries.size() && entries[end].product == entries[begin].product) {
+            SoftwareVersion fixed = entries[end].fixed.valid() ? entries[end].fixed : unboundedVersion();
+            if (end == begin || runningMax < fixed) runningMax = fixed;
+            maxFixed[end] = runningMax;
+            end++;
+        }
+        products[entries[begin].product] = ProductRange{ begin, end };
+        begin = end;
+    }
+}
+
+void VulnerabilityDatabase::clear() {
+    entries.clear();
+    maxFixed.clear();
+    products.clear();
+}
+
+size_t VulnerabilityDatabase::upperBound(size_t begin, size_t end, const SoftwareVersion& version) const {
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        if (version < entries[mid].introduced) end = mid;
+        else begin = mid + 1;
+    }
+    return begin;
+}
+
+size_t VulnerabilityDatabase::firstOpen(size_t begin, size_t end, const SoftwareVersion& version) const {
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        if (version < maxFixed[mid]) end = mid;
+        else begin = mid + 1;
+    }
+    return begin;
+}
+
+std::vector<const VulnerabilityEntry*> VulnerabilityDatabase::match(const SoftwareRecord& software) const {
+    std::vector<const VulnerabilityEntry*> matches;
+    forEachMatch(software.productKey, software.version, [&](const VulnerabilityEntry& entry) {
+        matches.push_back(&entry);
+    });
+    return matches;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "ComplianceResult.h"
+#include "SoftwareInventory.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CsvReader;
+
+// A vulnerable version range of one product: [introduced, fixed)
+struct VulnerabilityEntry {
+    std::string product;            // normalized product name
+    SoftwareVersion introduced;     // first affected version (unset = all earlier versions)
+    SoftwareVersion fixed;          // first fixed version (unset = no fix)
+    std::string fixedText;          // fixed version as published, for reports
+    std::string id;                 // CVE or advisory ID
+    Severity severity = Severity::Medium;
+
+    bool affects(const SoftwareVersion& version) const;
+};
+
+// Local vulnerable-version database. Entries are grouped by normalized
+// product name; each product's ranges are sorted by introduced version with
+// a running maximum of the fixed version, so a lookup is one hash probe, a
+// binary search and a scan of only the ranges that can still contain the
+// version.
+//
+// CSV format (header required):
+//   Product,Introduced,Fixed,Id,Severity
+//   7-Zip,,24.07,CVE-2024-11477,High
+class VulnerabilityDatabase {
+public:
+    bool loadFromFile(const std::string& path);
+    bool loadFromCsv(const CsvReader& table);
+
+    // Add a range; call build() before lookups
+    void add(std::string_view product, std::string_view introduced, std::string_view fixed,
+             std::string_view id, Severity severity);
+
+    // Sort and index the ranges
+    void build();
+
+    void clear();
+    size_t size() const { return entries.size(); }
+    size_t productCount() const { return products.size(); }
+
+    // Ranges affecting an installed version: fn(const VulnerabilityEntry&)
+    template <typename Fn>
+    void forEachMatch(const std::string& productKey, const SoftwareVersion& version, Fn&& fn) const {
+        if (!version.valid()) return;
+        auto it = products.find(productKey);
+        if (it == products.end()) return;
+        size_t begin = it->second.begin;
+        size_t end = upperBound(begin, it->second.end, version);
+        for (size_t i = firstOpen(begin, end, version); i < end; ++i) {
+            if (entries[i].affects(version)) fn(entries[i]);
+        }
+    }
+
+    // Matches for one installed application
+    std::vector<const VulnerabilityEntry*> match(const SoftwareRecord& software) const;
+
+private:
+    struct ProductRange {
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<VulnerabilityEntry> entries;
+    std::vector<SoftwareVersion> maxFixed;      // running max of fixed within each product
+    std::unordered_map<std::string, ProductRange> products;
+
+    // First range in [begin, end) whose introduced version is above version
+    size_t upperBound(size_t begin, size_t end, const SoftwareVersion& version) const;
+
+    // First range in [begin, end) whose running max fixed version is above version
+    size_t firstOpen(size_t begin, size_t end, const SoftwareVersion& version) const;
+};
@@ -0,0 +1,240 @@
+#include "WhatIfSimulator.h"
+#include "PolicyTables.h"
+#include "TextUtil.h"
+#include <algorithm>
+
+namespace {
+
+using TextUtil::startsWithIgnoreCase;
+
+const std::string_view SecurityPolicyPrefix = "SecurityPolicy\\";
+
+bool isSecurityPolicy(std::string_view name) {
+    return startsWithIgnoreCase(name, SecurityPolicyPrefix);
+}
+
+// Fact name as the definitions store it, as RulePack does for [fact] names
+std::string canonicalName(std::string_view setting) {
+    return isSecurityPolicy(setting) ? std::string(setting) : FactTable::canonicalKeyPath(setting);
+}
+
+inline int64_t contribution(int score, Severity severity) {
+    return static_cast<int64_t>(score) * PolicyTables::weight<ModuleWeights>(severity);
+}
+
+inline bool criticalFailure(const RuleOutcome& outcome) {
+    return outcome.status == CheckStatus::Fail && outcome.severity == Severity::Critical;
+}
+
+} // namespace
+
+WhatIfSimulator::WhatIfSimulator(const std::vector<ComplianceResult>& results) {
+    scanned.reserve(results.size());
+    for (const auto& result : results) {
+        scanned.emplace_back(result.score, result.severity);
+        if (result.status == CheckStatus::NotApplicable) continue;
+        overallWeighted += contribution(result.score, result.severity);
+        overallWeight += PolicyTables::weight<ModuleWeights>(result.severity);
+    }
+}
+
+int WhatIfSimulator::overallScore() const {
+    return overallWeight > 0 ? static_cast<int>(overallWeighted / overallWeight) : 0;
+}
+
+uint32_t WhatIfSimulator::dependentsFor(const std::string& name) {
+    uint32_t id = settings.find(name);
+    if (id == FactTable::NotFound) {
+        settings.set(name, std::string_view());
+        id = settings.find(name);
+    }
+    if (id >= dependents.size()) dependents.resize(id + 1);
+    return id;
+}
+
+void WhatIfSimulator::setBaseline(size_t result, const SecurityBaseline& definition, const FactTable& facts,
+                                  const std::vector<BaselineOutcome>& outcomes) {
+    if (result >= scanned.size() || outcomes.size() != definition.size()) return;
+    baseline = &definition;
+    baselineFacts = facts;
+    controlOutcomes = outcomes;
+    controlMarks.assign(definition.size(), 0);
+    controlFacts.assign(definition.size(), FactTable::NotFound);
+
+    baselineState = ModuleState();
+    baselineState.result = result;
+    baselineState.score = scanned[result].first;
+    baselineState.severity = scanned[result].second;
+    for (uint32_t i = 0; i < definition.size(); ++i) {
+        const BaselineControl& control = definition.controls()[i];
+        int weight = PolicyTables::weight<ModuleWeights>(control.severity);
+        baselineState.weight += weight;
+        if (outcomes[i].passed) baselineState.weighted += weight;
+        else if (control.severity == Severity::Critical) baselineState.criticalFailed++;
+        dependents[dependentsFor(control.factName)].controls.push_back(i);
+    }
+}
+
+void WhatIfSimulator::setRules(size_t result, const RulePack& pack, const FactTable& facts,
+                               const std::vector<RuleOutcome>& outcomes) {
+    if (result >= scanned.size() || outcomes.size() != pack.size()) return;
+    rules = &pack;
+    ruleFacts = facts;
+    ruleOutcomes = outcomes;
+    pack.resolve(ruleFacts, resolved);
+    ruleMarks.assign(pack.size(), 0);
+
+    ruleState = ModuleState();
+    ruleState.result = result;
+    ruleState.score = scanned[result].first;
+    ruleState.severity = scanned[result].second;
+    for (const auto& outcome : outcomes) {
+        ruleState.weighted += contribution(outcome.score, outcome.severity);
+        ruleState.weight += PolicyTables::weight<ModuleWeights>(outcome.severity);
+        if (criticalFailure(outcome)) ruleState.criticalFailed++;
+    }
+
+    // Rules reading each slot, grouped by slot
+    std::vector<std::vector<uint32_t>> readers(pack.factNames().size());
+    for (uint32_t rule = 0; rule < pack.size(); ++rule) {
+        for (uint32_t slot : pack.slotsRead(rule)) readers[slot].push_back(rule);
+    }
+    slotOffsets.assign(1, 0);
+    slotRules.clear();
+    for (uint32_t slot = 0; slot < readers.size(); ++slot) {
+        slotRules.insert(slotRules.end(), readers[slot].begin(), readers[slot].end());
+        slotOffsets.push_back(static_cast<uint32_t>(slotRules.size()));
+        dependents[dependentsFor(pack.factNames()[slot])].slots.push_back(slot);
+    }
+}
+
+uint32_t WhatIfSimulator::writeFact(FactTable& table, const std::string& name, const WhatIfChange& change, bool keep) {
+    // A removed setting only drops the readers' reference to it
+    if (change.remove) return FactTable::NotFound;
+    uint32_t id = table.find(name);
+    if (!keep && id != FactTable::NotFound) factUndo.push_back({ &table, id, table.value(id) });
+    table.set(name, change.value);
+    return id != FactTable::NotFound ? id : table.find(name);
+}
+
+void WhatIfSimulator::finish(ModuleState& state, int score, bool critical, SimulatedModule& module) {
+    state.score = score;
+    state.severity = PolicyTables::severity<DefaultStatusPolicy>(score, critical);
+    module = { state.result, score, PolicyTables::band<DefaultStatusPolicy>(score).status, state.severity };
+}
+
+WhatIfOutcome WhatIfSimulator::run(const std::vector<WhatIfChange>& changes, bool keep) {
+    WhatIfOutcome outcome = { 0, {}, 0, 0 };
+    if (++generation == 0) {
+        std::fill(controlMarks.begin(), controlMarks.end(), 0);
+        std::fill(ruleMarks.begin(), ruleMarks.end(), 0);
+        generation = 1;
+    }
+    touchedControls.clear();
+    touchedRules.clear();
+    slotUndo.clear();
+    factUndo.clear();
+    size_t baselineFactCount = baselineFacts.size();
+    size_t ruleFactCount = ruleFacts.size();
+
+    // Write each change into the facts its readers use
+    for (const auto& change : changes) {
+        std::string name = canonicalName(change.setting);
+        uint32_t id = settings.find(name);
+        if (id == FactTable::NotFound) {
+            outcome.unknownSettings++;
+            continue;
+        }
+        const Dependents& entry = dependents[id];
+        if (baseline && !entry.controls.empty()) {
+            uint32_t fact = writeFact(baselineFacts, name, change, keep);
+            for (uint32_t control : entry.controls) {
+                if (controlMarks[control] != generation) {
+                    controlMarks[control] = generation;
+                    touchedControls.push_back(control);
+                }
+                controlFacts[control] = fact;
+            }
+        }
+        if (rules && !entry.slots.empty()) {
+            RuleFact value = { writeFact(ruleFacts, name, change, keep), false, 0 };
+            if (value.id != FactTable::NotFound) value.numeric = ruleFacts.number(value.id, value.number);
+            for (uint32_t slot : entry.slots) {
+                if (!keep) slotUndo.emplace_back(slot, resolved[slot]);
+                resolved[slot] = value;
+                for (uint32_t i = slotOffsets[slot]; i < slotOffsets[slot + 1]; ++i) {
+                    uint32_t rule = slotRules[i];
+                    if (ruleMarks[rule] != generation) {
+                        ruleMarks[rule] = generation;
+                        touchedRules.push_back(rule);
+                    }
+                }
+            }
+        }
+    }
+
+    // Re-evaluate only what reads a changed setting and move the module
+    // sums by the difference
+    ModuleState baselineNext = baselineState;
+    for (uint32_t control : touchedControls) {
+        BaselineOutcome next = baseline->evaluate(control, baselineFacts, controlFacts[control]);
+        BaselineOutcome& current = controlOutcomes[control];
+        if (next.passed != current.passed) {
+            Severity severity = baseline->controls()[control].severity;
+            int sign = next.passed ? 1 : -1;
+            baselineNext.weighted += sign * PolicyTables::weight<ModuleWeights>(severity);
+            if (severity == Severity::Critical) baselineNext.criticalFailed -= sign;
+            outcome.controlsChanged++;
+        }
+        if (keep) current = next;
+    }
+
+    ModuleState ruleNext = ruleState;
+    for (uint32_t rule : touchedRules) {
+        RuleOutcome next = rules->evaluate(rule, ruleFacts, resolved);
+        RuleOutcome& current = ruleOutcomes[rule];
+        if (next.score != current.score || next.status != current.status || next.severity != current.severity) {
+            ruleNext.weighted += contribution(next.score, next.severity) - contribution(current.score, current.severity);
+            ruleNext.weight += PolicyTables::weight<ModuleWeights>(next.severity) - PolicyTables::weight<ModuleWeights>(current.severity);
+            ruleNext.criticalFailed += (criticalFailure(next) ? 1 : 0) - (criticalFailure(current) ? 1 : 0);
+            outcome.controlsChanged++;
+        }
+        if (keep) current = next;
+    }
+
+    // Same formulas as the checks, then calculateOverallScore's sums
+    // adjusted by each module's change
+    int64_t weighted = overallWeighted, weight = overallWeight;
+    SimulatedModule module;
+    if (baseline && baselineState.result != NoResult) {
+        int score = baselineNext.weight > 0 ? static_cast<int>(baselineNext.weighted * 100 / baselineNext.weight) : 0;
+        finish(baselineNext, score, baselineNext.criticalFailed > 0, module);
+        weighted += contribution(baselineNext.score, baselineNext.severity) - contribution(baselineState.score, baselineState.severity);
+        weight += PolicyTables::weight<ModuleWeights>(baselineNext.severity) - PolicyTables::weight<ModuleWeights>(baselineState.severity);
+        outcome.modules.push_back(module);
+    }
+    if (rules && ruleState.result != NoResult) {
+        int score = ruleNext.weight > 0 ? static_cast<int>(ruleNext.weighted / ruleNext.weight) : 0;
+        finish(ruleNext, score, ruleNext.criticalFailed > 0, module);
+        weighted += contribution(ruleNext.score, ruleNext.severity) - contribution(ruleState.score, ruleState.severity);
+        weight += PolicyTables::weight<ModuleWeights>(ruleNext.severity) - PolicyTables::weight<ModuleWeights>(ruleState.severity);
+        outcome.modules.push_back(module);
+    }
+    outcome.overallScore = weight > 0 ? static_cast<int>(weighted / weight) : 0;
+
+    if (keep) {
+        baselineState = baselineNext;
+        ruleState = ruleNext;
+        overallWeighted = weighted;
+        overallWeight = weight;
+    } else {
+        // Undo in reverse so a setting changed twice gets its first value back
+        for (auto it = slotUndo.rbegin(); it != slotUndo.rend(); ++it) resolved[it->first] = it->second;
+        for (auto it = factUndo.rbegin(); it != factUndo.rend(); ++it) {
+            it->table->set(it->table->name(it->id), it->value);
+        }
+        baselineFacts.truncate(baselineFactCount);
+        ruleFacts.truncate(ruleFactCount);
+    }
+    return outcome;
+}
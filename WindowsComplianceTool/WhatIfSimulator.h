@@ -0,0 +1,119 @@
+#pragma once
+#include "ComplianceResult.h"
+#include "FactTable.h"
+#include "RulePack.h"
+#include "SecurityBaseline.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A hypothetical setting change. Settings are named as in policy rules:
+// "HKLM\<key>\<value name>" or "SecurityPolicy\<section>\<key>".
+struct WhatIfChange {
+    std::string setting;
+    std::string value;
+    bool remove = false;            // setting deleted; the Windows default applies
+};
+
+struct SimulatedModule {
+    size_t result;                  // index into the scan's results
+    int score;
+    CheckStatus status;
+    Severity severity;
+};
+
+struct WhatIfOutcome {
+    int overallScore;
+    std::vector<SimulatedModule> modules;   // settings-driven modules, as simulated
+    uint32_t controlsChanged;       // benchmark controls and rules whose outcome changed
+    uint32_t unknownSettings;       // changes that no control or rule reads
+};
+
+// Answers "what would the scores be if these settings changed" from a
+// finished scan without rescanning. Each setting maps to the benchmark
+// controls and rule fact slots that read it; a query re-evaluates only
+// those, adjusts each module's weighted sums by the difference and
+// updates calculateOverallScore's weighted sum the same way, so a query
+// costs a few lookups and rule runs however large the definitions are.
+// Modules that do not read settings keep their scanned scores.
+class WhatIfSimulator {
+public:
+    static constexpr size_t NoResult = static_cast<size_t>(-1);
+
+    // Overall score as calculateOverallScore computes it for results
+    explicit WhatIfSimulator(const std::vector<ComplianceResult>& results);
+
+    // The scan's settings-driven modules, each set once; result is the
+    // module's index in the results. The definitions must outlive the
+    // simulator.
+    void setBaseline(size_t result, const SecurityBaseline& definition, const FactTable& facts,
+                     const std::vector<BaselineOutcome>& outcomes);
+    void setRules(size_t result, const RulePack& rules, const FactTable& facts,
+                  const std::vector<RuleOutcome>& outcomes);
+
+    int overallScore() const;
+
+    // Scores with the changes applied; the simulator is left as it was
+    WhatIfOutcome simulate(const std::vector<WhatIfChange>& changes) { return run(changes, false); }
+
+    // Apply the changes for good, so later queries start from them (a
+    // remediation planner committing a step)
+    WhatIfOutcome apply(const std::vector<WhatIfChange>& changes) { return run(changes, true); }
+
+private:
+    struct ModuleState {
+        size_t result = NoResult;
+        int64_t weighted = 0;       // passed weight (baseline) or weighted rule score
+        int64_t weight = 0;
+        int criticalFailed = 0;
+        int score = 0;              // contribution to the overall score
+        Severity severity = Severity::Low;
+    };
+
+    // Controls and rule slots reading one setting
+    struct Dependents {
+        std::vector<uint32_t> controls;
+        std::vector<uint32_t> slots;
+    };
+
+    // A fact overwritten during a query, restored afterwards; facts the
+    // query added are dropped by truncating the tables
+    struct FactUndo {
+        FactTable* table;
+        uint32_t id;
+        std::string value;
+    };
+
+    std::vector<std::pair<int, Severity>> scanned;     // score and severity per result
+    int64_t overallWeighted = 0;
+    int64_t overallWeight = 0;
+
+    const SecurityBaseline* baseline = nullptr;
+    FactTable baselineFacts;
+    std::vector<BaselineOutcome> controlOutcomes;
+    ModuleState baselineState;
+
+    const RulePack* rules = nullptr;
+    FactTable ruleFacts;
+    std::vector<RuleFact> resolved;
+    std::vector<RuleOutcome> ruleOutcomes;
+    std::vector<uint32_t> slotOffsets, slotRules;   // slot i is read by slotRules[slotOffsets[i] .. slotOffsets[i + 1]]
+    ModuleState ruleState;
+
+    FactTable settings;                 // setting name -> index into dependents
+    std::vector<Dependents> dependents;
+
+    // Per-query scratch, kept to avoid allocating on every query
+    std::vector<uint32_t> controlMarks, ruleMarks;
+    uint32_t generation = 0;
+    std::vector<uint32_t> touchedControls, touchedRules;
+    std::vector<uint32_t> controlFacts;             // new fact id per touched control
+    std::vector<std::pair<uint32_t, RuleFact>> slotUndo;
+    std::vector<FactUndo> factUndo;
+
+    uint32_t dependentsFor(const std::string& name);
+    uint32_t writeFact(FactTable& table, const std::string& name, const WhatIfChange& change, bool keep);
+    static void finish(ModuleState& state, int score, bool critical, SimulatedModule& module);
+    WhatIfOutcome run(const std::vector<WhatIfChange>& changes, bool keep);
+};
@@ -1,34 +1,88 @@
 #include "WindowsUpdateCheck.h"
-#include <sstream>
+#include "CsvReader.h"
+#include "PolicyTables.h"
+#include "RegistryProvider.h"
+#include "UpdateCatalog.h"
+#include <cstdlib>
+#include <filesystem>
 
 ComplianceResult WindowsUpdateCheck::performCheck() {
+    // Check Windows Update settings via registry
+    std::string auOptions = readRegistryValue(
+        "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\WindowsUpdate\\Auto Update",
+        "AUOptions");
+    
+    // Check if Windows Update service is running. An offline image runs
+    // nothing, so there the service counts as running unless it is disabled.
+    std::string serviceStatus;
+    if (registryProvider) {
+        std::string start = readRegistryValue("HKEY_LOCAL_MACHINE\\SYSTEM\\CurrentControlSet\\Services\\wuauserv", "Start");
+        if (!start.empty() && start != "4") serviceStatus = "Running";
+    } else {
+        serviceStatus = executePowerShell("Get-Service -Name wuauserv | Select-Object -ExpandProperty Status");
+    }
+    
+    // Load the local update catalog once and keep it for later scans
+    if (!updateCatalog) {
+        std::string path = dataFilePath("UpdateCatalog.csv");
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            auto catalog = std::make_shared<UpdateCatalog>();
+            if (catalog->loadFromFile(path)) {
+                updateCatalog = catalog;
+            }
+        }
+    }
+    
+    if (updateCatalog) {
+        // Installed updates from the servicing store (offline hives) or Get-HotFix
+        InstalledUpdates installed;
+        if (registryProvider) {
+            installed.loadFromRegistry(*registryProvider);
+        } else {
+            CsvReader hotfixes;
+            executePowerShellCsv("Get-HotFix | Select-Object HotFixID", hotfixes);
+            installed.loadFromCsv(hotfixes);
+            // Cumulative updates are matched by build revision as well as KB
+            const char* currentVersion = "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion";
+            installed.setBuild(static_cast<uint32_t>(std::strtoul(readRegistryValue(currentVersion, "CurrentBuild").c_str(), nullptr, 10)));
+            installed.setRevision(static_cast<uint32_t>(std::strtoul(readRegistryValue(currentVersion, "UBR").c_str(), nullptr, 10)));
+        }
+        
+        PatchGap gap = updateCatalog->evaluate(installed);
+        return evaluate(auOptions, serviceStatus, std::string(), &gap);
+    }
+    
+    // Check for pending updates; the update agent only searches the live
+    // machine, so an offline image without a catalog has no pending count
+    std::string pendingUpdates;
+    if (!registryProvider) {
+        pendingUpdates = executePowerShell("(New-Object -ComObject Microsoft.Update.Session).CreateUpdateSearcher().Search('IsInstalled=0').Updates.Count");
+    }
+    
+    return evaluate(auOptions, serviceStatus, pendingUpdates);
+}
+
+ComplianceResult WindowsUpdateCheck::evaluate(const std::string& auOptions, const std::string& serviceStatus,
+                                              const std::string& pendingUpdates, const PatchGap* patchGap) {
     ComplianceResult result("Windows Update Status",
                            "Checks if automatic updates and patch management are enabled.",
                            CheckStatus::Pass, Severity::Low, 100);
     
-    result.details.push_back("Checking Windows Update configuration...");
-    
     bool autoUpdateEnabled = false;
     int updateLevel = 0; // 0 = disabled, 1 = notify, 2 = download, 3 = install, 4 = auto install
     
-    // Check Windows Update settings via registry
-    std::string auOptions = readRegistryValue(
-        "HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\WindowsUpdate\\Auto Update",
-        "AUOptions");
-    
     if (!auOptions.empty()) {
         updateLevel = std::stoi(auOptions);
         autoUpdateEnabled = (updateLevel >= 2);
     }
     
-    // Check if Windows Update service is running
-    std::string serviceStatus = executePowerShell("Get-Service -Name wuauserv | Select-Object -ExpandProperty Status");
     bool serviceRunning = (serviceStatus.find("Running") != std::string::npos);
     
-    // Check for pending updates
-    std::string pendingUpdates = executePowerShell("(New-Object -ComObject Microsoft.Update.Session).CreateUpdateSearcher().Search('IsInstalled=0').Updates.Count");
     int pendingCount = 0;
-    if (!pendingUpdates.empty() && pendingUpdates.find_first_of("0123456789") != std::string::npos) {
+    if (patchGap != nullptr) {
+        pendingCount = static_cast<int>(patchGap->missing.size());
+    } else if (!pendingUpdates.empty() && pendingUpdates.find_first_of("0123456789") != std::string::npos) {
         try {
             pendingCount = std::stoi(pendingUpdates);
         } catch (...) {
@@ -36,48 +90,41 @@ ComplianceResult WindowsUpdateCheck::performCheck() {
         }
     }
     
-    std::stringstream details;
-    details << "Automatic Updates: " << (autoUpdateEnabled ? "Enabled" : "Disabled") << "\n";
-    details << "Update Level: " << updateLevel << " (0=Disabled, 2=Download, 3=Install, 4=Auto Install)\n";
-    details << "Windows Update Service: " << (serviceRunning ? "Running" : "Stopped") << "\n";
-    details << "Pending Updates: " << pendingCount;
+    result.findings.flag(FindingKey::AutomaticUpdates, autoUpdateEnabled);
+    result.findings.number(FindingKey::UpdateLevel, updateLevel);
+    result.findings.flag(FindingKey::UpdateService, serviceRunning);
+    result.findings.number(FindingKey::PendingUpdates, pendingCount);
     
-    result.details.push_back(details.str());
+    if (patchGap != nullptr) {
+        result.findings.number(FindingKey::CatalogUpdatesInstalled, patchGap->installed);
+        result.findings.number(FindingKey::CatalogUpdatesApplicable, patchGap->applicable);
+        
+        const size_t maxListed = 10;
+        std::string name;
+        for (size_t i = 0; i < patchGap->missing.size() && i < maxListed; ++i) {
+            const UpdateEntry* update = patchGap->missing[i];
+            name.assign("KB").append(std::to_string(update->kb)).append(" ").append(update->title);
+            result.findings.item(FindingKey::MissingUpdate, name, update->released);
+        }
+        if (patchGap->missing.size() > maxListed) {
+            result.findings.number(FindingKey::More, static_cast<int64_t>(patchGap->missing.size() - maxListed));
+        }
+    }
     
     // Calculate score
-    int score = 0;
+    int score = WindowsUpdateScores.stopped;
     
     if (autoUpdateEnabled && serviceRunning) {
-        score = 100;
-        if (pendingCount > 0) {
-            score -= (pendingCount > 10 ? 20 : pendingCount * 2); // Penalty for pending updates
-            if (score < 70) score = 70; // Minimum score if auto-update is enabled
-        }
+        score = PolicyTables::applyPenalty<PendingUpdatePenalty>(WindowsUpdateScores.automatic, pendingCount);
+        result.attribution.add("Pending updates", WindowsUpdateScores.automatic - score);
     } else if (serviceRunning) {
-        score = 50; // Service running but auto-update not fully configured
+        score = WindowsUpdateScores.serviceOnly; // Service running but auto-update not fully configured
+        result.attribution.add("Automatic updates", WindowsUpdateScores.automatic - score);
     } else {
-        score = 0; // Service not running
+        result.attribution.add("Windows Update service", WindowsUpdateScores.automatic - score);
     }
     
-    result.score = score;
-    
-    if (score >= 90) {
-        result.status = CheckStatus::Pass;
-        result.severity = Severity::Low;
-        result.recommendation = "Windows Update is properly configured. Consider installing pending updates if any.";
-    } else if (score >= 70) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Windows Update is enabled but has pending updates. Install updates to maintain security.";
-    } else if (score >= 50) {
-        result.status = CheckStatus::Warning;
-        result.severity = Severity::Medium;
-        result.recommendation = "Windows Update service is running but automatic updates are not fully configured. Enable automatic installation of updates.";
-    } else {
-        result.status = CheckStatus::Fail;
-        result.severity = Severity::High;
-        result.recommendation = "Windows Update is disabled or not functioning. Enable automatic updates immediately to ensure system security.";
-    }
+    PolicyTables::applyScore<WindowsUpdateStatusPolicy>(result, score);
     
     return result;
 }
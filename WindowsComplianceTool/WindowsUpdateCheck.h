@@ -1,9 +1,25 @@
 #pragma once
 #include "ComplianceCheck.h"
+#include <memory>
+
+class UpdateCatalog;
+struct PatchGap;
 
 class WindowsUpdateCheck : public ComplianceCheck {
 public:
     ComplianceResult performCheck() override;
     std::string getModuleName() const override { return "Windows Update Status"; }
-};
+    
+    // Local update catalog shared across scans; when unset, UpdateCatalog.csv
+    // in the working directory is loaded if present. With a catalog, missing
+    // updates are computed offline instead of asking the Windows Update agent.
+    void setUpdateCatalog(std::shared_ptr<const UpdateCatalog> catalog) { updateCatalog = std::move(catalog); }
+    
+    // Score AUOptions, wuauserv status and pending update count, or the
+    // catalog patch gap when given (no system access)
+    static ComplianceResult evaluate(const std::string& auOptions, const std::string& serviceStatus,
+                                     const std::string& pendingUpdates, const PatchGap* patchGap = nullptr);
 
+private:
+    std::shared_ptr<const UpdateCatalog> updateCatalog;
+};
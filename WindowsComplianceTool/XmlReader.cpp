@@ -0,0 +1,210 @@
+#include "XmlReader.h"
+#include "TextUtil.h"
+#include <cstdint>
+
+namespace {
+
+using TextUtil::isSpace;
+using TextUtil::trim;
+
+// "task:Exec" -> "Exec"
+std::string_view localName(std::string_view name) {
+    size_t colon = name.find(':');
+    return colon == std::string_view::npos ? name : name.substr(colon + 1);
+}
+
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x110000) {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+} // namespace
+
+XmlReader::XmlReader(std::string_view document) : document(document) {
+    // UTF-8 byte order mark
+    if (this->document.size() >= 3 && this->document.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        position = 3;
+    }
+}
+
+XmlReader::Token XmlReader::fail() {
+    position = document.size();
+    return Token::Error;
+}
+
+XmlReader::Token XmlReader::next() {
+    if (popLevel) {
+        popLevel = false;
+        if (level > 0) level--;
+    }
+    if (pendingEnd) {
+        pendingEnd = false;
+        popLevel = true;
+        return Token::EndElement;
+    }
+
+    while (position < document.size()) {
+        if (document[position] != '<') {
+            size_t end = document.find('<', position);
+            if (end == std::string_view::npos) end = document.size();
+            std::string_view run = trim(document.substr(position, end - position));
+            position = end;
+            if (!run.empty()) {
+                textValue = run;
+                cdata = false;
+                return Token::Text;
+            }
+            continue;
+        }
+
+        std::string_view rest = document.substr(position);
+        if (rest.compare(0, 4, "<!--") == 0) {
+            size_t end = document.find("-->", position + 4);
+            if (end == std::string_view::npos) return fail();
+            position = end + 3;
+        } else if (rest.compare(0, 9, "<![CDATA[") == 0) {
+            size_t end = document.find("]]>", position + 9);
+            if (end == std::string_view::npos) return fail();
+            textValue = document.substr(position + 9, end - position - 9);
+            cdata = true;
+            position = end + 3;
+            return Token::Text;
+        } else if (rest.compare(0, 2, "<?") == 0) {
+            size_t end = document.find("?>", position + 2);
+            if (end == std::string_view::npos) return fail();
+            position = end + 2;
+        } else if (rest.compare(0, 2, "<!") == 0) {
+            // DOCTYPE, possibly with an internal subset in brackets
+            size_t end = document.find_first_of("[>", position + 2);
+            if (end != std::string_view::npos && document[end] == '[') {
+                end = document.find("]", end);
+                if (end != std::string_view::npos) end = document.find('>', end);
+            }
+            if (end == std::string_view::npos) return fail();
+            position = end + 1;
+        } else if (rest.compare(0, 2, "</") == 0) {
+            size_t end = document.find('>', position + 2);
+            if (end == std::string_view::npos) return fail();
+            elementName = localName(trim(document.substr(position + 2, end - position - 2)));
+            position = end + 1;
+            popLevel = true;
+            return Token::EndElement;
+        } else {
+            // Start tag: find the closing '>' outside quoted attribute values
+            size_t end = position + 1;
+            char quote = 0;
+            for (; end < document.size(); ++end) {
+                char c = document[end];
+                if (quote != 0) {
+                    if (c == quote) quote = 0;
+                } else if (c == '"' || c == '\'') {
+                    quote = c;
+                } else if (c == '>') {
+                    break;
+                }
+            }
+            if (end >= document.size()) return fail();
+
+            std::string_view tag = document.substr(position + 1, end - position - 1);
+            bool empty = !tag.empty() && tag.back() == '/';
+            if (empty) tag.remove_suffix(1);
+
+            size_t nameEnd = 0;
+            while (nameEnd < tag.size() && !isSpace(tag[nameEnd])) nameEnd++;
+            if (nameEnd == 0) return fail();
+
+            elementName = localName(tag.substr(0, nameEnd));
+            attributes = tag.substr(nameEnd);
+            position = end + 1;
+            level++;
+            pendingEnd = empty;
+            return Token::StartElement;
+        }
+    }
+
+    return level == 0 ? Token::End : Token::Error;
+}
+
+std::string_view XmlReader::attribute(std::string_view attributeName) const {
+    size_t i = 0;
+    while (i < attributes.size()) {
+        while (i < attributes.size() && isSpace(attributes[i])) i++;
+        size_t nameStart = i;
+        while (i < attributes.size() && attributes[i] != '=' && !isSpace(attributes[i])) i++;
+        std::string_view name = attributes.substr(nameStart, i - nameStart);
+        while (i < attributes.size() && isSpace(attributes[i])) i++;
+        if (i >= attributes.size() || attributes[i] != '=') break;
+        i++;
+        while (i < attributes.size() && isSpace(attributes[i])) i++;
+        if (i >= attributes.size() || (attributes[i] != '"' && attributes[i] != '\'')) break;
+
+        char quote = attributes[i++];
+        size_t valueEnd = attributes.find(quote, i);
+        if (valueEnd == std::string_view::npos) break;
+        if (name == attributeName) return attributes.substr(i, valueEnd - i);
+        i = valueEnd + 1;
+    }
+    return std::string_view();
+}
+
+void XmlReader::readText(std::string& out) const {
+    out.clear();
+    if (cdata) {
+        out.assign(textValue.data(), textValue.size());
+    } else {
+        decode(textValue, out);
+    }
+}
+
+void XmlReader::decode(std::string_view raw, std::string& out) {
+    size_t start = 0;
+    for (size_t amp = raw.find('&'); amp != std::string_view::npos; amp = raw.find('&', start)) {
+        out.append(raw.data() + start, amp - start);
+        size_t semicolon = raw.find(';', amp);
+        if (semicolon == std::string_view::npos || semicolon - amp > 10) {
+            out += '&';
+            start = amp + 1;
+            continue;
+        }
+
+        std::string_view entity = raw.substr(amp + 1, semicolon - amp - 1);
+        if (entity == "lt") out += '<';
+        else if (entity == "gt") out += '>';
+        else if (entity == "amp") out += '&';
+        else if (entity == "quot") out += '"';
+        else if (entity == "apos") out += '\'';
+        else if (entity.size() > 1 && entity[0] == '#') {
+            bool hex = entity[1] == 'x' || entity[1] == 'X';
+            uint32_t codePoint = 0;
+            for (size_t i = hex ? 2 : 1; i < entity.size(); ++i) {
+                char c = entity[i];
+                uint32_t digit;
+                if (c >= '0' && c <= '9') digit = static_cast<uint32_t>(c - '0');
+                else if (hex && c >= 'a' && c <= 'f') digit = static_cast<uint32_t>(c - 'a' + 10);
+                else if (hex && c >= 'A' && c <= 'F') digit = static_cast<uint32_t>(c - 'A' + 10);
+                else break;
+                codePoint = codePoint * (hex ? 16 : 10) + digit;
+                if (codePoint >= 0x110000) break;
+            }
+            appendUtf8(out, codePoint);
+        } else {
+            // Unknown entity, keep it verbatim
+            out.append(raw.data() + amp, semicolon - amp + 1);
+        }
+        start = semicolon + 1;
+    }
+    out.append(raw.data() + start, raw.size() - start);
+}
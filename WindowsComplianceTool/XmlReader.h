@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Streaming pull reader for small, well-formed XML documents such as
+// Task Scheduler definitions. The document is scanned once in place:
+// element names, attribute values and text are handed out as string_views
+// into the source, and entities are only decoded when a value is copied
+// out with decode(), so reading a document allocates nothing. DTDs,
+// processing instructions and comments are skipped; namespace prefixes
+// are stripped from element names.
+class XmlReader {
+public:
+    enum class Token {
+        StartElement,
+        EndElement,     // also reported right after an empty element (<Name/>)
+        Text,           // character data or CDATA, whitespace-only runs are skipped
+        End,
+        Error
+    };
+
+    // UTF-8 text; it must outlive the reader
+    explicit XmlReader(std::string_view document);
+
+    Token next();
+
+    // Local name of the current start or end element
+    std::string_view name() const { return elementName; }
+
+    // Raw text of the current Text token (entities not decoded)
+    std::string_view text() const { return textValue; }
+
+    // Raw attribute value of the current start element, empty if missing
+    std::string_view attribute(std::string_view attributeName) const;
+
+    // Nesting depth of the current element (1 = document element)
+    size_t depth() const { return level; }
+
+    // Text of the current Text token with entities decoded (replaces out)
+    void readText(std::string& out) const;
+
+    // Append raw text to out with the standard and numeric character entities replaced
+    static void decode(std::string_view raw, std::string& out);
+
+private:
+    std::string_view document;
+    size_t position = 0;
+    size_t level = 0;
+    bool pendingEnd = false;     // empty element still owes its EndElement
+    bool popLevel = false;       // previous token closed an element
+    bool cdata = false;
+    std::string_view elementName;
+    std::string_view attributes;
+    std::string_view textValue;
+
+    Token fail();
+};